@@ -92,6 +92,7 @@ namespace keen
 	struct GraphicsDescriptorSet;
 	struct GraphicsQueryPool;
 	struct GraphicsCopyPipeline;
+	struct GraphicsIndirectCommandsLayout;
 
 #if KEEN_USING( KEEN_GRAPHICS_RAY_TRACING )
 	struct GraphicsRayTraceMesh;
@@ -154,6 +155,7 @@ namespace keen
 		DescriptorSetLayout,
 		DescriptorSet,
 		QueryPool,
+		IndirectCommandsLayout,
 
 #if KEEN_USING( KEEN_GRAPHICS_RAY_TRACING )
 		RayTraceMesh,
@@ -169,13 +171,17 @@ namespace keen
 	constexpr uint32 GraphicsLimits_MaxColorTargetCount = 7u;
 
 	constexpr uint32 GraphicsLimits_MaxDescriptorSetSlotCount = 4u;
-	constexpr uint32 GraphicsLimits_MaxPushConstantBufferSize = 16u;
+	constexpr uint32 GraphicsLimits_MaxPushConstantBufferSize = 256u;		// GraphicsDeviceInfo::maxPushConstantsSize is the real limit (at least 128 bytes)
+	constexpr uint32 GraphicsLimits_MaxPushConstantRangeCount = 4u;
 
 	constexpr uint64 GraphicsLimits_MaxDeviceMemorySizeInBytes = 1_gib;
 	constexpr uint64 GraphicsLimits_MaxUniformBufferOffsetAlignment = 256u;		// worst case uniform buffer offset alignment
 	constexpr uint64 GraphicsLimits_MaxStorageBufferOffsetAlignment = 256u;		// worst case storage buffer offset alignment
 
 	constexpr uint32 GraphicsLimits_MaxVertexFormatCount	= 128u;
+	constexpr uint32 GraphicsLimits_MaxVertexStreamCount	= 4u;		// vertex buffer bindings per render pipeline
+
+	constexpr uint32 GraphicsLimits_MaxIndirectCommandTokenCount = 8u;
 
 	constexpr uint32 GraphicsLimits_MaxRenderTargetPixelFormatCount = 2u;	// how many pixel format views per render target?
 
@@ -190,9 +196,11 @@ namespace keen
 
 	constexpr uint32 Graphics_ReservedBindlessTextureCount = 8u;
 	constexpr uint32 Graphics_ReservedBindlessSamplerCount = 1u;
+	constexpr uint32 Graphics_ReservedBindlessStorageBufferCount = 1u;
 
 	constexpr uint32 GraphicsLimits_MaxBindlessTextureCount = 16384u;
 	constexpr uint32 GraphicsLimits_MaxBindlessSamplerCount = 128u;
+	constexpr uint32 GraphicsLimits_MaxBindlessStorageBufferCount = 16384u;
 
 	struct GraphicsElementRange
 	{
@@ -400,6 +408,14 @@ namespace keen
 		DepthResolveModeMinMax,
 		DepthResolveModeAverage,
 		ShaderFloat16,
+		BufferDeviceAddress,	// storage buffers have a valid device address (see the bindless buffer address table)
+		ShaderObject,			// render pipelines are created without a pipeline compile (all fixed function state is set at record time)
+		RenderingLocalRead,		// attachments can be read as input attachments inside the rendering scope that writes them
+		PreciseOcclusionQuery,	// occlusion queries can return the exact number of passed samples (otherwise only zero/non-zero is reliable)
+		ConditionalRendering,	// draws and dispatches can be skipped based on a predicate value in a buffer
+		HostImageCopy,			// textures with GraphicsTextureFlag::HostTransfer can be written from the cpu without staging memory
+		HostMemoryImport,		// page aligned host memory (i.e. memory mapped files) can be used as copy source without staging memory
+		ExternalMemoryExport,	// textures with GraphicsTextureFlag::Exportable and timeline semaphores can be shared with other processes (linux only)
 	};
 
 	using GraphicsFeatureFlags = Bitmask32<GraphicsFeature>;
@@ -439,6 +455,7 @@ namespace keen
 		Render_DepthTarget,
 		Render_StencilTarget,			// :JK: rename to StencilAttachment
 		Render_ShaderStorage,		
+		Render_ShadingRateSource,		// used as fragment shading rate attachment (see GraphicsShadingRateAttachmentInfo)
 	};
 	using GraphicsTextureUsageMask = Bitmask8<GraphicsTextureUsageFlag>;
 	constexpr GraphicsTextureUsageMask GraphicsTextureUsageFlagMask_Render_DepthStencilTarget = { GraphicsTextureUsageFlag::Render_DepthTarget, GraphicsTextureUsageFlag::Render_StencilTarget };
@@ -446,6 +463,9 @@ namespace keen
 	enum class GraphicsTextureFlag : uint8
 	{
 		PreferHostMemory,
+		LocalReadAttachment,			// render target that is read as an input attachment inside its own rendering scope (needs GraphicsFeature::RenderingLocalRead)
+		HostTransfer,					// the texture can be written with GraphicsDevice::copyMemoryToTexture (ignored without GraphicsFeature::HostImageCopy)
+		Exportable,						// the texture memory can be exported with GraphicsDevice::exportTextureMemory (needs GraphicsFeature::ExternalMemoryExport)
 	};
 	using GraphicsTextureFlagMask = Bitmask8<GraphicsTextureFlag>;
 
@@ -461,6 +481,8 @@ namespace keen
 		ShaderReadOnlyOptimal,
 		TransferSourceOptimal,
 		TransferTargetOptimal,
+		ShadingRateAttachmentOptimal,
+		RenderingLocalRead,				// attachment that is written and read as an input attachment in the same rendering scope
 #if KEEN_USING( KEEN_GRAPHICS_VALIDATION )
 		InvalidatedByAlias,
 #endif
@@ -522,6 +544,7 @@ namespace keen
 		IndexBuffer,
 		VertexBuffer,
 		ArgumentBuffer,		// indirect draw parameters
+		ConditionalRenderingPredicate,	// predicate of GraphicsCommandId_BeginConditionalRendering (needs GraphicsFeature::ConditionalRendering)
 
 #if KEEN_USING( KEEN_GRAPHICS_RAY_TRACING )
 		RayTraceScratchBuffer,
@@ -607,6 +630,24 @@ namespace keen
 		Optional<GraphicsComparisonFunction>	preferredComparisonFunction = {};
 	};
 
+	// everything another process needs to import the memory of an exportable texture - the image has to be created with the same parameters there:
+	struct GraphicsExportedTextureMemory
+	{
+		sint32					fileDescriptor = -1;		// opaque fd - owned by the caller (close it or pass it to the consumer process)
+		uint64					allocationSize = 0u;
+		uint64					memoryOffset = 0u;			// offset of the image in the memory
+		uint32					memoryTypeIndex = 0u;
+		bool					isDedicatedAllocation = false;
+		uint8					deviceUuid[ 16u ] = {};		// the consumer has to use the same device and driver
+		uint8					driverUuid[ 16u ] = {};
+	};
+
+	// signaled by the gpu with increasing values - created with GraphicsDevice::createExportableTimelineSemaphore:
+	struct GraphicsTimelineSemaphore
+	{
+		DebugName				debugName;
+	};
+
 	struct GraphicsBufferRange
 	{
 		const GraphicsBuffer*	pBuffer;
@@ -623,8 +664,8 @@ namespace keen
 	{
 		const GraphicsBuffer*	pBuffer;
 		uint64					offset;
-		uint64					stride;
-		uint64					size;
+		uint64					stride;		// 0 keeps the stride of the vertex format - only used by pipelines with useDynamicVertexStrides
+		uint64					size;		// 0 binds the rest of the buffer - needs GraphicsDeviceInfo::isExtendedDynamicStateSupported (the whole buffer is bound otherwise)
 	};
 
 	enum class GraphicsTextureAspectFlag : uint8
@@ -790,6 +831,10 @@ namespace keen
 #if KEEN_USING( KEEN_GRAPHICS_RAY_TRACING )
 		RayTraceScene,
 #endif
+		UniformBufferDynamic,	// UniformBuffer with an additional offset given when the set is bound
+		StorageBufferDynamic,	// (RW)ByteAddressBuffer/(RW)StructuredBuffer with an additional offset given when the set is bound
+		InlineUniformBlock,		// ConstantBuffer stored in the descriptor set itself - arraySizeOrBufferStride is the size in bytes
+		InputAttachment,		// SubpassInput - an attachment of the current rendering scope (GraphicsDescriptorData_Image)
 	};
 
 	enum class GraphicsDescriptorSetLayoutBindingFlag : uint8
@@ -851,6 +896,13 @@ namespace keen
 		uint32									targetOffset;
 	};
 
+	struct GraphicsDescriptorData_InlineUniformBlock
+	{
+		const void*					pData;
+		uint32						size;		// multiple of 4
+		uint32						offset;		// byte offset in the block - multiple of 4
+	};
+
 #if KEEN_USING( KEEN_GRAPHICS_RAY_TRACING )
 	struct GraphicsDescriptorData_RayTraceScene
 	{
@@ -868,6 +920,7 @@ namespace keen
 			GraphicsDescriptorData_ImageArray		imageArray;
 			GraphicsDescriptorData_Sampler			sampler;
 			GraphicsDescriptorData_SamplerArray		samplerArray;
+			GraphicsDescriptorData_InlineUniformBlock	inlineUniformBlock;
 #if KEEN_USING( KEEN_GRAPHICS_RAY_TRACING )
 			GraphicsDescriptorData_RayTraceScene	scene;
 #endif
@@ -898,13 +951,64 @@ namespace keen
 		GraphicsStoreAction				storeAction = GraphicsStoreAction::Store;
 	};
 
+	// fragment size of a coarse shaded pixel
+	enum class GraphicsShadingRate : uint8
+	{
+		Rate1x1,
+		Rate1x2,
+		Rate2x1,
+		Rate2x2,
+		Rate2x4,
+		Rate4x2,
+		Rate4x4,
+	};
+
+	// how two shading rates are combined: the first combiner merges the pipeline/draw rate with the per primitive rate, the second one merges that result with the attachment rate
+	enum class GraphicsShadingRateCombiner : uint8
+	{
+		Keep,		// keep the first rate
+		Replace,	// replace with the second rate
+		Min,
+		Max,
+		Mul,
+	};
+
+	struct GraphicsShadingRateAttachmentInfo
+	{
+		const GraphicsTexture*			pTexture = nullptr;		// needs GraphicsTextureUsageFlag::Render_ShadingRateSource, nullptr disables the attachment
+		GraphicsTextureLayout			textureLayout = GraphicsTextureLayout::ShadingRateAttachmentOptimal;
+		uint2							texelSize = { 16u, 16u };	// in pixels, has to be inside GraphicsDeviceInfo::min/maxShadingRateTexelSize
+	};
+
+	constexpr uint8 GraphicsInputAttachmentIndex_None = 0xffu;
+
+	// maps the attachments of a rendering scope to the InputAttachmentIndex of the shaders that read them (needs GraphicsFeature::RenderingLocalRead).
+	// the render pipelines used inside the scope have to be created with the same mapping
+	struct GraphicsRenderingInputAttachmentIndices
+	{
+		bool8								isEnabled = { false };
+		uint8								colorInputIndices[ GraphicsLimits_MaxColorTargetCount ] = { 0u, 1u, 2u, 3u, 4u, 5u, 6u };	// GraphicsInputAttachmentIndex_None if the color attachment is not read
+		uint8								depthInputIndex = GraphicsInputAttachmentIndex_None;		// GraphicsInputAttachmentIndex_None: read without an InputAttachmentIndex decoration
+		uint8								stencilInputIndex = GraphicsInputAttachmentIndex_None;
+	};
+
 	struct GraphicsBeginRenderingParameters
 	{
-		DebugName						debugName = {};
-		GraphicsRenderingAttachmentInfo	colorAttachments[ GraphicsLimits_MaxColorTargetCount ];
-		uint32							colorAttachmentCount = 0u;
-		GraphicsRenderingAttachmentInfo	depthAttachment;
-		GraphicsRenderingAttachmentInfo	stencilAttachment;
+		DebugName							debugName = {};
+		GraphicsRenderingAttachmentInfo		colorAttachments[ GraphicsLimits_MaxColorTargetCount ];
+		uint32								colorAttachmentCount = 0u;
+		GraphicsRenderingAttachmentInfo		depthAttachment;
+		GraphicsRenderingAttachmentInfo		stencilAttachment;
+		GraphicsShadingRateAttachmentInfo	shadingRateAttachment;
+		GraphicsRenderingInputAttachmentIndices	inputAttachmentIndices;		// attachments that are read with GraphicsCommandId_RenderingLocalReadBarrier in between
+
+		// only the render area is loaded/stored - width or height 0 means the full render size
+		GraphicsRectangle					renderArea = {};
+
+		// layered rendering: the attachments are array textures and the shaders select the layer (SV_RenderTargetArrayIndex)
+		uint32								layerCount = 1u;
+		// multiview: every draw is broadcast to the layers set in the mask (SV_ViewID) - layerCount is ignored if this is not 0
+		uint32								viewMask = 0u;
 	};
 
 	enum class GraphicsBlendOperation : uint8
@@ -1010,6 +1114,12 @@ namespace keen
 		TimeStamp_PipelineBottom
 	};
 
+	enum class GraphicsQueryPoolType : uint8
+	{
+		Timestamp,			// written with GraphicsCommandId_WriteTimestampQuery
+		Occlusion,			// number of samples that passed the depth/stencil tests between GraphicsCommandId_BeginQuery and GraphicsCommandId_EndQuery
+	};
+
 	// :JK: don't change the order of these - it's referenced in the gpc compiler output
 	struct GraphicsSamplerParameters
 	{
@@ -1027,12 +1137,21 @@ namespace keen
 		GraphicsSamplerReductionMode    reductionMode = GraphicsSamplerReductionMode::Disabled;
 	};
 
+	struct GraphicsPushConstantRange
+	{
+		GraphicsPipelineStageMask			stageMask = {};
+		uint16								offset = 0u;			// multiple of 4
+		uint16								size = 0u;				// multiple of 4
+	};
+
 	struct GraphicsPipelineLayoutParameters
 	{
 		const GraphicsDescriptorSetLayout*	descriptorSetLayouts[ GraphicsLimits_MaxDescriptorSetSlotCount ] = {};
 		uint32								descriptorSetLayoutCount = 0u;
-		GraphicsPipelineStageMask			pushConstantsStageMask = {};
+		GraphicsPipelineStageMask			pushConstantsStageMask = {};	// shortcut for a single range at offset 0 (in addition to pushConstantRanges)
 		uint16								pushConstantsSize = 0u;
+		GraphicsPushConstantRange			pushConstantRanges[ GraphicsLimits_MaxPushConstantRangeCount ] = {};	// a stage may only be part of one range
+		uint32								pushConstantRangeCount = 0u;
 		bool								useBindlessDescriptors = false;
 		DebugName							debugName = {};
 	};
@@ -1044,6 +1163,7 @@ namespace keen
 		StencilReference,
 		StencilWriteMask,
 		StencilCompareMask,
+		ShadingRate,
 	};
 
 	struct GraphicsStencilParameters
@@ -1077,6 +1197,19 @@ namespace keen
 		size_t		size = 0u;
 	};
 
+	enum class GraphicsVertexInputRate : uint8
+	{
+		Vertex,
+		Instance,
+	};
+
+	// an additional vertex buffer binding of a render pipeline - the attributes of all streams have to be disjoint:
+	struct GraphicsVertexStream
+	{
+		const VertexFormat*					pFormat = nullptr;
+		GraphicsVertexInputRate				inputRate = GraphicsVertexInputRate::Vertex;
+	};
+
 	struct GraphicsRenderPipelineParameters
 	{
 		inline void setRasterizerState( GraphicsCullMode inCullMode, GraphicsFillMode inFillMode, GraphicsWindingOrder inWindingOrder )
@@ -1127,9 +1260,16 @@ namespace keen
 		ConstMemoryBlock					tcShaderCode = InvalidConstMemoryBlock;
 		ConstMemoryBlock					teShaderCode = InvalidConstMemoryBlock;
 		ConstMemoryBlock					fragmentShaderCode = InvalidConstMemoryBlock;
+
+		// mesh pipelines: if meshShaderCode is valid the vertex/tessellation stages (and the vertex format) are ignored
+		ConstMemoryBlock					taskShaderCode = InvalidConstMemoryBlock;
+		ConstMemoryBlock					meshShaderCode = InvalidConstMemoryBlock;
 		
 		const GraphicsPipelineLayout*		pPipelineLayout = nullptr;
-		const VertexFormat*					pVertexFormat = nullptr;
+		const VertexFormat*					pVertexFormat = nullptr;		// vertex stream 0 (per vertex)
+		GraphicsVertexStream				additionalVertexStreams[ GraphicsLimits_MaxVertexStreamCount - 1u ];	// vertex streams 1..n
+		uint8								additionalVertexStreamCount = 0u;
+		bool8								useDynamicVertexStrides = { false };		// the strides are set by GraphicsCommandId_BindVertexBuffers (needs GraphicsDeviceInfo::isExtendedDynamicStateSupported)
 
 		GraphicsRenderTargetFormat			renderTargetFormat;
 		GraphicsStencilParameters			frontStencil;
@@ -1158,12 +1298,25 @@ namespace keen
 		GraphicsComparisonFunction			depthComparisonFunction = GraphicsComparisonFunction::Always;
 		bool8								depthWriteEnabled = { false };
 		bool8								enableScissorTest = { false };
+
+		// variable rate shading (ignored if the device doesn't support it):
+		GraphicsShadingRate					shadingRate = GraphicsShadingRate::Rate1x1;
+		GraphicsShadingRateCombiner			shadingRateCombiners[ 2u ] = { GraphicsShadingRateCombiner::Keep, GraphicsShadingRateCombiner::Keep };	// anything but Keep needs isPrimitiveShadingRateSupported/isAttachmentShadingRateSupported
+		bool8								useShadingRateAttachment = { false };		// set if the pipeline is used inside a rendering scope with a shading rate attachment
+
+		bool8								isIndirectBindable = { false };				// can be selected by a GraphicsIndirectCommandTokenType::Pipeline token (needs GraphicsDeviceInfo::isDeviceGeneratedCommandsSupported)
+
+		GraphicsRenderingInputAttachmentIndices	inputAttachmentIndices;					// has to match the rendering scope the pipeline is used in
+		uint32								viewMask = 0u;								// multiview - has to match the rendering scope the pipeline is used in (needs GraphicsDeviceInfo::maxMultiviewViewCount)
+
 		GraphicsPipelineEntryPointId		entryPointId = { GraphicsPipelineEntryPointId::Stage_Main };
 
 		GraphicsShaderEntryPointName		vsEntryPoint;
 		GraphicsShaderEntryPointName		tcEntryPoint;
 		GraphicsShaderEntryPointName		teEntryPoint;
 		GraphicsShaderEntryPointName		fsEntryPoint;
+		GraphicsShaderEntryPointName		tsEntryPoint;
+		GraphicsShaderEntryPointName		msEntryPoint;
 
 		DebugName							debugName = {};
 	};
@@ -1182,6 +1335,36 @@ namespace keen
 		DebugName							debugName = EmptyDebugName;
 	};
 
+	// device generated commands: each sequence in the argument buffer contains the data of all tokens (in token order)
+	enum class GraphicsIndirectCommandTokenType : uint8
+	{
+		Pipeline,			// uint32 index into GraphicsIndirectCommandsLayoutParameters::pipelines, has to be the first token
+		PushConstants,		// pushConstantsSize bytes
+		VertexBuffer,		// uint64 device address, uint32 size, uint32 stride
+		IndexBuffer,		// uint64 device address, uint32 size, uint32 index type (VkIndexType)
+		Draw,				// GraphicsDrawIndirectParameter - action tokens have to be the last token
+		DrawIndexed,		// GraphicsDrawIndexedIndirectParameter
+		DrawMeshTasks,		// uint32 groupCountX/Y/Z
+	};
+
+	struct GraphicsIndirectCommandToken
+	{
+		GraphicsIndirectCommandTokenType	type = GraphicsIndirectCommandTokenType::Draw;
+		uint16								pushConstantsOffset = 0u;		// PushConstants only
+		uint16								pushConstantsSize = 0u;			// PushConstants only
+		uint8								vertexBufferSlot = 0u;			// VertexBuffer only
+	};
+
+	struct GraphicsIndirectCommandsLayoutParameters
+	{
+		ArrayView<const GraphicsIndirectCommandToken>	tokens;
+		const GraphicsPipelineLayout*					pPipelineLayout = nullptr;
+		GraphicsPipelineStageMask						stageMask = {};			// stages used by the generated commands - derived from the action token if empty
+		ArrayView<const GraphicsRenderPipeline* const>	pipelines;				// selectable by the Pipeline token (all need isIndirectBindable) - exactly one pipeline without a Pipeline token
+		uint32											maxSequenceCount = 0u;
+		DebugName										debugName = {};
+	};
+
 	// high level, typed similar to ArrayView<T>
 	template<typename T>
 	class GraphicsBufferView
@@ -1247,6 +1430,8 @@ namespace keen
 		GraphicsCompiledPipelineStageInfo	tessellationControl;
 		GraphicsCompiledPipelineStageInfo	tessellationEvaluation;
 		GraphicsCompiledPipelineStageInfo	fragment;
+		GraphicsCompiledPipelineStageInfo	task;
+		GraphicsCompiledPipelineStageInfo	mesh;
 	};
 
 	struct GraphicsCompiledComputePipelineInfo : GraphicsCompiledPipelineStageInfo
@@ -1432,6 +1617,13 @@ namespace keen
 		GraphicsTextureRegion		textureRegion;		
 	};
 
+	struct GraphicsHostTextureCopyRegion
+	{
+		const void*					pData = nullptr;		// tightly packed rows
+		size_t						dataSize = 0u;
+		GraphicsTextureRegion		textureRegion;
+	};
+
 	struct GraphicsCopyTextureParameters
 	{
 		const GraphicsTexture*	pTarget = nullptr;
@@ -1444,6 +1636,7 @@ namespace keen
 	{
 		GeometryShader,
 		TessellationShaders,
+		MeshShaders,
 #if KEEN_USING( KEEN_GRAPHICS_RAY_TRACING )
 		RaytracingShaders,
 #endif
@@ -1536,6 +1729,21 @@ namespace keen
 
 		bool							isMemoryPrioritySupported = false;
 
+		bool							isPipelineShadingRateSupported = false;		// per pipeline/draw shading rate
+		bool							isPrimitiveShadingRateSupported = false;	// per primitive shading rate written by the last pre rasterization stage
+		bool							isAttachmentShadingRateSupported = false;	// shading rate attachment in GraphicsBeginRenderingParameters
+		uint2							minShadingRateTexelSize = {};
+		uint2							maxShadingRateTexelSize = {};
+
+		bool							isDeviceGeneratedCommandsSupported = false;
+		uint32							maxIndirectPipelineCount = 0u;
+		uint32							maxIndirectSequenceCount = 0u;
+
+		// render state that can be overridden at record time (GraphicsCommandId_SetCullMode, _SetDepthState, _SetStencilState, _SetPrimitiveType):
+		bool							isExtendedDynamicStateSupported = false;
+		bool							isExtendedDynamicState2Supported = false;	// _SetDepthBias
+		bool							isExtendedDynamicState3Supported = false;	// _SetFillMode, _SetBlendState
+
 		bool							isFsr3Supported		= false;
 		bool							isDlssSupported		= false;
 #if KEEN_USING( KEEN_NVREFLEX_SUPPORT )
@@ -1547,6 +1755,9 @@ namespace keen
 		uint32							maxTextureDimension3d = 0u;
 		uint32							maxTextureDimensionCube = 0u;
 		uint32							maxFramebufferDimension = 0u;
+		uint32							maxFramebufferLayerCount = 0u;		// GraphicsBeginRenderingParameters::layerCount
+		uint32							maxMultiviewViewCount = 0u;			// 0 if multiview is not supported
+		bool							isVertexShaderLayerOutputSupported = false;	// layered rendering without a geometry shader
 		uint3							maxDispatchGroupCount = {};
 
 		uint64							minUniformBufferOffsetAlignment	= 0u;
@@ -1557,6 +1768,11 @@ namespace keen
 		uint64							minBufferTextureCopyBufferOffsetAlignment = 0u;
 
 		uint32							subgroupSize = 0u;
+		uint32							maxPushConstantsSize = 0u;		// <= GraphicsLimits_MaxPushConstantBufferSize
+		uint32							maxDynamicUniformBufferCount = 0u;	// per pipeline layout
+		uint32							maxDynamicStorageBufferCount = 0u;	// per pipeline layout
+		uint32							maxInlineUniformBlockSize = 0u;		// 0 if inline uniform blocks are not supported
+		uint64							minHostMemoryImportAlignment = 0u;	// address and size of GraphicsDevice::importHostMemoryBuffer ranges (0 if GraphicsFeature::HostMemoryImport is not supported)
 
 		bool							areBreadcrumbsEnabled = false;
 	};
@@ -1661,6 +1877,7 @@ namespace keen
 	struct GraphicsQueryPoolParameters
 	{
 		DebugName					debugName;
+		GraphicsQueryPoolType		type = GraphicsQueryPoolType::Timestamp;
 		uint32						queryCount = 0u;
 	};
 
@@ -1670,6 +1887,10 @@ namespace keen
 		PixelFormat					colorFormat;
 		uint32						presentationInterval;
 
+		// the part of the current back buffer that is older than the previously presented image (the accumulated damage of the
+		// frames since this image was presented the last time) - has to be redrawn in addition to the damage region of this frame
+		GraphicsRectangle			redrawArea;
+
 #if KEEN_USING( KEEN_OS_WINDOW_SUPPORT )
 		OsWindowHandle				windowHandle;
 #endif
@@ -1680,6 +1901,7 @@ namespace keen
 	{
 		// Read access
 		IndirectBuffer,										// Read as an indirect buffer for drawing or dispatch
+		ConditionalRenderingPredicate,						// Read as the predicate of a conditional rendering scope
 		IndexBuffer,										// Read as an index buffer for drawing
 		VertexBuffer,										// Read as a vertex buffer for drawing
 		VS_Read_UniformBuffer,								// Read as a uniform buffer in a vertex shader
@@ -1692,6 +1914,7 @@ namespace keen
 		FS_Read_Other,										// Read as any other resource in a fragment shader
 		ColorAttachment_Read,								// Read by standard blending/logic operations or subpass load operations
 		DepthStencilAttachment_Read,						// Read by depth/stencil tests or subpass load operations
+		ShadingRateAttachment_Read,							// Read as a fragment shading rate attachment during rendering
 		CS_Read_UniformBuffer,								// Read as a uniform buffer in a compute shader
 		CS_Read_SampledImage,								// Read as a sampled image/uniform texel buffer in a compute shader
 		CS_Read_Other,										// Read as any other resource in a compute shader
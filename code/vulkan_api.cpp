@@ -304,7 +304,9 @@ namespace keen
         pVulkan->vkGetPhysicalDeviceFeatures2                   = (PFN_vkGetPhysicalDeviceFeatures2)(void*)getVulkanInstanceProcAddress( &error, pVulkan, instance, "vkGetPhysicalDeviceFeatures2" );
         pVulkan->vkDestroyInstance                              = (PFN_vkDestroyInstance)(void*)getVulkanInstanceProcAddress( &error, pVulkan, instance, "vkDestroyInstance" );
         pVulkan->vkGetPhysicalDeviceFormatProperties            = (PFN_vkGetPhysicalDeviceFormatProperties)(void*)getVulkanInstanceProcAddress( &error, pVulkan, instance, "vkGetPhysicalDeviceFormatProperties" );
+        pVulkan->vkGetPhysicalDeviceFormatProperties2           = (PFN_vkGetPhysicalDeviceFormatProperties2)(void*)getVulkanInstanceProcAddress( &error, pVulkan, instance, "vkGetPhysicalDeviceFormatProperties2" );
         pVulkan->vkGetPhysicalDeviceImageFormatProperties       = (PFN_vkGetPhysicalDeviceImageFormatProperties)(void*)getVulkanInstanceProcAddress( &error, pVulkan, instance, "vkGetPhysicalDeviceImageFormatProperties" );
+        pVulkan->vkGetPhysicalDeviceImageFormatProperties2      = (PFN_vkGetPhysicalDeviceImageFormatProperties2)(void*)getVulkanInstanceProcAddress( &error, pVulkan, instance, "vkGetPhysicalDeviceImageFormatProperties2" );
         pVulkan->vkGetPhysicalDeviceProperties                  = (PFN_vkGetPhysicalDeviceProperties)(void*)getVulkanInstanceProcAddress( &error, pVulkan, instance, "vkGetPhysicalDeviceProperties" );
         pVulkan->vkGetPhysicalDeviceProperties2                 = (PFN_vkGetPhysicalDeviceProperties2)(void*)getVulkanInstanceProcAddress( &error, pVulkan, instance, "vkGetPhysicalDeviceProperties2" );
         pVulkan->vkGetPhysicalDeviceQueueFamilyProperties       = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)(void*)getVulkanInstanceProcAddress( &error, pVulkan, instance, "vkGetPhysicalDeviceQueueFamilyProperties" );
@@ -574,6 +576,10 @@ namespace keen
         }
 #endif
 
+#if defined( VK_KHR_incremental_present )
+        pVulkan->KHR_incremental_present = isExtensionActive( activeExtensions, VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME );
+#endif
+
 #if defined( VK_KHR_dynamic_rendering )
         pVulkan->KHR_dynamic_rendering  = isExtensionActive( activeExtensions, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME );
         pVulkan->vkCmdBeginRenderingKHR = (PFN_vkCmdBeginRenderingKHR)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdBeginRenderingKHR" );
@@ -585,6 +591,8 @@ namespace keen
         pVulkan->EXT_memory_budget = isExtensionActive( activeExtensions, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME );
 #endif
 
+        pVulkan->EXT_inline_uniform_block = isExtensionActive( activeExtensions, VK_EXT_INLINE_UNIFORM_BLOCK_EXTENSION_NAME );
+
 #if defined( VK_NV_device_diagnostic_checkpoints )
         pVulkan->NV_device_diagnostic_checkpoints = isExtensionActive( activeExtensions, VK_NV_DEVICE_DIAGNOSTIC_CHECKPOINTS_EXTENSION_NAME );
         if( pVulkan->NV_device_diagnostic_checkpoints )
@@ -628,6 +636,167 @@ namespace keen
         }
 #endif
 
+#if defined( VK_EXT_mesh_shader )
+        pVulkan->EXT_mesh_shader = isExtensionActive( activeExtensions, VK_EXT_MESH_SHADER_EXTENSION_NAME );
+        if( pVulkan->EXT_mesh_shader )
+        {
+            pVulkan->vkCmdDrawMeshTasksEXT              = (PFN_vkCmdDrawMeshTasksEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdDrawMeshTasksEXT" );
+            pVulkan->vkCmdDrawMeshTasksIndirectEXT      = (PFN_vkCmdDrawMeshTasksIndirectEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdDrawMeshTasksIndirectEXT" );
+            pVulkan->vkCmdDrawMeshTasksIndirectCountEXT = (PFN_vkCmdDrawMeshTasksIndirectCountEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdDrawMeshTasksIndirectCountEXT" );
+        }
+#endif
+
+#if defined( VK_KHR_fragment_shading_rate )
+        pVulkan->KHR_fragment_shading_rate = isExtensionActive( activeExtensions, VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME );
+        if( pVulkan->KHR_fragment_shading_rate )
+        {
+            pVulkan->vkCmdSetFragmentShadingRateKHR = (PFN_vkCmdSetFragmentShadingRateKHR)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetFragmentShadingRateKHR" );
+        }
+#endif
+
+#if defined( VK_EXT_device_generated_commands )
+        pVulkan->EXT_device_generated_commands = isExtensionActive( activeExtensions, VK_EXT_DEVICE_GENERATED_COMMANDS_EXTENSION_NAME );
+        if( pVulkan->EXT_device_generated_commands )
+        {
+            pVulkan->vkCreateIndirectCommandsLayoutEXT              = (PFN_vkCreateIndirectCommandsLayoutEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCreateIndirectCommandsLayoutEXT" );
+            pVulkan->vkDestroyIndirectCommandsLayoutEXT             = (PFN_vkDestroyIndirectCommandsLayoutEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkDestroyIndirectCommandsLayoutEXT" );
+            pVulkan->vkCreateIndirectExecutionSetEXT                = (PFN_vkCreateIndirectExecutionSetEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCreateIndirectExecutionSetEXT" );
+            pVulkan->vkDestroyIndirectExecutionSetEXT               = (PFN_vkDestroyIndirectExecutionSetEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkDestroyIndirectExecutionSetEXT" );
+            pVulkan->vkUpdateIndirectExecutionSetPipelineEXT        = (PFN_vkUpdateIndirectExecutionSetPipelineEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkUpdateIndirectExecutionSetPipelineEXT" );
+            pVulkan->vkGetGeneratedCommandsMemoryRequirementsEXT    = (PFN_vkGetGeneratedCommandsMemoryRequirementsEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkGetGeneratedCommandsMemoryRequirementsEXT" );
+            pVulkan->vkCmdExecuteGeneratedCommandsEXT               = (PFN_vkCmdExecuteGeneratedCommandsEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdExecuteGeneratedCommandsEXT" );
+        }
+#endif
+
+#if defined( VK_EXT_shader_object )
+        // the shader object extension exposes the extended dynamic state entry points on its own:
+        pVulkan->EXT_shader_object = isExtensionActive( activeExtensions, VK_EXT_SHADER_OBJECT_EXTENSION_NAME );
+#endif
+
+#if defined( VK_EXT_extended_dynamic_state )
+        pVulkan->EXT_extended_dynamic_state = isExtensionActive( activeExtensions, VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME );
+        if( pVulkan->EXT_extended_dynamic_state || pVulkan->EXT_shader_object )
+        {
+            pVulkan->vkCmdSetCullModeEXT          = (PFN_vkCmdSetCullModeEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetCullModeEXT" );
+            pVulkan->vkCmdSetFrontFaceEXT         = (PFN_vkCmdSetFrontFaceEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetFrontFaceEXT" );
+            pVulkan->vkCmdSetPrimitiveTopologyEXT = (PFN_vkCmdSetPrimitiveTopologyEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetPrimitiveTopologyEXT" );
+            pVulkan->vkCmdSetDepthTestEnableEXT   = (PFN_vkCmdSetDepthTestEnableEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetDepthTestEnableEXT" );
+            pVulkan->vkCmdSetDepthWriteEnableEXT  = (PFN_vkCmdSetDepthWriteEnableEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetDepthWriteEnableEXT" );
+            pVulkan->vkCmdSetDepthCompareOpEXT    = (PFN_vkCmdSetDepthCompareOpEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetDepthCompareOpEXT" );
+            pVulkan->vkCmdSetStencilTestEnableEXT = (PFN_vkCmdSetStencilTestEnableEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetStencilTestEnableEXT" );
+            pVulkan->vkCmdSetStencilOpEXT         = (PFN_vkCmdSetStencilOpEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetStencilOpEXT" );
+            pVulkan->vkCmdBindVertexBuffers2EXT   = (PFN_vkCmdBindVertexBuffers2EXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdBindVertexBuffers2EXT" );
+        }
+#endif
+
+#if defined( VK_EXT_extended_dynamic_state2 )
+        pVulkan->EXT_extended_dynamic_state2 = isExtensionActive( activeExtensions, VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME );
+        if( pVulkan->EXT_extended_dynamic_state2 || pVulkan->EXT_shader_object )
+        {
+            pVulkan->vkCmdSetDepthBiasEnableEXT = (PFN_vkCmdSetDepthBiasEnableEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetDepthBiasEnableEXT" );
+        }
+#endif
+
+#if defined( VK_EXT_extended_dynamic_state3 )
+        pVulkan->EXT_extended_dynamic_state3 = isExtensionActive( activeExtensions, VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME );
+        if( pVulkan->EXT_extended_dynamic_state3 || pVulkan->EXT_shader_object )
+        {
+            pVulkan->vkCmdSetPolygonModeEXT           = (PFN_vkCmdSetPolygonModeEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetPolygonModeEXT" );
+            pVulkan->vkCmdSetColorBlendEnableEXT      = (PFN_vkCmdSetColorBlendEnableEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetColorBlendEnableEXT" );
+            pVulkan->vkCmdSetColorBlendEquationEXT    = (PFN_vkCmdSetColorBlendEquationEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetColorBlendEquationEXT" );
+            pVulkan->vkCmdSetColorWriteMaskEXT        = (PFN_vkCmdSetColorWriteMaskEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetColorWriteMaskEXT" );
+            pVulkan->vkCmdSetAlphaToCoverageEnableEXT = (PFN_vkCmdSetAlphaToCoverageEnableEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetAlphaToCoverageEnableEXT" );
+        }
+#endif
+
+#if defined( VK_EXT_vertex_input_dynamic_state )
+        pVulkan->EXT_vertex_input_dynamic_state = isExtensionActive( activeExtensions, VK_EXT_VERTEX_INPUT_DYNAMIC_STATE_EXTENSION_NAME );
+        if( pVulkan->EXT_vertex_input_dynamic_state || pVulkan->EXT_shader_object )
+        {
+            pVulkan->vkCmdSetVertexInputEXT = (PFN_vkCmdSetVertexInputEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetVertexInputEXT" );
+        }
+#endif
+
+#if defined( VK_EXT_shader_object )
+        if( pVulkan->EXT_shader_object )
+        {
+            pVulkan->vkCreateShadersEXT                 = (PFN_vkCreateShadersEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCreateShadersEXT" );
+            pVulkan->vkDestroyShaderEXT                 = (PFN_vkDestroyShaderEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkDestroyShaderEXT" );
+            pVulkan->vkCmdBindShadersEXT                = (PFN_vkCmdBindShadersEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdBindShadersEXT" );
+            pVulkan->vkCmdSetViewportWithCountEXT       = (PFN_vkCmdSetViewportWithCountEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetViewportWithCountEXT" );
+            pVulkan->vkCmdSetScissorWithCountEXT        = (PFN_vkCmdSetScissorWithCountEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetScissorWithCountEXT" );
+            pVulkan->vkCmdSetRasterizerDiscardEnableEXT = (PFN_vkCmdSetRasterizerDiscardEnableEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetRasterizerDiscardEnableEXT" );
+            pVulkan->vkCmdSetPrimitiveRestartEnableEXT  = (PFN_vkCmdSetPrimitiveRestartEnableEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetPrimitiveRestartEnableEXT" );
+            pVulkan->vkCmdSetDepthBoundsTestEnableEXT   = (PFN_vkCmdSetDepthBoundsTestEnableEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetDepthBoundsTestEnableEXT" );
+            pVulkan->vkCmdSetDepthClampEnableEXT        = (PFN_vkCmdSetDepthClampEnableEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetDepthClampEnableEXT" );
+            pVulkan->vkCmdSetRasterizationSamplesEXT    = (PFN_vkCmdSetRasterizationSamplesEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetRasterizationSamplesEXT" );
+            pVulkan->vkCmdSetSampleMaskEXT              = (PFN_vkCmdSetSampleMaskEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetSampleMaskEXT" );
+            pVulkan->vkCmdSetPatchControlPointsEXT      = (PFN_vkCmdSetPatchControlPointsEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetPatchControlPointsEXT" );
+        }
+#endif
+
+#if defined( VK_KHR_dynamic_rendering_local_read )
+        pVulkan->KHR_dynamic_rendering_local_read = isExtensionActive( activeExtensions, VK_KHR_DYNAMIC_RENDERING_LOCAL_READ_EXTENSION_NAME );
+        if( pVulkan->KHR_dynamic_rendering_local_read )
+        {
+            pVulkan->vkCmdSetRenderingInputAttachmentIndicesKHR = (PFN_vkCmdSetRenderingInputAttachmentIndicesKHR)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdSetRenderingInputAttachmentIndicesKHR" );
+        }
+#endif
+
+#if defined( VK_EXT_host_image_copy )
+        pVulkan->EXT_host_image_copy = isExtensionActive( activeExtensions, VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME );
+        if( pVulkan->EXT_host_image_copy )
+        {
+            pVulkan->vkCopyMemoryToImageEXT = (PFN_vkCopyMemoryToImageEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCopyMemoryToImageEXT" );
+            pVulkan->vkTransitionImageLayoutEXT = (PFN_vkTransitionImageLayoutEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkTransitionImageLayoutEXT" );
+        }
+#endif
+
+#if defined( VK_EXT_conditional_rendering )
+        pVulkan->EXT_conditional_rendering = isExtensionActive( activeExtensions, VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME );
+        if( pVulkan->EXT_conditional_rendering )
+        {
+            pVulkan->vkCmdBeginConditionalRenderingEXT = (PFN_vkCmdBeginConditionalRenderingEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdBeginConditionalRenderingEXT" );
+            pVulkan->vkCmdEndConditionalRenderingEXT = (PFN_vkCmdEndConditionalRenderingEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCmdEndConditionalRenderingEXT" );
+        }
+#endif
+
+#if defined( VK_EXT_external_memory_host )
+        pVulkan->EXT_external_memory_host = isExtensionActive( activeExtensions, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME );
+        if( pVulkan->EXT_external_memory_host )
+        {
+            pVulkan->vkGetMemoryHostPointerPropertiesEXT = (PFN_vkGetMemoryHostPointerPropertiesEXT)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkGetMemoryHostPointerPropertiesEXT" );
+        }
+#endif
+
+#if defined( VK_KHR_external_memory_fd )
+        pVulkan->KHR_external_memory_fd = isExtensionActive( activeExtensions, VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME );
+        if( pVulkan->KHR_external_memory_fd )
+        {
+            pVulkan->vkGetMemoryFdKHR = (PFN_vkGetMemoryFdKHR)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkGetMemoryFdKHR" );
+        }
+#endif
+
+#if defined( VK_KHR_external_semaphore_fd )
+        pVulkan->KHR_external_semaphore_fd = isExtensionActive( activeExtensions, VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME );
+        if( pVulkan->KHR_external_semaphore_fd )
+        {
+            pVulkan->vkGetSemaphoreFdKHR = (PFN_vkGetSemaphoreFdKHR)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkGetSemaphoreFdKHR" );
+        }
+#endif
+
+#if defined( VK_KHR_pipeline_binary )
+        pVulkan->KHR_pipeline_binary = isExtensionActive( activeExtensions, VK_KHR_PIPELINE_BINARY_EXTENSION_NAME );
+        if( pVulkan->KHR_pipeline_binary )
+        {
+            pVulkan->vkCreatePipelineBinariesKHR        = (PFN_vkCreatePipelineBinariesKHR)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkCreatePipelineBinariesKHR" );
+            pVulkan->vkDestroyPipelineBinaryKHR         = (PFN_vkDestroyPipelineBinaryKHR)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkDestroyPipelineBinaryKHR" );
+            pVulkan->vkGetPipelineKeyKHR                = (PFN_vkGetPipelineKeyKHR)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkGetPipelineKeyKHR" );
+            pVulkan->vkGetPipelineBinaryDataKHR         = (PFN_vkGetPipelineBinaryDataKHR)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkGetPipelineBinaryDataKHR" );
+            pVulkan->vkReleaseCapturedPipelineDataKHR   = (PFN_vkReleaseCapturedPipelineDataKHR)(void*)getVulkanDeviceProcAddress( &error, pVulkan, device, "vkReleaseCapturedPipelineDataKHR" );
+        }
+#endif
+
         return error.getError();
     }
 
@@ -1611,6 +1780,10 @@ namespace keen
         {
             result |= VK_IMAGE_USAGE_STORAGE_BIT;
         }
+        if( usageMask.isSet( GraphicsTextureUsageFlag::Render_ShadingRateSource ) )
+        {
+            result |= VK_IMAGE_USAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR;
+        }
         return result;
     }
 
@@ -1733,6 +1906,14 @@ namespace keen
         {
             result |= VK_SHADER_STAGE_COMPUTE_BIT;
         }
+        if( mask.isSet( GraphicsPipelineStage::MS_Task ) )
+        {
+            result |= VK_SHADER_STAGE_TASK_BIT_EXT;
+        }
+        if( mask.isSet( GraphicsPipelineStage::MS_Mesh ) )
+        {
+            result |= VK_SHADER_STAGE_MESH_BIT_EXT;
+        }
         return result;
     }
 
@@ -1767,6 +1948,12 @@ namespace keen
         {
             result |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
         }
+#if defined( VK_EXT_conditional_rendering )
+        if( flags.isSet( GraphicsBufferUsageFlag::ConditionalRenderingPredicate ) )
+        {
+            result |= VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
+        }
+#endif
         return result;
     }
 
@@ -1788,6 +1975,10 @@ namespace keen
 #if KEEN_USING( KEEN_GRAPHICS_OLD_STORAGE_BUFFER_DESCRIPTORS )
         case GraphicsDescriptorType::StorageBuffer:         return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 #endif
+        case GraphicsDescriptorType::UniformBufferDynamic:  return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        case GraphicsDescriptorType::StorageBufferDynamic:  return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        case GraphicsDescriptorType::InlineUniformBlock:    return VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT;
+        case GraphicsDescriptorType::InputAttachment:       return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
         case GraphicsDescriptorType::Invalid:               break;
         }
 
@@ -1843,6 +2034,8 @@ namespace keen
         case GraphicsTextureLayout::ShaderReadOnlyOptimal:          return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
         case GraphicsTextureLayout::TransferSourceOptimal:          return VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
         case GraphicsTextureLayout::TransferTargetOptimal:          return VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        case GraphicsTextureLayout::ShadingRateAttachmentOptimal:   return VK_IMAGE_LAYOUT_FRAGMENT_SHADING_RATE_ATTACHMENT_OPTIMAL_KHR;
+        case GraphicsTextureLayout::RenderingLocalRead:             return VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ_KHR;
 #if KEEN_USING( KEEN_GRAPHICS_VALIDATION )
         case GraphicsTextureLayout::InvalidatedByAlias:             return VK_IMAGE_LAYOUT_UNDEFINED;
 #endif
@@ -1866,6 +2059,38 @@ namespace keen
         return result;
     }
 
+    VkExtent2D vulkan::getFragmentShadingRateSize( GraphicsShadingRate shadingRate )
+    {
+        switch( shadingRate )
+        {
+        case GraphicsShadingRate::Rate1x1:  return { 1u, 1u };
+        case GraphicsShadingRate::Rate1x2:  return { 1u, 2u };
+        case GraphicsShadingRate::Rate2x1:  return { 2u, 1u };
+        case GraphicsShadingRate::Rate2x2:  return { 2u, 2u };
+        case GraphicsShadingRate::Rate2x4:  return { 2u, 4u };
+        case GraphicsShadingRate::Rate4x2:  return { 4u, 2u };
+        case GraphicsShadingRate::Rate4x4:  return { 4u, 4u };
+        }
+
+        KEEN_TRACE_ERROR( "Invalid shading rate %d!\n", (uint32)shadingRate );
+        return { 1u, 1u };
+    }
+
+    VkFragmentShadingRateCombinerOpKHR vulkan::getFragmentShadingRateCombinerOp( GraphicsShadingRateCombiner combiner )
+    {
+        switch( combiner )
+        {
+        case GraphicsShadingRateCombiner::Keep:     return VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR;
+        case GraphicsShadingRateCombiner::Replace:  return VK_FRAGMENT_SHADING_RATE_COMBINER_OP_REPLACE_KHR;
+        case GraphicsShadingRateCombiner::Min:      return VK_FRAGMENT_SHADING_RATE_COMBINER_OP_MIN_KHR;
+        case GraphicsShadingRateCombiner::Max:      return VK_FRAGMENT_SHADING_RATE_COMBINER_OP_MAX_KHR;
+        case GraphicsShadingRateCombiner::Mul:      return VK_FRAGMENT_SHADING_RATE_COMBINER_OP_MUL_KHR;
+        }
+
+        KEEN_TRACE_ERROR( "Invalid shading rate combiner %d!\n", (uint32)combiner );
+        return VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR;
+    }
+
     VkImageSubresourceRange vulkan::getImageSubresourceRange( const GraphicsTextureSubresourceRange& subresourceRange )
     {
         VkImageSubresourceRange result{};
@@ -1956,6 +2181,48 @@ namespace keen
         pVulkanBufferImageCopy->imageExtent         = vulkan::createExtent3d( region.textureRegion.size );      
     }
 
+    void vulkan::fillRenderingInputAttachmentIndexInfo( VkRenderingInputAttachmentIndexInfoKHR* pInfo, uint32* pColorIndices, uint32* pDepthIndex, uint32* pStencilIndex, const GraphicsRenderingInputAttachmentIndices& indices, uint32 colorAttachmentCount )
+    {
+        KEEN_ASSERT( colorAttachmentCount <= GraphicsLimits_MaxColorTargetCount );
+
+        for( uint32 i = 0u; i < colorAttachmentCount; ++i )
+        {
+            pColorIndices[ i ] = indices.colorInputIndices[ i ] != GraphicsInputAttachmentIndex_None ? indices.colorInputIndices[ i ] : VK_ATTACHMENT_UNUSED;
+        }
+        *pDepthIndex    = indices.depthInputIndex;
+        *pStencilIndex  = indices.stencilInputIndex;
+
+        pInfo->sType                        = VK_STRUCTURE_TYPE_RENDERING_INPUT_ATTACHMENT_INDEX_INFO_KHR;
+        pInfo->pNext                        = nullptr;
+        pInfo->colorAttachmentCount         = colorAttachmentCount;
+        pInfo->pColorAttachmentInputIndices = pColorIndices;
+        // :JK: no index means the attachment is read without an InputAttachmentIndex decoration
+        pInfo->pDepthInputAttachmentIndex   = indices.depthInputIndex != GraphicsInputAttachmentIndex_None ? pDepthIndex : nullptr;
+        pInfo->pStencilInputAttachmentIndex = indices.stencilInputIndex != GraphicsInputAttachmentIndex_None ? pStencilIndex : nullptr;
+    }
+
+    void vulkan::writeRenderingLocalReadBarrier( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, bool colorAttachments, bool depthStencilAttachment )
+    {
+        KEEN_ASSERT( colorAttachments || depthStencilAttachment );
+
+        VkPipelineStageFlags srcStageMask = 0u;
+        VkMemoryBarrier memoryBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        if( colorAttachments )
+        {
+            srcStageMask                |= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            memoryBarrier.srcAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        }
+        if( depthStencilAttachment )
+        {
+            srcStageMask                |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            memoryBarrier.srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        }
+        memoryBarrier.dstAccessMask = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT;
+
+        // only framebuffer space stages + by region is allowed inside a rendering scope - which is exactly what keeps the data on tile:
+        pVulkan->vkCmdPipelineBarrier( commandBuffer, srcStageMask, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_DEPENDENCY_BY_REGION_BIT, 1u, &memoryBarrier, 0u, nullptr, 0u, nullptr );
+    }
+
     void vulkan::writeFullPipelineBarrier( VulkanApi* pVulkan, VkCommandBuffer commandBuffer )
     {
         VkMemoryBarrier memoryBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
@@ -77,7 +77,9 @@ namespace keen
         PFN_vkEnumeratePhysicalDevices                      vkEnumeratePhysicalDevices;
         PFN_vkGetPhysicalDeviceFeatures2                    vkGetPhysicalDeviceFeatures2;
         PFN_vkGetPhysicalDeviceFormatProperties             vkGetPhysicalDeviceFormatProperties;
+        PFN_vkGetPhysicalDeviceFormatProperties2            vkGetPhysicalDeviceFormatProperties2;
         PFN_vkGetPhysicalDeviceImageFormatProperties        vkGetPhysicalDeviceImageFormatProperties;
+        PFN_vkGetPhysicalDeviceImageFormatProperties2       vkGetPhysicalDeviceImageFormatProperties2;
         PFN_vkGetPhysicalDeviceProperties                   vkGetPhysicalDeviceProperties; // for VMA
         PFN_vkGetPhysicalDeviceProperties2                  vkGetPhysicalDeviceProperties2;
         PFN_vkGetPhysicalDeviceQueueFamilyProperties        vkGetPhysicalDeviceQueueFamilyProperties;
@@ -280,6 +282,7 @@ namespace keen
         PFN_vkAcquireNextImageKHR                           vkAcquireNextImageKHR;
         PFN_vkQueuePresentKHR                               vkQueuePresentKHR;
 #endif
+        bool                                                KHR_incremental_present;
 
         bool                                                KHR_dynamic_rendering;
 #if defined( VK_KHR_dynamic_rendering )
@@ -288,6 +291,7 @@ namespace keen
 #endif
 
         bool                                                EXT_memory_budget;
+        bool                                                EXT_inline_uniform_block;
 
         bool                                                NV_device_diagnostic_checkpoints;
 #if defined( VK_NV_device_diagnostic_checkpoints )
@@ -316,6 +320,119 @@ namespace keen
 #if defined( VK_AMD_shader_info )
         PFN_vkGetShaderInfoAMD                                  vkGetShaderInfoAMD;
 #endif
+
+        bool                                                    EXT_mesh_shader;
+#if defined( VK_EXT_mesh_shader )
+        PFN_vkCmdDrawMeshTasksEXT                               vkCmdDrawMeshTasksEXT;
+        PFN_vkCmdDrawMeshTasksIndirectEXT                       vkCmdDrawMeshTasksIndirectEXT;
+        PFN_vkCmdDrawMeshTasksIndirectCountEXT                  vkCmdDrawMeshTasksIndirectCountEXT;
+#endif
+
+        bool                                                    KHR_fragment_shading_rate;
+#if defined( VK_KHR_fragment_shading_rate )
+        PFN_vkCmdSetFragmentShadingRateKHR                      vkCmdSetFragmentShadingRateKHR;
+#endif
+
+        bool                                                    EXT_device_generated_commands;
+#if defined( VK_EXT_device_generated_commands )
+        PFN_vkCreateIndirectCommandsLayoutEXT                   vkCreateIndirectCommandsLayoutEXT;
+        PFN_vkDestroyIndirectCommandsLayoutEXT                  vkDestroyIndirectCommandsLayoutEXT;
+        PFN_vkCreateIndirectExecutionSetEXT                     vkCreateIndirectExecutionSetEXT;
+        PFN_vkDestroyIndirectExecutionSetEXT                    vkDestroyIndirectExecutionSetEXT;
+        PFN_vkUpdateIndirectExecutionSetPipelineEXT             vkUpdateIndirectExecutionSetPipelineEXT;
+        PFN_vkGetGeneratedCommandsMemoryRequirementsEXT         vkGetGeneratedCommandsMemoryRequirementsEXT;
+        PFN_vkCmdExecuteGeneratedCommandsEXT                    vkCmdExecuteGeneratedCommandsEXT;
+#endif
+
+        bool                                                    EXT_extended_dynamic_state;
+#if defined( VK_EXT_extended_dynamic_state )
+        PFN_vkCmdSetCullModeEXT                                 vkCmdSetCullModeEXT;
+        PFN_vkCmdSetFrontFaceEXT                                vkCmdSetFrontFaceEXT;
+        PFN_vkCmdSetPrimitiveTopologyEXT                        vkCmdSetPrimitiveTopologyEXT;
+        PFN_vkCmdSetDepthTestEnableEXT                          vkCmdSetDepthTestEnableEXT;
+        PFN_vkCmdSetDepthWriteEnableEXT                         vkCmdSetDepthWriteEnableEXT;
+        PFN_vkCmdSetDepthCompareOpEXT                           vkCmdSetDepthCompareOpEXT;
+        PFN_vkCmdSetStencilTestEnableEXT                        vkCmdSetStencilTestEnableEXT;
+        PFN_vkCmdSetStencilOpEXT                                vkCmdSetStencilOpEXT;
+        PFN_vkCmdBindVertexBuffers2EXT                          vkCmdBindVertexBuffers2EXT;
+#endif
+
+        bool                                                    EXT_extended_dynamic_state2;
+#if defined( VK_EXT_extended_dynamic_state2 )
+        PFN_vkCmdSetDepthBiasEnableEXT                          vkCmdSetDepthBiasEnableEXT;
+#endif
+
+        bool                                                    EXT_extended_dynamic_state3;
+#if defined( VK_EXT_extended_dynamic_state3 )
+        PFN_vkCmdSetPolygonModeEXT                              vkCmdSetPolygonModeEXT;
+        PFN_vkCmdSetColorBlendEnableEXT                         vkCmdSetColorBlendEnableEXT;
+        PFN_vkCmdSetColorBlendEquationEXT                       vkCmdSetColorBlendEquationEXT;
+        PFN_vkCmdSetColorWriteMaskEXT                           vkCmdSetColorWriteMaskEXT;
+        PFN_vkCmdSetAlphaToCoverageEnableEXT                    vkCmdSetAlphaToCoverageEnableEXT;
+#endif
+
+        bool                                                    EXT_vertex_input_dynamic_state;
+#if defined( VK_EXT_vertex_input_dynamic_state )
+        PFN_vkCmdSetVertexInputEXT                              vkCmdSetVertexInputEXT;
+#endif
+
+        // :JK: VK_EXT_shader_object also provides all extended dynamic state entry points above
+        bool                                                    EXT_shader_object;
+#if defined( VK_EXT_shader_object )
+        PFN_vkCreateShadersEXT                                  vkCreateShadersEXT;
+        PFN_vkDestroyShaderEXT                                  vkDestroyShaderEXT;
+        PFN_vkCmdBindShadersEXT                                 vkCmdBindShadersEXT;
+        PFN_vkCmdSetViewportWithCountEXT                        vkCmdSetViewportWithCountEXT;
+        PFN_vkCmdSetScissorWithCountEXT                         vkCmdSetScissorWithCountEXT;
+        PFN_vkCmdSetRasterizerDiscardEnableEXT                  vkCmdSetRasterizerDiscardEnableEXT;
+        PFN_vkCmdSetPrimitiveRestartEnableEXT                   vkCmdSetPrimitiveRestartEnableEXT;
+        PFN_vkCmdSetDepthBoundsTestEnableEXT                    vkCmdSetDepthBoundsTestEnableEXT;
+        PFN_vkCmdSetDepthClampEnableEXT                         vkCmdSetDepthClampEnableEXT;
+        PFN_vkCmdSetRasterizationSamplesEXT                     vkCmdSetRasterizationSamplesEXT;
+        PFN_vkCmdSetSampleMaskEXT                               vkCmdSetSampleMaskEXT;
+        PFN_vkCmdSetPatchControlPointsEXT                       vkCmdSetPatchControlPointsEXT;
+#endif
+
+        bool                                                    KHR_dynamic_rendering_local_read;
+#if defined( VK_KHR_dynamic_rendering_local_read )
+        PFN_vkCmdSetRenderingInputAttachmentIndicesKHR          vkCmdSetRenderingInputAttachmentIndicesKHR;
+#endif
+
+        bool                                                    EXT_host_image_copy;
+#if defined( VK_EXT_host_image_copy )
+        PFN_vkCopyMemoryToImageEXT                              vkCopyMemoryToImageEXT;
+        PFN_vkTransitionImageLayoutEXT                          vkTransitionImageLayoutEXT;
+#endif
+
+        bool                                                    EXT_conditional_rendering;
+#if defined( VK_EXT_conditional_rendering )
+        PFN_vkCmdBeginConditionalRenderingEXT                   vkCmdBeginConditionalRenderingEXT;
+        PFN_vkCmdEndConditionalRenderingEXT                     vkCmdEndConditionalRenderingEXT;
+#endif
+
+        bool                                                    EXT_external_memory_host;
+#if defined( VK_EXT_external_memory_host )
+        PFN_vkGetMemoryHostPointerPropertiesEXT                 vkGetMemoryHostPointerPropertiesEXT;
+#endif
+
+        bool                                                    KHR_external_memory_fd;
+#if defined( VK_KHR_external_memory_fd )
+        PFN_vkGetMemoryFdKHR                                    vkGetMemoryFdKHR;
+#endif
+
+        bool                                                    KHR_external_semaphore_fd;
+#if defined( VK_KHR_external_semaphore_fd )
+        PFN_vkGetSemaphoreFdKHR                                 vkGetSemaphoreFdKHR;
+#endif
+
+        bool                                                    KHR_pipeline_binary;
+#if defined( VK_KHR_pipeline_binary )
+        PFN_vkCreatePipelineBinariesKHR                         vkCreatePipelineBinariesKHR;
+        PFN_vkDestroyPipelineBinaryKHR                          vkDestroyPipelineBinaryKHR;
+        PFN_vkGetPipelineKeyKHR                                 vkGetPipelineKeyKHR;
+        PFN_vkGetPipelineBinaryDataKHR                          vkGetPipelineBinaryDataKHR;
+        PFN_vkReleaseCapturedPipelineDataKHR                    vkReleaseCapturedPipelineDataKHR;
+#endif
     };
 
     using VulkanExtensionStringSet = Set<HashKey64>;
@@ -453,6 +570,9 @@ namespace keen
 
         VkStencilFaceFlags          getStencilFaceFlags( GraphicsStencilFaceMask faceMask );
 
+        VkExtent2D                  getFragmentShadingRateSize( GraphicsShadingRate shadingRate );
+        VkFragmentShadingRateCombinerOpKHR  getFragmentShadingRateCombinerOp( GraphicsShadingRateCombiner combiner );
+
         VkImageSubresourceRange     getImageSubresourceRange( const GraphicsTextureSubresourceRange& subresourceRange );
 
         float                       getMemoryPriority( GraphicsDeviceMemoryPriority priority );
@@ -465,6 +585,11 @@ namespace keen
 
         void                        writeFullPipelineBarrier( VulkanApi* pVulkan, VkCommandBuffer commandBuffer );
 
+        // rendering local read: maps the attachments to input attachment indices (same struct for the pipeline and the command buffer)
+        void                        fillRenderingInputAttachmentIndexInfo( VkRenderingInputAttachmentIndexInfoKHR* pInfo, uint32* pColorIndices, uint32* pDepthIndex, uint32* pStencilIndex, const GraphicsRenderingInputAttachmentIndices& indices, uint32 colorAttachmentCount );
+        // by-region dependency from the attachment writes to the input attachment reads inside the current rendering scope
+        void                        writeRenderingLocalReadBarrier( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, bool colorAttachments, bool depthStencilAttachment );
+
         inline uint32               calculateSubresource( uint32 mipLevelIndex, uint32 arrayLayerIndex, uint32 planeIndex, uint32 mipLevels, uint32 arraySize ) { return mipLevelIndex + ( arrayLayerIndex * mipLevels ) + ( planeIndex * mipLevels * arraySize ); }
 
 #if KEEN_USING( KEEN_VULKAN_CHECKPOINTS )
@@ -51,6 +51,10 @@ namespace keen
         case VulkanBreadcrumbType::DrawIndexedIndirectCount:    return "DrawIndexedIndirectCount"_s;
         case VulkanBreadcrumbType::DrawIndexedIndirect:         return "DrawIndexedIndirect"_s;
         case VulkanBreadcrumbType::DrawIndexed:                 return "DrawIndexed"_s;
+        case VulkanBreadcrumbType::DrawMeshTasks:               return "DrawMeshTasks"_s;
+        case VulkanBreadcrumbType::DrawMeshTasksIndirect:       return "DrawMeshTasksIndirect"_s;
+        case VulkanBreadcrumbType::DrawMeshTasksIndirectCount:  return "DrawMeshTasksIndirectCount"_s;
+        case VulkanBreadcrumbType::ExecuteGeneratedCommands:    return "ExecuteGeneratedCommands"_s;
         case VulkanBreadcrumbType::FillBuffer:                  return "FillBuffer"_s;
         case VulkanBreadcrumbType::CopyBuffer:                  return "CopyBuffer"_s;
         }
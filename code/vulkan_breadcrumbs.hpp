@@ -29,6 +29,10 @@ namespace keen
         DrawIndexedIndirectCount,
         DrawIndexedIndirect,
         DrawIndexed,
+        DrawMeshTasks,
+        DrawMeshTasksIndirect,
+        DrawMeshTasksIndirectCount,
+        ExecuteGeneratedCommands,
         FillBuffer,
         CopyBuffer,
     };
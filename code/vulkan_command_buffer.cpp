@@ -1,16 +1,22 @@
 #include "vulkan_command_buffer.hpp"
+#include "vulkan_command_buffer_key.hpp"
 #include "vulkan_types.hpp"
 #include "vulkan_synchronization.hpp"
 #include "keen/base/inivariables.hpp"
 #include "keen/base/thread_local_storage.hpp"
+#include "keen/base/tls_allocator_scope.hpp"
 #include "../global/graphics_command_buffer.hpp"
 #include "vulkan_graphics_objects.hpp"
+#include "vulkan_rendering_scope_optimizer.hpp"
+#include "vulkan_mip_generator.hpp"
 
 namespace keen
 {
 
     namespace vulkan
     {
+        KEEN_DEFINE_BOOL_VARIABLE( s_optimizeRenderingScopes, "vulkan/optimizeRenderingScopes", true, "Fold texture clears into the load actions of rendering scopes and merge adjacent rendering scopes on the same attachments" );
+        KEEN_DEFINE_BOOL_VARIABLE( s_coalesceTransferCommands, "vulkan/coalesceTransferCommands", true, "Write consecutive copy and fill commands on the same resources with a single vulkan call" );
 
         static uint32 getVulkanQueueFamilyIndex( const VulkanQueueInfos& queueInfos, GraphicsQueueId queueId )
         {
@@ -24,12 +30,53 @@ namespace keen
 
         static void writeVulkanCommand( VulkanRecordCommandBufferState* pState, VulkanApi* pVulkan, VkCommandBuffer commandBuffer, const GraphicsCommand* pCommand );
 
+        // returns the next command of the stream without consuming it - but only when it has the given id and is recorded as it is:
+        static const GraphicsCommand* peekNextTransferCommand( const VulkanRecordCommandBufferState* pState, GraphicsCommandId commandId, VulkanReadCommandBufferState* pNextReadState )
+        {
+            if( !s_coalesceTransferCommands )
+            {
+                return nullptr;
+            }
+
+            *pNextReadState = pState->readState;
+            const GraphicsCommand* pNextCommand = readNextCommand( pNextReadState );
+            if( pNextCommand == nullptr || pNextCommand->id != commandId )
+            {
+                return nullptr;
+            }
+            if( pState->pRenderingScopeRewrite != nullptr && pState->pRenderingScopeRewrite->commands[ pState->streamCommandIndex ].type != VulkanCommandRewriteType::Record )
+            {
+                return nullptr;
+            }
+            return pNextCommand;
+        }
+
+        // the peeked command was merged into the current one - so it must not be recorded on its own:
+        static void consumeNextTransferCommand( VulkanRecordCommandBufferState* pState, const VulkanReadCommandBufferState& nextReadState )
+        {
+            pState->readState = nextReadState;
+            if( pState->pRenderingScopeRewrite != nullptr )
+            {
+                pState->streamCommandIndex += 1u;
+            }
+        }
+
     }
 
-    void bindDescriptorSets( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, const GraphicsBindDescriptorSetsCommand* pBindDescriptorSetsCommand, VkDescriptorSet bindlessDescriptorSet, VkDescriptorSet emptyDescriptorSet )
+    void bindDescriptorSets( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, const GraphicsBindDescriptorSetsCommand* pBindDescriptorSetsCommand, ArrayView<const uint32> dynamicOffsets, VkDescriptorSet bindlessDescriptorSet, VkDescriptorSet emptyDescriptorSet )
     {
         const VulkanPipelineLayout* pPipelineLayout = (const VulkanPipelineLayout*)pBindDescriptorSetsCommand->pPipelineLayout;
 
+#if KEEN_USING( KEEN_GRAPHICS_VALIDATION )
+        // one offset per dynamic buffer descriptor of the bound sets (in set + binding order):
+        uint32 dynamicOffsetCount = 0u;
+        for( size_t i = 0u; i < pBindDescriptorSetsCommand->descriptorSetCount; ++i )
+        {
+            dynamicOffsetCount += pPipelineLayout->dynamicOffsetCounts[ i ];
+        }
+        KEEN_ASSERT( dynamicOffsets.getCount32() == dynamicOffsetCount );
+#endif
+
         DynamicArray<VkDescriptorSet,GraphicsLimits_MaxDescriptorSetSlotCount + 1u> descriptorSets;
         for( size_t i = 0u; i < pBindDescriptorSetsCommand->descriptorSetCount; ++i )
         {
@@ -48,7 +95,7 @@ namespace keen
         }
 
         pVulkan->vkCmdBindDescriptorSets( commandBuffer, pipelineBindPoint, pPipelineLayout->pipelineLayout, 0u,
-            descriptorSets.getCount32(), descriptorSets.getStart(), 0u, nullptr );
+            descriptorSets.getCount32(), descriptorSets.getStart(), dynamicOffsets.getCount32(), dynamicOffsets.getStart() );
     }
 
     static void writePipelineBarrier( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, const GraphicsPipelineBarrierCommand* pCommand, GraphicsOptionalShaderStageMask shaderStageMask )
@@ -227,7 +274,12 @@ namespace keen
         state.bindlessDescriptorSet = parameters.bindlessDescriptorSet;
         state.emptyDescriptorSet    = parameters.emptyDescriptorSet;
         state.queueInfos            = parameters.queueInfos;
+        state.generatedCommandsPreprocessAddress    = parameters.generatedCommandsPreprocessAddress;
+        state.generatedCommandsPreprocessSize       = parameters.generatedCommandsPreprocessSize;
+        state.pGeneratedCommandsPreprocessUsedSize  = parameters.pGeneratedCommandsPreprocessUsedSize;
         state.shaderStageMask       = graphics::getDeviceInfo( pCommandBuffer->pGraphicsSystem ).optionalShaderStages;
+        state.isPreciseOcclusionQuerySupported  = graphics::getDeviceInfo( pCommandBuffer->pGraphicsSystem ).supportedFeatures.isSet( GraphicsFeature::PreciseOcclusionQuery );
+        state.pTransferStatistics   = parameters.pTransferStatistics;
 
 #if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
         state.pBreadcrumbBuffer = parameters.pBreadcrumbBuffer;
@@ -244,13 +296,36 @@ namespace keen
             return false;
         }
 
+        if( pState->pRenderingScopeRewrite != nullptr )
+        {
+            const VulkanCommandRewrite& rewrite = pState->pRenderingScopeRewrite->commands[ pState->streamCommandIndex ];
+            pState->streamCommandIndex += 1u;
+
+            if( rewrite.type == VulkanCommandRewriteType::Skip )
+            {
+                return true;
+            }
+            if( rewrite.type == VulkanCommandRewriteType::PatchedBeginRendering )
+            {
+                pState->pRenderingScopePatch = &pState->pRenderingScopeRewrite->patches[ rewrite.patchIndex ];
+            }
+        }
+
         writeVulkanCommand( pState, pVulkan, commandBuffer, pCommand );
+        pState->pRenderingScopePatch = nullptr;
 
         return true;
     }
 
     void vulkan::endCommandBufferRecording( VulkanRecordCommandBufferState* pState )
     {
+        if( pState->pTransferStatistics != nullptr )
+        {
+            pState->pTransferStatistics->savedCopyBufferCount           += pState->transferStatistics.savedCopyBufferCount;
+            pState->pTransferStatistics->savedCopyBufferToTextureCount  += pState->transferStatistics.savedCopyBufferToTextureCount;
+            pState->pTransferStatistics->savedFillBufferCount           += pState->transferStatistics.savedFillBufferCount;
+        }
+
         pf::restoreExceptionState( pState->oldFpuExceptionState );
     }
 
@@ -260,6 +335,36 @@ namespace keen
 
         beginCommandBufferRecording( &recordState, pCommandBuffer, parameters );
 
+        TlsStackAllocatorScope stackAllocator;
+        Array<const GraphicsCommand*> commands;
+        VulkanRenderingScopeRewrite renderingScopeRewrite;
+        if( s_optimizeRenderingScopes )
+        {
+            KEEN_PROFILE_CPU( Vk_OptimizeRenderingScopes );
+
+            uint32 commandCount = 0u;
+            for( const GraphicsCommandBufferChunk* pChunk = pCommandBuffer->pFirstChunk; pChunk != nullptr; pChunk = pChunk->pNextChunk )
+            {
+                commandCount += pChunk->commandCount;
+            }
+
+            if( commands.tryCreate( &stackAllocator, commandCount ) )
+            {
+                VulkanReadCommandBufferState readState;
+                beginCommandBufferReading( &readState, pCommandBuffer );
+                for( uint32 i = 0u; i < commandCount; ++i )
+                {
+                    commands[ i ] = readNextCommand( &readState );
+                }
+
+                // :JK: without anything to rewrite the commands are recorded without looking at the rewrite at all
+                if( optimizeRenderingScopes( &renderingScopeRewrite, &stackAllocator, commands ) && renderingScopeRewrite.hasRewrites() )
+                {
+                    recordState.pRenderingScopeRewrite = &renderingScopeRewrite;
+                }
+            }
+        }
+
         vulkan::beginDebugLabel( pVulkan, commandBuffer, pCommandBuffer->debugName );
         vulkan::insertCheckPoint( pVulkan, commandBuffer, pCommandBuffer->debugName.getCName() );
 
@@ -271,6 +376,30 @@ namespace keen
         vulkan::endDebugLabel( pVulkan, commandBuffer );
 
         endCommandBufferRecording( &recordState );
+
+        destroyRenderingScopeRewrite( &renderingScopeRewrite );
+        commands.destroy();
+    }
+
+    uint64 vulkan::computeCommandBufferKey( const GraphicsCommandBuffer* pCommandBuffer )
+    {
+        KEEN_PROFILE_CPU( Vk_computeCommandBufferKey );
+
+        // :JK: the debug name is part of the recorded debug label - so it is part of the content as well
+        uint64 key = calculateFnv1a64Hash( createStringView( pCommandBuffer->debugName.getCName() ) ).value;
+
+        VulkanReadCommandBufferState readState;
+        beginCommandBufferReading( &readState, pCommandBuffer );
+
+        const GraphicsCommand* pCommand = readNextCommand( &readState );
+        while( pCommand != nullptr )
+        {
+            key = combineCommandBufferKey( key, pCommand );
+
+            pCommand = readNextCommand( &readState );
+        }
+
+        return key;
     }
 
     static void vulkan::writeVulkanCommand( VulkanRecordCommandBufferState* pState, VulkanApi* pVulkan, VkCommandBuffer commandBuffer, const GraphicsCommand* pCommand )
@@ -288,7 +417,15 @@ namespace keen
                 viewport.height     = (float32)pSetViewportCommand->viewport.height;
                 viewport.minDepth   = pSetViewportCommand->viewport.minDepth;
                 viewport.maxDepth   = pSetViewportCommand->viewport.maxDepth;
-                pVulkan->vkCmdSetViewport( commandBuffer, 0u, 1u, &viewport );
+                if( pVulkan->EXT_shader_object )
+                {
+                    // :JK: all render pipelines are shader objects then - and those have no viewport count
+                    pVulkan->vkCmdSetViewportWithCountEXT( commandBuffer, 1u, &viewport );
+                }
+                else
+                {
+                    pVulkan->vkCmdSetViewport( commandBuffer, 0u, 1u, &viewport );
+                }
             }
             break;
 
@@ -301,7 +438,32 @@ namespace keen
                 scissorRect.offset.y = pSetScissorRectangleCommand->scissorRectangle.y;
                 scissorRect.extent.width = pSetScissorRectangleCommand->scissorRectangle.width;
                 scissorRect.extent.height = pSetScissorRectangleCommand->scissorRectangle.height;
-                pVulkan->vkCmdSetScissor( commandBuffer, 0u, 1u, &scissorRect );
+                if( pVulkan->EXT_shader_object )
+                {
+                    pVulkan->vkCmdSetScissorWithCountEXT( commandBuffer, 1u, &scissorRect );
+                }
+                else
+                {
+                    pVulkan->vkCmdSetScissor( commandBuffer, 0u, 1u, &scissorRect );
+                }
+            }
+            break;
+
+        case GraphicsCommandId_SetShadingRate:
+            {
+                const GraphicsSetShadingRateCommand* pSetShadingRateCommand = (const GraphicsSetShadingRateCommand*)pCommand;
+
+                // :JK: silently ignore this if vrs is not supported - this is only an optimization after all
+                if( pVulkan->KHR_fragment_shading_rate )
+                {
+                    const VkExtent2D fragmentSize = vulkan::getFragmentShadingRateSize( pSetShadingRateCommand->shadingRate );
+                    const VkFragmentShadingRateCombinerOpKHR combinerOps[ 2u ] =
+                    {
+                        vulkan::getFragmentShadingRateCombinerOp( pSetShadingRateCommand->combiners[ 0u ] ),
+                        vulkan::getFragmentShadingRateCombinerOp( pSetShadingRateCommand->combiners[ 1u ] ),
+                    };
+                    pVulkan->vkCmdSetFragmentShadingRateKHR( commandBuffer, &fragmentSize, combinerOps );
+                }
             }
             break;
 
@@ -332,12 +494,152 @@ namespace keen
             }
             break;
 
+        case GraphicsCommandId_SetCullMode:
+            {
+                const GraphicsSetCullModeCommand* pSetCullModeCommand = (const GraphicsSetCullModeCommand*)pCommand;
+
+                KEEN_ASSERT( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) );
+                if( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) )
+                {
+                    pVulkan->vkCmdSetCullModeEXT( commandBuffer, vulkan::getCullModeFlagBits( pSetCullModeCommand->cullMode ) );
+                    pVulkan->vkCmdSetFrontFaceEXT( commandBuffer, vulkan::getFrontFace( pSetCullModeCommand->windingOrder ) );
+                }
+            }
+            break;
+
+        case GraphicsCommandId_SetDepthState:
+            {
+                const GraphicsSetDepthStateCommand* pSetDepthStateCommand = (const GraphicsSetDepthStateCommand*)pCommand;
+
+                KEEN_ASSERT( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) );
+                if( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) )
+                {
+                    // same mapping as the pipeline state:
+                    const bool depthTestEnabled = pSetDepthStateCommand->depthComparisonFunction != GraphicsComparisonFunction::Always;
+                    pVulkan->vkCmdSetDepthTestEnableEXT( commandBuffer, (VkBool32)( depthTestEnabled || pSetDepthStateCommand->depthWriteEnabled ) );
+                    pVulkan->vkCmdSetDepthWriteEnableEXT( commandBuffer, (VkBool32)pSetDepthStateCommand->depthWriteEnabled );
+                    pVulkan->vkCmdSetDepthCompareOpEXT( commandBuffer, vulkan::getCompareOp( pSetDepthStateCommand->depthComparisonFunction ) );
+                }
+            }
+            break;
+
+        case GraphicsCommandId_SetStencilState:
+            {
+                const GraphicsSetStencilStateCommand* pSetStencilStateCommand = (const GraphicsSetStencilStateCommand*)pCommand;
+
+                KEEN_ASSERT( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) );
+                if( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) )
+                {
+                    const GraphicsStencilParameters& front  = pSetStencilStateCommand->frontStencil;
+                    const GraphicsStencilParameters& back   = pSetStencilStateCommand->backStencil;
+                    pVulkan->vkCmdSetStencilTestEnableEXT( commandBuffer, (VkBool32)( front.testEnabled || back.testEnabled ) );
+                    pVulkan->vkCmdSetStencilOpEXT( commandBuffer, VK_STENCIL_FACE_FRONT_BIT, vulkan::getStencilOp( front.opFail ), vulkan::getStencilOp( front.opDepthPass ), vulkan::getStencilOp( front.opDepthFail ), vulkan::getCompareOp( front.testFunc ) );
+                    pVulkan->vkCmdSetStencilOpEXT( commandBuffer, VK_STENCIL_FACE_BACK_BIT, vulkan::getStencilOp( back.opFail ), vulkan::getStencilOp( back.opDepthPass ), vulkan::getStencilOp( back.opDepthFail ), vulkan::getCompareOp( back.testFunc ) );
+                }
+            }
+            break;
+
+        case GraphicsCommandId_SetPrimitiveType:
+            {
+                const GraphicsSetPrimitiveTypeCommand* pSetPrimitiveTypeCommand = (const GraphicsSetPrimitiveTypeCommand*)pCommand;
+
+                // :JK: only types of the same topology class as the pipeline primitive type are allowed here
+                KEEN_ASSERT( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) );
+                if( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) )
+                {
+                    pVulkan->vkCmdSetPrimitiveTopologyEXT( commandBuffer, vulkan::getPrimitiveTopology( pSetPrimitiveTypeCommand->primitiveType ) );
+                }
+            }
+            break;
+
+        case GraphicsCommandId_SetDepthBias:
+            {
+                const GraphicsSetDepthBiasCommand* pSetDepthBiasCommand = (const GraphicsSetDepthBiasCommand*)pCommand;
+
+                KEEN_ASSERT( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState2 ) );
+                if( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState2 ) )
+                {
+                    const bool depthBiasEnabled = ( pSetDepthBiasCommand->constDepthBias != 0.0f ) || ( pSetDepthBiasCommand->slopeDepthBias != 0.0f );
+                    pVulkan->vkCmdSetDepthBiasEnableEXT( commandBuffer, depthBiasEnabled ? VK_TRUE : VK_FALSE );
+                    pVulkan->vkCmdSetDepthBias( commandBuffer, pSetDepthBiasCommand->constDepthBias, 0.0f, pSetDepthBiasCommand->slopeDepthBias );
+                }
+            }
+            break;
+
+        case GraphicsCommandId_SetFillMode:
+            {
+                const GraphicsSetFillModeCommand* pSetFillModeCommand = (const GraphicsSetFillModeCommand*)pCommand;
+
+                KEEN_ASSERT( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState3 ) );
+                if( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState3 ) )
+                {
+                    pVulkan->vkCmdSetPolygonModeEXT( commandBuffer, vulkan::getPolygonMode( pSetFillModeCommand->fillMode ) );
+                }
+            }
+            break;
+
+        case GraphicsCommandId_SetBlendState:
+            {
+                const GraphicsSetBlendStateCommand* pSetBlendStateCommand = (const GraphicsSetBlendStateCommand*)pCommand;
+
+                KEEN_ASSERT( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState3 ) );
+                if( pState->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState3 ) && pSetBlendStateCommand->colorTargetCount > 0u )
+                {
+                    const uint32 colorTargetCount = pSetBlendStateCommand->colorTargetCount;
+                    KEEN_ASSERT( colorTargetCount <= GraphicsLimits_MaxColorTargetCount );
+
+                    VkBool32                blendEnable[ GraphicsLimits_MaxColorTargetCount ];
+                    VkColorBlendEquationEXT blendEquations[ GraphicsLimits_MaxColorTargetCount ];
+                    VkColorComponentFlags   writeMasks[ GraphicsLimits_MaxColorTargetCount ];
+                    for( uint32 i = 0u; i < colorTargetCount; ++i )
+                    {
+                        blendEnable[ i ]                        = pSetBlendStateCommand->blendOp != GraphicsBlendOperation::None ? VK_TRUE : VK_FALSE;
+                        blendEquations[ i ].srcColorBlendFactor = vulkan::getBlendFactor( pSetBlendStateCommand->blendSourceFactor );
+                        blendEquations[ i ].dstColorBlendFactor = vulkan::getBlendFactor( pSetBlendStateCommand->blendDestFactor );
+                        blendEquations[ i ].colorBlendOp        = vulkan::getBlendOp( pSetBlendStateCommand->blendOp );
+                        blendEquations[ i ].srcAlphaBlendFactor = vulkan::getBlendFactor( pSetBlendStateCommand->blendSourceFactor );
+                        blendEquations[ i ].dstAlphaBlendFactor = vulkan::getBlendFactor( pSetBlendStateCommand->blendDestFactor );
+                        blendEquations[ i ].alphaBlendOp        = vulkan::getBlendOp( pSetBlendStateCommand->blendOp );
+                        writeMasks[ i ]                         = vulkan::getColorComponentFlagBits( pSetBlendStateCommand->colorWriteMask[ i ] );
+                    }
+                    pVulkan->vkCmdSetColorBlendEnableEXT( commandBuffer, 0u, colorTargetCount, blendEnable );
+                    pVulkan->vkCmdSetColorBlendEquationEXT( commandBuffer, 0u, colorTargetCount, blendEquations );
+                    pVulkan->vkCmdSetColorWriteMaskEXT( commandBuffer, 0u, colorTargetCount, writeMasks );
+                    pVulkan->vkCmdSetAlphaToCoverageEnableEXT( commandBuffer, (VkBool32)pSetBlendStateCommand->alphaToCoverage );
+                }
+            }
+            break;
+
         case GraphicsCommandId_BindRenderPipeline:
             {
                 const GraphicsBindRenderPipelineCommand* pBindRenderPipelineCommand = (const GraphicsBindRenderPipelineCommand*)pCommand;
 
                 const VulkanRenderPipeline* pRenderPipeline = (const VulkanRenderPipeline*)pBindRenderPipelineCommand->pRenderPipeline;
-                pVulkan->vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pRenderPipeline->pipeline );
+                if( pRenderPipeline->isShaderObjectPipeline )
+                {
+                    vulkan::writeShaderObjectPipelineBind( pVulkan, commandBuffer, pRenderPipeline->shaderObjects, pRenderPipeline->dynamicState );
+                }
+                else
+                {
+                    pVulkan->vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pRenderPipeline->pipeline );
+                }
+
+                // :JK: the VkPipeline might be shared with other permutations - so the dynamic part of the state has to be set on every bind
+                if( !pRenderPipeline->isShaderObjectPipeline && pRenderPipeline->dynamicStateFeatures.hasSetBits() )
+                {
+                    vulkan::writeRenderPipelineDynamicState( pVulkan, commandBuffer, pRenderPipeline->dynamicStateFeatures, pRenderPipeline->dynamicState );
+                }
+                pState->dynamicStateFeatures = pRenderPipeline->dynamicStateFeatures;
+
+                pState->hasDynamicVertexStrides = pRenderPipeline->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) && pRenderPipeline->dynamicState.hasDynamicVertexStrides;
+                if( pState->hasDynamicVertexStrides )
+                {
+                    for( uint32 i = 0u; i < pRenderPipeline->dynamicState.vertexBindingCount; ++i )
+                    {
+                        const VkVertexInputBindingDescription2EXT& binding = pRenderPipeline->dynamicState.vertexBindings[ i ];
+                        pState->vertexStreamStrides[ binding.binding ] = binding.stride;
+                    }
+                }
 
 #if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
                 pState->pCurrentRenderPipeline = pRenderPipeline;
@@ -392,7 +694,33 @@ namespace keen
                 VulkanBreadcrumbScope breadcrumb( pState->pBreadcrumbBuffer, pVulkan, commandBuffer, VulkanBreadcrumbType::FillBuffer, pBuffer->getDebugName() );
 #endif
 
-                pVulkan->vkCmdFillBuffer( commandBuffer, pBuffer->buffer, pFillBufferCommand->offset, pFillBufferCommand->size, pFillBufferCommand->value );
+                VulkanFillBufferRange range;
+                range.offset    = pFillBufferCommand->offset;
+                range.size      = pFillBufferCommand->size;
+                range.value     = pFillBufferCommand->value;
+
+                // following fills of the same buffer that touch the range are written with the same call:
+                VulkanReadCommandBufferState nextReadState;
+                const GraphicsCommand* pNextCommand = peekNextTransferCommand( pState, GraphicsCommandId_FillBuffer, &nextReadState );
+                while( pNextCommand != nullptr )
+                {
+                    const GraphicsFillBufferCommand* pNextFillBufferCommand = (const GraphicsFillBufferCommand*)pNextCommand;
+
+                    VulkanFillBufferRange nextRange;
+                    nextRange.offset    = pNextFillBufferCommand->offset;
+                    nextRange.size      = pNextFillBufferCommand->size;
+                    nextRange.value     = pNextFillBufferCommand->value;
+                    if( pNextFillBufferCommand->pBuffer != pFillBufferCommand->pBuffer || !tryMergeFillBufferRange( &range, nextRange ) )
+                    {
+                        break;
+                    }
+
+                    consumeNextTransferCommand( pState, nextReadState );
+                    pState->transferStatistics.savedFillBufferCount += 1u;
+                    pNextCommand = peekNextTransferCommand( pState, GraphicsCommandId_FillBuffer, &nextReadState );
+                }
+
+                pVulkan->vkCmdFillBuffer( commandBuffer, pBuffer->buffer, range.offset, range.size, range.value );
             }
             break;
 
@@ -406,12 +734,41 @@ namespace keen
                 VulkanBreadcrumbScope breadcrumb( pState->pBreadcrumbBuffer, pVulkan, commandBuffer, VulkanBreadcrumbType::CopyBuffer, pSourceBuffer->getDebugName() );
 #endif
 
+                const bool isSameBuffer = ( pSourceBuffer == pTargetBuffer );
+
+                DynamicArray<VkBufferCopy, VulkanMaxCoalescedCopyRegionCount> regions;
                 VkBufferCopy region;
                 region.srcOffset    = pCopyBufferCommand->sourceOffset;
                 region.dstOffset    = pCopyBufferCommand->targetOffset;
                 region.size         = pCopyBufferCommand->size;
+                regions.pushBack( region );
+
+                // following copies between the same buffers are written with the same call as long as their regions don't overlap:
+                VulkanReadCommandBufferState nextReadState;
+                const GraphicsCommand* pNextCommand = peekNextTransferCommand( pState, GraphicsCommandId_CopyBuffer, &nextReadState );
+                while( pNextCommand != nullptr )
+                {
+                    const GraphicsCopyBufferCommand* pNextCopyBufferCommand = (const GraphicsCopyBufferCommand*)pNextCommand;
+                    if( pNextCopyBufferCommand->pSourceBuffer != pCopyBufferCommand->pSourceBuffer || pNextCopyBufferCommand->pTargetBuffer != pCopyBufferCommand->pTargetBuffer )
+                    {
+                        break;
+                    }
+
+                    VkBufferCopy nextRegion;
+                    nextRegion.srcOffset    = pNextCopyBufferCommand->sourceOffset;
+                    nextRegion.dstOffset    = pNextCopyBufferCommand->targetOffset;
+                    nextRegion.size         = pNextCopyBufferCommand->size;
+                    if( !appendBufferCopyRegion( &regions, nextRegion, isSameBuffer ) )
+                    {
+                        break;
+                    }
+
+                    consumeNextTransferCommand( pState, nextReadState );
+                    pState->transferStatistics.savedCopyBufferCount += 1u;
+                    pNextCommand = peekNextTransferCommand( pState, GraphicsCommandId_CopyBuffer, &nextReadState );
+                }
 
-                pVulkan->vkCmdCopyBuffer( commandBuffer, pSourceBuffer->buffer, pTargetBuffer->buffer, 1u, &region );
+                pVulkan->vkCmdCopyBuffer( commandBuffer, pSourceBuffer->buffer, pTargetBuffer->buffer, regions.getCount32(), regions.getStart() );
             }
             break;
 
@@ -443,29 +800,49 @@ namespace keen
                 const VulkanBuffer* pSourceBuffer = (const VulkanBuffer*)pCopyCommand->pSourceBuffer;
                 const VulkanTexture* pTargetTexture = (const VulkanTexture*)pCopyCommand->pTargetTexture;
                 const VkImageLayout targetLayout = vulkan::getImageLayout( pCopyCommand->targetLayout );
-                const GraphicsBufferTextureCopyRegion* pCopyRegions = (const GraphicsBufferTextureCopyRegion*)( (const uint8*)pCommand + sizeof( GraphicsCopyBufferToTextureCommand ) );
-                const size_t copyRegionCount = pCopyCommand->copyRegionCount;
 
-                constexpr size_t BatchSize = 16u;
-                StaticArray<VkBufferImageCopy, BatchSize> vulkanCopyRegions;
-                for( size_t batchIndex = 0u; batchIndex < alignUp( copyRegionCount, BatchSize ) / BatchSize; ++batchIndex )
+                // :JK: the regions of following copies from the same buffer into the same texture (i.e. streamed tiles) are written with
+                // the same calls - a region that overlaps another region of the call starts a new call because the regions of one call
+                // must not overlap (the two copies are still a write-after-write hazard without a barrier in between)
+                DynamicArray<VkBufferImageCopy, VulkanMaxCoalescedCopyRegionCount> vulkanCopyRegions;
+
+                const GraphicsCopyBufferToTextureCommand* pNextCopyCommand = pCopyCommand;
+                while( pNextCopyCommand != nullptr )
                 {
-                    size_t batchRegionIndex;
-                    for( batchRegionIndex = 0u; batchRegionIndex < BatchSize; ++batchRegionIndex )
+                    const GraphicsBufferTextureCopyRegion* pCopyRegions = (const GraphicsBufferTextureCopyRegion*)( (const uint8*)pNextCopyCommand + sizeof( GraphicsCopyBufferToTextureCommand ) );
+                    const size_t copyRegionCount = pNextCopyCommand->copyRegionCount;
+
+                    for( size_t regionIndex = 0u; regionIndex < copyRegionCount; ++regionIndex )
                     {
-                        const size_t regionIndex = batchIndex * BatchSize + batchRegionIndex;
-                        if( regionIndex == copyRegionCount )
+                        VkBufferImageCopy vulkanCopyRegion;
+                        vulkan::fillVkBufferImageCopy( &vulkanCopyRegion, pCopyRegions[ regionIndex ] );
+                        if( !vulkan::appendBufferImageCopyRegion( &vulkanCopyRegions, vulkanCopyRegion ) )
                         {
-                            break;
+                            pVulkan->vkCmdCopyBufferToImage( commandBuffer, pSourceBuffer->buffer, pTargetTexture->image, targetLayout, vulkanCopyRegions.getCount32(), vulkanCopyRegions.getStart() );
+                            vulkanCopyRegions.clear();
+                            vulkanCopyRegions.pushBack( vulkanCopyRegion );
                         }
+                    }
 
-                        const GraphicsBufferTextureCopyRegion& copyRegion = pCopyRegions[ regionIndex ];
-                        VkBufferImageCopy* pVulkanCopyRegion = &vulkanCopyRegions[ batchRegionIndex ];
-                        vulkan::fillVkBufferImageCopy( pVulkanCopyRegion, copyRegion );
+                    VulkanReadCommandBufferState nextReadState;
+                    pNextCopyCommand = (const GraphicsCopyBufferToTextureCommand*)peekNextTransferCommand( pState, GraphicsCommandId_CopyBufferToTexture, &nextReadState );
+                    if( pNextCopyCommand != nullptr )
+                    {
+                        if( pNextCopyCommand->pSourceBuffer != pCopyCommand->pSourceBuffer || pNextCopyCommand->pTargetTexture != pCopyCommand->pTargetTexture || pNextCopyCommand->targetLayout != pCopyCommand->targetLayout )
+                        {
+                            pNextCopyCommand = nullptr;
+                        }
+                        else
+                        {
+                            consumeNextTransferCommand( pState, nextReadState );
+                            pState->transferStatistics.savedCopyBufferToTextureCount += 1u;
+                        }
                     }
+                }
 
-                    KEEN_ASSERT( batchRegionIndex > 0u );
-                    pVulkan->vkCmdCopyBufferToImage( commandBuffer, pSourceBuffer->buffer, pTargetTexture->image, targetLayout, rangecheck_cast<uint32>( batchRegionIndex ), vulkanCopyRegions.getStart() );
+                if( vulkanCopyRegions.hasElements() )
+                {
+                    pVulkan->vkCmdCopyBufferToImage( commandBuffer, pSourceBuffer->buffer, pTargetTexture->image, targetLayout, vulkanCopyRegions.getCount32(), vulkanCopyRegions.getStart() );
                 }
             }
             break;
@@ -528,6 +905,25 @@ namespace keen
             }
             break;
 
+        case GraphicsCommandId_GenerateMips:
+            {
+                const GraphicsGenerateMipsCommand* pGenerateMipsCommand = (const GraphicsGenerateMipsCommand*)pCommand;
+
+                VulkanGenerateMipsParameters parameters;
+                parameters.pTexture         = pGenerateMipsCommand->pTexture;
+                parameters.subresourceRange = pGenerateMipsCommand->subresourceRange;
+                parameters.oldLayout        = pGenerateMipsCommand->oldLayout;
+                parameters.oldAccessMask    = pGenerateMipsCommand->oldAccessMask;
+                parameters.newLayout        = pGenerateMipsCommand->newLayout;
+                parameters.newAccessMask    = pGenerateMipsCommand->newAccessMask;
+
+                // the command is rejected when it is recorded for a texture without blit support (see vulkan::canGenerateMips):
+                const bool mipsGenerated = vulkan::writeGenerateMips( pVulkan, commandBuffer, parameters, pState->shaderStageMask );
+                KEEN_ASSERT( mipsGenerated );
+                KEEN_UNUSED1( mipsGenerated );
+            }
+            break;
+
         case GraphicsCommandId_PipelineBarrier:
             {
                 const GraphicsPipelineBarrierCommand* pPipelineBarrierCommand = (const GraphicsPipelineBarrierCommand*)pCommand;
@@ -548,7 +944,7 @@ namespace keen
             {
                 const GraphicsBindDescriptorSetsCommand* pBindDescriptorSetsCommand = (const GraphicsBindDescriptorSetsCommand*)pCommand;
 
-                bindDescriptorSets( pVulkan, commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pBindDescriptorSetsCommand, pState->bindlessDescriptorSet, pState->emptyDescriptorSet );
+                bindDescriptorSets( pVulkan, commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pBindDescriptorSetsCommand, {}, pState->bindlessDescriptorSet, pState->emptyDescriptorSet );
             }
             break;
 
@@ -556,7 +952,19 @@ namespace keen
             {
                 const GraphicsBindDescriptorSetsCommand* pBindDescriptorSetsCommand = (const GraphicsBindDescriptorSetsCommand*)pCommand;
 
-                bindDescriptorSets( pVulkan, commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pBindDescriptorSetsCommand, pState->bindlessDescriptorSet, pState->emptyDescriptorSet );
+                bindDescriptorSets( pVulkan, commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pBindDescriptorSetsCommand, {}, pState->bindlessDescriptorSet, pState->emptyDescriptorSet );
+            }
+            break;
+
+        case GraphicsCommandId_BindRenderDescriptorSetsWithOffsets:
+        case GraphicsCommandId_BindComputeDescriptorSetsWithOffsets:
+            {
+                // the dynamic offsets follow the command:
+                const GraphicsBindDescriptorSetsWithOffsetsCommand* pBindDescriptorSetsCommand = (const GraphicsBindDescriptorSetsWithOffsetsCommand*)pCommand;
+                const uint32* pDynamicOffsets = (const uint32*)( ( (const uint8*)pBindDescriptorSetsCommand ) + sizeof( GraphicsBindDescriptorSetsWithOffsetsCommand ) );
+                const VkPipelineBindPoint bindPoint = pCommand->id == GraphicsCommandId_BindRenderDescriptorSetsWithOffsets ? VK_PIPELINE_BIND_POINT_GRAPHICS : VK_PIPELINE_BIND_POINT_COMPUTE;
+
+                bindDescriptorSets( pVulkan, commandBuffer, bindPoint, &pBindDescriptorSetsCommand->sets, createArrayView( pDynamicOffsets, pBindDescriptorSetsCommand->dynamicOffsetCount ), pState->bindlessDescriptorSet, pState->emptyDescriptorSet );
             }
             break;
 
@@ -565,10 +973,23 @@ namespace keen
                 // get stage mask + pipeline layout:
                 const GraphicsPushConstantsCommand* pPushConstantsCommand = (const GraphicsPushConstantsCommand*)pCommand;
                 const VulkanPipelineLayout* pPipelineLayout = (const VulkanPipelineLayout*)pPushConstantsCommand->pPipelineLayout;
-                const VkShaderStageFlags stageMask = vulkan::getStageFlags( pPushConstantsCommand->stageMask );
+                const uint32 offset = pPushConstantsCommand->offset;
+                const uint32 size = pPushConstantsCommand->dataSize;
                 const uint8* pData = ( (const uint8*)pPushConstantsCommand ) + sizeof( GraphicsPushConstantsCommand );
 
-                pVulkan->vkCmdPushConstants( commandBuffer, pPipelineLayout->pipelineLayout, stageMask, 0u, pPushConstantsCommand->dataSize, pData );
+                // :JK: vulkan wants the stages of every range that overlaps the updated bytes:
+                VkShaderStageFlags stageMask = vulkan::getStageFlags( pPushConstantsCommand->stageMask );
+                for( uint32 i = 0u; i < pPipelineLayout->pushConstantRangeCount; ++i )
+                {
+                    const VkPushConstantRange& range = pPipelineLayout->pushConstantRanges[ i ];
+                    if( offset < range.offset + range.size && range.offset < offset + size )
+                    {
+                        KEEN_ASSERT( range.offset <= offset && offset + size <= range.offset + range.size );
+                        stageMask |= range.stageFlags;
+                    }
+                }
+
+                pVulkan->vkCmdPushConstants( commandBuffer, pPipelineLayout->pipelineLayout, stageMask, offset, size, pData );
             }
             break;
 
@@ -576,7 +997,59 @@ namespace keen
             {
                 const GraphicsBindVertexBufferCommand* pBindVertexBufferCommand = (const GraphicsBindVertexBufferCommand*)pCommand;
                 const VulkanBuffer* pVulkanBuffer = (const VulkanBuffer*)pBindVertexBufferCommand->vertexBuffer.pBuffer;
-                pVulkan->vkCmdBindVertexBuffers( commandBuffer, 0u, 1u, &pVulkanBuffer->buffer, &pBindVertexBufferCommand->vertexBuffer.offset );
+
+                // with dynamic strides the stride of the vertex format has to be passed with the buffer (see GraphicsCommandId_BindVertexBuffers):
+                if( pState->hasDynamicVertexStrides )
+                {
+                    const VkDeviceSize stride = pState->vertexStreamStrides[ 0u ];
+                    KEEN_ASSERT( stride != 0u );
+                    pVulkan->vkCmdBindVertexBuffers2EXT( commandBuffer, 0u, 1u, &pVulkanBuffer->buffer, &pBindVertexBufferCommand->vertexBuffer.offset, nullptr, &stride );
+                }
+                else
+                {
+                    pVulkan->vkCmdBindVertexBuffers( commandBuffer, 0u, 1u, &pVulkanBuffer->buffer, &pBindVertexBufferCommand->vertexBuffer.offset );
+                }
+            }
+            break;
+
+        case GraphicsCommandId_BindVertexBuffers:
+            {
+                // the GraphicsStridedBufferRanges of the streams follow the command:
+                const GraphicsBindVertexBuffersCommand* pBindVertexBuffersCommand = (const GraphicsBindVertexBuffersCommand*)pCommand;
+                const GraphicsStridedBufferRange* pStreams = (const GraphicsStridedBufferRange*)( ( (const uint8*)pBindVertexBuffersCommand ) + sizeof( GraphicsBindVertexBuffersCommand ) );
+                const uint32 firstStream = pBindVertexBuffersCommand->firstStream;
+                const uint32 streamCount = pBindVertexBuffersCommand->streamCount;
+                KEEN_ASSERT( streamCount > 0u && firstStream + streamCount <= GraphicsLimits_MaxVertexStreamCount );
+
+                VkBuffer buffers[ GraphicsLimits_MaxVertexStreamCount ];
+                VkDeviceSize offsets[ GraphicsLimits_MaxVertexStreamCount ];
+                VkDeviceSize sizes[ GraphicsLimits_MaxVertexStreamCount ];
+                VkDeviceSize strides[ GraphicsLimits_MaxVertexStreamCount ];
+                bool hasSizes = false;
+                for( uint32 i = 0u; i < streamCount; ++i )
+                {
+                    const VulkanBuffer* pVulkanBuffer = (const VulkanBuffer*)pStreams[ i ].pBuffer;
+                    buffers[ i ]    = pVulkanBuffer->buffer;
+                    offsets[ i ]    = pStreams[ i ].offset;
+                    sizes[ i ]      = pStreams[ i ].size != 0u ? pStreams[ i ].size : VK_WHOLE_SIZE;
+                    // :JK: a zero stride keeps the stride of the vertex format:
+                    strides[ i ]    = pStreams[ i ].stride != 0u ? pStreams[ i ].stride : pState->vertexStreamStrides[ firstStream + i ];
+                    hasSizes |= pStreams[ i ].size != 0u;
+                }
+
+                // :JK: without extended dynamic state the sizes can't be passed and the whole buffers are bound - callers have to check
+                // isExtendedDynamicStateSupported (see GraphicsStridedBufferRange)
+                KEEN_ASSERT( !hasSizes || pVulkan->EXT_extended_dynamic_state );
+
+                // the strides are only allowed for pipelines with dynamic strides - so the vertex buffers have to be bound after the pipeline:
+                if( pState->hasDynamicVertexStrides || ( hasSizes && pVulkan->EXT_extended_dynamic_state ) )
+                {
+                    pVulkan->vkCmdBindVertexBuffers2EXT( commandBuffer, firstStream, streamCount, buffers, offsets, sizes, pState->hasDynamicVertexStrides ? strides : nullptr );
+                }
+                else
+                {
+                    pVulkan->vkCmdBindVertexBuffers( commandBuffer, firstStream, streamCount, buffers, offsets );
+                }
             }
             break;
 
@@ -663,6 +1136,100 @@ namespace keen
             }
             break;
 
+        case GraphicsCommandId_DrawMeshTasks:
+            {
+                const GraphicsDrawMeshTasksCommand* pDrawCommand = (const GraphicsDrawMeshTasksCommand*)pCommand;
+                KEEN_ASSERT( pVulkan->EXT_mesh_shader );
+
+#if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
+                VulkanBreadcrumbScope breadcrumb( pState->pBreadcrumbBuffer, pVulkan, commandBuffer, VulkanBreadcrumbType::DrawMeshTasks, pState->pCurrentRenderPipeline->getDebugName() );
+#endif
+
+                pVulkan->vkCmdDrawMeshTasksEXT( commandBuffer, pDrawCommand->groupCountX, pDrawCommand->groupCountY, pDrawCommand->groupCountZ );
+            }
+            break;
+
+        case GraphicsCommandId_DrawMeshTasksIndirect:
+            {
+                const GraphicsDrawMeshTasksIndirectCommand* pDrawCommand = (const GraphicsDrawMeshTasksIndirectCommand*)pCommand;
+                const VulkanBuffer* pParameterBuffer = (const VulkanBuffer*)pDrawCommand->pParametersBuffer;
+                KEEN_ASSERT( pVulkan->EXT_mesh_shader );
+
+#if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
+                VulkanBreadcrumbScope breadcrumb( pState->pBreadcrumbBuffer, pVulkan, commandBuffer, VulkanBreadcrumbType::DrawMeshTasksIndirect, pState->pCurrentRenderPipeline->getDebugName() );
+#endif
+
+                pVulkan->vkCmdDrawMeshTasksIndirectEXT( commandBuffer, pParameterBuffer->buffer, pDrawCommand->parameterBufferOffset, pDrawCommand->drawCount, pDrawCommand->parameterStride );
+            }
+            break;
+
+        case GraphicsCommandId_DrawMeshTasksIndirectCount:
+            {
+                const GraphicsDrawMeshTasksIndirectCountCommand* pDrawCommand = (const GraphicsDrawMeshTasksIndirectCountCommand*)pCommand;
+                const VulkanBuffer* pParameterBuffer = (const VulkanBuffer*)pDrawCommand->pParametersBuffer;
+                const VulkanBuffer* pCountBuffer = (const VulkanBuffer*)pDrawCommand->pCountBuffer;
+                KEEN_ASSERT( pVulkan->EXT_mesh_shader );
+
+#if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
+                VulkanBreadcrumbScope breadcrumb( pState->pBreadcrumbBuffer, pVulkan, commandBuffer, VulkanBreadcrumbType::DrawMeshTasksIndirectCount, pState->pCurrentRenderPipeline->getDebugName() );
+#endif
+
+                pVulkan->vkCmdDrawMeshTasksIndirectCountEXT( commandBuffer, pParameterBuffer->buffer, pDrawCommand->parameterBufferOffset, pCountBuffer->buffer, pDrawCommand->countBufferOffset, pDrawCommand->maxDrawCount, pDrawCommand->parameterStride );
+            }
+            break;
+
+        case GraphicsCommandId_ExecuteGeneratedCommands:
+            {
+                const GraphicsExecuteGeneratedCommandsCommand* pExecuteCommand = (const GraphicsExecuteGeneratedCommandsCommand*)pCommand;
+                const VulkanIndirectCommandsLayout* pLayout = (const VulkanIndirectCommandsLayout*)pExecuteCommand->pIndirectCommandsLayout;
+                const VulkanBuffer* pArgumentBuffer = (const VulkanBuffer*)pExecuteCommand->pArgumentBuffer;
+                const VulkanBuffer* pCountBuffer = (const VulkanBuffer*)pExecuteCommand->pCountBuffer;
+                KEEN_ASSERT( pVulkan->EXT_device_generated_commands );
+                KEEN_ASSERT( pArgumentBuffer->deviceAddress != 0u );
+                KEEN_ASSERT( pExecuteCommand->maxSequenceCount <= pLayout->maxSequenceCount );
+
+                KEEN_ASSERT( pState->pGeneratedCommandsPreprocessUsedSize != nullptr );
+
+                // :JK: each execute of the frame gets its own range of the preprocess buffer - so no barrier is needed between them (which
+                // would not be allowed inside of a rendering scope anyway). The used size grows even when the buffer is too small so the
+                // render context can size the buffer of the next frames.
+                const uint64 preprocessOffset = alignUp( *pState->pGeneratedCommandsPreprocessUsedSize, pLayout->preprocessAlignment );
+                *pState->pGeneratedCommandsPreprocessUsedSize = preprocessOffset + pLayout->preprocessSize;
+                if( preprocessOffset + pLayout->preprocessSize > pState->generatedCommandsPreprocessSize )
+                {
+                    KEEN_TRACE_ERROR( "[graphics] Skipping generated commands '%k': the preprocess buffer is too small (%,d < %,d bytes)\n", pLayout->getDebugName(), pState->generatedCommandsPreprocessSize, preprocessOffset + pLayout->preprocessSize );
+                    break;
+                }
+
+                VkGeneratedCommandsPipelineInfoEXT pipelineInfo{ VK_STRUCTURE_TYPE_GENERATED_COMMANDS_PIPELINE_INFO_EXT };
+                pipelineInfo.pipeline = pLayout->pipeline;
+
+                VkGeneratedCommandsInfoEXT generatedCommandsInfo{ VK_STRUCTURE_TYPE_GENERATED_COMMANDS_INFO_EXT };
+                generatedCommandsInfo.pNext                     = pLayout->executionSet == VK_NULL_HANDLE ? &pipelineInfo : nullptr;
+                generatedCommandsInfo.shaderStages              = pLayout->shaderStages;
+                generatedCommandsInfo.indirectExecutionSet      = pLayout->executionSet;
+                generatedCommandsInfo.indirectCommandsLayout    = pLayout->layout;
+                generatedCommandsInfo.indirectAddress           = pArgumentBuffer->deviceAddress + pExecuteCommand->argumentBufferOffset;
+                generatedCommandsInfo.indirectAddressSize       = (VkDeviceSize)pExecuteCommand->maxSequenceCount * pLayout->indirectStride;
+                generatedCommandsInfo.preprocessAddress         = pState->generatedCommandsPreprocessAddress + preprocessOffset;
+                generatedCommandsInfo.preprocessSize            = pLayout->preprocessSize;
+                generatedCommandsInfo.maxSequenceCount          = pExecuteCommand->maxSequenceCount;
+                if( pCountBuffer != nullptr )
+                {
+                    KEEN_ASSERT( pCountBuffer->deviceAddress != 0u );
+                    generatedCommandsInfo.sequenceCountAddress  = pCountBuffer->deviceAddress + pExecuteCommand->countBufferOffset;
+                }
+                generatedCommandsInfo.maxDrawCount              = 0u;
+
+#if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
+                VulkanBreadcrumbScope breadcrumb( pState->pBreadcrumbBuffer, pVulkan, commandBuffer, VulkanBreadcrumbType::ExecuteGeneratedCommands, pLayout->getDebugName() );
+#endif
+
+                // :JK: the bound pipeline (and the state touched by the tokens) is undefined after this - rebind before the next draw
+                pVulkan->vkCmdExecuteGeneratedCommandsEXT( commandBuffer, VK_FALSE, &generatedCommandsInfo );
+            }
+            break;
+
 #if KEEN_USING( KEEN_GRAPHICS_DEBUG_CODE )
         case GraphicsCommandId_BeginDebugLabel:
             {
@@ -750,6 +1317,54 @@ namespace keen
             }
             break;
 
+        case GraphicsCommandId_BeginQuery:
+            {
+                const GraphicsBeginQueryCommand* pQueryCommand = (const GraphicsBeginQueryCommand*)pCommand;
+                VulkanQueryPool* pQueryPool = (VulkanQueryPool*)pQueryCommand->pQueryPool;
+                KEEN_ASSERT( pQueryPool->queryType == VK_QUERY_TYPE_OCCLUSION );
+
+                // :JK: non-precise queries only guarantee zero/non-zero results but are cheaper on some hardware. without
+                // GraphicsFeature::PreciseOcclusionQuery the precise bit is invalid - the query falls back to a non-precise one
+                const bool isPrecise = pQueryCommand->isPrecise && pState->isPreciseOcclusionQuerySupported;
+                const VkQueryControlFlags controlFlags = isPrecise ? VK_QUERY_CONTROL_PRECISE_BIT : 0u;
+
+                pVulkan->vkCmdBeginQuery( commandBuffer, pQueryPool->queryPool, pQueryCommand->queryIndex, controlFlags );
+            }
+            break;
+
+        case GraphicsCommandId_EndQuery:
+            {
+                const GraphicsEndQueryCommand* pQueryCommand = (const GraphicsEndQueryCommand*)pCommand;
+                VulkanQueryPool* pQueryPool = (VulkanQueryPool*)pQueryCommand->pQueryPool;
+                KEEN_ASSERT( pQueryPool->queryType == VK_QUERY_TYPE_OCCLUSION );
+
+                pVulkan->vkCmdEndQuery( commandBuffer, pQueryPool->queryPool, pQueryCommand->queryIndex );
+            }
+            break;
+
+        case GraphicsCommandId_BeginConditionalRendering:
+            {
+                const GraphicsBeginConditionalRenderingCommand* pConditionalRenderingCommand = (const GraphicsBeginConditionalRenderingCommand*)pCommand;
+                const VulkanBuffer* pPredicateBuffer = (const VulkanBuffer*)pConditionalRenderingCommand->pBuffer;
+                KEEN_ASSERT( pVulkan->EXT_conditional_rendering );
+                KEEN_ASSERT( ( pConditionalRenderingCommand->offset & 3u ) == 0u );
+
+                // draws and dispatches until the end of the scope are discarded if the 32 bit predicate at offset is zero (non-zero if inverted)
+                VkConditionalRenderingBeginInfoEXT beginInfo{ VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT };
+                beginInfo.buffer    = pPredicateBuffer->buffer;
+                beginInfo.offset    = pConditionalRenderingCommand->offset;
+                beginInfo.flags     = pConditionalRenderingCommand->isInverted ? VK_CONDITIONAL_RENDERING_INVERTED_BIT_EXT : 0u;
+                pVulkan->vkCmdBeginConditionalRenderingEXT( commandBuffer, &beginInfo );
+            }
+            break;
+
+        case GraphicsCommandId_EndConditionalRendering:
+            {
+                KEEN_ASSERT( pVulkan->EXT_conditional_rendering );
+                pVulkan->vkCmdEndConditionalRenderingEXT( commandBuffer );
+            }
+            break;
+
         case GraphicsCommandId_CopyQueryResults:
             {
                 const GraphicsCopyQueryResultsCommand* pCopyQueryResultsCommand = (const GraphicsCopyQueryResultsCommand*)pCommand;
@@ -772,10 +1387,16 @@ namespace keen
 #endif
                 breadcrumbRenderpassHint( pState->pBreadcrumbBuffer, true );
 
+                // folded clears and merged scopes replace the load and store actions:
+                const VulkanRenderingScopePatch* pPatch = pState->pRenderingScopePatch;
+                const GraphicsRenderingAttachmentInfo* pColorAttachments    = pPatch != nullptr ? pPatch->colorAttachments : pBeginRenderingCommand->colorAttachments;
+                const GraphicsRenderingAttachmentInfo& depthAttachment      = pPatch != nullptr ? pPatch->depthAttachment : pBeginRenderingCommand->depthAttachment;
+                const GraphicsRenderingAttachmentInfo& stencilAttachment    = pPatch != nullptr ? pPatch->stencilAttachment : pBeginRenderingCommand->stencilAttachment;
+
                 VkRenderingAttachmentInfo colorAttachmentInfos[ GraphicsLimits_MaxColorTargetCount ];
                 for( uint32 i = 0u; i < pBeginRenderingCommand->colorAttachmentCount; ++i )
                 {
-                    const GraphicsRenderingAttachmentInfo& colorAttachment = pBeginRenderingCommand->colorAttachments[ i ];
+                    const GraphicsRenderingAttachmentInfo& colorAttachment = pColorAttachments[ i ];
                     const VulkanTexture* pTexture = (const VulkanTexture*)colorAttachment.pTexture;
                     const VulkanTexture* pResolveTexture = (const VulkanTexture*)colorAttachment.pResolveTexture;
 
@@ -802,31 +1423,42 @@ namespace keen
                     colorAttachmentInfos[ i ].clearValue.color = vulkan::getColorClearValue( colorAttachment.clearValue.color );
                 }
 
-                //const GraphicsRectangle renderArea = pBeginRenderingCommand->renderArea;
+                const GraphicsRectangle renderArea = pBeginRenderingCommand->renderArea;
 
                 VkRenderingInfo renderingInfo{ VK_STRUCTURE_TYPE_RENDERING_INFO };
-                renderingInfo.renderArea.offset     = { 0u, 0u };
-                renderingInfo.renderArea.extent     = { pBeginRenderingCommand->renderSize.x, pBeginRenderingCommand->renderSize.y };
-                renderingInfo.layerCount            = 1u;
+                if( renderArea.width == 0u || renderArea.height == 0u )
+                {
+                    renderingInfo.renderArea.offset = { 0u, 0u };
+                    renderingInfo.renderArea.extent = { pBeginRenderingCommand->renderSize.x, pBeginRenderingCommand->renderSize.y };
+                }
+                else
+                {
+                    KEEN_ASSERT( renderArea.x >= 0 && renderArea.y >= 0 );
+                    KEEN_ASSERT( (uint32)renderArea.x + renderArea.width <= pBeginRenderingCommand->renderSize.x && (uint32)renderArea.y + renderArea.height <= pBeginRenderingCommand->renderSize.y );
+                    renderingInfo.renderArea.offset = { renderArea.x, renderArea.y };
+                    renderingInfo.renderArea.extent = { renderArea.width, renderArea.height };
+                }
+                renderingInfo.layerCount            = max( pBeginRenderingCommand->layerCount, 1u );
+                renderingInfo.viewMask              = pBeginRenderingCommand->viewMask;
                 renderingInfo.colorAttachmentCount  = pBeginRenderingCommand->colorAttachmentCount;
                 renderingInfo.pColorAttachments     = colorAttachmentInfos;
 
                 VkRenderingAttachmentInfo depthAttachmentInfo;
-                if( pBeginRenderingCommand->depthAttachment.pTexture != nullptr )
+                if( depthAttachment.pTexture != nullptr )
                 {
-                    const VulkanTexture* pDepthImage = (const VulkanTexture*)pBeginRenderingCommand->depthAttachment.pTexture;
-                    const VulkanTexture* pDepthResolveImage = (const VulkanTexture*)pBeginRenderingCommand->depthAttachment.pResolveTexture;
+                    const VulkanTexture* pDepthImage = (const VulkanTexture*)depthAttachment.pTexture;
+                    const VulkanTexture* pDepthResolveImage = (const VulkanTexture*)depthAttachment.pResolveTexture;
 
                     depthAttachmentInfo.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
                     depthAttachmentInfo.pNext       = nullptr;
                     depthAttachmentInfo.imageView   = pDepthImage->imageView;
-                    depthAttachmentInfo.imageLayout = vulkan::getImageLayout( pBeginRenderingCommand->depthAttachment.textureLayout );
+                    depthAttachmentInfo.imageLayout = vulkan::getImageLayout( depthAttachment.textureLayout );
 
                     if( pDepthResolveImage != nullptr )
                     {
                         depthAttachmentInfo.resolveMode         = VK_RESOLVE_MODE_MIN_BIT;
                         depthAttachmentInfo.resolveImageView    = pDepthResolveImage->imageView;
-                        depthAttachmentInfo.resolveImageLayout  = vulkan::getImageLayout( pBeginRenderingCommand->depthAttachment.resolveTextureLayout );
+                        depthAttachmentInfo.resolveImageLayout  = vulkan::getImageLayout( depthAttachment.resolveTextureLayout );
                     }
                     else
                     {
@@ -834,32 +1466,32 @@ namespace keen
                         depthAttachmentInfo.resolveImageView    = VK_NULL_HANDLE;
                         depthAttachmentInfo.resolveImageLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
                     }
-                    depthAttachmentInfo.loadOp  = vulkan::getLoadOp( pBeginRenderingCommand->depthAttachment.loadAction );
-                    depthAttachmentInfo.storeOp = vulkan::getStoreOp( pBeginRenderingCommand->depthAttachment.storeAction );
+                    depthAttachmentInfo.loadOp  = vulkan::getLoadOp( depthAttachment.loadAction );
+                    depthAttachmentInfo.storeOp = vulkan::getStoreOp( depthAttachment.storeAction );
 
-                    depthAttachmentInfo.clearValue.depthStencil = vulkan::getDepthStencilClearValue( pBeginRenderingCommand->depthAttachment.clearValue.depth, 0 );
+                    depthAttachmentInfo.clearValue.depthStencil = vulkan::getDepthStencilClearValue( depthAttachment.clearValue.depth, 0 );
                     renderingInfo.pDepthAttachment = &depthAttachmentInfo;
                 }
 
                 VkRenderingAttachmentInfo stencilAttachmentInfo;
-                if( pBeginRenderingCommand->stencilAttachment.pTexture != nullptr )
+                if( stencilAttachment.pTexture != nullptr )
                 {
                     // :FK: :NOTE: No vulkan hardware supports separate depth stencil attachments
-                    KEEN_ASSERT( pBeginRenderingCommand->depthAttachment.pTexture == nullptr || pBeginRenderingCommand->stencilAttachment.pTexture == pBeginRenderingCommand->depthAttachment.pTexture );
+                    KEEN_ASSERT( depthAttachment.pTexture == nullptr || stencilAttachment.pTexture == depthAttachment.pTexture );
 
-                    const VulkanTexture* pStencilImage = (const VulkanTexture*)pBeginRenderingCommand->stencilAttachment.pTexture;
-                    const VulkanTexture* pStencilResolveImage = (const VulkanTexture*)pBeginRenderingCommand->stencilAttachment.pResolveTexture;
+                    const VulkanTexture* pStencilImage = (const VulkanTexture*)stencilAttachment.pTexture;
+                    const VulkanTexture* pStencilResolveImage = (const VulkanTexture*)stencilAttachment.pResolveTexture;
 
                     stencilAttachmentInfo.sType         = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
                     stencilAttachmentInfo.pNext         = nullptr;
                     stencilAttachmentInfo.imageView     = pStencilImage->imageView;
-                    stencilAttachmentInfo.imageLayout   = vulkan::getImageLayout( pBeginRenderingCommand->stencilAttachment.textureLayout );
+                    stencilAttachmentInfo.imageLayout   = vulkan::getImageLayout( stencilAttachment.textureLayout );
 
                     if( pStencilResolveImage != nullptr )
                     {
                         stencilAttachmentInfo.resolveMode           = VK_RESOLVE_MODE_MIN_BIT;
                         stencilAttachmentInfo.resolveImageView      = pStencilResolveImage->imageView;
-                        stencilAttachmentInfo.resolveImageLayout    = vulkan::getImageLayout( pBeginRenderingCommand->stencilAttachment.resolveTextureLayout );
+                        stencilAttachmentInfo.resolveImageLayout    = vulkan::getImageLayout( stencilAttachment.resolveTextureLayout );
                     }
                     else
                     {
@@ -867,15 +1499,50 @@ namespace keen
                         stencilAttachmentInfo.resolveImageView      = VK_NULL_HANDLE;
                         stencilAttachmentInfo.resolveImageLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
                     }
-                    stencilAttachmentInfo.loadOp    = vulkan::getLoadOp( pBeginRenderingCommand->stencilAttachment.loadAction );
-                    stencilAttachmentInfo.storeOp   = vulkan::getStoreOp( pBeginRenderingCommand->stencilAttachment.storeAction );
+                    stencilAttachmentInfo.loadOp    = vulkan::getLoadOp( stencilAttachment.loadAction );
+                    stencilAttachmentInfo.storeOp   = vulkan::getStoreOp( stencilAttachment.storeAction );
 
-                    stencilAttachmentInfo.clearValue.depthStencil = vulkan::getDepthStencilClearValue( GraphicsDepthClearValue::Zero, pBeginRenderingCommand->stencilAttachment.clearValue.stencil );
+                    stencilAttachmentInfo.clearValue.depthStencil = vulkan::getDepthStencilClearValue( GraphicsDepthClearValue::Zero, stencilAttachment.clearValue.stencil );
 
                     renderingInfo.pStencilAttachment = &stencilAttachmentInfo;
                 }
 
+                VkRenderingFragmentShadingRateAttachmentInfoKHR shadingRateAttachmentInfo{ VK_STRUCTURE_TYPE_RENDERING_FRAGMENT_SHADING_RATE_ATTACHMENT_INFO_KHR };
+                if( pBeginRenderingCommand->shadingRateAttachment.pTexture != nullptr )
+                {
+                    KEEN_ASSERT( pVulkan->KHR_fragment_shading_rate );
+
+                    const VulkanTexture* pShadingRateImage = (const VulkanTexture*)pBeginRenderingCommand->shadingRateAttachment.pTexture;
+
+                    shadingRateAttachmentInfo.imageView                         = pShadingRateImage->imageView;
+                    shadingRateAttachmentInfo.imageLayout                       = vulkan::getImageLayout( pBeginRenderingCommand->shadingRateAttachment.textureLayout );
+                    shadingRateAttachmentInfo.shadingRateAttachmentTexelSize    = vulkan::createExtent2d( pBeginRenderingCommand->shadingRateAttachment.texelSize.x, pBeginRenderingCommand->shadingRateAttachment.texelSize.y );
+                    renderingInfo.pNext = &shadingRateAttachmentInfo;
+                }
+
                 pVulkan->vkCmdBeginRenderingKHR( commandBuffer, &renderingInfo );
+
+                // the default mapping reads color attachment i as input attachment i - only set if the scope wants something else:
+                if( pBeginRenderingCommand->inputAttachmentIndices.isEnabled )
+                {
+                    KEEN_ASSERT( pVulkan->KHR_dynamic_rendering_local_read );
+
+                    VkRenderingInputAttachmentIndexInfoKHR inputAttachmentIndexInfo;
+                    uint32 colorInputAttachmentIndices[ GraphicsLimits_MaxColorTargetCount ];
+                    uint32 depthInputAttachmentIndex;
+                    uint32 stencilInputAttachmentIndex;
+                    vulkan::fillRenderingInputAttachmentIndexInfo( &inputAttachmentIndexInfo, colorInputAttachmentIndices, &depthInputAttachmentIndex, &stencilInputAttachmentIndex, pBeginRenderingCommand->inputAttachmentIndices, pBeginRenderingCommand->colorAttachmentCount );
+                    pVulkan->vkCmdSetRenderingInputAttachmentIndicesKHR( commandBuffer, &inputAttachmentIndexInfo );
+                }
+            }
+            break;
+
+        case GraphicsCommandId_RenderingLocalReadBarrier:
+            {
+                const GraphicsRenderingLocalReadBarrierCommand* pLocalReadBarrierCommand = (const GraphicsRenderingLocalReadBarrierCommand*)pCommand;
+
+                KEEN_ASSERT( pVulkan->KHR_dynamic_rendering_local_read );
+                vulkan::writeRenderingLocalReadBarrier( pVulkan, commandBuffer, pLocalReadBarrierCommand->colorAttachments, pLocalReadBarrierCommand->depthStencilAttachment );
             }
             break;
 
@@ -3,10 +3,13 @@
 
 #include "keen/base/small_dynamic_array.hpp"
 #include "vulkan_types.hpp"
+#include "vulkan_transfer_coalescer.hpp"
 
 namespace keen
 {
     struct VulkanBreadcrumbBuffer;
+    struct VulkanRenderingScopeRewrite;
+    struct VulkanRenderingScopePatch;
 
     struct VulkanReadCommandBufferState
     {
@@ -23,6 +26,10 @@ namespace keen
         VulkanBreadcrumbBuffer* pBreadcrumbBuffer = nullptr;
         VkDescriptorSet         bindlessDescriptorSet = VK_NULL_HANDLE;
         VkDescriptorSet         emptyDescriptorSet = VK_NULL_HANDLE;
+        VkDeviceAddress         generatedCommandsPreprocessAddress = 0u;
+        uint64                  generatedCommandsPreprocessSize = 0u;
+        uint64*                 pGeneratedCommandsPreprocessUsedSize = nullptr;     // shared by all command buffers of the frame - the executes allocate their range from it
+        VulkanTransferCoalescingStatistics* pTransferStatistics = nullptr;  // optional - the saved calls are added to it
     };
 
     struct VulkanRecordCommandBufferState
@@ -35,8 +42,22 @@ namespace keen
         VulkanQueueInfos                    queueInfos{};
         VkDescriptorSet                     bindlessDescriptorSet = VK_NULL_HANDLE;
         VkDescriptorSet                     emptyDescriptorSet = VK_NULL_HANDLE;
+        VkDeviceAddress                     generatedCommandsPreprocessAddress = 0u;
+        uint64                              generatedCommandsPreprocessSize = 0u;
+        uint64*                             pGeneratedCommandsPreprocessUsedSize = nullptr;
 
         GraphicsOptionalShaderStageMask     shaderStageMask;
+        bool                                isPreciseOcclusionQuerySupported = false;
+        VulkanDynamicStateFeatureMask       dynamicStateFeatures;       // of the bound render pipeline
+        bool                                hasDynamicVertexStrides = false;
+        uint32                              vertexStreamStrides[ GraphicsLimits_MaxVertexStreamCount ] = {};  // of the bound render pipeline - used for streams bound without a stride
+
+        const VulkanRenderingScopeRewrite*  pRenderingScopeRewrite = nullptr;   // optional - one entry per command of the stream
+        uint32                              streamCommandIndex = 0u;
+        const VulkanRenderingScopePatch*    pRenderingScopePatch = nullptr;     // of the BeginRendering command that is currently written
+
+        VulkanTransferCoalescingStatistics  transferStatistics;
+        VulkanTransferCoalescingStatistics* pTransferStatistics = nullptr;
 #if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
         VulkanBreadcrumbBuffer*             pBreadcrumbBuffer = nullptr;
 #endif
@@ -55,6 +76,9 @@ namespace keen
 
         void        recordCommandBuffer( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, const GraphicsCommandBuffer* pCommandBuffer, const VulkanRecordCommandBufferParameters& parameters );
 
+        // key of the cached recording: the command data and the generations of the referenced objects (see combineCommandBufferKey):
+        uint64      computeCommandBufferKey( const GraphicsCommandBuffer* pCommandBuffer );
+
         void        beginCommandBufferRecording( VulkanRecordCommandBufferState* pState, const GraphicsCommandBuffer* pCommandBuffer, const VulkanRecordCommandBufferParameters& parameters );
         bool        recordNextCommand( VulkanRecordCommandBufferState* pState, VulkanApi* pVulkan, VkCommandBuffer commandBuffer );
         void        endCommandBufferRecording( VulkanRecordCommandBufferState* pState );
@@ -0,0 +1,218 @@
+#include "vulkan_command_buffer_key.hpp"
+#include "vulkan_types.hpp"
+#include "../global/graphics_command_buffer.hpp"
+
+namespace keen
+{
+
+    static uint64 combineKey( uint64 key, uint64 value )
+    {
+        // fnv1a style combine:
+        return ( key ^ value ) * 0x100000001b3ull;
+    }
+
+    template<typename T>
+    static uint64 combineObjectGeneration( uint64 key, const void* pObject )
+    {
+        if( pObject == nullptr )
+        {
+            return key;
+        }
+        return combineKey( key, static_cast<const T*>( pObject )->objectGeneration );
+    }
+
+    static uint64 combineAttachmentGenerations( uint64 key, const GraphicsRenderingAttachmentInfo& attachment )
+    {
+        key = combineObjectGeneration<VulkanTexture>( key, attachment.pTexture );
+        key = combineObjectGeneration<VulkanTexture>( key, attachment.pResolveTexture );
+        return key;
+    }
+
+    static uint64 combineDescriptorSetGenerations( uint64 key, const GraphicsBindDescriptorSetsCommand* pCommand )
+    {
+        key = combineObjectGeneration<VulkanPipelineLayout>( key, pCommand->pPipelineLayout );
+        for( size_t i = 0u; i < pCommand->descriptorSetCount; ++i )
+        {
+            key = combineObjectGeneration<VulkanDescriptorSet>( key, pCommand->descriptorSets[ i ] );
+        }
+        return key;
+    }
+
+    static uint64 combineTextureArrayGenerations( uint64 key, const GraphicsTexture* const* ppTextures, size_t textureCount )
+    {
+        for( size_t i = 0u; i < textureCount; ++i )
+        {
+            key = combineObjectGeneration<VulkanTexture>( key, ppTextures[ i ] );
+        }
+        return key;
+    }
+
+    uint64 vulkan::combineCommandBufferKey( uint64 key, const GraphicsCommand* pCommand )
+    {
+        key = combineKey( key, calculateFnv1a64Hash( pCommand, pCommand->sizeInBytes ).value );
+
+        // :JK: keep this in sync with writeVulkanCommand - every object that ends up in the recording has to be part of the key
+        switch( pCommand->id )
+        {
+        case GraphicsCommandId_BindRenderPipeline:
+            return combineObjectGeneration<VulkanRenderPipeline>( key, ( (const GraphicsBindRenderPipelineCommand*)pCommand )->pRenderPipeline );
+
+        case GraphicsCommandId_BindComputePipeline:
+            return combineObjectGeneration<VulkanComputePipeline>( key, ( (const GraphicsBindComputePipelineCommand*)pCommand )->pComputePipeline );
+
+        case GraphicsCommandId_DispatchIndirect:
+            return combineObjectGeneration<VulkanBuffer>( key, ( (const GraphicsDispatchIndirectCommand*)pCommand )->pParametersBuffer );
+
+        case GraphicsCommandId_FillBuffer:
+            return combineObjectGeneration<VulkanBuffer>( key, ( (const GraphicsFillBufferCommand*)pCommand )->pBuffer );
+
+        case GraphicsCommandId_CopyBuffer:
+            {
+                const GraphicsCopyBufferCommand* pCopyCommand = (const GraphicsCopyBufferCommand*)pCommand;
+                key = combineObjectGeneration<VulkanBuffer>( key, pCopyCommand->pSourceBuffer );
+                return combineObjectGeneration<VulkanBuffer>( key, pCopyCommand->pTargetBuffer );
+            }
+
+        case GraphicsCommandId_CopyTexture:
+            {
+                const GraphicsCopyTextureCommand* pCopyCommand = (const GraphicsCopyTextureCommand*)pCommand;
+                key = combineObjectGeneration<VulkanTexture>( key, pCopyCommand->pSourceTexture );
+                return combineObjectGeneration<VulkanTexture>( key, pCopyCommand->pTargetTexture );
+            }
+
+        case GraphicsCommandId_CopyBufferToTexture:
+            {
+                const GraphicsCopyBufferToTextureCommand* pCopyCommand = (const GraphicsCopyBufferToTextureCommand*)pCommand;
+                key = combineObjectGeneration<VulkanBuffer>( key, pCopyCommand->pSourceBuffer );
+                return combineObjectGeneration<VulkanTexture>( key, pCopyCommand->pTargetTexture );
+            }
+
+        case GraphicsCommandId_CopyTextureToBuffer:
+            {
+                const GraphicsCopyTextureToBufferCommand* pCopyCommand = (const GraphicsCopyTextureToBufferCommand*)pCommand;
+                key = combineObjectGeneration<VulkanTexture>( key, pCopyCommand->pSourceTexture );
+                return combineObjectGeneration<VulkanBuffer>( key, pCopyCommand->pTargetBuffer );
+            }
+
+        case GraphicsCommandId_ClearColorTexture:
+            return combineObjectGeneration<VulkanTexture>( key, ( (const GraphicsClearColorTextureCommand*)pCommand )->pTexture );
+
+        case GraphicsCommandId_ClearDepthTexture:
+            return combineObjectGeneration<VulkanTexture>( key, ( (const GraphicsClearDepthTextureCommand*)pCommand )->pTexture );
+
+        case GraphicsCommandId_GenerateMips:
+            return combineObjectGeneration<VulkanTexture>( key, ( (const GraphicsGenerateMipsCommand*)pCommand )->pTexture );
+
+        case GraphicsCommandId_PipelineBarrier:
+            {
+                // the textures follow the command (see writePipelineBarrier):
+                const GraphicsPipelineBarrierCommand* pBarrierCommand = (const GraphicsPipelineBarrierCommand*)pCommand;
+                const GraphicsTexture* const* ppTextures = pointer_cast<const GraphicsTexture* const>( (const uint8*)pCommand + alignUp( sizeof( GraphicsPipelineBarrierCommand ), sizeof( void* ) ) );
+                return combineTextureArrayGenerations( key, ppTextures, pBarrierCommand->textureBarrierCount );
+            }
+
+        case GraphicsCommandId_QueueOwnershipTransfer:
+            {
+                // the textures follow the command (see writeQueueOwnershipTransfer):
+                const GraphicsQueueOwnershipTransferCommand* pTransferCommand = (const GraphicsQueueOwnershipTransferCommand*)pCommand;
+                return combineTextureArrayGenerations( key, (const GraphicsTexture* const*)( pTransferCommand + 1u ), pTransferCommand->imageBarrierCount );
+            }
+
+        case GraphicsCommandId_BindRenderDescriptorSets:
+        case GraphicsCommandId_BindComputeDescriptorSets:
+            return combineDescriptorSetGenerations( key, (const GraphicsBindDescriptorSetsCommand*)pCommand );
+
+        case GraphicsCommandId_BindRenderDescriptorSetsWithOffsets:
+        case GraphicsCommandId_BindComputeDescriptorSetsWithOffsets:
+            return combineDescriptorSetGenerations( key, &( (const GraphicsBindDescriptorSetsWithOffsetsCommand*)pCommand )->sets );
+
+        case GraphicsCommandId_PushConstants:
+            return combineObjectGeneration<VulkanPipelineLayout>( key, ( (const GraphicsPushConstantsCommand*)pCommand )->pPipelineLayout );
+
+        case GraphicsCommandId_BindVertexBuffer:
+            return combineObjectGeneration<VulkanBuffer>( key, ( (const GraphicsBindVertexBufferCommand*)pCommand )->vertexBuffer.pBuffer );
+
+        case GraphicsCommandId_BindVertexBuffers:
+            {
+                // the streams follow the command:
+                const GraphicsBindVertexBuffersCommand* pBindCommand = (const GraphicsBindVertexBuffersCommand*)pCommand;
+                const GraphicsStridedBufferRange* pStreams = (const GraphicsStridedBufferRange*)( ( (const uint8*)pBindCommand ) + sizeof( GraphicsBindVertexBuffersCommand ) );
+                for( uint32 i = 0u; i < pBindCommand->streamCount; ++i )
+                {
+                    key = combineObjectGeneration<VulkanBuffer>( key, pStreams[ i ].pBuffer );
+                }
+                return key;
+            }
+
+        case GraphicsCommandId_BindIndexBuffer:
+            return combineObjectGeneration<VulkanBuffer>( key, ( (const GraphicsBindIndexBufferCommand*)pCommand )->indexBuffer.pBuffer );
+
+        case GraphicsCommandId_DrawIndirect:
+            return combineObjectGeneration<VulkanBuffer>( key, ( (const GraphicsDrawIndirectCommand*)pCommand )->pParametersBuffer );
+
+        case GraphicsCommandId_DrawIndirectCount:
+            {
+                const GraphicsDrawIndirectCountCommand* pDrawCommand = (const GraphicsDrawIndirectCountCommand*)pCommand;
+                key = combineObjectGeneration<VulkanBuffer>( key, pDrawCommand->pParametersBuffer );
+                return combineObjectGeneration<VulkanBuffer>( key, pDrawCommand->pCountBuffer );
+            }
+
+        case GraphicsCommandId_DrawMeshTasksIndirect:
+            return combineObjectGeneration<VulkanBuffer>( key, ( (const GraphicsDrawMeshTasksIndirectCommand*)pCommand )->pParametersBuffer );
+
+        case GraphicsCommandId_DrawMeshTasksIndirectCount:
+            {
+                const GraphicsDrawMeshTasksIndirectCountCommand* pDrawCommand = (const GraphicsDrawMeshTasksIndirectCountCommand*)pCommand;
+                key = combineObjectGeneration<VulkanBuffer>( key, pDrawCommand->pParametersBuffer );
+                return combineObjectGeneration<VulkanBuffer>( key, pDrawCommand->pCountBuffer );
+            }
+
+        case GraphicsCommandId_ExecuteGeneratedCommands:
+            {
+                const GraphicsExecuteGeneratedCommandsCommand* pExecuteCommand = (const GraphicsExecuteGeneratedCommandsCommand*)pCommand;
+                key = combineObjectGeneration<VulkanIndirectCommandsLayout>( key, pExecuteCommand->pIndirectCommandsLayout );
+                key = combineObjectGeneration<VulkanBuffer>( key, pExecuteCommand->pArgumentBuffer );
+                return combineObjectGeneration<VulkanBuffer>( key, pExecuteCommand->pCountBuffer );
+            }
+
+        case GraphicsCommandId_ResetQueryPool:
+            return combineObjectGeneration<VulkanQueryPool>( key, ( (const GraphicsResetQueryPoolCommand*)pCommand )->pQueryPool );
+
+        case GraphicsCommandId_WriteTimestampQuery:
+            return combineObjectGeneration<VulkanQueryPool>( key, ( (const GraphicsWriteTimestampQueryCommand*)pCommand )->pQueryPool );
+
+        case GraphicsCommandId_BeginQuery:
+            return combineObjectGeneration<VulkanQueryPool>( key, ( (const GraphicsBeginQueryCommand*)pCommand )->pQueryPool );
+
+        case GraphicsCommandId_EndQuery:
+            return combineObjectGeneration<VulkanQueryPool>( key, ( (const GraphicsEndQueryCommand*)pCommand )->pQueryPool );
+
+        case GraphicsCommandId_CopyQueryResults:
+            {
+                const GraphicsCopyQueryResultsCommand* pCopyCommand = (const GraphicsCopyQueryResultsCommand*)pCommand;
+                key = combineObjectGeneration<VulkanQueryPool>( key, pCopyCommand->pQueryPool );
+                return combineObjectGeneration<VulkanBuffer>( key, pCopyCommand->pTargetBuffer );
+            }
+
+        case GraphicsCommandId_BeginConditionalRendering:
+            return combineObjectGeneration<VulkanBuffer>( key, ( (const GraphicsBeginConditionalRenderingCommand*)pCommand )->pBuffer );
+
+        case GraphicsCommandId_BeginRendering:
+            {
+                const GraphicsBeginRenderingCommand* pBeginRenderingCommand = (const GraphicsBeginRenderingCommand*)pCommand;
+                for( uint32 i = 0u; i < pBeginRenderingCommand->colorAttachmentCount; ++i )
+                {
+                    key = combineAttachmentGenerations( key, pBeginRenderingCommand->colorAttachments[ i ] );
+                }
+                key = combineAttachmentGenerations( key, pBeginRenderingCommand->depthAttachment );
+                key = combineAttachmentGenerations( key, pBeginRenderingCommand->stencilAttachment );
+                return combineObjectGeneration<VulkanTexture>( key, pBeginRenderingCommand->shadingRateAttachment.pTexture );
+            }
+
+        default:
+            // no object references:
+            return key;
+        }
+    }
+
+}
@@ -0,0 +1,22 @@
+#ifndef KEEN_VULKAN_COMMAND_BUFFER_KEY_HPP_INCLUDED
+#define KEEN_VULKAN_COMMAND_BUFFER_KEY_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+
+namespace keen
+{
+    struct GraphicsCommand;
+
+    namespace vulkan
+    {
+
+        // key of a cached command buffer: the raw command data (objects are referenced by address) plus the generation of every object the
+        // command references. A new object that reuses the address of a destroyed one has a new generation - so only the cached command
+        // buffers that referenced the destroyed object get recorded again.
+        uint64      combineCommandBufferKey( uint64 key, const GraphicsCommand* pCommand );
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,135 @@
+#include "vulkan_command_buffer_key.hpp"
+#include "vulkan_types.hpp"
+#include "../global/graphics_command_buffer.hpp"
+
+#include "keen/base/unit_test.hpp"
+
+
+namespace keen
+{
+    class VulkanCommandBufferKeyTestFixture : public UnitTest
+    {
+    public:
+        VulkanCommandBufferKeyTestFixture()
+        {
+            // :JK: only the generations are read - the objects don't need any vulkan handles
+            zeroValue( &m_indexBuffer );
+            zeroValue( &m_vertexBuffer );
+            zeroValue( &m_colorTexture );
+            zeroValue( &m_depthTexture );
+            m_indexBuffer.objectGeneration  = 1u;
+            m_vertexBuffer.objectGeneration = 2u;
+            m_colorTexture.objectGeneration = 3u;
+            m_depthTexture.objectGeneration = 4u;
+        }
+
+    protected:
+        VulkanBuffer                    m_indexBuffer;
+        VulkanBuffer                    m_vertexBuffer;
+        VulkanTexture                   m_colorTexture;
+        VulkanTexture                   m_depthTexture;
+
+        void fillBindIndexBufferCommand( GraphicsBindIndexBufferCommand* pCommand, uint64 offset )
+        {
+            *pCommand = {};
+            pCommand->id                    = GraphicsCommandId_BindIndexBuffer;
+            pCommand->sizeInBytes           = sizeof( GraphicsBindIndexBufferCommand );
+            pCommand->indexBuffer.pBuffer   = &m_indexBuffer;
+            pCommand->indexBuffer.offset    = offset;
+        }
+
+        void fillBeginRenderingCommand( GraphicsBeginRenderingCommand* pCommand )
+        {
+            *pCommand = {};
+            pCommand->id                                = GraphicsCommandId_BeginRendering;
+            pCommand->sizeInBytes                       = sizeof( GraphicsBeginRenderingCommand );
+            pCommand->renderSize                        = { 1280u, 720u };
+            pCommand->layerCount                        = 1u;
+            pCommand->colorAttachmentCount              = 1u;
+            pCommand->colorAttachments[ 0u ].pTexture   = &m_colorTexture;
+            pCommand->depthAttachment.pTexture          = &m_depthTexture;
+        }
+
+        static uint64 computeKey( const GraphicsCommand* pCommand )
+        {
+            return vulkan::combineCommandBufferKey( 0u, pCommand );
+        }
+    };
+
+    KEEN_UNIT_TEST_F( VulkanCommandBufferKeyTestFixture, testCommandDataKey )
+    {
+        GraphicsBindIndexBufferCommand command;
+        fillBindIndexBufferCommand( &command, 0u );
+        const uint64 key = computeKey( &command );
+
+        // the same content gives the same key:
+        GraphicsBindIndexBufferCommand otherCommand;
+        fillBindIndexBufferCommand( &otherCommand, 0u );
+        KEEN_UT_CHECK( computeKey( &otherCommand ) == key );
+
+        fillBindIndexBufferCommand( &otherCommand, 256u );
+        KEEN_UT_CHECK( computeKey( &otherCommand ) != key );
+
+        // a different object is a different address:
+        fillBindIndexBufferCommand( &otherCommand, 0u );
+        otherCommand.indexBuffer.pBuffer = &m_vertexBuffer;
+        KEEN_UT_CHECK( computeKey( &otherCommand ) != key );
+
+        // the key depends on the order of the commands:
+        KEEN_UT_CHECK( vulkan::combineCommandBufferKey( computeKey( &command ), &otherCommand ) != vulkan::combineCommandBufferKey( computeKey( &otherCommand ), &command ) );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanCommandBufferKeyTestFixture, testRecreatedObjectChangesKey )
+    {
+        GraphicsBindIndexBufferCommand command;
+        fillBindIndexBufferCommand( &command, 0u );
+        const uint64 key = computeKey( &command );
+
+        // the buffer was destroyed and a new one got the same address - so the old recording references a dead VkBuffer:
+        m_indexBuffer.objectGeneration = 5u;
+        KEEN_UT_CHECK( computeKey( &command ) != key );
+
+        // objects that are not referenced don't matter:
+        m_indexBuffer.objectGeneration  = 1u;
+        m_vertexBuffer.objectGeneration = 6u;
+        m_colorTexture.objectGeneration = 7u;
+        KEEN_UT_CHECK( computeKey( &command ) == key );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanCommandBufferKeyTestFixture, testRenderingAttachmentGenerations )
+    {
+        GraphicsBeginRenderingCommand command;
+        fillBeginRenderingCommand( &command );
+        const uint64 key = computeKey( &command );
+
+        m_depthTexture.objectGeneration = 8u;
+        const uint64 depthKey = computeKey( &command );
+        KEEN_UT_CHECK( depthKey != key );
+
+        m_colorTexture.objectGeneration = 9u;
+        KEEN_UT_CHECK( computeKey( &command ) != depthKey );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanCommandBufferKeyTestFixture, testVertexStreamGenerations )
+    {
+        // the streams follow the command:
+        uint64 commandStorage[ 32u ];
+        zeroValue( &commandStorage );
+        GraphicsBindVertexBuffersCommand* pCommand = (GraphicsBindVertexBuffersCommand*)commandStorage;
+        GraphicsStridedBufferRange* pStreams = (GraphicsStridedBufferRange*)( (uint8*)commandStorage + sizeof( GraphicsBindVertexBuffersCommand ) );
+        pCommand->id            = GraphicsCommandId_BindVertexBuffers;
+        pCommand->sizeInBytes   = (uint32)( sizeof( GraphicsBindVertexBuffersCommand ) + 2u * sizeof( GraphicsStridedBufferRange ) );
+        pCommand->firstStream   = 0u;
+        pCommand->streamCount   = 2u;
+        pStreams[ 0u ].pBuffer  = &m_vertexBuffer;
+        pStreams[ 1u ].pBuffer  = &m_indexBuffer;
+        KEEN_ASSERT( pCommand->sizeInBytes <= sizeof( commandStorage ) );
+
+        const uint64 key = computeKey( pCommand );
+
+        // the last stream is part of the key as well:
+        m_indexBuffer.objectGeneration = 10u;
+        KEEN_UT_CHECK( computeKey( pCommand ) != key );
+    }
+
+}
@@ -23,12 +23,14 @@ namespace keen
         DynamicArray<VkWriteDescriptorSet, 64u>     writes;
         DynamicArray<VkDescriptorBufferInfo, 64u>   bufferInfos;
         DynamicArray<VkDescriptorImageInfo, 64u>    imageInfos;
+        DynamicArray<VkWriteDescriptorSetInlineUniformBlockEXT, 16u>   inlineUniformBlocks;
 
         uint32                                      writeDescriptorCount;
 
         VkWriteDescriptorSet*   pushWrite();
         VkDescriptorBufferInfo* pushBufferInfo();
         VkDescriptorImageInfo*  pushImageInfo();
+        void                    pushInlineUniformBlock( const void* pData, uint32 size );
     };
 }
 
@@ -56,7 +56,14 @@ namespace keen
 #if KEEN_USING( KEEN_GRAPHICS_VALIDATION ) && KEEN_USING( KEEN_ASSERT_FEATURE )
         const GraphicsDescriptorSetLayoutBinding* pBinding = &pDescriptorSetLayout->bindings[ bindingIndex ];
 
-        if( graphics::isArrayDescriptor( descriptorType ) )
+        if( descriptorType == GraphicsDescriptorType::InlineUniformBlock )
+        {
+            // start + count are in bytes:
+            KEEN_ASSERT( pBinding->type == GraphicsDescriptorType::InlineUniformBlock );
+            KEEN_ASSERT( ( startArrayIndex & 3u ) == 0u && ( descriptorCount & 3u ) == 0u );
+            KEEN_ASSERT( startArrayIndex + descriptorCount <= pBinding->arraySizeOrBufferStride );
+        }
+        else if( graphics::isArrayDescriptor( descriptorType ) )
         {
             KEEN_ASSERT( graphics::isDescriptorTypeCompatible( descriptorType, pBinding->type ) );
             KEEN_ASSERT( startArrayIndex + descriptorCount <= pBinding->arraySizeOrBufferStride );
@@ -104,6 +111,7 @@ namespace keen
             break;
 
         case GraphicsDescriptorType::SampledImage:
+        case GraphicsDescriptorType::InputAttachment:
             {
                 const VulkanTexture* pTexture = (const VulkanTexture*)descriptorData.image.pTexture;
 
@@ -163,6 +171,8 @@ namespace keen
 #if KEEN_USING( KEEN_GRAPHICS_OLD_STORAGE_BUFFER_DESCRIPTORS )
         case GraphicsDescriptorType::StorageBuffer:
 #endif
+        case GraphicsDescriptorType::UniformBufferDynamic:
+        case GraphicsDescriptorType::StorageBufferDynamic:
             {
                 const VulkanBuffer* pBuffer = (const VulkanBuffer*)descriptorData.buffer.pBuffer;
 
@@ -175,6 +185,10 @@ namespace keen
             }
             break;
 
+        case GraphicsDescriptorType::InlineUniformBlock:
+            pushInlineUniformBlock( descriptorData.inlineUniformBlock.pData, descriptorData.inlineUniformBlock.size );
+            break;
+
         case GraphicsDescriptorType::Invalid:
             KEEN_BREAK( "invalid descriptor type" );
             break;
@@ -187,6 +201,7 @@ namespace keen
         {
             KEEN_ASSERT( bufferInfos.isEmpty() );
             KEEN_ASSERT( imageInfos.isEmpty() );
+            KEEN_ASSERT( inlineUniformBlocks.isEmpty() );
 
             return;
         }
@@ -204,6 +219,7 @@ namespace keen
         writes.clear();
         bufferInfos.clear();
         imageInfos.clear();
+        inlineUniformBlocks.clear();
 
         KEEN_ASSERT( lastWrite.descriptorCount <= writeDescriptorCount );
         if( lastWrite.descriptorCount != writeDescriptorCount )
@@ -274,4 +290,26 @@ namespace keen
 
         return pImageInfo;
     }
+
+    inline void VulkanDescriptorSetWriter::pushInlineUniformBlock( const void* pData, uint32 size )
+    {
+        if( inlineUniformBlocks.getRemainingCapacity() == 0u )
+        {
+            flush();
+        }
+
+        // :JK: the whole block is written with a single write - the descriptor count is the size in bytes:
+        VkWriteDescriptorSet* pLastWrite = &writes.getLast();
+        KEEN_ASSERT( pLastWrite->descriptorCount == 0u && pLastWrite->pNext == nullptr );
+        KEEN_ASSERT( size == writeDescriptorCount );
+
+        VkWriteDescriptorSetInlineUniformBlockEXT* pInlineUniformBlock = inlineUniformBlocks.pushBackZero();
+        KEEN_ASSERT( pInlineUniformBlock != nullptr );
+        pInlineUniformBlock->sType      = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_INLINE_UNIFORM_BLOCK_EXT;
+        pInlineUniformBlock->dataSize   = size;
+        pInlineUniformBlock->pData      = pData;
+
+        pLastWrite->pNext               = pInlineUniformBlock;
+        pLastWrite->descriptorCount     = size;
+    }
 }
\ No newline at end of file
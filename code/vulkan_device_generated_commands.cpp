@@ -0,0 +1,257 @@
+#include "vulkan_device_generated_commands.hpp"
+
+namespace keen
+{
+
+    static bool isIndirectCommandActionToken( GraphicsIndirectCommandTokenType type )
+    {
+        switch( type )
+        {
+        case GraphicsIndirectCommandTokenType::Draw:
+        case GraphicsIndirectCommandTokenType::DrawIndexed:
+        case GraphicsIndirectCommandTokenType::DrawMeshTasks:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    static VkShaderStageFlags getDefaultIndirectCommandShaderStages( GraphicsIndirectCommandTokenType actionType )
+    {
+        switch( actionType )
+        {
+        case GraphicsIndirectCommandTokenType::Draw:
+        case GraphicsIndirectCommandTokenType::DrawIndexed:
+            return VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        case GraphicsIndirectCommandTokenType::DrawMeshTasks:
+            return VK_SHADER_STAGE_MESH_BIT_EXT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        default:
+            return 0u;
+        }
+    }
+
+    static VkIndirectCommandsTokenTypeEXT getVulkanIndirectCommandsTokenType( GraphicsIndirectCommandTokenType type )
+    {
+        switch( type )
+        {
+        case GraphicsIndirectCommandTokenType::Pipeline:        return VK_INDIRECT_COMMANDS_TOKEN_TYPE_EXECUTION_SET_EXT;
+        case GraphicsIndirectCommandTokenType::PushConstants:   return VK_INDIRECT_COMMANDS_TOKEN_TYPE_PUSH_CONSTANT_EXT;
+        case GraphicsIndirectCommandTokenType::VertexBuffer:    return VK_INDIRECT_COMMANDS_TOKEN_TYPE_VERTEX_BUFFER_EXT;
+        case GraphicsIndirectCommandTokenType::IndexBuffer:     return VK_INDIRECT_COMMANDS_TOKEN_TYPE_INDEX_BUFFER_EXT;
+        case GraphicsIndirectCommandTokenType::Draw:            return VK_INDIRECT_COMMANDS_TOKEN_TYPE_DRAW_EXT;
+        case GraphicsIndirectCommandTokenType::DrawIndexed:     return VK_INDIRECT_COMMANDS_TOKEN_TYPE_DRAW_INDEXED_EXT;
+        case GraphicsIndirectCommandTokenType::DrawMeshTasks:   return VK_INDIRECT_COMMANDS_TOKEN_TYPE_DRAW_MESH_TASKS_EXT;
+        }
+
+        KEEN_BREAK( "Invalid indirect command token type" );
+        return VK_INDIRECT_COMMANDS_TOKEN_TYPE_MAX_ENUM_EXT;
+    }
+
+    uint32 vulkan::getIndirectCommandTokenSize( const GraphicsIndirectCommandToken& token )
+    {
+        switch( token.type )
+        {
+        case GraphicsIndirectCommandTokenType::Pipeline:        return sizeof( uint32 );
+        case GraphicsIndirectCommandTokenType::PushConstants:   return token.pushConstantsSize;
+        case GraphicsIndirectCommandTokenType::VertexBuffer:    return sizeof( VkBindVertexBufferIndirectCommandEXT );
+        case GraphicsIndirectCommandTokenType::IndexBuffer:     return sizeof( VkBindIndexBufferIndirectCommandEXT );
+        case GraphicsIndirectCommandTokenType::Draw:            return sizeof( GraphicsDrawIndirectParameter );
+        case GraphicsIndirectCommandTokenType::DrawIndexed:     return sizeof( GraphicsDrawIndexedIndirectParameter );
+        case GraphicsIndirectCommandTokenType::DrawMeshTasks:   return sizeof( VkDrawMeshTasksIndirectCommandEXT );
+        }
+
+        KEEN_BREAK( "Invalid indirect command token type" );
+        return 0u;
+    }
+
+    Result<void> vulkan::fillIndirectCommandsLayoutInfo( VulkanIndirectCommandsLayoutInfo* pInfo, const GraphicsIndirectCommandsLayoutParameters& parameters, const VulkanIndirectCommandsLimits& limits )
+    {
+        KEEN_ASSERT( pInfo != nullptr );
+
+        pInfo->tokens.clear();
+        pInfo->pushConstantTokens.clear();
+        pInfo->vertexBufferTokens.clear();
+        pInfo->indexBufferToken     = {};
+        pInfo->executionSetToken    = {};
+        pInfo->shaderStages         = 0u;
+        pInfo->indirectStride       = 0u;
+        pInfo->hasExecutionSet      = false;
+
+        const size_t maxTokenCount = min<size_t>( limits.maxTokenCount, GraphicsLimits_MaxIndirectCommandTokenCount );
+        if( parameters.tokens.isEmpty() || parameters.tokens.getCount() > maxTokenCount )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k' has %d tokens (supported: 1..%d)\n", parameters.debugName, parameters.tokens.getCount(), maxTokenCount );
+            return ErrorId_NotSupported;
+        }
+
+        if( parameters.maxSequenceCount == 0u || parameters.maxSequenceCount > limits.maxSequenceCount )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k' has an invalid max sequence count %d (supported: 1..%d)\n", parameters.debugName, parameters.maxSequenceCount, limits.maxSequenceCount );
+            return ErrorId_NotSupported;
+        }
+
+        // the action token terminates the sequence:
+        const GraphicsIndirectCommandTokenType actionType = parameters.tokens.getLast().type;
+        if( !isIndirectCommandActionToken( actionType ) )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k' has to end with an action token\n", parameters.debugName );
+            return ErrorId_Generic;
+        }
+
+        if( actionType == GraphicsIndirectCommandTokenType::DrawMeshTasks && ( limits.supportedShaderStages & VK_SHADER_STAGE_MESH_BIT_EXT ) == 0u )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k' uses mesh tasks but the device doesn't support mesh shaders in generated commands\n", parameters.debugName );
+            return ErrorId_NotSupported;
+        }
+
+        pInfo->shaderStages = parameters.stageMask.isAnySet() ? vulkan::getStageFlags( parameters.stageMask ) : getDefaultIndirectCommandShaderStages( actionType );
+        if( ( pInfo->shaderStages & ~limits.supportedShaderStages ) != 0u )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k' uses shader stages 0x%x that are not supported in generated commands (supported: 0x%x)\n", parameters.debugName, pInfo->shaderStages, limits.supportedShaderStages );
+            return ErrorId_NotSupported;
+        }
+
+        const bool isDrawAction = actionType == GraphicsIndirectCommandTokenType::Draw || actionType == GraphicsIndirectCommandTokenType::DrawIndexed;
+
+        uint32 vertexBufferSlotMask = 0u;
+        uint32 offset = 0u;
+        for( size_t tokenIndex = 0u; tokenIndex < parameters.tokens.getCount(); ++tokenIndex )
+        {
+            const GraphicsIndirectCommandToken& token = parameters.tokens[ tokenIndex ];
+
+            if( isIndirectCommandActionToken( token.type ) && tokenIndex + 1u != parameters.tokens.getCount() )
+            {
+                KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k' has more than one action token (token %d)\n", parameters.debugName, tokenIndex );
+                return ErrorId_Generic;
+            }
+
+            if( offset > limits.maxTokenOffset )
+            {
+                KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k': token %d offset %d exceeds the device limit %d\n", parameters.debugName, tokenIndex, offset, limits.maxTokenOffset );
+                return ErrorId_NotSupported;
+            }
+
+            VkIndirectCommandsLayoutTokenEXT vulkanToken{};
+            vulkanToken.sType   = VK_STRUCTURE_TYPE_INDIRECT_COMMANDS_LAYOUT_TOKEN_EXT;
+            vulkanToken.type    = getVulkanIndirectCommandsTokenType( token.type );
+            vulkanToken.offset  = offset;
+
+            switch( token.type )
+            {
+            case GraphicsIndirectCommandTokenType::Pipeline:
+                {
+                    if( tokenIndex != 0u )
+                    {
+                        KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k': the pipeline token has to be the first token\n", parameters.debugName );
+                        return ErrorId_Generic;
+                    }
+                    if( parameters.pipelines.isEmpty() || parameters.pipelines.getCount() > limits.maxPipelineCount )
+                    {
+                        KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k' has %d pipelines (supported: 1..%d)\n", parameters.debugName, parameters.pipelines.getCount(), limits.maxPipelineCount );
+                        return ErrorId_NotSupported;
+                    }
+
+                    pInfo->executionSetToken.type           = VK_INDIRECT_EXECUTION_SET_INFO_TYPE_PIPELINES_EXT;
+                    pInfo->executionSetToken.shaderStages   = pInfo->shaderStages;
+                    vulkanToken.data.pExecutionSet          = &pInfo->executionSetToken;
+                    pInfo->hasExecutionSet                  = true;
+                }
+                break;
+
+            case GraphicsIndirectCommandTokenType::PushConstants:
+                {
+                    if( parameters.pPipelineLayout == nullptr )
+                    {
+                        KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k': push constant tokens need a pipeline layout\n", parameters.debugName );
+                        return ErrorId_Generic;
+                    }
+                    if( token.pushConstantsSize == 0u || ( token.pushConstantsSize & 3u ) != 0u || ( token.pushConstantsOffset & 3u ) != 0u )
+                    {
+                        KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k': push constant range [%d, %d) has to be non empty and 4 byte aligned\n", parameters.debugName, token.pushConstantsOffset, token.pushConstantsOffset + token.pushConstantsSize );
+                        return ErrorId_Generic;
+                    }
+                    if( (uint32)token.pushConstantsOffset + token.pushConstantsSize > limits.maxPushConstantsSize )
+                    {
+                        KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k': push constant range [%d, %d) exceeds the device limit %d\n", parameters.debugName, token.pushConstantsOffset, token.pushConstantsOffset + token.pushConstantsSize, limits.maxPushConstantsSize );
+                        return ErrorId_NotSupported;
+                    }
+
+                    VkIndirectCommandsPushConstantTokenEXT* pPushConstantToken = pInfo->pushConstantTokens.pushBackZero();
+                    KEEN_ASSERT( pPushConstantToken != nullptr );
+                    pPushConstantToken->updateRange.stageFlags  = pInfo->shaderStages;
+                    pPushConstantToken->updateRange.offset      = token.pushConstantsOffset;
+                    pPushConstantToken->updateRange.size        = token.pushConstantsSize;
+                    vulkanToken.data.pPushConstant              = pPushConstantToken;
+                }
+                break;
+
+            case GraphicsIndirectCommandTokenType::VertexBuffer:
+                {
+                    if( !isDrawAction )
+                    {
+                        KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k': vertex buffer tokens are only allowed for draws\n", parameters.debugName );
+                        return ErrorId_Generic;
+                    }
+                    if( token.vertexBufferSlot >= 32u || ( vertexBufferSlotMask & ( 1u << token.vertexBufferSlot ) ) != 0u )
+                    {
+                        KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k': invalid or duplicate vertex buffer slot %d\n", parameters.debugName, token.vertexBufferSlot );
+                        return ErrorId_Generic;
+                    }
+                    vertexBufferSlotMask |= 1u << token.vertexBufferSlot;
+
+                    VkIndirectCommandsVertexBufferTokenEXT* pVertexBufferToken = pInfo->vertexBufferTokens.pushBackZero();
+                    KEEN_ASSERT( pVertexBufferToken != nullptr );
+                    pVertexBufferToken->vertexBindingUnit   = token.vertexBufferSlot;
+                    vulkanToken.data.pVertexBuffer          = pVertexBufferToken;
+                }
+                break;
+
+            case GraphicsIndirectCommandTokenType::IndexBuffer:
+                {
+                    if( actionType != GraphicsIndirectCommandTokenType::DrawIndexed )
+                    {
+                        KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k': index buffer tokens are only allowed for indexed draws\n", parameters.debugName );
+                        return ErrorId_Generic;
+                    }
+                    if( pInfo->indexBufferToken.mode != 0 )
+                    {
+                        KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k' has more than one index buffer token\n", parameters.debugName );
+                        return ErrorId_Generic;
+                    }
+
+                    pInfo->indexBufferToken.mode    = VK_INDIRECT_COMMANDS_INPUT_MODE_VULKAN_INDEX_BUFFER_EXT;
+                    vulkanToken.data.pIndexBuffer   = &pInfo->indexBufferToken;
+                }
+                break;
+
+            default:
+                break;
+            }
+
+            pInfo->tokens.pushBack( vulkanToken );
+
+            offset += alignUp( vulkan::getIndirectCommandTokenSize( token ), 4u );
+        }
+
+        // :JK: without a pipeline token the layout is bound to a single pipeline (needed for the preprocess size and the execute call)
+        if( !pInfo->hasExecutionSet && parameters.pipelines.getCount() != 1u )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k' has no pipeline token and needs exactly one pipeline (has %d)\n", parameters.debugName, parameters.pipelines.getCount() );
+            return ErrorId_Generic;
+        }
+
+        if( offset > limits.maxIndirectStride )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Indirect commands layout '%k': sequence stride %d exceeds the device limit %d\n", parameters.debugName, offset, limits.maxIndirectStride );
+            return ErrorId_NotSupported;
+        }
+
+        pInfo->indirectStride = offset;
+
+        return ErrorId_Ok;
+    }
+
+}
@@ -0,0 +1,46 @@
+#ifndef KEEN_VULKAN_DEVICE_GENERATED_COMMANDS_HPP_INCLUDED
+#define KEEN_VULKAN_DEVICE_GENERATED_COMMANDS_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+
+namespace keen
+{
+
+    struct VulkanIndirectCommandsLimits
+    {
+        uint32                  maxTokenCount = 0u;
+        uint32                  maxTokenOffset = 0u;
+        uint32                  maxIndirectStride = 0u;
+        uint32                  maxPipelineCount = 0u;
+        uint32                  maxSequenceCount = 0u;
+        uint32                  maxPushConstantsSize = 0u;
+        VkShaderStageFlags      supportedShaderStages = 0u;
+    };
+
+    // :JK: the tokens point into the token data arrays of this struct - so don't copy it after it was filled
+    struct VulkanIndirectCommandsLayoutInfo
+    {
+        DynamicArray<VkIndirectCommandsLayoutTokenEXT, GraphicsLimits_MaxIndirectCommandTokenCount>         tokens;
+        DynamicArray<VkIndirectCommandsPushConstantTokenEXT, GraphicsLimits_MaxIndirectCommandTokenCount>   pushConstantTokens;
+        DynamicArray<VkIndirectCommandsVertexBufferTokenEXT, GraphicsLimits_MaxIndirectCommandTokenCount>   vertexBufferTokens;
+        VkIndirectCommandsIndexBufferTokenEXT                                                               indexBufferToken;
+        VkIndirectCommandsExecutionSetTokenEXT                                                              executionSetToken;
+
+        VkShaderStageFlags      shaderStages;
+        uint32                  indirectStride;
+        bool                    hasExecutionSet;
+    };
+
+    namespace vulkan
+    {
+
+        uint32          getIndirectCommandTokenSize( const GraphicsIndirectCommandToken& token );
+
+        // validates the layout against the device limits and fills the token list (token offsets are packed in token order):
+        Result<void>    fillIndirectCommandsLayoutInfo( VulkanIndirectCommandsLayoutInfo* pInfo, const GraphicsIndirectCommandsLayoutParameters& parameters, const VulkanIndirectCommandsLimits& limits );
+
+    }
+
+}
+
+#endif
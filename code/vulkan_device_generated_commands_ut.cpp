@@ -0,0 +1,155 @@
+#include "vulkan_device_generated_commands.hpp"
+
+#include "keen/base/unit_test.hpp"
+
+
+namespace keen
+{
+    class VulkanDeviceGeneratedCommandsTestFixture : public UnitTest
+    {
+    public:
+        VulkanDeviceGeneratedCommandsTestFixture()
+        {
+            // :JK: roughly the minimum limits required by VK_EXT_device_generated_commands
+            m_limits.maxTokenCount          = 16u;
+            m_limits.maxTokenOffset         = 2047u;
+            m_limits.maxIndirectStride      = 2048u;
+            m_limits.maxPipelineCount       = 2048u;
+            m_limits.maxSequenceCount       = 1u << 20u;
+            m_limits.maxPushConstantsSize   = 128u;
+            m_limits.supportedShaderStages  = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+            // :JK: any non null pointer works - the pipelines and the pipeline layout are only passed through
+            m_pipelines[ 0u ]       = (const GraphicsRenderPipeline*)this;
+            m_pipelines[ 1u ]       = (const GraphicsRenderPipeline*)this;
+            m_singlePipeline[ 0u ]  = (const GraphicsRenderPipeline*)this;
+            m_pPipelineLayout       = (const GraphicsPipelineLayout*)this;
+        }
+
+    protected:
+        VulkanIndirectCommandsLimits    m_limits;
+        const GraphicsRenderPipeline*   m_pipelines[ 2u ];
+        const GraphicsRenderPipeline*   m_singlePipeline[ 1u ];
+        const GraphicsPipelineLayout*   m_pPipelineLayout;
+    };
+
+    KEEN_UNIT_TEST_F( VulkanDeviceGeneratedCommandsTestFixture, testValidLayout )
+    {
+        GraphicsIndirectCommandToken tokens[ 4u ];
+        tokens[ 0u ].type                   = GraphicsIndirectCommandTokenType::Pipeline;
+        tokens[ 1u ].type                   = GraphicsIndirectCommandTokenType::PushConstants;
+        tokens[ 1u ].pushConstantsOffset    = 16u;
+        tokens[ 1u ].pushConstantsSize      = 8u;
+        tokens[ 2u ].type                   = GraphicsIndirectCommandTokenType::IndexBuffer;
+        tokens[ 3u ].type                   = GraphicsIndirectCommandTokenType::DrawIndexed;
+
+        GraphicsIndirectCommandsLayoutParameters parameters;
+        parameters.tokens               = tokens;
+        parameters.pPipelineLayout      = m_pPipelineLayout;
+        parameters.pipelines            = m_pipelines;
+        parameters.maxSequenceCount     = 4096u;
+
+        VulkanIndirectCommandsLayoutInfo info;
+        const Result<void> result = vulkan::fillIndirectCommandsLayoutInfo( &info, parameters, m_limits );
+        KEEN_UT_CHECK( !result.hasError() );
+
+        KEEN_UT_COMPARE_UINT32( (uint32)info.tokens.getSize(), 4u );
+        KEEN_UT_COMPARE_UINT32( info.tokens[ 0u ].type, VK_INDIRECT_COMMANDS_TOKEN_TYPE_EXECUTION_SET_EXT );
+        KEEN_UT_COMPARE_UINT32( info.tokens[ 0u ].offset, 0u );
+        KEEN_UT_COMPARE_UINT32( info.tokens[ 1u ].type, VK_INDIRECT_COMMANDS_TOKEN_TYPE_PUSH_CONSTANT_EXT );
+        KEEN_UT_COMPARE_UINT32( info.tokens[ 1u ].offset, 4u );
+        KEEN_UT_COMPARE_UINT32( info.tokens[ 2u ].type, VK_INDIRECT_COMMANDS_TOKEN_TYPE_INDEX_BUFFER_EXT );
+        KEEN_UT_COMPARE_UINT32( info.tokens[ 2u ].offset, 12u );
+        KEEN_UT_COMPARE_UINT32( info.tokens[ 3u ].type, VK_INDIRECT_COMMANDS_TOKEN_TYPE_DRAW_INDEXED_EXT );
+        KEEN_UT_COMPARE_UINT32( info.tokens[ 3u ].offset, 28u );
+        KEEN_UT_COMPARE_UINT32( info.indirectStride, 48u );
+        KEEN_UT_COMPARE_UINT32( info.shaderStages, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT );
+        KEEN_UT_CHECK( info.hasExecutionSet );
+
+        KEEN_UT_CHECK( info.tokens[ 0u ].data.pExecutionSet == &info.executionSetToken );
+        KEEN_UT_CHECK( info.tokens[ 1u ].data.pPushConstant == &info.pushConstantTokens[ 0u ] );
+        KEEN_UT_COMPARE_UINT32( info.pushConstantTokens[ 0u ].updateRange.offset, 16u );
+        KEEN_UT_COMPARE_UINT32( info.pushConstantTokens[ 0u ].updateRange.size, 8u );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanDeviceGeneratedCommandsTestFixture, testInvalidLayouts )
+    {
+        VulkanIndirectCommandsLayoutInfo info;
+
+        // the action token has to be the last token:
+        {
+            GraphicsIndirectCommandToken tokens[ 2u ];
+            tokens[ 0u ].type = GraphicsIndirectCommandTokenType::Draw;
+            tokens[ 1u ].type = GraphicsIndirectCommandTokenType::VertexBuffer;
+
+            GraphicsIndirectCommandsLayoutParameters parameters;
+            parameters.tokens           = tokens;
+            parameters.pipelines        = m_singlePipeline;
+            parameters.maxSequenceCount = 1u;
+            KEEN_UT_CHECK( vulkan::fillIndirectCommandsLayoutInfo( &info, parameters, m_limits ).hasError() );
+        }
+
+        // more than one pipeline needs a pipeline token:
+        {
+            GraphicsIndirectCommandToken tokens[ 1u ];
+            tokens[ 0u ].type = GraphicsIndirectCommandTokenType::Draw;
+
+            GraphicsIndirectCommandsLayoutParameters parameters;
+            parameters.tokens           = tokens;
+            parameters.pipelines        = m_pipelines;
+            parameters.maxSequenceCount = 1u;
+            KEEN_UT_CHECK( vulkan::fillIndirectCommandsLayoutInfo( &info, parameters, m_limits ).hasError() );
+
+            parameters.pipelines        = m_singlePipeline;
+            KEEN_UT_CHECK( !vulkan::fillIndirectCommandsLayoutInfo( &info, parameters, m_limits ).hasError() );
+        }
+
+        // index buffer tokens need an indexed draw:
+        {
+            GraphicsIndirectCommandToken tokens[ 2u ];
+            tokens[ 0u ].type = GraphicsIndirectCommandTokenType::IndexBuffer;
+            tokens[ 1u ].type = GraphicsIndirectCommandTokenType::Draw;
+
+            GraphicsIndirectCommandsLayoutParameters parameters;
+            parameters.tokens           = tokens;
+            parameters.pipelines        = m_singlePipeline;
+            parameters.maxSequenceCount = 1u;
+            KEEN_UT_CHECK( vulkan::fillIndirectCommandsLayoutInfo( &info, parameters, m_limits ).hasError() );
+        }
+
+        // mesh tasks are not supported by the test limits:
+        {
+            GraphicsIndirectCommandToken tokens[ 1u ];
+            tokens[ 0u ].type = GraphicsIndirectCommandTokenType::DrawMeshTasks;
+
+            GraphicsIndirectCommandsLayoutParameters parameters;
+            parameters.tokens           = tokens;
+            parameters.pipelines        = m_singlePipeline;
+            parameters.maxSequenceCount = 1u;
+            KEEN_UT_CHECK( vulkan::fillIndirectCommandsLayoutInfo( &info, parameters, m_limits ).hasError() );
+        }
+    }
+
+    KEEN_UNIT_TEST_F( VulkanDeviceGeneratedCommandsTestFixture, testStrideLimit )
+    {
+        GraphicsIndirectCommandToken tokens[ 2u ];
+        tokens[ 0u ].type                   = GraphicsIndirectCommandTokenType::PushConstants;
+        tokens[ 0u ].pushConstantsSize      = 128u;
+        tokens[ 1u ].type                   = GraphicsIndirectCommandTokenType::Draw;
+
+        GraphicsIndirectCommandsLayoutParameters parameters;
+        parameters.tokens               = tokens;
+        parameters.pPipelineLayout      = m_pPipelineLayout;
+        parameters.pipelines            = m_singlePipeline;
+        parameters.maxSequenceCount     = 1u;
+
+        VulkanIndirectCommandsLayoutInfo info;
+        KEEN_UT_CHECK( !vulkan::fillIndirectCommandsLayoutInfo( &info, parameters, m_limits ).hasError() );
+        KEEN_UT_COMPARE_UINT32( info.indirectStride, 144u );
+        KEEN_UT_CHECK( !info.hasExecutionSet );
+
+        m_limits.maxIndirectStride = 128u;
+        KEEN_UT_CHECK( vulkan::fillIndirectCommandsLayoutInfo( &info, parameters, m_limits ).hasError() );
+    }
+
+}
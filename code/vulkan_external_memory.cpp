@@ -0,0 +1,174 @@
+#include "vulkan_external_memory.hpp"
+
+namespace keen
+{
+
+    static Result<uint32> findExportableMemoryTypeIndex( const VkPhysicalDeviceMemoryProperties& memoryProperties, uint32 memoryTypeBits )
+    {
+        // the consumer reads every frame - so the memory should stay in vram:
+        for( uint32 memoryTypeIndex = 0u; memoryTypeIndex < memoryProperties.memoryTypeCount; ++memoryTypeIndex )
+        {
+            if( isBitmaskSet( memoryTypeBits, 1u << memoryTypeIndex ) && isBitmaskSet( memoryProperties.memoryTypes[ memoryTypeIndex ].propertyFlags, (VkMemoryPropertyFlags)VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT ) )
+            {
+                return memoryTypeIndex;
+            }
+        }
+        for( uint32 memoryTypeIndex = 0u; memoryTypeIndex < memoryProperties.memoryTypeCount; ++memoryTypeIndex )
+        {
+            if( isBitmaskSet( memoryTypeBits, 1u << memoryTypeIndex ) )
+            {
+                return memoryTypeIndex;
+            }
+        }
+        return ErrorId_NotFound;
+    }
+
+    bool vulkan::isImageExportable( VulkanApi* pVulkan, VkPhysicalDevice physicalDevice, const VkImageCreateInfo& imageCreateInfo )
+    {
+        VkPhysicalDeviceExternalImageFormatInfo externalImageFormatInfo{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_IMAGE_FORMAT_INFO };
+        externalImageFormatInfo.handleType = VulkanExportMemoryHandleType;
+
+        VkPhysicalDeviceImageFormatInfo2 imageFormatInfo{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_FORMAT_INFO_2, &externalImageFormatInfo };
+        imageFormatInfo.format  = imageCreateInfo.format;
+        imageFormatInfo.type    = imageCreateInfo.imageType;
+        imageFormatInfo.tiling  = imageCreateInfo.tiling;
+        imageFormatInfo.usage   = imageCreateInfo.usage;
+        imageFormatInfo.flags   = imageCreateInfo.flags;
+
+        VkExternalImageFormatProperties externalImageFormatProperties{ VK_STRUCTURE_TYPE_EXTERNAL_IMAGE_FORMAT_PROPERTIES };
+        VkImageFormatProperties2 imageFormatProperties{ VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2, &externalImageFormatProperties };
+
+        const VulkanResult result = pVulkan->vkGetPhysicalDeviceImageFormatProperties2( physicalDevice, &imageFormatInfo, &imageFormatProperties );
+        if( result.hasError() )
+        {
+            return false;
+        }
+
+        // :JK: we always use a dedicated allocation - so dedicated only handle types are fine
+        return isBitmaskSet( externalImageFormatProperties.externalMemoryProperties.externalMemoryFeatures, (VkExternalMemoryFeatureFlags)VK_EXTERNAL_MEMORY_FEATURE_EXPORTABLE_BIT );
+    }
+
+    Result<VulkanExportableMemory> vulkan::allocateExportableImageMemory( VulkanApi* pVulkan, VkDevice device, const VkPhysicalDeviceMemoryProperties& memoryProperties, VkImage image, const VkAllocationCallbacks* pAllocationCallbacks )
+    {
+        VkMemoryRequirements memoryRequirements{};
+        pVulkan->vkGetImageMemoryRequirements( device, image, &memoryRequirements );
+
+        const Result<uint32> memoryTypeResult = findExportableMemoryTypeIndex( memoryProperties, memoryRequirements.memoryTypeBits );
+        if( memoryTypeResult.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] No memory type for exportable image memory (memoryTypeBits: 0x%08x)\n", memoryRequirements.memoryTypeBits );
+            return memoryTypeResult.getError();
+        }
+
+        VkMemoryDedicatedAllocateInfo dedicatedAllocateInfo{ VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO };
+        dedicatedAllocateInfo.image = image;
+
+        VkExportMemoryAllocateInfo exportAllocateInfo{ VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO, &dedicatedAllocateInfo };
+        exportAllocateInfo.handleTypes = (VkExternalMemoryHandleTypeFlags)VulkanExportMemoryHandleType;
+
+        VkMemoryAllocateInfo allocateInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, &exportAllocateInfo };
+        allocateInfo.allocationSize     = memoryRequirements.size;
+        allocateInfo.memoryTypeIndex    = memoryTypeResult.getValue();
+
+        VulkanExportableMemory memory;
+        VulkanResult result = pVulkan->vkAllocateMemory( device, &allocateInfo, pAllocationCallbacks, &memory.memory );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkAllocateMemory failed for exportable image memory with error '%s'\n", result );
+            return result.getErrorId();
+        }
+        memory.allocationSize   = memoryRequirements.size;
+        memory.memoryTypeIndex  = allocateInfo.memoryTypeIndex;
+
+        result = pVulkan->vkBindImageMemory( device, image, memory.memory, 0u );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkBindImageMemory failed for exportable image memory with error '%s'\n", result );
+            pVulkan->vkFreeMemory( device, memory.memory, pAllocationCallbacks );
+            return result.getErrorId();
+        }
+
+        return memory;
+    }
+
+    Result<GraphicsExportedTextureMemory> vulkan::exportImageMemory( VulkanApi* pVulkan, VkDevice device, const VulkanExternalMemoryInfo& info, const VulkanExportableMemory& memory )
+    {
+        if( !info.isSupported || memory.memory == VK_NULL_HANDLE )
+        {
+            return ErrorId_NotSupported;
+        }
+
+#if defined( VK_KHR_external_memory_fd )
+        VkMemoryGetFdInfoKHR getFdInfo{ VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR };
+        getFdInfo.memory        = memory.memory;
+        getFdInfo.handleType    = VulkanExportMemoryHandleType;
+
+        int fileDescriptor = -1;
+        const VulkanResult result = pVulkan->vkGetMemoryFdKHR( device, &getFdInfo, &fileDescriptor );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkGetMemoryFdKHR failed with error '%s'\n", result );
+            return result.getErrorId();
+        }
+
+        GraphicsExportedTextureMemory exportedMemory;
+        exportedMemory.fileDescriptor           = (sint32)fileDescriptor;
+        exportedMemory.allocationSize           = memory.allocationSize;
+        exportedMemory.memoryOffset             = 0u;       // dedicated allocation
+        exportedMemory.memoryTypeIndex          = memory.memoryTypeIndex;
+        exportedMemory.isDedicatedAllocation    = true;
+        copyMemoryNonOverlapping( exportedMemory.deviceUuid, info.deviceUuid, sizeof( exportedMemory.deviceUuid ) );
+        copyMemoryNonOverlapping( exportedMemory.driverUuid, info.driverUuid, sizeof( exportedMemory.driverUuid ) );
+        return exportedMemory;
+#else
+        KEEN_UNUSED1( pVulkan );
+        KEEN_UNUSED1( device );
+        return ErrorId_NotSupported;
+#endif
+    }
+
+    Result<VkSemaphore> vulkan::createExportableTimelineSemaphore( VulkanApi* pVulkan, VkDevice device, uint64 initialValue, const VkAllocationCallbacks* pAllocationCallbacks )
+    {
+        VkExportSemaphoreCreateInfo exportCreateInfo{ VK_STRUCTURE_TYPE_EXPORT_SEMAPHORE_CREATE_INFO };
+        exportCreateInfo.handleTypes = (VkExternalSemaphoreHandleTypeFlags)VulkanExportSemaphoreHandleType;
+
+        VkSemaphoreTypeCreateInfo typeCreateInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO, &exportCreateInfo };
+        typeCreateInfo.semaphoreType    = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeCreateInfo.initialValue     = initialValue;
+
+        VkSemaphoreCreateInfo semaphoreCreateInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, &typeCreateInfo };
+
+        VkSemaphore semaphore = VK_NULL_HANDLE;
+        const VulkanResult result = pVulkan->vkCreateSemaphore( device, &semaphoreCreateInfo, pAllocationCallbacks, &semaphore );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkCreateSemaphore failed for exportable timeline semaphore with error '%s'\n", result );
+            return result.getErrorId();
+        }
+        return semaphore;
+    }
+
+    Result<sint32> vulkan::exportSemaphore( VulkanApi* pVulkan, VkDevice device, VkSemaphore semaphore )
+    {
+#if defined( VK_KHR_external_semaphore_fd )
+        VkSemaphoreGetFdInfoKHR getFdInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_GET_FD_INFO_KHR };
+        getFdInfo.semaphore     = semaphore;
+        getFdInfo.handleType    = VulkanExportSemaphoreHandleType;
+
+        int fileDescriptor = -1;
+        const VulkanResult result = pVulkan->vkGetSemaphoreFdKHR( device, &getFdInfo, &fileDescriptor );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkGetSemaphoreFdKHR failed with error '%s'\n", result );
+            return result.getErrorId();
+        }
+        return (sint32)fileDescriptor;
+#else
+        KEEN_UNUSED1( pVulkan );
+        KEEN_UNUSED1( device );
+        KEEN_UNUSED1( semaphore );
+        return ErrorId_NotSupported;
+#endif
+    }
+
+}
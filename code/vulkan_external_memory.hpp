@@ -0,0 +1,47 @@
+#ifndef KEEN_VULKAN_EXTERNAL_MEMORY_HPP_INCLUDED
+#define KEEN_VULKAN_EXTERNAL_MEMORY_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+
+namespace keen
+{
+    // :JK: opaque fds can only be imported by vulkan (or cuda/gl interop) on the same device and driver - that's what the uuids are for
+    constexpr VkExternalMemoryHandleTypeFlagBits    VulkanExportMemoryHandleType    = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+    constexpr VkExternalSemaphoreHandleTypeFlagBits VulkanExportSemaphoreHandleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+    constexpr size_t VulkanMaxFrameTimelineSemaphoreSignalCount = 8u;
+
+    struct VulkanExternalMemoryInfo
+    {
+        bool8                       isSupported = false;    // VK_KHR_external_memory_fd and VK_KHR_external_semaphore_fd (linux only)
+        uint8                       deviceUuid[ VK_UUID_SIZE ];
+        uint8                       driverUuid[ VK_UUID_SIZE ];
+    };
+
+    // dedicated memory of an exportable texture - owned by the texture:
+    struct VulkanExportableMemory
+    {
+        VkDeviceMemory              memory = VK_NULL_HANDLE;
+        uint64                      allocationSize = 0u;
+        uint32                      memoryTypeIndex = 0u;
+    };
+
+    namespace vulkan
+    {
+
+        bool                                    isImageExportable( VulkanApi* pVulkan, VkPhysicalDevice physicalDevice, const VkImageCreateInfo& imageCreateInfo );
+
+        // the image has to be created with a VkExternalMemoryImageCreateInfo - the memory is bound to it:
+        Result<VulkanExportableMemory>          allocateExportableImageMemory( VulkanApi* pVulkan, VkDevice device, const VkPhysicalDeviceMemoryProperties& memoryProperties, VkImage image, const VkAllocationCallbacks* pAllocationCallbacks );
+
+        // every call returns a new file descriptor - the caller owns it:
+        Result<GraphicsExportedTextureMemory>   exportImageMemory( VulkanApi* pVulkan, VkDevice device, const VulkanExternalMemoryInfo& info, const VulkanExportableMemory& memory );
+
+        Result<VkSemaphore>                     createExportableTimelineSemaphore( VulkanApi* pVulkan, VkDevice device, uint64 initialValue, const VkAllocationCallbacks* pAllocationCallbacks );
+        Result<sint32>                          exportSemaphore( VulkanApi* pVulkan, VkDevice device, VkSemaphore semaphore );
+
+    }
+
+}
+
+#endif
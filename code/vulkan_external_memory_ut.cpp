@@ -0,0 +1,267 @@
+#include "vulkan_external_memory.hpp"
+#include "vulkan_stub_api_ut.hpp"
+
+
+namespace keen
+{
+    // the export bookkeeping is checked against these stubs instead of a device:
+    struct VulkanRecordedExternalMemoryCalls
+    {
+        VkExternalMemoryFeatureFlags    externalMemoryFeatures;     // returned by vkGetPhysicalDeviceImageFormatProperties2
+        VkExternalMemoryHandleTypeFlags queriedHandleType;
+        uint32                          memoryTypeBits;             // returned by vkGetImageMemoryRequirements
+        VkResult                        bindResult;
+        VkResult                        getFdResult;
+
+        uint32                          allocateCount;
+        uint32                          freeCount;
+        uint32                          bindCount;
+        uint32                          allocatedMemoryTypeIndex;
+        VkDeviceSize                    allocatedSize;
+        VkExternalMemoryHandleTypeFlags exportHandleTypes;
+        VkImage                         dedicatedImage;
+
+        uint32                          getFdCount;
+        VkDeviceMemory                  exportedMemory;
+        VkExternalMemoryHandleTypeFlags exportedHandleType;
+
+        VkSemaphoreType                 semaphoreType;
+        uint64                          semaphoreInitialValue;
+        VkExternalSemaphoreHandleTypeFlags  semaphoreExportHandleTypes;
+        VkSemaphore                     exportedSemaphore;
+    };
+
+    static VulkanRecordedExternalMemoryCalls s_recordedCalls;
+
+    static const VkBaseInStructure* findStruct( const void* pNext, VkStructureType type )
+    {
+        const VkBaseInStructure* pStruct = (const VkBaseInStructure*)pNext;
+        while( pStruct != nullptr && pStruct->sType != type )
+        {
+            pStruct = pStruct->pNext;
+        }
+        return pStruct;
+    }
+
+    static VKAPI_ATTR VkResult VKAPI_CALL recordGetPhysicalDeviceImageFormatProperties2( VkPhysicalDevice, const VkPhysicalDeviceImageFormatInfo2* pImageFormatInfo, VkImageFormatProperties2* pImageFormatProperties )
+    {
+        const VkPhysicalDeviceExternalImageFormatInfo* pExternalInfo = (const VkPhysicalDeviceExternalImageFormatInfo*)findStruct( pImageFormatInfo->pNext, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_IMAGE_FORMAT_INFO );
+        s_recordedCalls.queriedHandleType = pExternalInfo != nullptr ? (VkExternalMemoryHandleTypeFlags)pExternalInfo->handleType : 0u;
+
+        VkExternalImageFormatProperties* pExternalProperties = (VkExternalImageFormatProperties*)findStruct( pImageFormatProperties->pNext, VK_STRUCTURE_TYPE_EXTERNAL_IMAGE_FORMAT_PROPERTIES );
+        pExternalProperties->externalMemoryProperties.externalMemoryFeatures = s_recordedCalls.externalMemoryFeatures;
+        return VK_SUCCESS;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordGetImageMemoryRequirements( VkDevice, VkImage, VkMemoryRequirements* pMemoryRequirements )
+    {
+        pMemoryRequirements->size           = 8u * 1024u * 1024u;
+        pMemoryRequirements->alignment      = 64u * 1024u;
+        pMemoryRequirements->memoryTypeBits = s_recordedCalls.memoryTypeBits;
+    }
+
+    static VKAPI_ATTR VkResult VKAPI_CALL recordAllocateMemory( VkDevice, const VkMemoryAllocateInfo* pAllocateInfo, const VkAllocationCallbacks*, VkDeviceMemory* pMemory )
+    {
+        s_recordedCalls.allocateCount++;
+        s_recordedCalls.allocatedMemoryTypeIndex    = pAllocateInfo->memoryTypeIndex;
+        s_recordedCalls.allocatedSize               = pAllocateInfo->allocationSize;
+
+        const VkExportMemoryAllocateInfo* pExportInfo = (const VkExportMemoryAllocateInfo*)findStruct( pAllocateInfo->pNext, VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO );
+        s_recordedCalls.exportHandleTypes = pExportInfo != nullptr ? pExportInfo->handleTypes : 0u;
+        const VkMemoryDedicatedAllocateInfo* pDedicatedInfo = (const VkMemoryDedicatedAllocateInfo*)findStruct( pAllocateInfo->pNext, VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO );
+        s_recordedCalls.dedicatedImage = pDedicatedInfo != nullptr ? pDedicatedInfo->image : VK_NULL_HANDLE;
+
+        *pMemory = (VkDeviceMemory)(uintptr_t)0x2000u;
+        return VK_SUCCESS;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordFreeMemory( VkDevice, VkDeviceMemory, const VkAllocationCallbacks* )
+    {
+        s_recordedCalls.freeCount++;
+    }
+
+    static VKAPI_ATTR VkResult VKAPI_CALL recordBindImageMemory( VkDevice, VkImage, VkDeviceMemory, VkDeviceSize )
+    {
+        s_recordedCalls.bindCount++;
+        return s_recordedCalls.bindResult;
+    }
+
+    static VKAPI_ATTR VkResult VKAPI_CALL recordGetMemoryFdKHR( VkDevice, const VkMemoryGetFdInfoKHR* pGetFdInfo, int* pFd )
+    {
+        s_recordedCalls.getFdCount++;
+        s_recordedCalls.exportedMemory      = pGetFdInfo->memory;
+        s_recordedCalls.exportedHandleType  = (VkExternalMemoryHandleTypeFlags)pGetFdInfo->handleType;
+        if( s_recordedCalls.getFdResult != VK_SUCCESS )
+        {
+            return s_recordedCalls.getFdResult;
+        }
+        *pFd = 42;
+        return VK_SUCCESS;
+    }
+
+    static VKAPI_ATTR VkResult VKAPI_CALL recordCreateSemaphore( VkDevice, const VkSemaphoreCreateInfo* pCreateInfo, const VkAllocationCallbacks*, VkSemaphore* pSemaphore )
+    {
+        const VkSemaphoreTypeCreateInfo* pTypeInfo = (const VkSemaphoreTypeCreateInfo*)findStruct( pCreateInfo->pNext, VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO );
+        s_recordedCalls.semaphoreType           = pTypeInfo != nullptr ? pTypeInfo->semaphoreType : VK_SEMAPHORE_TYPE_BINARY;
+        s_recordedCalls.semaphoreInitialValue   = pTypeInfo != nullptr ? pTypeInfo->initialValue : 0u;
+
+        const VkExportSemaphoreCreateInfo* pExportInfo = (const VkExportSemaphoreCreateInfo*)findStruct( pCreateInfo->pNext, VK_STRUCTURE_TYPE_EXPORT_SEMAPHORE_CREATE_INFO );
+        s_recordedCalls.semaphoreExportHandleTypes = pExportInfo != nullptr ? pExportInfo->handleTypes : 0u;
+
+        *pSemaphore = (VkSemaphore)(uintptr_t)0x3000u;
+        return VK_SUCCESS;
+    }
+
+    static VKAPI_ATTR VkResult VKAPI_CALL recordGetSemaphoreFdKHR( VkDevice, const VkSemaphoreGetFdInfoKHR* pGetFdInfo, int* pFd )
+    {
+        s_recordedCalls.exportedSemaphore = pGetFdInfo->semaphore;
+        *pFd = 7;
+        return VK_SUCCESS;
+    }
+
+    class VulkanExternalMemoryTestFixture : public VulkanStubApiTestFixture
+    {
+    public:
+        VulkanExternalMemoryTestFixture()
+        {
+            zeroValue( &s_recordedCalls );
+            s_recordedCalls.externalMemoryFeatures  = VK_EXTERNAL_MEMORY_FEATURE_EXPORTABLE_BIT | VK_EXTERNAL_MEMORY_FEATURE_IMPORTABLE_BIT;
+            s_recordedCalls.memoryTypeBits          = 0x6u;
+            s_recordedCalls.bindResult              = VK_SUCCESS;
+            s_recordedCalls.getFdResult             = VK_SUCCESS;
+
+            m_vulkan.vkGetPhysicalDeviceImageFormatProperties2  = recordGetPhysicalDeviceImageFormatProperties2;
+            m_vulkan.vkGetImageMemoryRequirements               = recordGetImageMemoryRequirements;
+            m_vulkan.vkAllocateMemory                           = recordAllocateMemory;
+            m_vulkan.vkFreeMemory                               = recordFreeMemory;
+            m_vulkan.vkBindImageMemory                          = recordBindImageMemory;
+            m_vulkan.vkGetMemoryFdKHR                           = recordGetMemoryFdKHR;
+            m_vulkan.vkCreateSemaphore                          = recordCreateSemaphore;
+            m_vulkan.vkGetSemaphoreFdKHR                        = recordGetSemaphoreFdKHR;
+
+            // host memory, host visible memory and vram:
+            zeroValue( &m_memoryProperties );
+            m_memoryProperties.memoryTypeCount = 3u;
+            m_memoryProperties.memoryTypes[ 0u ].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            m_memoryProperties.memoryTypes[ 1u ].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+            m_memoryProperties.memoryTypes[ 2u ].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+            m_info.isSupported = true;
+            for( size_t i = 0u; i < VK_UUID_SIZE; ++i )
+            {
+                m_info.deviceUuid[ i ] = (uint8)( 0x10u + i );
+                m_info.driverUuid[ i ] = (uint8)( 0x80u + i );
+            }
+
+            m_image = createStubHandle<VkImage>( 0x1000u );
+        }
+
+    protected:
+        VkPhysicalDeviceMemoryProperties    m_memoryProperties;
+        VulkanExternalMemoryInfo            m_info;
+        VkImage                             m_image;
+    };
+
+    KEEN_UNIT_TEST_F( VulkanExternalMemoryTestFixture, testImageExportable )
+    {
+        VkImageCreateInfo imageCreateInfo{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+        imageCreateInfo.imageType   = VK_IMAGE_TYPE_2D;
+        imageCreateInfo.format      = VK_FORMAT_R8G8B8A8_UNORM;
+        imageCreateInfo.tiling      = VK_IMAGE_TILING_OPTIMAL;
+        imageCreateInfo.usage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+        KEEN_UT_CHECK( vulkan::isImageExportable( &m_vulkan, VK_NULL_HANDLE, imageCreateInfo ) );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.queriedHandleType, (uint32)VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT );
+
+        // importable only:
+        s_recordedCalls.externalMemoryFeatures = VK_EXTERNAL_MEMORY_FEATURE_IMPORTABLE_BIT;
+        KEEN_UT_CHECK( !vulkan::isImageExportable( &m_vulkan, VK_NULL_HANDLE, imageCreateInfo ) );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanExternalMemoryTestFixture, testExportImageMemory )
+    {
+        const Result<VulkanExportableMemory> memoryResult = vulkan::allocateExportableImageMemory( &m_vulkan, VK_NULL_HANDLE, m_memoryProperties, m_image, nullptr );
+        KEEN_UT_CHECK( memoryResult.isOk() );
+
+        // one dedicated exportable allocation in vram (type 2 is the only device local type allowed):
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.allocateCount, 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.bindCount, 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.allocatedMemoryTypeIndex, 2u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.exportHandleTypes, (uint32)VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT );
+        KEEN_UT_CHECK( s_recordedCalls.dedicatedImage == m_image );
+
+        const VulkanExportableMemory& memory = memoryResult.getValue();
+        KEEN_UT_CHECK( memory.memory != VK_NULL_HANDLE );
+        KEEN_UT_CHECK( memory.allocationSize == s_recordedCalls.allocatedSize );
+
+        const Result<GraphicsExportedTextureMemory> exportResult = vulkan::exportImageMemory( &m_vulkan, VK_NULL_HANDLE, m_info, memory );
+        KEEN_UT_CHECK( exportResult.isOk() );
+        KEEN_UT_CHECK( s_recordedCalls.exportedMemory == memory.memory );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.exportedHandleType, (uint32)VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT );
+
+        // the layout the consumer needs for the import:
+        const GraphicsExportedTextureMemory& exportedMemory = exportResult.getValue();
+        KEEN_UT_CHECK( exportedMemory.fileDescriptor == 42 );
+        KEEN_UT_CHECK( exportedMemory.allocationSize == 8u * 1024u * 1024u );
+        KEEN_UT_CHECK( exportedMemory.memoryOffset == 0u );
+        KEEN_UT_COMPARE_UINT32( exportedMemory.memoryTypeIndex, 2u );
+        KEEN_UT_CHECK( exportedMemory.isDedicatedAllocation );
+        KEEN_UT_CHECK( isMemoryBlockEqual( createConstMemoryBlockFromArray( exportedMemory.deviceUuid ), createConstMemoryBlockFromArray( m_info.deviceUuid ) ) );
+        KEEN_UT_CHECK( isMemoryBlockEqual( createConstMemoryBlockFromArray( exportedMemory.driverUuid ), createConstMemoryBlockFromArray( m_info.driverUuid ) ) );
+
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.freeCount, 0u );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanExternalMemoryTestFixture, testExportFailures )
+    {
+        // only host memory types allowed - the first one is used:
+        s_recordedCalls.memoryTypeBits = 0x3u;
+        Result<VulkanExportableMemory> memoryResult = vulkan::allocateExportableImageMemory( &m_vulkan, VK_NULL_HANDLE, m_memoryProperties, m_image, nullptr );
+        KEEN_UT_CHECK( memoryResult.isOk() );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.allocatedMemoryTypeIndex, 0u );
+
+        // no memory type at all:
+        s_recordedCalls.memoryTypeBits = 0x0u;
+        memoryResult = vulkan::allocateExportableImageMemory( &m_vulkan, VK_NULL_HANDLE, m_memoryProperties, m_image, nullptr );
+        KEEN_UT_CHECK( memoryResult.hasError() );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.allocateCount, 1u );
+
+        // a failed bind must not leak the memory:
+        s_recordedCalls.memoryTypeBits  = 0x4u;
+        s_recordedCalls.bindResult      = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        memoryResult = vulkan::allocateExportableImageMemory( &m_vulkan, VK_NULL_HANDLE, m_memoryProperties, m_image, nullptr );
+        KEEN_UT_CHECK( memoryResult.hasError() );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.allocateCount, 2u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.freeCount, 1u );
+
+        // no export without the extensions or for textures without exportable memory:
+        VulkanExportableMemory memory;
+        memory.memory           = createStubHandle<VkDeviceMemory>( 0x2000u );
+        memory.allocationSize   = 4096u;
+
+        m_info.isSupported = false;
+        KEEN_UT_CHECK( vulkan::exportImageMemory( &m_vulkan, VK_NULL_HANDLE, m_info, memory ).hasError() );
+        m_info.isSupported = true;
+        KEEN_UT_CHECK( vulkan::exportImageMemory( &m_vulkan, VK_NULL_HANDLE, m_info, VulkanExportableMemory{} ).hasError() );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.getFdCount, 0u );
+
+        s_recordedCalls.getFdResult = VK_ERROR_TOO_MANY_OBJECTS;
+        KEEN_UT_CHECK( vulkan::exportImageMemory( &m_vulkan, VK_NULL_HANDLE, m_info, memory ).hasError() );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.getFdCount, 1u );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanExternalMemoryTestFixture, testExportTimelineSemaphore )
+    {
+        const Result<VkSemaphore> semaphoreResult = vulkan::createExportableTimelineSemaphore( &m_vulkan, VK_NULL_HANDLE, 17u, nullptr );
+        KEEN_UT_CHECK( semaphoreResult.isOk() );
+        KEEN_UT_CHECK( s_recordedCalls.semaphoreType == VK_SEMAPHORE_TYPE_TIMELINE );
+        KEEN_UT_CHECK( s_recordedCalls.semaphoreInitialValue == 17u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.semaphoreExportHandleTypes, (uint32)VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT );
+
+        const Result<sint32> fdResult = vulkan::exportSemaphore( &m_vulkan, VK_NULL_HANDLE, semaphoreResult.getValue() );
+        KEEN_UT_CHECK( fdResult.isOk() );
+        KEEN_UT_CHECK( fdResult.getValue() == 7 );
+        KEEN_UT_CHECK( s_recordedCalls.exportedSemaphore == semaphoreResult.getValue() );
+    }
+
+}
@@ -237,7 +237,7 @@ namespace keen
 #endif
     }
 
-    bool vulkan::allocateGpuBuffer( VulkanGpuBufferResult* pResult, VulkanGpuAllocator* pGpuAllocator, VulkanGpuMemoryUsage memoryUsage, VulkanGpuMemoryFlagMask flags, uint32 minAlignment, const VkBufferCreateInfo& bufferCreateInfo, const DebugName& debugName )
+    bool vulkan::allocateGpuBuffer( VulkanGpuBufferResult* pResult, VulkanGpuAllocator* pGpuAllocator, VulkanGpuMemoryUsage memoryUsage, VulkanGpuMemoryFlagMask flags, uint32 minAlignment, uint32 memoryTypeBits, const VkBufferCreateInfo& bufferCreateInfo, const DebugName& debugName )
     {
         KEEN_PROFILE_CPU( vk_allocateGpuBuffer );
 
@@ -250,6 +250,7 @@ namespace keen
 
         VmaAllocationCreateInfo vmaAllocCreateInfo = {};
         fillVmaAllocationCreateInfo( &vmaAllocCreateInfo, memoryUsage, flags );
+        vmaAllocCreateInfo.memoryTypeBits = memoryTypeBits;    // 0 allows all memory types that fit the buffer
 
         VmaAllocationInfo allocationInfo;
         VulkanResult result = vmaCreateBufferWithAlignment( pGpuAllocator->vmaAllocator, &bufferCreateInfo, &vmaAllocCreateInfo, minAlignment, &pResult->buffer, (VmaAllocation*)&pResult->allocationInfo.pAllocation, &allocationInfo );
@@ -89,7 +89,7 @@ namespace keen
 
         void                    traceGpuAllocations( const VulkanGpuAllocator* pGpuAllocator );
 
-        bool                    allocateGpuBuffer( VulkanGpuBufferResult* pResult, VulkanGpuAllocator* pGpuAllocator, VulkanGpuMemoryUsage memoryUsage, VulkanGpuMemoryFlagMask flags, uint32 minAlignment, const VkBufferCreateInfo& bufferCreateInfo, const DebugName& debugName );
+        bool                    allocateGpuBuffer( VulkanGpuBufferResult* pResult, VulkanGpuAllocator* pGpuAllocator, VulkanGpuMemoryUsage memoryUsage, VulkanGpuMemoryFlagMask flags, uint32 minAlignment, uint32 memoryTypeBits, const VkBufferCreateInfo& bufferCreateInfo, const DebugName& debugName );
         void                    freeGpuBuffer( VulkanGpuAllocator* pGpuAllocator, VkBuffer buffer, VulkanGpuAllocationInfo allocationInfo );
 
         void                    flushCpuMemoryCache( VulkanGpuAllocator* pGpuAllocator, ArrayView<VulkanGpuAllocation*> allocations, ArrayView<uint64> offsets, ArrayView<uint64> sizes );
@@ -35,6 +35,9 @@ namespace keen
         KEEN_DEFINE_BOOL_VARIABLE( s_enableCompiledShaderInfo,      "vulkan/EnableCompiledShaderInfo", false, "" );
         KEEN_DEFINE_BOOL_VARIABLE( s_testWorstCaseOffsetAlignments, "vulkan/TestWorstCaseOffsetAlignments", KEEN_TRUE_IN_DEBUG, "" );
         KEEN_DEFINE_BOOL_VARIABLE( s_robustBufferAccess,            "vulkan/RobustBufferAccess", true, "" );
+        KEEN_DEFINE_BOOL_VARIABLE( s_enableExtendedDynamicState,    "vulkan/EnableExtendedDynamicState", false, "" );
+        KEEN_DEFINE_BOOL_VARIABLE( s_enableShaderObjects,           "vulkan/EnableShaderObjects", false, "" );
+        KEEN_DEFINE_BOOL_VARIABLE( s_enablePipelineBinaries,        "vulkan/EnablePipelineBinaries", false, "" );
 
         static constexpr uint32 VendorId_Nvidia = 0x10DEu;
         static constexpr uint32 VendorId_Amd = 0x1002u;
@@ -135,6 +138,7 @@ namespace keen
         objectsParameters.enableBindlessDescriptors     = parameters.enableBindlessDescriptors;
         objectsParameters.bindlessTextureCount          = parameters.bindlessTextureCount;
         objectsParameters.bindlessSamplerCount          = parameters.bindlessSamplerCount;      
+        objectsParameters.bindlessStorageBufferCount    = parameters.bindlessStorageBufferCount;
 
         error = m_objects.create( objectsParameters );
         if( error != ErrorId_Ok )
@@ -157,6 +161,7 @@ namespace keen
         renderContextParameters.enableBindlessDescriptors   = parameters.enableBindlessDescriptors;
         renderContextParameters.bindlessTextureCount        = parameters.bindlessTextureCount;
         renderContextParameters.bindlessSamplerCount        = parameters.bindlessSamplerCount;
+        renderContextParameters.bindlessStorageBufferCount  = parameters.bindlessStorageBufferCount;
 
         if( !m_renderContext.tryCreate( renderContextParameters ) )
         {
@@ -335,6 +340,20 @@ namespace keen
 
         KEEN_DISABLE_FLOATINGPOINT_EXCEPTIONS_SCOPE;
 
+        // host memory imports of batches that were never waited for (they might still be read by the transfer queue):
+        if( m_device != VK_NULL_HANDLE )
+        {
+            m_pVulkan->vkDeviceWaitIdle( m_device );
+
+            SynchronizedDataWriteLock<VulkanTransferQueue> sharedDataLock( &m_transferQueue );
+            VulkanTransferQueue* pTransferQueue = sharedDataLock.getData();
+
+            for( uint32 batchIndex = 0u; batchIndex < pTransferQueue->batches.getCount(); ++batchIndex )
+            {
+                destroyTransferBatchHostMemoryBuffers( &pTransferQueue->batches[ batchIndex ] );
+            }
+        }
+
         m_renderContext.destroy();
         m_objects.destroy();
         destroyDevice();
@@ -508,6 +527,97 @@ namespace keen
         }
     }
 
+    Result<void> VulkanGraphicsDevice::copyMemoryToTexture( GraphicsTexture* pTexture, ArrayView<const GraphicsHostTextureCopyRegion> regions, GraphicsTextureLayout oldLayout, GraphicsTextureLayout newLayout )
+    {
+        KEEN_PROFILE_CPU( Vk_copyMemoryToTexture );
+
+        const VulkanTexture* pVulkanTexture = (const VulkanTexture*)pTexture;
+        if( pVulkanTexture->image == VK_NULL_HANDLE )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Can't copy memory to texture view '%k' - use the viewed texture\n", pTexture->getDebugName() );
+            return ErrorId_InvalidValue;
+        }
+
+        VulkanTextureUploadRequest request;
+        request.isHostTransferTexture   = pVulkanTexture->isHostTransferEnabled;
+        request.layout                  = vulkan::getImageLayout( newLayout );
+        for( size_t i = 0u; i < regions.getCount(); ++i )
+        {
+            request.dataSize += regions[ i ].dataSize;
+        }
+
+        // :JK: not an error - the caller uploads the texture through a transfer batch instead
+        if( vulkan::selectTextureUploadPath( m_sharedData.hostImageCopyInfo, request ) != VulkanTextureUploadPath::HostImageCopy )
+        {
+            return ErrorId_NotSupported;
+        }
+
+        return vulkan::copyMemoryToImage( m_pVulkan, m_device, pVulkanTexture, regions, vulkan::getImageLayout( oldLayout ), request.layout );
+    }
+
+    Result<GraphicsExportedTextureMemory> VulkanGraphicsDevice::exportTextureMemory( const GraphicsTexture* pTexture )
+    {
+        const VulkanTexture* pVulkanTexture = (const VulkanTexture*)pTexture;
+        if( pVulkanTexture->exportableMemory.memory == VK_NULL_HANDLE )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Can't export memory of texture '%k' - it was not created with GraphicsTextureFlag::Exportable\n", pTexture->getDebugName() );
+            return ErrorId_InvalidValue;
+        }
+
+        return vulkan::exportImageMemory( m_pVulkan, m_device, m_sharedData.externalMemoryInfo, pVulkanTexture->exportableMemory );
+    }
+
+    GraphicsTimelineSemaphore* VulkanGraphicsDevice::createExportableTimelineSemaphore( uint64 initialValue, DebugName debugName )
+    {
+        if( !m_sharedData.externalMemoryInfo.isSupported )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Can't create exportable timeline semaphore '%k': external memory is not supported\n", debugName );
+            return nullptr;
+        }
+
+        const Result<VkSemaphore> semaphoreResult = vulkan::createExportableTimelineSemaphore( m_pVulkan, m_device, initialValue, m_sharedData.pVulkanAllocationCallbacks );
+        if( semaphoreResult.hasError() )
+        {
+            return nullptr;
+        }
+
+        VulkanTimelineSemaphore* pSemaphore = newObjectZero<VulkanTimelineSemaphore>( m_pAllocator, "VulkanTimelineSemaphore"_debug );
+        if( pSemaphore == nullptr )
+        {
+            m_pVulkan->vkDestroySemaphore( m_device, semaphoreResult.getValue(), m_sharedData.pVulkanAllocationCallbacks );
+            return nullptr;
+        }
+        pSemaphore->debugName   = debugName;
+        pSemaphore->semaphore   = semaphoreResult.getValue();
+
+        vulkan::setObjectName( m_pVulkan, m_device, (VkObjectHandle)pSemaphore->semaphore, VK_OBJECT_TYPE_SEMAPHORE, debugName );
+        return pSemaphore;
+    }
+
+    void VulkanGraphicsDevice::destroyTimelineSemaphore( GraphicsTimelineSemaphore* pSemaphore )
+    {
+        // :JK: the caller has to make sure that no frame that signals the semaphore is still running
+        VulkanTimelineSemaphore* pVulkanSemaphore = (VulkanTimelineSemaphore*)pSemaphore;
+        m_pVulkan->vkDestroySemaphore( m_device, pVulkanSemaphore->semaphore, m_sharedData.pVulkanAllocationCallbacks );
+        deleteObject( m_pAllocator, pVulkanSemaphore );
+    }
+
+    Result<sint32> VulkanGraphicsDevice::exportTimelineSemaphore( GraphicsTimelineSemaphore* pSemaphore )
+    {
+        const VulkanTimelineSemaphore* pVulkanSemaphore = (const VulkanTimelineSemaphore*)pSemaphore;
+        return vulkan::exportSemaphore( m_pVulkan, m_device, pVulkanSemaphore->semaphore );
+    }
+
+    void VulkanGraphicsDevice::signalTimelineSemaphore( GraphicsFrame* pFrame, GraphicsTimelineSemaphore* pSemaphore, uint64 value )
+    {
+        VulkanFrame* pVulkanFrame = (VulkanFrame*)pFrame;
+        const VulkanTimelineSemaphore* pVulkanSemaphore = (const VulkanTimelineSemaphore*)pSemaphore;
+        KEEN_ASSERT( pVulkanFrame->timelineSignalSemaphores.getRemainingCapacity() > 0u );
+
+        pVulkanFrame->timelineSignalSemaphores.pushBack( pVulkanSemaphore->semaphore );
+        pVulkanFrame->timelineSignalValues.pushBack( value );
+    }
+
     void VulkanGraphicsDevice::resetQueryPool( GraphicsQueryPool* pQueryPool, uint32 firstQuery, uint32 queryCount )
     {
         VulkanQueryPool* pVulkanQueryPool = (VulkanQueryPool*)pQueryPool;
@@ -599,6 +709,11 @@ namespace keen
         return m_objects.createQueryPool( parameters );
     }
 
+    GraphicsIndirectCommandsLayout* VulkanGraphicsDevice::createIndirectCommandsLayout( const GraphicsIndirectCommandsLayoutParameters& parameters )
+    {
+        return m_objects.createIndirectCommandsLayout( parameters );
+    }
+
     GraphicsMemoryRequirements VulkanGraphicsDevice::queryTextureMemoryRequirements( const GraphicsTexture* pTexture )
     {
         return m_objects.queryTextureMemoryRequirements( (const VulkanTexture*)pTexture );
@@ -632,6 +747,12 @@ namespace keen
         pSwapChainWrapper->info.presentationInterval = presentationInterval;
     }
 
+    void VulkanGraphicsDevice::setSwapChainDamageRegion( GraphicsSwapChain* pSwapChain, ArrayView<const GraphicsRectangle> damageRectangles )
+    {
+        VulkanSwapChainWrapper* pSwapChainWrapper = (VulkanSwapChainWrapper*)pSwapChain;
+        pSwapChainWrapper->pSwapChain->setDamageRegion( damageRectangles );
+    }
+
     GraphicsComputePipeline* VulkanGraphicsDevice::createComputePipeline( const GraphicsComputePipelineParameters& parameters )
     {
         return m_objects.createComputePipeline( parameters );
@@ -741,7 +862,7 @@ namespace keen
         VkShaderStageFlags seenStages = 0u;
         for( uint32 executableIndex = 0u; executableIndex < executableCount; ++executableIndex )
         {
-            const uint32 executableGraphicsStages = executableProperties[ executableIndex ].stages & VK_SHADER_STAGE_ALL_GRAPHICS;
+            const uint32 executableGraphicsStages = executableProperties[ executableIndex ].stages & ( VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT );
 
             if( isAnyBitSet( seenStages, executableGraphicsStages ) )
             {
@@ -785,6 +906,14 @@ namespace keen
                 {
                     pPipelineInfo->fragment.nvidia.set( nvidia );
                 }
+                if( isBitmaskSet( executableProperties[ executableIndex ].stages, VK_SHADER_STAGE_TASK_BIT_EXT ) )
+                {
+                    pPipelineInfo->task.nvidia.set( nvidia );
+                }
+                if( isBitmaskSet( executableProperties[ executableIndex ].stages, VK_SHADER_STAGE_MESH_BIT_EXT ) )
+                {
+                    pPipelineInfo->mesh.nvidia.set( nvidia );
+                }
             }
         }
     }
@@ -848,6 +977,11 @@ namespace keen
         getCompiledPipelineStageInfoAMD( &pCompiledPipelineInfo->tessellationControl, m_pVulkan, pVulkanRenderPipeline->pipeline, VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT );
         getCompiledPipelineStageInfoAMD( &pCompiledPipelineInfo->tessellationEvaluation, m_pVulkan, pVulkanRenderPipeline->pipeline, VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT );
         getCompiledPipelineStageInfoAMD( &pCompiledPipelineInfo->fragment, m_pVulkan, pVulkanRenderPipeline->pipeline, VK_SHADER_STAGE_FRAGMENT_BIT );
+        if( m_pVulkan->EXT_mesh_shader )
+        {
+            getCompiledPipelineStageInfoAMD( &pCompiledPipelineInfo->task, m_pVulkan, pVulkanRenderPipeline->pipeline, VK_SHADER_STAGE_TASK_BIT_EXT );
+            getCompiledPipelineStageInfoAMD( &pCompiledPipelineInfo->mesh, m_pVulkan, pVulkanRenderPipeline->pipeline, VK_SHADER_STAGE_MESH_BIT_EXT );
+        }
 
         getCompiledRenderPipelineInfoKHR( pCompiledPipelineInfo, m_pVulkan, pVulkanRenderPipeline->pipeline );
     }
@@ -970,6 +1104,7 @@ namespace keen
         const GraphicsTransferBatchId id = pTransferQueue->nextId;
 
         VulkanTransferBatch* pBatch = &pTransferQueue->batches[ batchIndex ];
+        KEEN_ASSERT( !pBatch->hostMemoryBuffers.hasElements() );
         pBatch->id                  = id;
         pBatch->debugName           = debugName;
         pBatch->pFirstCommandBuffer = nullptr;
@@ -1024,6 +1159,9 @@ namespace keen
             }
         }
 
+        // the gpu is done with the imported host memory:
+        destroyTransferBatchHostMemoryBuffers( pBatch );
+
         // free the batch:
         {
             SynchronizedDataWriteLock<VulkanTransferQueue> sharedDataLock( &m_transferQueue );
@@ -1039,6 +1177,44 @@ namespace keen
         return result.getErrorId();
     }
 
+    GraphicsBuffer* VulkanGraphicsDevice::importHostMemoryBuffer( GraphicsTransferBatch* pTransferBatch, ConstMemoryBlock hostMemory, DebugName debugName )
+    {
+        KEEN_PROFILE_CPU( Vk_importHostMemoryBuffer );
+
+        VulkanTransferBatch* pBatch = (VulkanTransferBatch*)pTransferBatch;
+        KEEN_ASSERT( pBatch != nullptr && pBatch->id.value != 0u );
+
+        if( !m_sharedData.info.supportedFeatures.isSet( GraphicsFeature::HostMemoryImport ) )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Can't import host memory for buffer '%k': host memory import is not supported\n", debugName );
+            return nullptr;
+        }
+        if( pBatch->hostMemoryBuffers.getRemainingCapacity() == 0u )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Can't import host memory for buffer '%k': too many imports in transfer batch '%k'\n", debugName, pBatch->debugName );
+            return nullptr;
+        }
+
+        VulkanBuffer* pBuffer = m_objects.createHostMemoryBuffer( hostMemory, debugName );
+        if( pBuffer == nullptr )
+        {
+            return nullptr;
+        }
+
+        // :JK: the batch is owned by the caller until waitForTransferBatch - so no lock is needed here
+        pBatch->hostMemoryBuffers.pushBack( pBuffer );
+        return pBuffer;
+    }
+
+    void VulkanGraphicsDevice::destroyTransferBatchHostMemoryBuffers( VulkanTransferBatch* pBatch )
+    {
+        for( size_t i = 0u; i < pBatch->hostMemoryBuffers.getCount(); ++i )
+        {
+            m_objects.destroyDeviceObject( pBatch->hostMemoryBuffers[ i ] );
+        }
+        pBatch->hostMemoryBuffers.clear();
+    }
+
     void VulkanGraphicsDevice::waitForGpuIdle( const ArrayView<GraphicsDeviceObject*> destroyObjects )
     {
         m_renderContext.waitForAllFramesFinished();
@@ -1390,6 +1566,13 @@ namespace keen
             VkPhysicalDeviceProperties2                             deviceProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, &devicePropertiesVulkan11 };
             VkPhysicalDeviceVulkan11Properties                      devicePropertiesVulkan11 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_PROPERTIES, &devicePropertiesVulkan12 };
             VkPhysicalDeviceVulkan12Properties                      devicePropertiesVulkan12 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES };
+            VkPhysicalDeviceFragmentShadingRatePropertiesKHR        devicePropertiesFragmentShadingRate = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_PROPERTIES_KHR };
+            VkPhysicalDeviceDeviceGeneratedCommandsPropertiesEXT    devicePropertiesDeviceGeneratedCommands = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DEVICE_GENERATED_COMMANDS_PROPERTIES_EXT };
+            VkPhysicalDevicePipelineBinaryPropertiesKHR             devicePropertiesPipelineBinary = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_BINARY_PROPERTIES_KHR };
+            VkPhysicalDeviceInlineUniformBlockPropertiesEXT         devicePropertiesInlineUniformBlock = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INLINE_UNIFORM_BLOCK_PROPERTIES_EXT };
+            VkPhysicalDeviceHostImageCopyPropertiesEXT              devicePropertiesHostImageCopy = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_PROPERTIES_EXT };
+            VkImageLayout                                           hostImageCopyDstLayouts[ VulkanMaxHostImageCopyLayoutCount ];
+            VkPhysicalDeviceExternalMemoryHostPropertiesEXT         devicePropertiesExternalMemoryHost = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT };
 
             void **ppNextProperties                                 = &devicePropertiesVulkan12.pNext;
             VkPhysicalDeviceFeatures2                               deviceFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, &deviceFeaturesVulkan11 };
@@ -1399,6 +1582,20 @@ namespace keen
             VkPhysicalDeviceDynamicRenderingFeatures                deviceFeaturesDynamicRendering = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES };
             VkPhysicalDeviceMemoryPriorityFeaturesEXT               deviceFeaturesMemoryPriority = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT };
             VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT    deviceFeaturesPageableDeviceLocalMemory = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT };
+            VkPhysicalDeviceMeshShaderFeaturesEXT                   deviceFeaturesMeshShader = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT };
+            VkPhysicalDeviceFragmentShadingRateFeaturesKHR          deviceFeaturesFragmentShadingRate = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_FEATURES_KHR };
+            VkPhysicalDeviceMaintenance5FeaturesKHR                 deviceFeaturesMaintenance5 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_5_FEATURES_KHR };
+            VkPhysicalDeviceDeviceGeneratedCommandsFeaturesEXT      deviceFeaturesDeviceGeneratedCommands = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DEVICE_GENERATED_COMMANDS_FEATURES_EXT };
+            VkPhysicalDeviceExtendedDynamicStateFeaturesEXT         deviceFeaturesExtendedDynamicState = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT };
+            VkPhysicalDeviceExtendedDynamicState2FeaturesEXT        deviceFeaturesExtendedDynamicState2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT };
+            VkPhysicalDeviceExtendedDynamicState3FeaturesEXT        deviceFeaturesExtendedDynamicState3 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT };
+            VkPhysicalDeviceVertexInputDynamicStateFeaturesEXT      deviceFeaturesVertexInputDynamicState = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VERTEX_INPUT_DYNAMIC_STATE_FEATURES_EXT };
+            VkPhysicalDeviceShaderObjectFeaturesEXT                 deviceFeaturesShaderObject = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT };
+            VkPhysicalDevicePipelineBinaryFeaturesKHR               deviceFeaturesPipelineBinary = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_BINARY_FEATURES_KHR };
+            VkPhysicalDeviceInlineUniformBlockFeaturesEXT           deviceFeaturesInlineUniformBlock = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INLINE_UNIFORM_BLOCK_FEATURES_EXT };
+            VkPhysicalDeviceDynamicRenderingLocalReadFeaturesKHR    deviceFeaturesDynamicRenderingLocalRead = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_LOCAL_READ_FEATURES_KHR };
+            VkPhysicalDeviceConditionalRenderingFeaturesEXT         deviceFeaturesConditionalRendering = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT };
+            VkPhysicalDeviceHostImageCopyFeaturesEXT                deviceFeaturesHostImageCopy = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT };
 #if KEEN_USING( KEEN_COMPILED_SHADER_INFO )
             VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR deviceFeaturesPipelineExecutableProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_EXECUTABLE_PROPERTIES_FEATURES_KHR };
 #endif
@@ -1411,6 +1608,17 @@ namespace keen
             DynamicArray<const char*, 64u>                          activeDeviceExtensions;
 
             bool                                                    isMemoryPrioritySupported = false;
+            bool                                                    isMeshShaderSupported = false;
+            bool                                                    isFragmentShadingRateSupported = false;
+            bool                                                    isDeviceGeneratedCommandsSupported = false;
+            bool                                                    isShaderObjectSupported = false;
+            bool                                                    isInlineUniformBlockSupported = false;
+            bool                                                    isDynamicRenderingLocalReadSupported = false;
+            bool                                                    isConditionalRenderingSupported = false;
+            bool                                                    isHostImageCopySupported = false;
+            bool                                                    isExternalMemoryHostSupported = false;
+            bool                                                    isExternalMemoryFdSupported = false;
+            VulkanDynamicStateFeatureMask                           dynamicStateFeatures;
             bool                                                    isSupported = false;
         };
         Array<PhysicalDeviceInfo> physicalDeviceInfo;
@@ -1434,6 +1642,23 @@ namespace keen
             VkPhysicalDeviceFeatures2                   deviceFeatures2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, &deviceFeaturesVulkan11 };
             const VkPhysicalDeviceFeatures&             deviceFeatures = deviceFeatures2.features;
 
+            // optional extension features are only added to the query chain if the device supports the extension:
+            VkPhysicalDeviceMeshShaderFeaturesEXT       deviceFeaturesMeshShader = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT };
+            VkPhysicalDeviceFragmentShadingRateFeaturesKHR  deviceFeaturesFragmentShadingRate = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_FEATURES_KHR };
+            VkPhysicalDeviceMaintenance5FeaturesKHR     deviceFeaturesMaintenance5 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_5_FEATURES_KHR };
+            VkPhysicalDeviceDeviceGeneratedCommandsFeaturesEXT  deviceFeaturesDeviceGeneratedCommands = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DEVICE_GENERATED_COMMANDS_FEATURES_EXT };
+            VkPhysicalDeviceExtendedDynamicStateFeaturesEXT     deviceFeaturesExtendedDynamicState = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT };
+            VkPhysicalDeviceExtendedDynamicState2FeaturesEXT    deviceFeaturesExtendedDynamicState2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT };
+            VkPhysicalDeviceExtendedDynamicState3FeaturesEXT    deviceFeaturesExtendedDynamicState3 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT };
+            VkPhysicalDeviceVertexInputDynamicStateFeaturesEXT  deviceFeaturesVertexInputDynamicState = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VERTEX_INPUT_DYNAMIC_STATE_FEATURES_EXT };
+            VkPhysicalDeviceShaderObjectFeaturesEXT     deviceFeaturesShaderObject = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT };
+            VkPhysicalDevicePipelineBinaryFeaturesKHR   deviceFeaturesPipelineBinary = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_BINARY_FEATURES_KHR };
+            VkPhysicalDeviceInlineUniformBlockFeaturesEXT   deviceFeaturesInlineUniformBlock = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INLINE_UNIFORM_BLOCK_FEATURES_EXT };
+            VkPhysicalDeviceDynamicRenderingLocalReadFeaturesKHR    deviceFeaturesDynamicRenderingLocalRead = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_LOCAL_READ_FEATURES_KHR };
+            VkPhysicalDeviceConditionalRenderingFeaturesEXT deviceFeaturesConditionalRendering = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT };
+            VkPhysicalDeviceHostImageCopyFeaturesEXT    deviceFeaturesHostImageCopy = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT };
+            void**                                      ppNextQueryFeatures = &deviceFeaturesVulkan12.pNext;
+
             m_pVulkan->vkGetPhysicalDeviceProperties( physicalDevices[ physicalDeviceIndex ], &pDeviceInfo->deviceProperties.properties );
 
             KEEN_TRACE_INFO( "[graphics] Vulkan device %d (%s):\n", physicalDeviceIndex, deviceProperties.deviceName );
@@ -1456,6 +1681,75 @@ namespace keen
                 continue;
             }
 
+            if( layerExtensionInfo.hasExtension( VK_EXT_MESH_SHADER_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesMeshShader );
+            }
+            if( layerExtensionInfo.hasExtension( VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesFragmentShadingRate );
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextProperties, &pDeviceInfo->devicePropertiesFragmentShadingRate );
+            }
+            if( layerExtensionInfo.hasExtension( VK_KHR_MAINTENANCE_5_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesMaintenance5 );
+            }
+            if( layerExtensionInfo.hasExtension( VK_EXT_DEVICE_GENERATED_COMMANDS_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesDeviceGeneratedCommands );
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextProperties, &pDeviceInfo->devicePropertiesDeviceGeneratedCommands );
+            }
+            if( layerExtensionInfo.hasExtension( VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesExtendedDynamicState );
+            }
+            if( layerExtensionInfo.hasExtension( VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesExtendedDynamicState2 );
+            }
+            if( layerExtensionInfo.hasExtension( VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesExtendedDynamicState3 );
+            }
+            if( layerExtensionInfo.hasExtension( VK_EXT_VERTEX_INPUT_DYNAMIC_STATE_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesVertexInputDynamicState );
+            }
+            if( layerExtensionInfo.hasExtension( VK_EXT_SHADER_OBJECT_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesShaderObject );
+            }
+            if( layerExtensionInfo.hasExtension( VK_KHR_PIPELINE_BINARY_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesPipelineBinary );
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextProperties, &pDeviceInfo->devicePropertiesPipelineBinary );
+            }
+            if( layerExtensionInfo.hasExtension( VK_EXT_INLINE_UNIFORM_BLOCK_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesInlineUniformBlock );
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextProperties, &pDeviceInfo->devicePropertiesInlineUniformBlock );
+            }
+            if( layerExtensionInfo.hasExtension( VK_KHR_DYNAMIC_RENDERING_LOCAL_READ_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesDynamicRenderingLocalRead );
+            }
+            if( layerExtensionInfo.hasExtension( VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesConditionalRendering );
+            }
+            if( layerExtensionInfo.hasExtension( VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME ) )
+            {
+                // :JK: only the destination layouts are needed - the source layouts are for image to memory copies
+                pDeviceInfo->devicePropertiesHostImageCopy.copyDstLayoutCount   = (uint32)VulkanMaxHostImageCopyLayoutCount;
+                pDeviceInfo->devicePropertiesHostImageCopy.pCopyDstLayouts      = pDeviceInfo->hostImageCopyDstLayouts;
+                vulkan::appendToStructChain( &ppNextQueryFeatures, &deviceFeaturesHostImageCopy );
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextProperties, &pDeviceInfo->devicePropertiesHostImageCopy );
+            }
+            if( layerExtensionInfo.hasExtension( VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME ) )
+            {
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextProperties, &pDeviceInfo->devicePropertiesExternalMemoryHost );
+            }
+
             m_pVulkan->vkGetPhysicalDeviceProperties2( physicalDevices[ physicalDeviceIndex ], &pDeviceInfo->deviceProperties );
             m_pVulkan->vkGetPhysicalDeviceFeatures2( physicalDevices[ physicalDeviceIndex ], &deviceFeatures2 );
 
@@ -1698,6 +1992,28 @@ namespace keen
             KEEN_TRACE_INFO( "[graphics] - shaderOutputViewportIndex: %s\n", deviceFeaturesVulkan12.shaderOutputViewportIndex ? "VK_TRUE" : "VK_FALSE" );
             KEEN_TRACE_INFO( "[graphics] - shaderOutputLayer: %s\n", deviceFeaturesVulkan12.shaderOutputLayer ? "VK_TRUE" : "VK_FALSE" );
             KEEN_TRACE_INFO( "[graphics] - subgroupBroadcastDynamicId: %s\n", deviceFeaturesVulkan12.subgroupBroadcastDynamicId ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - taskShader: %s\n", deviceFeaturesMeshShader.taskShader ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - meshShader: %s\n", deviceFeaturesMeshShader.meshShader ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - pipelineFragmentShadingRate: %s\n", deviceFeaturesFragmentShadingRate.pipelineFragmentShadingRate ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - primitiveFragmentShadingRate: %s\n", deviceFeaturesFragmentShadingRate.primitiveFragmentShadingRate ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - attachmentFragmentShadingRate: %s\n", deviceFeaturesFragmentShadingRate.attachmentFragmentShadingRate ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - maintenance5: %s\n", deviceFeaturesMaintenance5.maintenance5 ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - deviceGeneratedCommands: %s\n", deviceFeaturesDeviceGeneratedCommands.deviceGeneratedCommands ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - dynamicGeneratedPipelineLayout: %s\n", deviceFeaturesDeviceGeneratedCommands.dynamicGeneratedPipelineLayout ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - extendedDynamicState: %s\n", deviceFeaturesExtendedDynamicState.extendedDynamicState ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - extendedDynamicState2: %s\n", deviceFeaturesExtendedDynamicState2.extendedDynamicState2 ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - extendedDynamicState3PolygonMode: %s\n", deviceFeaturesExtendedDynamicState3.extendedDynamicState3PolygonMode ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - extendedDynamicState3ColorBlendEquation: %s\n", deviceFeaturesExtendedDynamicState3.extendedDynamicState3ColorBlendEquation ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - vertexInputDynamicState: %s\n", deviceFeaturesVertexInputDynamicState.vertexInputDynamicState ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - shaderObject: %s\n", deviceFeaturesShaderObject.shaderObject ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - pipelineBinaries: %s\n", deviceFeaturesPipelineBinary.pipelineBinaries ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - pipelineBinaryPrefersInternalCache: %s\n", pDeviceInfo->devicePropertiesPipelineBinary.pipelineBinaryPrefersInternalCache ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - inlineUniformBlock: %s\n", deviceFeaturesInlineUniformBlock.inlineUniformBlock ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - maxInlineUniformBlockSize: %,d\n", pDeviceInfo->devicePropertiesInlineUniformBlock.maxInlineUniformBlockSize );
+            KEEN_TRACE_INFO( "[graphics] - dynamicRenderingLocalRead: %s\n", deviceFeaturesDynamicRenderingLocalRead.dynamicRenderingLocalRead ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - conditionalRendering: %s\n", deviceFeaturesConditionalRendering.conditionalRendering ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - hostImageCopy: %s\n", deviceFeaturesHostImageCopy.hostImageCopy ? "VK_TRUE" : "VK_FALSE" );
+            KEEN_TRACE_INFO( "[graphics] - minImportedHostPointerAlignment: %,d\n", pDeviceInfo->devicePropertiesExternalMemoryHost.minImportedHostPointerAlignment );
 
             if( !devicePropertiesVulkan12.shaderSignedZeroInfNanPreserveFloat32 )
             {
@@ -1712,6 +2028,12 @@ namespace keen
             }
             pDeviceInfo->activeDeviceExtensions.pushBack( VK_KHR_SWAPCHAIN_EXTENSION_NAME );
 
+            // optional: lets the compositor only update the damaged rectangles of a swap chain image
+            if( layerExtensionInfo.hasExtension( VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME ) )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME );
+            }
+
             if( !deviceFeaturesVulkan12.scalarBlockLayout )
             {
                 KEEN_TRACE_INFO( "[graphics] skipping device because it does not support scalar Block layout!\n" );
@@ -1759,6 +2081,30 @@ namespace keen
                 vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesPageableDeviceLocalMemory );
             }
 
+            // :JK: we only expose mesh pipelines with an (optional) task stage, so require both
+            if( deviceFeaturesMeshShader.meshShader && deviceFeaturesMeshShader.taskShader )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_EXT_MESH_SHADER_EXTENSION_NAME );
+                pDeviceInfo->deviceFeaturesMeshShader.taskShader    = VK_TRUE;
+                pDeviceInfo->deviceFeaturesMeshShader.meshShader    = VK_TRUE;
+                pDeviceInfo->deviceFeaturesMeshShader.multiviewMeshShader = deviceFeaturesMeshShader.multiviewMeshShader && deviceFeaturesVulkan11.multiview;
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesMeshShader );
+
+                pDeviceInfo->isMeshShaderSupported = true;
+            }
+
+            // pipelineFragmentShadingRate is required to be supported when the extension is supported
+            if( deviceFeaturesFragmentShadingRate.pipelineFragmentShadingRate )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME );
+                pDeviceInfo->deviceFeaturesFragmentShadingRate.pipelineFragmentShadingRate      = VK_TRUE;
+                pDeviceInfo->deviceFeaturesFragmentShadingRate.primitiveFragmentShadingRate     = deviceFeaturesFragmentShadingRate.primitiveFragmentShadingRate;
+                pDeviceInfo->deviceFeaturesFragmentShadingRate.attachmentFragmentShadingRate    = deviceFeaturesFragmentShadingRate.attachmentFragmentShadingRate;
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesFragmentShadingRate );
+
+                pDeviceInfo->isFragmentShadingRateSupported = true;
+            }
+
 #if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
 #if KEEN_USING( KEEN_TRACE_FEATURE )
             if( layerExtensionInfo.hasExtension( VK_NV_DEVICE_DIAGNOSTIC_CHECKPOINTS_EXTENSION_NAME ) )
@@ -1903,6 +2249,9 @@ namespace keen
             }
             pDeviceInfo->deviceFeatures.features.shaderStorageImageWriteWithoutFormat = VK_TRUE;
 
+            // optional: occlusion queries return the exact sample count (GraphicsFeature::PreciseOcclusionQuery)
+            pDeviceInfo->deviceFeatures.features.occlusionQueryPrecise = deviceFeatures.occlusionQueryPrecise;
+
             pDeviceInfo->deviceFeatures.features.shaderInt16    = deviceFeatures.shaderInt16; // We need this for FSR support
             pDeviceInfo->deviceFeaturesVulkan12.shaderFloat16   = deviceFeaturesVulkan12.shaderFloat16; // We need this for FSR support
 
@@ -1946,6 +2295,152 @@ namespace keen
 
             pDeviceInfo->deviceFeatures.features.shaderInt64    = deviceFeatures.shaderInt64;
 
+            // optional: used for the bindless buffer address table
+            pDeviceInfo->deviceFeaturesVulkan12.bufferDeviceAddress = deviceFeaturesVulkan12.bufferDeviceAddress;
+
+            // optional: cube faces, cascades and eyes in a single rendering scope (multiview is core since vulkan 1.1)
+            pDeviceInfo->deviceFeaturesVulkan11.multiview                   = deviceFeaturesVulkan11.multiview;
+            pDeviceInfo->deviceFeaturesVulkan11.multiviewTessellationShader = deviceFeaturesVulkan11.multiview && deviceFeaturesVulkan11.multiviewTessellationShader;
+            pDeviceInfo->deviceFeaturesVulkan12.shaderOutputLayer           = deviceFeaturesVulkan12.shaderOutputLayer;
+
+            // optional: device generated commands read all their inputs through buffer device addresses and need the flags2 usage bits of maintenance5
+            if( deviceFeaturesDeviceGeneratedCommands.deviceGeneratedCommands && deviceFeaturesMaintenance5.maintenance5 && deviceFeaturesVulkan12.bufferDeviceAddress )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_KHR_MAINTENANCE_5_EXTENSION_NAME );
+                pDeviceInfo->deviceFeaturesMaintenance5.maintenance5 = VK_TRUE;
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesMaintenance5 );
+
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_EXT_DEVICE_GENERATED_COMMANDS_EXTENSION_NAME );
+                pDeviceInfo->deviceFeaturesDeviceGeneratedCommands.deviceGeneratedCommands = VK_TRUE;
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesDeviceGeneratedCommands );
+
+                pDeviceInfo->isDeviceGeneratedCommandsSupported = true;
+            }
+
+            // optional: set the fixed function state at record time instead of baking it into every pipeline permutation.
+            // :JK: the later levels are only used on top of the first one - the pipeline key assumes this
+            if( vulkan::s_enableExtendedDynamicState && deviceFeaturesExtendedDynamicState.extendedDynamicState )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME );
+                pDeviceInfo->deviceFeaturesExtendedDynamicState.extendedDynamicState = VK_TRUE;
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesExtendedDynamicState );
+                pDeviceInfo->dynamicStateFeatures.set( VulkanDynamicStateFeature::ExtendedDynamicState );
+
+                if( deviceFeaturesExtendedDynamicState2.extendedDynamicState2 )
+                {
+                    pDeviceInfo->activeDeviceExtensions.pushBack( VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME );
+                    pDeviceInfo->deviceFeaturesExtendedDynamicState2.extendedDynamicState2 = VK_TRUE;
+                    vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesExtendedDynamicState2 );
+                    pDeviceInfo->dynamicStateFeatures.set( VulkanDynamicStateFeature::ExtendedDynamicState2 );
+                }
+
+                const VkPhysicalDeviceExtendedDynamicState3FeaturesEXT& features3 = deviceFeaturesExtendedDynamicState3;
+                if( features3.extendedDynamicState3PolygonMode && features3.extendedDynamicState3ColorBlendEnable && features3.extendedDynamicState3ColorBlendEquation &&
+                    features3.extendedDynamicState3ColorWriteMask && features3.extendedDynamicState3AlphaToCoverageEnable )
+                {
+                    pDeviceInfo->activeDeviceExtensions.pushBack( VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME );
+                    pDeviceInfo->deviceFeaturesExtendedDynamicState3.extendedDynamicState3PolygonMode           = VK_TRUE;
+                    pDeviceInfo->deviceFeaturesExtendedDynamicState3.extendedDynamicState3ColorBlendEnable      = VK_TRUE;
+                    pDeviceInfo->deviceFeaturesExtendedDynamicState3.extendedDynamicState3ColorBlendEquation    = VK_TRUE;
+                    pDeviceInfo->deviceFeaturesExtendedDynamicState3.extendedDynamicState3ColorWriteMask        = VK_TRUE;
+                    pDeviceInfo->deviceFeaturesExtendedDynamicState3.extendedDynamicState3AlphaToCoverageEnable = VK_TRUE;
+                    vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesExtendedDynamicState3 );
+                    pDeviceInfo->dynamicStateFeatures.set( VulkanDynamicStateFeature::ExtendedDynamicState3 );
+                }
+
+                if( deviceFeaturesVertexInputDynamicState.vertexInputDynamicState )
+                {
+                    pDeviceInfo->activeDeviceExtensions.pushBack( VK_EXT_VERTEX_INPUT_DYNAMIC_STATE_EXTENSION_NAME );
+                    pDeviceInfo->deviceFeaturesVertexInputDynamicState.vertexInputDynamicState = VK_TRUE;
+                    vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesVertexInputDynamicState );
+                    pDeviceInfo->dynamicStateFeatures.set( VulkanDynamicStateFeature::VertexInputDynamicState );
+                }
+            }
+
+            // optional (tools): render pipelines are created from per stage VkShaderEXTs - no pipeline compile at all, but slower draws
+            if( vulkan::s_enableShaderObjects && deviceFeaturesShaderObject.shaderObject )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_EXT_SHADER_OBJECT_EXTENSION_NAME );
+                pDeviceInfo->deviceFeaturesShaderObject.shaderObject = VK_TRUE;
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesShaderObject );
+
+                pDeviceInfo->isShaderObjectSupported = true;
+            }
+
+            // optional: pipelines are created from binaries that we store ourselves instead of going through the opaque pipeline cache
+            if( vulkan::s_enablePipelineBinaries && deviceFeaturesPipelineBinary.pipelineBinaries && deviceFeaturesMaintenance5.maintenance5 )
+            {
+                if( !pDeviceInfo->deviceFeaturesMaintenance5.maintenance5 )
+                {
+                    pDeviceInfo->activeDeviceExtensions.pushBack( VK_KHR_MAINTENANCE_5_EXTENSION_NAME );
+                    pDeviceInfo->deviceFeaturesMaintenance5.maintenance5 = VK_TRUE;
+                    vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesMaintenance5 );
+                }
+
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_KHR_PIPELINE_BINARY_EXTENSION_NAME );
+                pDeviceInfo->deviceFeaturesPipelineBinary.pipelineBinaries = VK_TRUE;
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesPipelineBinary );
+            }
+
+            // optional: small constant blocks are stored in the descriptor set instead of a uniform buffer (core in vulkan 1.3)
+            if( deviceFeaturesInlineUniformBlock.inlineUniformBlock )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_EXT_INLINE_UNIFORM_BLOCK_EXTENSION_NAME );
+                pDeviceInfo->deviceFeaturesInlineUniformBlock.inlineUniformBlock = VK_TRUE;
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesInlineUniformBlock );
+
+                pDeviceInfo->isInlineUniformBlockSupported = true;
+            }
+
+            // optional: attachments can be read as input attachments inside the rendering scope that writes them (keeps g-buffers in tile memory)
+            if( deviceFeaturesDynamicRenderingLocalRead.dynamicRenderingLocalRead )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_KHR_DYNAMIC_RENDERING_LOCAL_READ_EXTENSION_NAME );
+                pDeviceInfo->deviceFeaturesDynamicRenderingLocalRead.dynamicRenderingLocalRead = VK_TRUE;
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesDynamicRenderingLocalRead );
+
+                pDeviceInfo->isDynamicRenderingLocalReadSupported = true;
+            }
+
+            // optional: draws and dispatches are skipped based on a predicate in a buffer (i.e. gpu driven occlusion culling without readback)
+            if( deviceFeaturesConditionalRendering.conditionalRendering )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME );
+                pDeviceInfo->deviceFeaturesConditionalRendering.conditionalRendering = VK_TRUE;
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesConditionalRendering );
+
+                pDeviceInfo->isConditionalRenderingSupported = true;
+            }
+
+            // optional: textures are written from the cpu without staging memory and transfer queue submits
+            if( deviceFeaturesHostImageCopy.hostImageCopy )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME );
+                pDeviceInfo->deviceFeaturesHostImageCopy.hostImageCopy = VK_TRUE;
+                vulkan::appendToStructChain( &pDeviceInfo->ppNextFeatures, &pDeviceInfo->deviceFeaturesHostImageCopy );
+
+                pDeviceInfo->isHostImageCopySupported = true;
+            }
+
+            // optional: page aligned host memory (i.e. memory mapped asset files) is used as copy source without a copy into staging memory
+            if( layerExtensionInfo.hasExtension( VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME ) && pDeviceInfo->devicePropertiesExternalMemoryHost.minImportedHostPointerAlignment > 0u )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME );
+
+                pDeviceInfo->isExternalMemoryHostSupported = true;
+            }
+
+#if defined( KEEN_PLATFORM_LINUX )
+            // optional: textures and timeline semaphores are shared with other processes (i.e. a capture encoder) as opaque fds
+            if( layerExtensionInfo.hasExtension( VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME ) && layerExtensionInfo.hasExtension( VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME ) )
+            {
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME );
+                pDeviceInfo->activeDeviceExtensions.pushBack( VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME );
+
+                pDeviceInfo->isExternalMemoryFdSupported = true;
+            }
+#endif
+
             pDeviceInfo->isSupported = true;
         }
 
@@ -2083,6 +2578,48 @@ namespace keen
         {
             m_sharedData.info.optionalShaderStages |= GraphicsOptionalShaderStageFlag::TessellationShaders;
         }
+        if( pSelectedDeviceInfo->isMeshShaderSupported )
+        {
+            m_sharedData.info.optionalShaderStages |= GraphicsOptionalShaderStageFlag::MeshShaders;
+        }
+
+        if( pSelectedDeviceInfo->isFragmentShadingRateSupported )
+        {
+            const VkPhysicalDeviceFragmentShadingRatePropertiesKHR& shadingRateProperties = pSelectedDeviceInfo->devicePropertiesFragmentShadingRate;
+
+            m_sharedData.info.isPipelineShadingRateSupported    = true;
+            m_sharedData.info.isPrimitiveShadingRateSupported   = pSelectedDeviceInfo->deviceFeaturesFragmentShadingRate.primitiveFragmentShadingRate == VK_TRUE;
+            m_sharedData.info.isAttachmentShadingRateSupported  = pSelectedDeviceInfo->deviceFeaturesFragmentShadingRate.attachmentFragmentShadingRate == VK_TRUE;
+            m_sharedData.info.minShadingRateTexelSize           = uint2{ shadingRateProperties.minFragmentShadingRateAttachmentTexelSize.width, shadingRateProperties.minFragmentShadingRateAttachmentTexelSize.height };
+            m_sharedData.info.maxShadingRateTexelSize           = uint2{ shadingRateProperties.maxFragmentShadingRateAttachmentTexelSize.width, shadingRateProperties.maxFragmentShadingRateAttachmentTexelSize.height };
+        }
+
+        // :JK: the indirect execution sets are only implemented for pipelines - so no device generated commands with shader objects
+        if( pSelectedDeviceInfo->isDeviceGeneratedCommandsSupported && !pSelectedDeviceInfo->isShaderObjectSupported )
+        {
+            m_sharedData.deviceGeneratedCommandsProperties          = pSelectedDeviceInfo->devicePropertiesDeviceGeneratedCommands;
+            m_sharedData.deviceGeneratedCommandsProperties.pNext    = nullptr;  // this should never be used, so reset it to be safe
+
+            m_sharedData.info.isDeviceGeneratedCommandsSupported    = true;
+            m_sharedData.info.maxIndirectPipelineCount              = m_sharedData.deviceGeneratedCommandsProperties.maxIndirectPipelineCount;
+            m_sharedData.info.maxIndirectSequenceCount              = m_sharedData.deviceGeneratedCommandsProperties.maxIndirectSequenceCount;
+        }
+
+        m_sharedData.dynamicStateFeatures                   = pSelectedDeviceInfo->dynamicStateFeatures;
+        m_sharedData.info.isExtendedDynamicStateSupported   = pSelectedDeviceInfo->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState );
+        m_sharedData.info.isExtendedDynamicState2Supported  = pSelectedDeviceInfo->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState2 );
+        m_sharedData.info.isExtendedDynamicState3Supported  = pSelectedDeviceInfo->dynamicStateFeatures.isSet( VulkanDynamicStateFeature::ExtendedDynamicState3 );
+
+        m_sharedData.useShaderObjects = pSelectedDeviceInfo->isShaderObjectSupported;
+        if( m_sharedData.useShaderObjects )
+        {
+            // shader object pipelines set all of the extended dynamic state on bind - so the set state commands are always available:
+            m_sharedData.shaderObjectStageMask                  = vulkan::getShaderObjectBindStageMask( pSelectedDeviceInfo->deviceFeatures.features, pSelectedDeviceInfo->isMeshShaderSupported );
+            m_sharedData.info.isExtendedDynamicStateSupported   = true;
+            m_sharedData.info.isExtendedDynamicState2Supported  = true;
+            m_sharedData.info.isExtendedDynamicState3Supported  = true;
+            m_sharedData.info.supportedFeatures.set( GraphicsFeature::ShaderObject );
+        }
 
         if( pSelectedDeviceInfo->deviceFeatures.features.shaderInt16 != 0u )
         {
@@ -2147,6 +2684,10 @@ namespace keen
         m_sharedData.info.maxTextureDimension3d     = m_sharedData.deviceProperties.limits.maxImageDimension3D;
         m_sharedData.info.maxTextureDimensionCube   = m_sharedData.deviceProperties.limits.maxImageDimensionCube;
         m_sharedData.info.maxFramebufferDimension   = min( m_sharedData.deviceProperties.limits.maxFramebufferWidth, m_sharedData.deviceProperties.limits.maxFramebufferHeight );
+        m_sharedData.info.maxFramebufferLayerCount  = m_sharedData.deviceProperties.limits.maxFramebufferLayers;
+        // :JK: the view mask is a uint32 - so never more than 32 views
+        m_sharedData.info.maxMultiviewViewCount     = m_sharedData.deviceFeatures_1_1.multiview ? min( m_sharedData.deviceProperties_1_1.maxMultiviewViewCount, 32u ) : 0u;
+        m_sharedData.info.isVertexShaderLayerOutputSupported = m_sharedData.deviceFeatures_1_2.shaderOutputLayer == VK_TRUE;
         m_sharedData.info.maxDispatchGroupCount     = uint3{ m_sharedData.deviceProperties.limits.maxComputeWorkGroupCount[ 0u ], m_sharedData.deviceProperties.limits.maxComputeWorkGroupCount[ 1u ], m_sharedData.deviceProperties.limits.maxComputeWorkGroupCount[ 2u ] };
 
         m_sharedData.info.minUniformBufferOffsetAlignment           = m_sharedData.deviceProperties.limits.minUniformBufferOffsetAlignment;
@@ -2169,9 +2710,50 @@ namespace keen
         m_sharedData.info.supportedFeatures.setIf( GraphicsFeature::DepthResolveModeMinMax, isBitmaskSet( m_sharedData.deviceProperties_1_2.supportedDepthResolveModes, VK_RESOLVE_MODE_MIN_BIT | VK_RESOLVE_MODE_MAX_BIT ) );
         m_sharedData.info.supportedFeatures.setIf( GraphicsFeature::DepthResolveModeAverage, isBitmaskSet( m_sharedData.deviceProperties_1_2.supportedDepthResolveModes, VK_RESOLVE_MODE_AVERAGE_BIT ) );
         m_sharedData.info.supportedFeatures.setIf( GraphicsFeature::ShaderFloat16, m_sharedData.deviceFeatures_1_2.shaderFloat16 == VK_TRUE );
+        m_sharedData.info.supportedFeatures.setIf( GraphicsFeature::BufferDeviceAddress, m_sharedData.deviceFeatures_1_2.bufferDeviceAddress == VK_TRUE );
+        m_sharedData.info.supportedFeatures.setIf( GraphicsFeature::RenderingLocalRead, pSelectedDeviceInfo->isDynamicRenderingLocalReadSupported );
+        m_sharedData.info.supportedFeatures.setIf( GraphicsFeature::PreciseOcclusionQuery, pSelectedDeviceInfo->deviceFeatures.features.occlusionQueryPrecise == VK_TRUE );
+        m_sharedData.info.supportedFeatures.setIf( GraphicsFeature::ConditionalRendering, pSelectedDeviceInfo->isConditionalRenderingSupported );
+        m_sharedData.info.supportedFeatures.setIf( GraphicsFeature::HostImageCopy, pSelectedDeviceInfo->isHostImageCopySupported );
+        m_sharedData.info.supportedFeatures.setIf( GraphicsFeature::HostMemoryImport, pSelectedDeviceInfo->isExternalMemoryHostSupported );
+        m_sharedData.info.supportedFeatures.setIf( GraphicsFeature::ExternalMemoryExport, pSelectedDeviceInfo->isExternalMemoryFdSupported );
 
         m_sharedData.info.subgroupSize = m_sharedData.deviceProperties_1_1.subgroupSize;
 
+        // :JK: the spec guarantees at least 128 bytes - desktop devices usually have 256:
+        m_sharedData.info.maxPushConstantsSize          = min( m_sharedData.deviceProperties.limits.maxPushConstantsSize, GraphicsLimits_MaxPushConstantBufferSize );
+        m_sharedData.info.maxDynamicUniformBufferCount  = m_sharedData.deviceProperties.limits.maxDescriptorSetUniformBuffersDynamic;
+        m_sharedData.info.maxDynamicStorageBufferCount  = m_sharedData.deviceProperties.limits.maxDescriptorSetStorageBuffersDynamic;
+
+        if( pSelectedDeviceInfo->isInlineUniformBlockSupported )
+        {
+            m_sharedData.info.maxInlineUniformBlockSize = pSelectedDeviceInfo->devicePropertiesInlineUniformBlock.maxInlineUniformBlockSize;
+        }
+
+        m_sharedData.hostImageCopyInfo.isSupported  = pSelectedDeviceInfo->isHostImageCopySupported;
+        m_sharedData.hostImageCopyInfo.maxCopySize  = VulkanDefaultMaxHostImageCopySize;
+        m_sharedData.hostImageCopyInfo.copyDstLayouts.clear();
+        if( pSelectedDeviceInfo->isHostImageCopySupported )
+        {
+            const uint32 copyDstLayoutCount = min( pSelectedDeviceInfo->devicePropertiesHostImageCopy.copyDstLayoutCount, (uint32)VulkanMaxHostImageCopyLayoutCount );
+            for( uint32 i = 0u; i < copyDstLayoutCount; ++i )
+            {
+                m_sharedData.hostImageCopyInfo.copyDstLayouts.pushBack( pSelectedDeviceInfo->hostImageCopyDstLayouts[ i ] );
+            }
+        }
+
+        m_sharedData.hostMemoryImportInfo.isSupported           = pSelectedDeviceInfo->isExternalMemoryHostSupported;
+        m_sharedData.hostMemoryImportInfo.minImportAlignment    = 0u;
+        if( pSelectedDeviceInfo->isExternalMemoryHostSupported )
+        {
+            m_sharedData.hostMemoryImportInfo.minImportAlignment    = pSelectedDeviceInfo->devicePropertiesExternalMemoryHost.minImportedHostPointerAlignment;
+        }
+        m_sharedData.info.minHostMemoryImportAlignment = m_sharedData.hostMemoryImportInfo.minImportAlignment;
+
+        m_sharedData.externalMemoryInfo.isSupported = pSelectedDeviceInfo->isExternalMemoryFdSupported;
+        copyMemoryNonOverlapping( m_sharedData.externalMemoryInfo.deviceUuid, m_sharedData.deviceProperties_1_1.deviceUUID, sizeof( m_sharedData.externalMemoryInfo.deviceUuid ) );
+        copyMemoryNonOverlapping( m_sharedData.externalMemoryInfo.driverUuid, m_sharedData.deviceProperties_1_1.driverUUID, sizeof( m_sharedData.externalMemoryInfo.driverUuid ) );
+
         KEEN_STATIC_ASSERT( VK_SAMPLE_COUNT_1_BIT == 1u );
         KEEN_STATIC_ASSERT( VK_SAMPLE_COUNT_2_BIT == 2u );
         KEEN_STATIC_ASSERT( VK_SAMPLE_COUNT_4_BIT == 4u );
@@ -45,6 +45,7 @@ namespace keen
         virtual GraphicsDescriptorSet*              createStaticDescriptorSet( const GraphicsDescriptorSetParameters& parameters ) override final;
         virtual GraphicsDescriptorSet*              createDynamicDescriptorSet( GraphicsFrame* pFrame, const GraphicsDescriptorSetParameters& parameters ) override final;
         virtual GraphicsQueryPool*                  createQueryPool( const GraphicsQueryPoolParameters& parameters ) override final;
+        virtual GraphicsIndirectCommandsLayout*     createIndirectCommandsLayout( const GraphicsIndirectCommandsLayoutParameters& parameters ) override final;
 
         virtual GraphicsMemoryRequirements          queryTextureMemoryRequirements( const GraphicsTexture* pTexture ) override final;
         virtual GraphicsMemoryRequirements          queryBufferMemoryRequirements( const GraphicsBuffer* pBuffer ) override final;
@@ -52,11 +53,18 @@ namespace keen
 
         virtual void                                flushCpuCache( const ArrayView<const GraphicsBufferRange>& bufferRanges ) override final;
         virtual void                                invalidateCpuCache( const ArrayView<const GraphicsBufferRange>& bufferRanges ) override final;
+        virtual Result<void>                        copyMemoryToTexture( GraphicsTexture* pTexture, ArrayView<const GraphicsHostTextureCopyRegion> regions, GraphicsTextureLayout oldLayout, GraphicsTextureLayout newLayout ) override final;
+        virtual Result<GraphicsExportedTextureMemory>   exportTextureMemory( const GraphicsTexture* pTexture ) override final;
+        virtual GraphicsTimelineSemaphore*          createExportableTimelineSemaphore( uint64 initialValue, DebugName debugName ) override final;
+        virtual void                                destroyTimelineSemaphore( GraphicsTimelineSemaphore* pSemaphore ) override final;
+        virtual Result<sint32>                      exportTimelineSemaphore( GraphicsTimelineSemaphore* pSemaphore ) override final;
+        virtual void                                signalTimelineSemaphore( GraphicsFrame* pFrame, GraphicsTimelineSemaphore* pSemaphore, uint64 value ) override final;
         virtual void                                resetQueryPool( GraphicsQueryPool* pQueryPool, uint32 firstQuery, uint32 queryCount ) override final;
         virtual Result<void>                        copyQueryPoolTimeValues( ArrayView<Time> target, GraphicsQueryPool* pQueryPool, uint32 firstQuery ) override final;
 
         virtual void                                resizeSwapChain( GraphicsSwapChain* pSwapChain, uint2 size ) override final;
         virtual void                                setSwapChainPresentationInterval( GraphicsSwapChain* pSwapChain, uint32 presentationInterval ) override final;
+        virtual void                                setSwapChainDamageRegion( GraphicsSwapChain* pSwapChain, ArrayView<const GraphicsRectangle> damageRectangles ) override final;
 
 #if KEEN_USING( KEEN_COMPILED_SHADER_INFO )
         virtual void                                getCompiledRenderPipelineInfo( GraphicsCompiledRenderPipelineInfo* pCompiledPipelineInfo, const GraphicsRenderPipeline* pRenderPipeline ) override final;
@@ -70,6 +78,9 @@ namespace keen
         virtual void                                submitTransferBatch( GraphicsTransferBatch* pTransferBatch ) override final;
         virtual Result<void>                        waitForTransferBatch( GraphicsTransferBatch* pTransferBatch, Time timeOut ) override final;
 
+        // the buffer can be used as copy source in the batch and is destroyed with it - the host memory has to stay valid until the batch has finished:
+        virtual GraphicsBuffer*                     importHostMemoryBuffer( GraphicsTransferBatch* pTransferBatch, ConstMemoryBlock hostMemory, DebugName debugName ) override final;
+
         virtual void                                waitForGpuIdle( const ArrayView<GraphicsDeviceObject*> destroyObjects ) override final;
 
     private:
@@ -145,6 +156,7 @@ namespace keen
         VulkanTransferQueueSynchronized             m_transferQueue;
 
         void                                        submitVulkanTransferBatch( VulkanTransferBatch* pBatch );
+        void                                        destroyTransferBatchHostMemoryBuffers( VulkanTransferBatch* pBatch );
     };
 }
 
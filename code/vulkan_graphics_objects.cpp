@@ -1,4 +1,5 @@
 #include "vulkan_graphics_objects.hpp"
+#include "vulkan_device_generated_commands.hpp"
 
 #include "../global/graphics_system_private.hpp"
 
@@ -22,40 +23,33 @@
 
 namespace keen
 {
-    constexpr fourcc VulkanPipelineCacheHeaderMagic = "VKPC"_4cc;
-    constexpr uint64 VulkanPipelineCacheHeaderVersion = 3ull;
+    // pipeline binaries that were not used in this many runs are evicted from the archive:
+    constexpr uint32 VulkanPipelineBinaryMaxUnusedSessionCount = 8u;
 
     static const VkFormat s_D16_Candidates[]    = { VK_FORMAT_D16_UNORM, VK_FORMAT_D16_UNORM_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT };
     static const VkFormat s_D24S8_Candidates[]  = { VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D32_SFLOAT, VK_FORMAT_X8_D24_UNORM_PACK32, VK_FORMAT_D16_UNORM_S8_UINT, VK_FORMAT_D16_UNORM };
 
     KEEN_DEFINE_BOOL_VARIABLE( s_enableVulkanObjectTracking,            "enableVulkanObjectTracking", false, "" );
     KEEN_DEFINE_BOOL_VARIABLE( s_enableVulkanPipelineCache,             "enableVulkanPipelineCache", false, "" );
-
-    struct VulkanPipelineCacheHeader
-    {
-        uint32                              magic;              // VulkanPipelineCacheHeaderMagic
-        uint32                              dataSize;           // equal to *pDataSize returned by vkGetPipelineCacheData
-        uint64                              headerVersion;      // random seed VulkanPipelineCacheHeaderVersion
-        uint64                              dataHash;           // a hash of pipeline cache data
-
-        uint32                              vendorId;           // equal to VkPhysicalDeviceProperties::vendorID
-        uint32                              deviceId;           // equal to VkPhysicalDeviceProperties::deviceID
-        uint32                              driverVersion;      // equal to VkPhysicalDeviceProperties::driverVersion
-        uint32                              driverABI;          // equal to sizeof(void*)
-
-        StaticArray<uint8, VK_UUID_SIZE>    uuid;               // equal to VkPhysicalDeviceProperties::pipelineCacheUUID
-    };
+#if KEEN_USING( KEEN_COMPILED_SHADER_INFO )
+    KEEN_DEFINE_BOOL_VARIABLE( s_enableVulkanPipelineStatistics,        "enableVulkanPipelineStatistics", false, "Collect the compiled statistics of all pipelines and report register/spill regressions against the last run" );
+#endif
 
     VulkanDescriptorPoolSizes vulkan::fillDefaultVulkanDescriptorPoolSizes( uint32 descriptorSetCount )
     {
         VulkanDescriptorPoolSizes result{};
         
-        result.descriptorSetCount           = descriptorSetCount;
-        result.uniformBufferDescriptorCount = descriptorSetCount * 2u;
-        result.storageBufferDescriptorCount = descriptorSetCount * 2u;
-        result.samplerDescriptorCount       = descriptorSetCount * 4u;
-        result.sampledImageDescriptorCount  = descriptorSetCount * 16u;
-        result.storageImageDescriptorCount  = descriptorSetCount * 16u;
+        result.descriptorSetCount                   = descriptorSetCount;
+        result.uniformBufferDescriptorCount         = descriptorSetCount * 2u;
+        result.storageBufferDescriptorCount         = descriptorSetCount * 2u;
+        result.uniformBufferDynamicDescriptorCount  = descriptorSetCount;
+        result.storageBufferDynamicDescriptorCount  = descriptorSetCount;
+        result.inlineUniformBlockBindingCount       = descriptorSetCount;
+        result.inlineUniformBlockSize               = descriptorSetCount * 128u;
+        result.samplerDescriptorCount               = descriptorSetCount * 4u;
+        result.sampledImageDescriptorCount          = descriptorSetCount * 16u;
+        result.storageImageDescriptorCount          = descriptorSetCount * 16u;
+        result.inputAttachmentDescriptorCount       = descriptorSetCount * 4u;
 
         return result;
     }
@@ -120,6 +114,7 @@ namespace keen
         gpuAllocatorParameters.instance         = m_instance;
         gpuAllocatorParameters.blockSizeInBytes = parameters.allocationBlockSizeInBytes;
         gpuAllocatorParameters.memoryProperties = m_pSharedData->deviceMemoryProperties;
+        gpuAllocatorParameters.enableDeviceAddressExtension = m_pSharedData->deviceFeatures_1_2.bufferDeviceAddress == VK_TRUE;
 
         m_pGpuAllocator = vulkan::createGpuAllocator( gpuAllocatorParameters );
 
@@ -132,7 +127,10 @@ namespace keen
         m_allocatorMutex.create( "VulkanObjectAllocator"_debug );
         m_descriptorPoolMutex.create( "VulkanDescriptorPool"_debug );
         m_staticDescriptorPoolMutex.create( "VulkanStaticDescriptorSetPool"_debug );
+        m_generatedCommandsMutex.create( "VulkanGeneratedCommands"_debug );
         m_staticSamplerMap.create( m_pAllocator, 128u );
+        m_sharedRenderPipelineMutex.create( "VulkanSharedRenderPipelines"_debug );
+        m_sharedRenderPipelines.create( m_pAllocator, 1024u );
 
         m_staticDescriptorPoolSizes     = parameters.staticDescriptorPoolSizes;
         m_dynamicDescriptorPoolSizes    = parameters.dynamicDescriptorPoolSizes;
@@ -148,6 +146,7 @@ namespace keen
         createObjectPoolAllocator<StaticVulkanDescriptorSet>( 1024u, 8u, "Vk_DescriptorSet"_debug );
         createObjectPoolAllocator<VulkanQueryPool>( 16, 8u, "Vk_QueryPool"_debug );
         createObjectPoolAllocator<VulkanComputePipeline>( 32u, 8u, "Vk_CsPipeline"_debug );
+        createObjectPoolAllocator<VulkanIndirectCommandsLayout>( 16u, 8u, "Vk_IndirectCommandsLayout"_debug );
 
         KEEN_PROFILE_COUNTER_REGISTER( m_vulkanDeviceMemoryCount, 0u, "Vk_DeviceMemory", false );
         KEEN_PROFILE_COUNTER_REGISTER( m_vulkanPipelineLayoutCount, 0u, "Vk_PipelineLayout", false );
@@ -161,8 +160,48 @@ namespace keen
         KEEN_PROFILE_COUNTER_REGISTER( m_vulkanQueryPoolCount, 0u, "Vk_QueryPoolCount", false );
         KEEN_PROFILE_COUNTER_REGISTER( m_vulkanComputePipelineCount, 0u, "Vk_ComputePipelineCount", false );
         KEEN_PROFILE_COUNTER_REGISTER( m_vulkanDescriptorPoolCount, 0u, "Vk_DescriptorPoolCount", false );
+        KEEN_PROFILE_COUNTER_REGISTER( m_vulkanIndirectCommandsLayoutCount, 0u, "Vk_IndirectCommandsLayoutCount", false );
+
+        // the pipeline binary archive replaces the pipeline cache completely - pipelines that capture or use binaries can't use a VkPipelineCache anyways:
+        m_usePipelineBinaries = false;
+        if( m_pVulkan->KHR_pipeline_binary && parameters.pipelineCacheDirectory.hasElements() )
+        {
+            VulkanPipelineBinaryKey globalKey;
+            if( !vulkan::getPipelineBinaryKey( &globalKey, m_pVulkan, nullptr ) )
+            {
+                KEEN_TRACE_ERROR( "[graphics] Could not query the global pipeline binary key. Running without pipeline binaries.\n" );
+            }
+            else if( !m_pipelineBinaryArchivePath.tryCreateCombinedFilePath( m_pAllocator, parameters.pipelineCacheDirectory, "vk_pipeline_binaries.bin" ) )
+            {
+                KEEN_TRACE_ERROR( "[graphics] failed to allocate pipeline binary archive path name.\n" );
+            }
+            else
+            {
+                m_pipelineBinaryMutex.create( "VulkanPipelineBinaries"_debug );
+                vulkan::createPipelineBinaryArchive( &m_pipelineBinaryArchive, m_pAllocator, globalKey );
+                m_usePipelineBinaries = true;
+
+                Array<uint8> archiveData;
+                if( os::readWholeFile( &archiveData, m_pAllocator, m_pipelineBinaryArchivePath ).isOk() )
+                {
+                    const Result<void> readResult = vulkan::readPipelineBinaryArchive( &m_pipelineBinaryArchive, archiveData.getMemory() );
+                    if( readResult.getError() == ErrorId_WrongVersion )
+                    {
+                        KEEN_TRACE_WARNING( "[graphics] Pipeline binary archive found is no longer valid (probably due to a driver update). Rebuilding now!\n" );
+                    }
+                    else if( readResult.hasError() )
+                    {
+                        KEEN_TRACE_WARNING( "[graphics] Pipeline binary archive '%s' is invalid (error=%k). Rebuilding now!\n", m_pipelineBinaryArchivePath, readResult.getError() );
+                    }
+                    else
+                    {
+                        KEEN_TRACE_INFO( "[graphics] Found compatible vulkan pipeline binary archive path:%s pipelines:%d size:%,k\n", m_pipelineBinaryArchivePath, m_pipelineBinaryArchive.records.getCount(), m_pipelineBinaryArchive.data.getSize() );
+                    }
+                }
+            }
+        }
 
-        if( s_enableVulkanPipelineCache && parameters.pipelineCacheDirectory.hasElements() )
+        if( !m_usePipelineBinaries && s_enableVulkanPipelineCache && parameters.pipelineCacheDirectory.hasElements() )
         {
             Array< uint8 > pipelineCacheData;
             VkPipelineCacheCreateInfo pipelineCacheCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
@@ -250,6 +289,25 @@ namespace keen
             return ErrorId_OutOfMemory;
         }
 
+#if KEEN_USING( KEEN_COMPILED_SHADER_INFO )
+        m_collectPipelineStatistics = false;
+        if( s_enableVulkanPipelineStatistics && parameters.pipelineCacheDirectory.hasElements() )
+        {
+            if( !m_pVulkan->KHR_pipeline_executable_properties && !m_pVulkan->AMD_shader_info )
+            {
+                KEEN_TRACE_WARNING( "[graphics] Pipeline statistics are not supported by the device (vulkan/enableCompiledShaderInfo has to be set)\n" );
+            }
+            else if( m_pipelineStatisticsPath.tryCreateCombinedFilePath( m_pAllocator, parameters.pipelineCacheDirectory, "vk_pipeline_statistics.bin" ) )
+            {
+                m_pipelineStatisticsMutex.create( "VulkanPipelineStatistics"_debug );
+                vulkan::createPipelineStatisticsSet( &m_pipelineStatistics, m_pAllocator );
+                m_collectPipelineStatistics = true;
+
+                KEEN_TRACE_INFO( "[graphics] Collecting pipeline statistics into '%s'\n", m_pipelineStatisticsPath );
+            }
+        }
+#endif
+
         m_depthFormats[ VulkanDepthFormat_Depth16 ] = findFirstMatchingDepthStencilFormat( createArrayView( s_D16_Candidates ), false );
         m_depthFormats[ VulkanDepthFormat_Depth16_ShaderInput ] = findFirstMatchingDepthStencilFormat( createArrayView( s_D16_Candidates ), true );
         m_depthFormats[ VulkanDepthFormat_Depth24S8 ] = findFirstMatchingDepthStencilFormat( createArrayView( s_D24S8_Candidates ), false );
@@ -259,18 +317,27 @@ namespace keen
         {
             const uint32 bindlessTextureCount = parameters.bindlessTextureCount;
             const uint32 bindlessSamplerCount = parameters.bindlessSamplerCount;
+            const uint32 bindlessStorageBufferCount = parameters.bindlessStorageBufferCount;
 
-            const VkShaderStageFlags bindlessShaderStageMask = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+            VkShaderStageFlags bindlessShaderStageMask = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+            if( m_pVulkan->EXT_mesh_shader )
+            {
+                bindlessShaderStageMask |= VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT;
+            }
             VkDescriptorSetLayoutBinding bindlessBindings[] =
             {
                 { 0u, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, bindlessTextureCount, bindlessShaderStageMask, nullptr },
                 { 1u, VK_DESCRIPTOR_TYPE_SAMPLER, bindlessSamplerCount, bindlessShaderStageMask, nullptr },
+                { 2u, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bindlessStorageBufferCount, bindlessShaderStageMask, nullptr },
+                { 3u, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u, bindlessShaderStageMask, nullptr },     // uint64 device address per bindless storage buffer
             };
 
             const VkDescriptorBindingFlags bindlessBindingFlags[] =
             {
                 VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
                 VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
+                VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
+                0u,
             };
 
             KEEN_STATIC_ASSERT( KEEN_COUNTOF( bindlessBindings ) == KEEN_COUNTOF( bindlessBindingFlags ) );
@@ -310,8 +377,14 @@ namespace keen
             m_bindlessDescriptorSetLayout = VK_NULL_HANDLE;
         }
 
-        m_nextBufferId  = 1u;
-        m_nextTextureId = 1u;
+        m_nextBufferId          = 1u;
+        m_nextTextureId         = 1u;
+        m_nextPipelineLayoutId  = 1u;
+
+        m_maxGeneratedCommandsPreprocessSize        = 0u;
+        m_maxGeneratedCommandsPreprocessAlignment   = 1u;
+        m_generatedCommandsPreprocessMemoryTypeBits = ~0u;
+        m_objectGeneration = 0u;
 
         return ErrorId_Ok;
     }
@@ -359,6 +432,26 @@ namespace keen
             m_pFirstStaticDescriptorPool = nullptr;
         }
 
+#if KEEN_USING( KEEN_COMPILED_SHADER_INFO )
+        if( m_collectPipelineStatistics )
+        {
+            storePipelineStatistics();
+
+            vulkan::destroyPipelineStatisticsSet( &m_pipelineStatistics );
+            m_pipelineStatisticsMutex.destroy();
+            m_collectPipelineStatistics = false;
+        }
+#endif
+
+        if( m_usePipelineBinaries )
+        {
+            storePipelineBinaryArchive();
+
+            vulkan::destroyPipelineBinaryArchive( &m_pipelineBinaryArchive );
+            m_pipelineBinaryMutex.destroy();
+            m_usePipelineBinaries = false;
+        }
+
         if( m_pipelineCache != VK_NULL_HANDLE && !m_pipelineCachePath.isEmpty() )
         {
             size_t dataSize = 0;
@@ -372,16 +465,7 @@ namespace keen
                     if( fetchResult.isOk() )
                     {
                         VulkanPipelineCacheHeader* pHeader = pointer_cast<VulkanPipelineCacheHeader>( rawBuffer.getStart() );
-                        pHeader->magic          = VulkanPipelineCacheHeaderMagic;
-                        pHeader->headerVersion  = VulkanPipelineCacheHeaderVersion;
-                        pHeader->dataSize       = rangecheck_cast<uint32>( dataSize );
-                        pHeader->dataHash       = calculateFnv1a32Hash( rawBuffer.getStart() + sizeof( VulkanPipelineCacheHeader ), dataSize ).value;
-
-                        pHeader->driverVersion  = m_pSharedData->deviceProperties.driverVersion;
-                        pHeader->deviceId       = m_pSharedData->deviceProperties.deviceID;
-                        pHeader->vendorId       = m_pSharedData->deviceProperties.vendorID;
-                        pHeader->driverABI      = sizeof( void* );
-                        copyMemoryBlockNonOverlapping( pHeader->uuid.getMemory(), createMemoryBlockFromArray( m_pSharedData->deviceProperties.pipelineCacheUUID ) );
+                        vulkan::fillPipelineCacheHeader( pHeader, m_pSharedData->deviceProperties, createConstMemoryBlock( rawBuffer.getStart() + sizeof( VulkanPipelineCacheHeader ), dataSize ) );
 
                         const Result<void> directoryResult = os::createDirectoryTree( m_pipelineCachePath.getDirectoryPath() );
                         if( directoryResult.hasError() )
@@ -428,6 +512,8 @@ namespace keen
 
         m_freeObjectListMutex.destroy();
 
+        m_generatedCommandsMutex.destroy();
+        m_sharedRenderPipelineMutex.destroy();
         m_staticDescriptorPoolMutex.destroy();
         m_descriptorPoolMutex.destroy();
 
@@ -592,6 +678,7 @@ namespace keen
         pSwapChainWrapper->info.colorFormat             = pSwapChainWrapper->backBuffers[ 0u ]->format;
         pSwapChainWrapper->info.size                    = pSwapChainWrapper->pSwapChain->getSize();
         pSwapChainWrapper->info.presentationInterval    = parameters.presentationInterval;
+        pSwapChainWrapper->info.redrawArea              = { 0, 0, pSwapChainWrapper->info.size.x, pSwapChainWrapper->info.size.y };
 
 #if KEEN_USING( KEEN_OS_WINDOW_SUPPORT )
         pSwapChainWrapper->info.windowHandle    = parameters.windowHandle;
@@ -615,11 +702,31 @@ namespace keen
         graphics::initializeDeviceObject( pPipelineLayout, GraphicsDeviceObjectType::PipelineLayout, parameters.debugName );
         KEEN_PROFILE_COUNTER_INC( m_vulkanPipelineLayoutCount );
 
+        pPipelineLayout->pipelineLayout = VK_NULL_HANDLE;
+        pPipelineLayout->layoutId = m_nextPipelineLayoutId++;
+
         DynamicArray<VkDescriptorSetLayout, GraphicsLimits_MaxDescriptorSetSlotCount + 1u> setLayouts;
+        uint32 dynamicUniformBufferCount = 0u;
+        uint32 dynamicStorageBufferCount = 0u;
         for( size_t i = 0u; i < parameters.descriptorSetLayoutCount; ++i )
         {
             const VulkanDescriptorSetLayout* pDescriptorSetLayout = ( const VulkanDescriptorSetLayout* )parameters.descriptorSetLayouts[ i ];
             setLayouts.pushBack( pDescriptorSetLayout->layout );
+
+            pPipelineLayout->dynamicOffsetCounts[ i ] = pDescriptorSetLayout->dynamicUniformBufferCount + pDescriptorSetLayout->dynamicStorageBufferCount;
+            dynamicUniformBufferCount += pDescriptorSetLayout->dynamicUniformBufferCount;
+            dynamicStorageBufferCount += pDescriptorSetLayout->dynamicStorageBufferCount;
+        }
+        for( size_t i = parameters.descriptorSetLayoutCount; i < GraphicsLimits_MaxDescriptorSetSlotCount; ++i )
+        {
+            pPipelineLayout->dynamicOffsetCounts[ i ] = 0u;
+        }
+
+        if( dynamicUniformBufferCount > m_pSharedData->info.maxDynamicUniformBufferCount || dynamicStorageBufferCount > m_pSharedData->info.maxDynamicStorageBufferCount )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Pipeline layout '%k': %d dynamic uniform buffers and %d dynamic storage buffers exceed the device limits %d and %d\n", parameters.debugName, dynamicUniformBufferCount, dynamicStorageBufferCount, m_pSharedData->info.maxDynamicUniformBufferCount, m_pSharedData->info.maxDynamicStorageBufferCount );
+            destroyPipelineLayout( pPipelineLayout );
+            return nullptr;
         }
 
         if( parameters.useBindlessDescriptors )
@@ -639,15 +746,75 @@ namespace keen
         layoutCreateInfo.pSetLayouts = setLayouts.getStart();
         layoutCreateInfo.setLayoutCount = setLayouts.getCount32();
 
-        VkPushConstantRange pushConstantRange{};
+        // the legacy single range + the explicit ranges:
+        GraphicsPushConstantRange ranges[ GraphicsLimits_MaxPushConstantRangeCount + 1u ];
+        uint32 rangeCount = 0u;
         if( parameters.pushConstantsSize > 0u )
         {
-            pushConstantRange.offset                = 0u;
-            pushConstantRange.size                  = parameters.pushConstantsSize;
-            pushConstantRange.stageFlags            = vulkan::getStageFlags( parameters.pushConstantsStageMask );
-            layoutCreateInfo.pPushConstantRanges    = &pushConstantRange;
-            layoutCreateInfo.pushConstantRangeCount = 1u;
+            ranges[ rangeCount ].stageMask  = parameters.pushConstantsStageMask;
+            ranges[ rangeCount ].offset     = 0u;
+            ranges[ rangeCount ].size       = parameters.pushConstantsSize;
+            rangeCount++;
+        }
+        KEEN_ASSERT( parameters.pushConstantRangeCount <= GraphicsLimits_MaxPushConstantRangeCount );
+        for( uint32 i = 0u; i < parameters.pushConstantRangeCount; ++i )
+        {
+            ranges[ rangeCount++ ] = parameters.pushConstantRanges[ i ];
+        }
+
+        const uint32 maxPushConstantsSize = m_pSharedData->info.maxPushConstantsSize;
+        VkShaderStageFlags usedStageFlags = 0u;
+        for( uint32 i = 0u; i < rangeCount; ++i )
+        {
+            const GraphicsPushConstantRange& range = ranges[ i ];
+            const VkShaderStageFlags stageFlags = vulkan::getStageFlags( range.stageMask );
+            if( range.size == 0u || ( range.size & 3u ) != 0u || ( range.offset & 3u ) != 0u || (uint32)range.offset + range.size > maxPushConstantsSize )
+            {
+                KEEN_TRACE_ERROR( "[graphics] Pipeline layout '%k': push constant range [%d, %d) has to be non empty, 4 byte aligned and within the device limit %d\n", parameters.debugName, range.offset, range.offset + range.size, maxPushConstantsSize );
+                destroyPipelineLayout( pPipelineLayout );
+                return nullptr;
+            }
+            if( stageFlags == 0u || ( usedStageFlags & stageFlags ) != 0u )
+            {
+                KEEN_TRACE_ERROR( "[graphics] Pipeline layout '%k': push constant range [%d, %d) has no stages or shares a stage with another range\n", parameters.debugName, range.offset, range.offset + range.size );
+                destroyPipelineLayout( pPipelineLayout );
+                return nullptr;
+            }
+            usedStageFlags |= stageFlags;
+
+            VkPushConstantRange* pRange = &pPipelineLayout->pushConstantRanges[ i ];
+            pRange->offset      = range.offset;
+            pRange->size        = range.size;
+            pRange->stageFlags  = stageFlags;
+        }
+        pPipelineLayout->pushConstantRangeCount = rangeCount;
+
+        if( rangeCount > 0u )
+        {
+            layoutCreateInfo.pPushConstantRanges    = pPipelineLayout->pushConstantRanges;
+            layoutCreateInfo.pushConstantRangeCount = rangeCount;
+        }
+
+        for( size_t i = 0u; i < setLayouts.getSize(); ++i )
+        {
+            pPipelineLayout->setLayouts[ i ] = setLayouts[ i ];
+        }
+        pPipelineLayout->setLayoutCount     = setLayouts.getCount32();
+
+        uint64 layoutHash = 0xcbf29ce484222325ull;
+        for( size_t i = 0u; i < parameters.descriptorSetLayoutCount; ++i )
+        {
+            const VulkanDescriptorSetLayout* pDescriptorSetLayout = ( const VulkanDescriptorSetLayout* )parameters.descriptorSetLayouts[ i ];
+            layoutHash = ( layoutHash ^ pDescriptorSetLayout->layoutHash ) * 0x100000001b3ull;
+        }
+        layoutHash = ( layoutHash ^ (uint64)parameters.useBindlessDescriptors ) * 0x100000001b3ull;
+        for( uint32 i = 0u; i < rangeCount; ++i )
+        {
+            const VkPushConstantRange& range = pPipelineLayout->pushConstantRanges[ i ];
+            const uint32 rangeData[] = { range.offset, range.size, range.stageFlags };
+            layoutHash = ( layoutHash ^ calculateFnv1a64Hash( rangeData, sizeof( rangeData ) ).value ) * 0x100000001b3ull;
         }
+        pPipelineLayout->layoutHash = layoutHash;
 
         VulkanResult result = m_pVulkan->vkCreatePipelineLayout( m_device, &layoutCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pPipelineLayout->pipelineLayout );
         if( result.hasError() )
@@ -671,6 +838,46 @@ namespace keen
 
         KEEN_ASSERT( parameters.pPipelineLayout != nullptr );
 
+        if( parameters.additionalVertexStreamCount >= GraphicsLimits_MaxVertexStreamCount )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Render pipeline '%k': too many vertex streams (%d additional streams, max is %d)\n", parameters.debugName, parameters.additionalVertexStreamCount, GraphicsLimits_MaxVertexStreamCount - 1u );
+            return nullptr;
+        }
+        if( parameters.useDynamicVertexStrides && !m_pSharedData->info.isExtendedDynamicStateSupported )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Render pipeline '%k': dynamic vertex strides need extended dynamic state support\n", parameters.debugName );
+            return nullptr;
+        }
+        if( parameters.inputAttachmentIndices.isEnabled && !m_pVulkan->KHR_dynamic_rendering_local_read )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Render pipeline '%k': input attachment indices need rendering local read support\n", parameters.debugName );
+            return nullptr;
+        }
+        // the first combiner combines with the primitive shading rate and the second one with the shading rate attachment:
+        if( m_pVulkan->KHR_fragment_shading_rate &&
+            ( ( parameters.shadingRateCombiners[ 0u ] != GraphicsShadingRateCombiner::Keep && !m_pSharedData->info.isPrimitiveShadingRateSupported ) ||
+              ( parameters.shadingRateCombiners[ 1u ] != GraphicsShadingRateCombiner::Keep && !m_pSharedData->info.isAttachmentShadingRateSupported ) ) )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Render pipeline '%k': shading rate combiners need primitive/attachment shading rate support\n", parameters.debugName );
+            return nullptr;
+        }
+        if( parameters.viewMask != 0u && ( m_pSharedData->info.maxMultiviewViewCount == 0u || ( parameters.viewMask >> ( m_pSharedData->info.maxMultiviewViewCount - 1u ) ) > 1u ) )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Render pipeline '%k': view mask 0x%x is not supported (max view count is %d)\n", parameters.debugName, parameters.viewMask, m_pSharedData->info.maxMultiviewViewCount );
+            return nullptr;
+        }
+        {
+            uint32 bindingCount;
+            uint32 attributeCount;
+            VkVertexInputBindingDescription2EXT bindings[ GraphicsLimits_MaxVertexStreamCount ];
+            VkVertexInputAttributeDescription2EXT attributes[ VertexAttributeId_Count ];
+            if( !vulkan::fillVertexInputDescriptions( &bindingCount, bindings, &attributeCount, attributes, parameters ) )
+            {
+                KEEN_TRACE_ERROR( "[graphics] Render pipeline '%k': a vertex attribute is part of more than one vertex stream\n", parameters.debugName );
+                return nullptr;
+            }
+        }
+
         VulkanRenderPipeline* pRenderPipeline = allocateDeviceObject<VulkanRenderPipeline>();
         if( pRenderPipeline == nullptr )
         {
@@ -681,6 +888,48 @@ namespace keen
 
         KEEN_PROFILE_COUNTER_INC( m_vulkanRenderPipelineCount );
 
+        pRenderPipeline->isSharedPipeline       = false;
+        pRenderPipeline->isShaderObjectPipeline = false;
+        pRenderPipeline->dynamicStateFeatures   = m_pSharedData->dynamicStateFeatures;
+
+        // shader objects skip the pipeline compile completely - the fixed function state is set when the pipeline is bound:
+        if( m_pSharedData->useShaderObjects )
+        {
+            KEEN_ASSERT( !parameters.isIndirectBindable );
+
+            pRenderPipeline->pipeline               = VK_NULL_HANDLE;
+            pRenderPipeline->isShaderObjectPipeline = true;
+            pRenderPipeline->dynamicStateFeatures   = { VulkanDynamicStateFeature::ExtendedDynamicState, VulkanDynamicStateFeature::ExtendedDynamicState2, VulkanDynamicStateFeature::ExtendedDynamicState3, VulkanDynamicStateFeature::VertexInputDynamicState };
+            vulkan::fillRenderPipelineDynamicState( &pRenderPipeline->dynamicState, parameters );
+            vulkan::fillShaderObjectPipeline( &pRenderPipeline->shaderObjects, parameters, m_pSharedData->shaderObjectStageMask, m_pVulkan->KHR_fragment_shading_rate );
+
+            const ErrorId error = createRenderPipelineShaderObjects( pRenderPipeline, parameters );
+            if( error != ErrorId_Ok )
+            {
+                destroyRenderPipeline( pRenderPipeline );
+                return nullptr;
+            }
+
+            pRenderPipeline->scissorTestEnabled = parameters.enableScissorTest;
+            return pRenderPipeline;
+        }
+
+        // with extended dynamic state most of the fixed function state is set when the pipeline is bound - so most permutations can share the VkPipeline:
+        if( pRenderPipeline->dynamicStateFeatures.hasSetBits() )
+        {
+            vulkan::fillRenderPipelineDynamicState( &pRenderPipeline->dynamicState, parameters );
+
+            const VulkanPipelineLayout* pPipelineLayout = (const VulkanPipelineLayout*)parameters.pPipelineLayout;
+            const HashKey64 pipelineKey = vulkan::computeRenderPipelineKey( parameters, pRenderPipeline->dynamicStateFeatures );
+            pRenderPipeline->sharedPipelineKey = HashKey64{ ( pipelineKey.value ^ pPipelineLayout->layoutId ) * 0x100000001b3ull };
+
+            if( acquireSharedRenderPipeline( pRenderPipeline ) )
+            {
+                pRenderPipeline->scissorTestEnabled = parameters.enableScissorTest;
+                return pRenderPipeline;
+            }
+        }
+
         RenderPipelineShaderModules shaderModules {};
 
         Result<void> prepareResult = prepareRenderPipelineCompileParameters( &shaderModules, parameters );
@@ -701,6 +950,11 @@ namespace keen
             return nullptr;
         }
 
+        if( pRenderPipeline->dynamicStateFeatures.hasSetBits() )
+        {
+            registerSharedRenderPipeline( pRenderPipeline );
+        }
+
         pRenderPipeline->scissorTestEnabled = parameters.enableScissorTest;
 
         return pRenderPipeline;
@@ -759,7 +1013,9 @@ namespace keen
             }
             pDeviceMemory->mappedMemory = createMemoryBlock( pMappedMemory, parameters.sizeInBytes );
 
-            pDeviceMemory->isCoherent = isBitmaskSet( m_pSharedData->deviceMemoryProperties.memoryTypes[ parameters.memoryTypeIndex ].propertyFlags, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+            const VkMemoryPropertyFlags memoryFlags = m_pSharedData->deviceMemoryProperties.memoryTypes[ parameters.memoryTypeIndex ].propertyFlags;
+            pDeviceMemory->isCoherent       = isBitmaskSet( memoryFlags, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+            pDeviceMemory->uploadCopyKernel = vulkan::selectUploadCopyKernel( memoryFlags );
         }
 
         graphics::initializeDeviceObject( pDeviceMemory, GraphicsDeviceObjectType::DeviceMemory, parameters.debugName );
@@ -821,7 +1077,7 @@ namespace keen
 #endif
 
             VulkanGpuBufferResult allocationResult;
-            if( !vulkan::allocateGpuBuffer( &allocationResult, m_pGpuAllocator, memoryUsage, memoryFlags, minAlignment, bufferCreateInfo, parameters.debugName ) )
+            if( !vulkan::allocateGpuBuffer( &allocationResult, m_pGpuAllocator, memoryUsage, memoryFlags, minAlignment, 0u, bufferCreateInfo, parameters.debugName ) )
             {
                 freeDeviceObject( pBuffer );
                 return nullptr;
@@ -832,6 +1088,10 @@ namespace keen
 
             KEEN_ASSERT( allocationResult.mappedMemory.isInvalid() || allocationResult.mappedMemory.size == parameters.sizeInBytes );
             pBuffer->pMappedMemory  = allocationResult.mappedMemory.pStart;
+            if( pBuffer->pMappedMemory != nullptr )
+            {
+                pBuffer->uploadCopyKernel = vulkan::selectUploadCopyKernel( allocationResult.memoryFlags );
+            }
 
             if( isAnyBitSet( bufferCreateInfo.usage, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT ) )
             {
@@ -866,6 +1126,107 @@ namespace keen
         return pBuffer;
     }
 
+    VulkanBuffer* VulkanGraphicsObjects::createHostMemoryBuffer( ConstMemoryBlock hostMemory, const DebugName& debugName )
+    {
+        KEEN_PROFILE_CPU( Vk_createHostMemoryBuffer );
+
+        if( !vulkan::isHostMemoryImportable( m_pSharedData->hostMemoryImportInfo, hostMemory ) )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Can't import host memory for buffer '%k': range is not aligned to %d bytes or host memory import is not supported\n", debugName, m_pSharedData->hostMemoryImportInfo.minImportAlignment );
+            return nullptr;
+        }
+
+#if defined( VK_EXT_external_memory_host )
+        KEEN_ASSERT( m_pVulkan->EXT_external_memory_host );
+
+        KEEN_DISABLE_FLOATINGPOINT_EXCEPTIONS_SCOPE;
+
+        // :JK: vulkan wants a non const pointer - the memory is only ever read by the gpu because the buffer is a transfer source only
+        void* pHostPointer = (void*)hostMemory.pStart;
+        const VkExternalMemoryHandleTypeFlagBits handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+
+        VkMemoryHostPointerPropertiesEXT hostPointerProperties{ VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT };
+        VulkanResult result = m_pVulkan->vkGetMemoryHostPointerPropertiesEXT( m_device, handleType, pHostPointer, &hostPointerProperties );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkGetMemoryHostPointerPropertiesEXT failed for buffer '%k' with error '%s'\n", debugName, result );
+            return nullptr;
+        }
+
+        VulkanBuffer* pBuffer = allocateDeviceObject<VulkanBuffer>();
+        if( pBuffer == nullptr )
+        {
+            return nullptr;
+        }
+
+        VkExternalMemoryBufferCreateInfo externalMemoryBufferCreateInfo{ VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO };
+        externalMemoryBufferCreateInfo.handleTypes = (VkExternalMemoryHandleTypeFlags)handleType;
+
+        VkBufferCreateInfo bufferCreateInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO, &externalMemoryBufferCreateInfo };
+        bufferCreateInfo.size           = hostMemory.size;
+        bufferCreateInfo.usage          = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferCreateInfo.sharingMode    = VK_SHARING_MODE_EXCLUSIVE;
+
+        result = m_pVulkan->vkCreateBuffer( m_device, &bufferCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pBuffer->buffer );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkCreateBuffer failed for buffer '%k' with error '%s'\n", debugName, result );
+            freeDeviceObject( pBuffer );
+            return nullptr;
+        }
+
+        VkMemoryRequirements memoryRequirements;
+        m_pVulkan->vkGetBufferMemoryRequirements( m_device, pBuffer->buffer, &memoryRequirements );
+
+        const Optional<uint32> memoryTypeIndex = vulkan::selectHostMemoryImportType( m_pSharedData->deviceMemoryProperties, memoryRequirements.memoryTypeBits & hostPointerProperties.memoryTypeBits );
+        if( memoryTypeIndex.isClear() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Can't import host memory for buffer '%k': no compatible memory type\n", debugName );
+            m_pVulkan->vkDestroyBuffer( m_device, pBuffer->buffer, m_pSharedData->pVulkanAllocationCallbacks );
+            freeDeviceObject( pBuffer );
+            return nullptr;
+        }
+
+        VkImportMemoryHostPointerInfoEXT importInfo{ VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT };
+        importInfo.handleType       = handleType;
+        importInfo.pHostPointer     = pHostPointer;
+
+        VkMemoryAllocateInfo allocateInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, &importInfo };
+        allocateInfo.allocationSize     = hostMemory.size;
+        allocateInfo.memoryTypeIndex    = memoryTypeIndex.get();
+
+        result = m_pVulkan->vkAllocateMemory( m_device, &allocateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pBuffer->importedMemory );
+        if( result.hasError() )
+        {
+            // i.e. read only mappings are rejected by some drivers
+            KEEN_TRACE_ERROR( "[graphics] vkAllocateMemory failed to import host memory for buffer '%k' with error '%s'\n", debugName, result );
+            m_pVulkan->vkDestroyBuffer( m_device, pBuffer->buffer, m_pSharedData->pVulkanAllocationCallbacks );
+            freeDeviceObject( pBuffer );
+            return nullptr;
+        }
+
+        result = m_pVulkan->vkBindBufferMemory( m_device, pBuffer->buffer, pBuffer->importedMemory, 0u );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkBindBufferMemory failed for buffer '%k' with error '%s'\n", debugName, result );
+            // not destroyBuffer - the buffer was never counted:
+            m_pVulkan->vkFreeMemory( m_device, pBuffer->importedMemory, m_pSharedData->pVulkanAllocationCallbacks );
+            m_pVulkan->vkDestroyBuffer( m_device, pBuffer->buffer, m_pSharedData->pVulkanAllocationCallbacks );
+            freeDeviceObject( pBuffer );
+            return nullptr;
+        }
+
+        vulkan::setObjectName( m_pVulkan, m_device, (VkObjectHandle)pBuffer->buffer, VK_OBJECT_TYPE_BUFFER, debugName );
+
+        graphics::initializeDeviceObject( pBuffer, GraphicsDeviceObjectType::Buffer, debugName );
+
+        KEEN_PROFILE_COUNTER_INC( m_vulkanBufferCount );
+        return pBuffer;
+#else
+        return nullptr;
+#endif
+    }
+
     VulkanTexture* VulkanGraphicsObjects::createTexture( const GraphicsTextureParameters& parameters )
     {
         KEEN_PROFILE_CPU( Vk_createTexture );
@@ -902,6 +1263,29 @@ namespace keen
             imageCreateInfo.flags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT;
         }
 
+        // exportable textures get their own dedicated memory - the gpu allocator can't create exportable memory blocks:
+        VkExternalMemoryImageCreateInfo externalMemoryImageCreateInfo{ VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO };
+        const bool isExportable = parameters.flags.isSet( GraphicsTextureFlag::Exportable );
+        if( isExportable )
+        {
+            if( !m_pSharedData->externalMemoryInfo.isSupported || !parameters.allocateMemory )
+            {
+                KEEN_TRACE_ERROR( "[graphics] Can't create exportable texture '%k': external memory is not supported or the memory is not allocated by the texture\n", parameters.debugName );
+                freeDeviceObject( pTexture );
+                return nullptr;
+            }
+            if( !vulkan::isImageExportable( m_pVulkan, m_physicalDevice, imageCreateInfo ) )
+            {
+                KEEN_TRACE_ERROR( "[graphics] Can't create exportable texture '%k': format %s can't be exported with this usage\n", parameters.debugName, image::getPixelFormatName( parameters.format ) );
+                freeDeviceObject( pTexture );
+                return nullptr;
+            }
+
+            externalMemoryImageCreateInfo.pNext         = imageCreateInfo.pNext;
+            externalMemoryImageCreateInfo.handleTypes   = (VkExternalMemoryHandleTypeFlags)VulkanExportMemoryHandleType;
+            imageCreateInfo.pNext = &externalMemoryImageCreateInfo;
+        }
+
         const uint16 cubeFaceCount = image::isCubeTextureType( parameters.type ) ? 6u : 1u;
         pTexture->width         = parameters.width;
         pTexture->height        = parameters.height;
@@ -912,10 +1296,42 @@ namespace keen
         pTexture->usageMask     = parameters.usageMask;
         pTexture->type          = parameters.type;
         pTexture->format        = parameters.format;
+        pTexture->isLocalReadAttachment = parameters.flags.isSet( GraphicsTextureFlag::LocalReadAttachment );
+
+        VkFormatProperties formatProperties;
+        m_pVulkan->vkGetPhysicalDeviceFormatProperties( m_physicalDevice, imageCreateInfo.format, &formatProperties );
+        pTexture->formatFeatures = formatProperties.optimalTilingFeatures;
+#if defined( VK_EXT_host_image_copy )
+        pTexture->isHostTransferEnabled = ( imageCreateInfo.usage & VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT ) != 0u;
+#endif
 
 KEEN_ASSERT( parameters.debugName.hasElements() );
 
-        if( parameters.allocateMemory )
+        if( isExportable )
+        {
+            const VulkanResult result = m_pVulkan->vkCreateImage( m_device, &imageCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pTexture->image );
+            if( result.hasError() )
+            {
+                KEEN_TRACE_ERROR( "[graphics] vkCreateImage failed with error '%s'\n", result );
+                destroyTexture( pTexture );
+                return nullptr;
+            }
+
+            const Result<VulkanExportableMemory> memoryResult = vulkan::allocateExportableImageMemory( m_pVulkan, m_device, m_pSharedData->deviceMemoryProperties, pTexture->image, m_pSharedData->pVulkanAllocationCallbacks );
+            if( memoryResult.hasError() )
+            {
+                destroyTexture( pTexture );
+                return nullptr;
+            }
+            pTexture->exportableMemory = memoryResult.getValue();
+
+            if( !createDefaultTextureView( pTexture ) )
+            {
+                destroyTexture( pTexture );
+                return nullptr;
+            }
+        }
+        else if( parameters.allocateMemory )
         {
             VulkanGpuMemoryUsage usage = VulkanGpuMemoryUsage::Auto_PreferDevice;
             if( parameters.flags.isSet( GraphicsTextureFlag::PreferHostMemory ) )
@@ -1044,11 +1460,18 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         pTexture->type              = parameters.type;
         pTexture->format            = parameters.format;
         pTexture->image             = VK_NULL_HANDLE;
+        pTexture->isLocalReadAttachment = pViewedTexture->isLocalReadAttachment;
+        pTexture->formatFeatures        = pViewedTexture->formatFeatures;
+        pTexture->isHostTransferEnabled = pViewedTexture->isHostTransferEnabled;
 
         const VkImageSubresourceRange imageSubresourceRange = vulkan::getImageSubresourceRange( pTexture );
 
         VkImageViewUsageCreateInfo imageViewUsageCreateInfo{ VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO };
         imageViewUsageCreateInfo.usage  = vulkan::getImageUsageMask( parameters.usageMask );
+        if( pTexture->isLocalReadAttachment )
+        {
+            imageViewUsageCreateInfo.usage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+        }
 
         VkImageViewCreateInfo imageViewCreateInfo{ VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
         imageViewCreateInfo.pNext               = &imageViewUsageCreateInfo;
@@ -1158,6 +1581,8 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
 
         KEEN_DISABLE_FLOATINGPOINT_EXCEPTIONS_SCOPE;
 
+        pLayout->layout = VK_NULL_HANDLE;
+
         const uint32 totalBindingCount = parameters.bindings.getCount32() + parameters.staticSamplers.getCount32();
 
         DynamicArray<VkDescriptorSetLayoutBinding,128u> vulkanBindings; // :JK: what is the proper limit?
@@ -1176,6 +1601,9 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
 
         VkShaderStageFlags mergedStageFlags = 0u;
 
+        pLayout->dynamicUniformBufferCount = 0u;
+        pLayout->dynamicStorageBufferCount = 0u;
+
         uint32 lastBindingSlotIndex = 0u;
         for( uint32 bindingIndex = 0u; bindingIndex < parameters.bindings.getCount32(); ++bindingIndex )
         {
@@ -1191,7 +1619,18 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
             pVulkanBinding->binding             = bindingIndex;
             pVulkanBinding->descriptorType      = vulkan::getDescriptorType( binding.type );
 
-            if( graphics::isArrayDescriptor( binding.type ) )
+            if( binding.type == GraphicsDescriptorType::InlineUniformBlock )
+            {
+                // the descriptor count of an inline uniform block is its size in bytes:
+                if( binding.arraySizeOrBufferStride == 0u || ( binding.arraySizeOrBufferStride & 3u ) != 0u || binding.arraySizeOrBufferStride > m_pSharedData->info.maxInlineUniformBlockSize )
+                {
+                    KEEN_TRACE_ERROR( "[graphics] Descriptor set layout '%k': inline uniform block binding %d has size %d (has to be a non zero multiple of 4 and at most %d)\n", parameters.debugName, bindingIndex, binding.arraySizeOrBufferStride, m_pSharedData->info.maxInlineUniformBlockSize );
+                    destroyDescriptorSetLayout( pLayout );
+                    return nullptr;
+                }
+                pVulkanBinding->descriptorCount = binding.arraySizeOrBufferStride;
+            }
+            else if( graphics::isArrayDescriptor( binding.type ) )
             {
                 pVulkanBinding->descriptorCount = binding.arraySizeOrBufferStride;
             }
@@ -1204,6 +1643,16 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
 
             mergedStageFlags |= pVulkanBinding->stageFlags;
 
+            // the dynamic offsets are given in binding order when the set is bound:
+            if( binding.type == GraphicsDescriptorType::UniformBufferDynamic )
+            {
+                pLayout->dynamicUniformBufferCount++;
+            }
+            else if( binding.type == GraphicsDescriptorType::StorageBufferDynamic )
+            {
+                pLayout->dynamicStorageBufferCount++;
+            }
+
             if( binding.flags.isSet( GraphicsDescriptorSetLayoutBindingFlag::AllowInvalidDescriptor ) )
             {
                 *pVulkanBindingFlags |= VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
@@ -1243,6 +1692,20 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
             }
         }
 
+        // :JK: the layout hash has to be the same between runs (it is part of the pipeline binary hash) - so no sampler handles in here
+        uint64 layoutHash = 0xcbf29ce484222325ull;
+        for( size_t i = 0u; i < vulkanBindings.getSize(); ++i )
+        {
+            const VkDescriptorSetLayoutBinding& vulkanBinding = vulkanBindings[ i ];
+            const uint32 bindingData[] = { vulkanBinding.binding, (uint32)vulkanBinding.descriptorType, vulkanBinding.descriptorCount, vulkanBinding.stageFlags, vulkanBindingFlags[ i ] };
+            layoutHash = ( layoutHash ^ calculateFnv1a64Hash( bindingData, sizeof( bindingData ) ).value ) * 0x100000001b3ull;
+        }
+        for( size_t i = 0u; i < parameters.staticSamplers.getCount(); ++i )
+        {
+            layoutHash = ( layoutHash ^ graphics::computeSamplerParametersHash( parameters.staticSamplers[ i ] ).value ) * 0x100000001b3ull;
+        }
+        pLayout->layoutHash = layoutHash;
+
         VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
         descriptorSetLayoutCreateInfo.bindingCount  = (uint32)vulkanBindings.getSize();
         descriptorSetLayoutCreateInfo.pBindings     = vulkanBindings.getStart();
@@ -1315,6 +1778,11 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
                     startDescriptorIndex    = descriptorData.samplerArray.targetOffset;
                     descriptorCount         = descriptorData.samplerArray.samplerCount;
                 }
+                else if( descriptorData.type == GraphicsDescriptorType::InlineUniformBlock )
+                {
+                    startDescriptorIndex    = descriptorData.inlineUniformBlock.offset;
+                    descriptorCount         = descriptorData.inlineUniformBlock.size;
+                }
 
                 if( descriptorCount > 0 )
                 {
@@ -1406,6 +1874,9 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
                 pDescriptorSet->set         = allocationResult.getValue();
                 pDescriptorSet->flags       |= GraphicsDescriptorSetFlagMask::Dynamic;
 
+                // :JK: the pool memory is reused every frame - the generation keeps a dynamic set from matching the key of an older one
+                setObjectGeneration( pDescriptorSet, atomic::add_uint32_ordered( &m_objectGeneration, 1u ) );
+
                 vulkan::setObjectName( m_pVulkan, m_device, allocationResult.getValue(), VK_OBJECT_TYPE_DESCRIPTOR_SET, parameters.debugName );
 
 #if KEEN_USING( KEEN_GRAPHICS_VALIDATION )
@@ -1434,6 +1905,16 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
 
     VulkanQueryPool* VulkanGraphicsObjects::createQueryPool( const GraphicsQueryPoolParameters& parameters )
     {
+        VkQueryType queryType = VK_QUERY_TYPE_TIMESTAMP;
+        switch( parameters.type )
+        {
+        case GraphicsQueryPoolType::Timestamp:  queryType = VK_QUERY_TYPE_TIMESTAMP; break;
+        case GraphicsQueryPoolType::Occlusion:  queryType = VK_QUERY_TYPE_OCCLUSION; break;
+        default:
+            KEEN_TRACE_ERROR( "[graphics] Can't create query pool '%k': invalid query pool type %d\n", parameters.debugName, (int)parameters.type );
+            return nullptr;
+        }
+
         VulkanQueryPool* pQueryPool = allocateDeviceObject<VulkanQueryPool>();
         if( pQueryPool == nullptr )
         {
@@ -1445,8 +1926,9 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         KEEN_PROFILE_COUNTER_INC( m_vulkanQueryPoolCount );
 
         VkQueryPoolCreateInfo createQueryPoolInfo{ VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
-        createQueryPoolInfo.queryType   = VK_QUERY_TYPE_TIMESTAMP;
+        createQueryPoolInfo.queryType   = queryType;
         createQueryPoolInfo.queryCount  = (uint32)parameters.queryCount;
+        pQueryPool->queryType           = queryType;
         const VulkanResult result = m_pVulkan->vkCreateQueryPool( m_device, &createQueryPoolInfo, m_pSharedData->pVulkanAllocationCallbacks, &pQueryPool->queryPool );
         if( result.hasError() )
         {
@@ -1458,16 +1940,206 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         return pQueryPool;
     }
 
-    GraphicsMemoryRequirements VulkanGraphicsObjects::queryTextureMemoryRequirements( const VulkanTexture* pTexture )
+    VulkanIndirectCommandsLayout* VulkanGraphicsObjects::createIndirectCommandsLayout( const GraphicsIndirectCommandsLayoutParameters& parameters )
     {
+        KEEN_PROFILE_CPU( Vk_createIndirectCommandsLayout );
         KEEN_DISABLE_FLOATINGPOINT_EXCEPTIONS_SCOPE;
 
-        VkImageMemoryRequirementsInfo2 imageRequirementsInfo{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2, nullptr, pTexture->image };
+        if( !m_pVulkan->EXT_device_generated_commands )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Can't create indirect commands layout '%k': device generated commands are not supported\n", parameters.debugName );
+            return nullptr;
+        }
 
-        VkMemoryDedicatedRequirements dedicatedRequirements{ VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS };
-        VkMemoryRequirements2 memoryRequirements{ VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2, &dedicatedRequirements };
+        const VkPhysicalDeviceDeviceGeneratedCommandsPropertiesEXT& properties = m_pSharedData->deviceGeneratedCommandsProperties;
 
-        m_pVulkan->vkGetImageMemoryRequirements2( m_device, &imageRequirementsInfo, &memoryRequirements );
+        VulkanIndirectCommandsLimits limits;
+        limits.maxTokenCount            = properties.maxIndirectCommandsTokenCount;
+        limits.maxTokenOffset           = properties.maxIndirectCommandsTokenOffset;
+        limits.maxIndirectStride        = properties.maxIndirectCommandsIndirectStride;
+        limits.maxPipelineCount         = properties.maxIndirectPipelineCount;
+        limits.maxSequenceCount         = properties.maxIndirectSequenceCount;
+        limits.maxPushConstantsSize     = m_pSharedData->info.maxPushConstantsSize;
+        limits.supportedShaderStages    = properties.supportedIndirectCommandsShaderStages & properties.supportedIndirectCommandsShaderStagesPipelineBinding;
+
+        VulkanIndirectCommandsLayoutInfo layoutInfo;
+        if( vulkan::fillIndirectCommandsLayoutInfo( &layoutInfo, parameters, limits ).hasError() )
+        {
+            return nullptr;
+        }
+
+        VulkanIndirectCommandsLayout* pLayout = allocateDeviceObject<VulkanIndirectCommandsLayout>();
+        if( pLayout == nullptr )
+        {
+            return nullptr;
+        }
+
+        graphics::initializeDeviceObject( pLayout, GraphicsDeviceObjectType::IndirectCommandsLayout, parameters.debugName );
+        KEEN_PROFILE_COUNTER_INC( m_vulkanIndirectCommandsLayoutCount );
+
+        pLayout->layout             = VK_NULL_HANDLE;
+        pLayout->executionSet       = VK_NULL_HANDLE;
+        pLayout->pipeline           = VK_NULL_HANDLE;
+        pLayout->shaderStages       = layoutInfo.shaderStages;
+        pLayout->indirectStride     = layoutInfo.indirectStride;
+        pLayout->maxSequenceCount   = parameters.maxSequenceCount;
+        pLayout->preprocessSize     = 0u;
+
+        VkIndirectCommandsLayoutCreateInfoEXT layoutCreateInfo{ VK_STRUCTURE_TYPE_INDIRECT_COMMANDS_LAYOUT_CREATE_INFO_EXT };
+        layoutCreateInfo.shaderStages   = layoutInfo.shaderStages;
+        layoutCreateInfo.indirectStride = layoutInfo.indirectStride;
+        layoutCreateInfo.pipelineLayout = parameters.pPipelineLayout != nullptr ? ( (const VulkanPipelineLayout*)parameters.pPipelineLayout )->pipelineLayout : VK_NULL_HANDLE;
+        layoutCreateInfo.tokenCount     = rangecheck_cast<uint32>( layoutInfo.tokens.getCount() );
+        layoutCreateInfo.pTokens        = layoutInfo.tokens.getStart();
+
+        VulkanResult result = m_pVulkan->vkCreateIndirectCommandsLayoutEXT( m_device, &layoutCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pLayout->layout );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkCreateIndirectCommandsLayoutEXT of layout '%k' failed with error '%s'\n", parameters.debugName, result );
+            pLayout->layout = VK_NULL_HANDLE;
+            destroyIndirectCommandsLayout( pLayout );
+            return nullptr;
+        }
+        vulkan::setObjectName( m_pVulkan, m_device, (VkObjectHandle)pLayout->layout, VK_OBJECT_TYPE_INDIRECT_COMMANDS_LAYOUT_EXT, parameters.debugName );
+
+        const VulkanRenderPipeline* pFirstPipeline = (const VulkanRenderPipeline*)parameters.pipelines[ 0u ];
+        if( layoutInfo.hasExecutionSet )
+        {
+            VkIndirectExecutionSetPipelineInfoEXT pipelineInfo{ VK_STRUCTURE_TYPE_INDIRECT_EXECUTION_SET_PIPELINE_INFO_EXT };
+            pipelineInfo.initialPipeline    = pFirstPipeline->pipeline;
+            pipelineInfo.maxPipelineCount   = rangecheck_cast<uint32>( parameters.pipelines.getCount() );
+
+            VkIndirectExecutionSetCreateInfoEXT executionSetCreateInfo{ VK_STRUCTURE_TYPE_INDIRECT_EXECUTION_SET_CREATE_INFO_EXT };
+            executionSetCreateInfo.type                 = VK_INDIRECT_EXECUTION_SET_INFO_TYPE_PIPELINES_EXT;
+            executionSetCreateInfo.info.pPipelineInfo   = &pipelineInfo;
+
+            result = m_pVulkan->vkCreateIndirectExecutionSetEXT( m_device, &executionSetCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pLayout->executionSet );
+            if( result.hasError() )
+            {
+                KEEN_TRACE_ERROR( "[graphics] vkCreateIndirectExecutionSetEXT of layout '%k' failed with error '%s'\n", parameters.debugName, result );
+                pLayout->executionSet = VK_NULL_HANDLE;
+                destroyIndirectCommandsLayout( pLayout );
+                return nullptr;
+            }
+            vulkan::setObjectName( m_pVulkan, m_device, (VkObjectHandle)pLayout->executionSet, VK_OBJECT_TYPE_INDIRECT_EXECUTION_SET_EXT, parameters.debugName );
+
+            // :JK: index 0 is the initial pipeline - write the remaining ones
+            constexpr size_t BatchSize = 64u;
+            for( size_t batchStart = 1u; batchStart < parameters.pipelines.getCount(); batchStart += BatchSize )
+            {
+                DynamicArray<VkWriteIndirectExecutionSetPipelineEXT, BatchSize> writes;
+                const size_t batchEnd = min( batchStart + BatchSize, parameters.pipelines.getCount() );
+                for( size_t pipelineIndex = batchStart; pipelineIndex < batchEnd; ++pipelineIndex )
+                {
+                    const VulkanRenderPipeline* pPipeline = (const VulkanRenderPipeline*)parameters.pipelines[ pipelineIndex ];
+
+                    VkWriteIndirectExecutionSetPipelineEXT* pWrite = writes.pushBackZero();
+                    pWrite->sType       = VK_STRUCTURE_TYPE_WRITE_INDIRECT_EXECUTION_SET_PIPELINE_EXT;
+                    pWrite->index       = (uint32)pipelineIndex;
+                    pWrite->pipeline    = pPipeline->pipeline;
+                }
+                m_pVulkan->vkUpdateIndirectExecutionSetPipelineEXT( m_device, pLayout->executionSet, (uint32)writes.getCount(), writes.getStart() );
+            }
+        }
+        else
+        {
+            pLayout->pipeline = pFirstPipeline->pipeline;
+        }
+
+        // query the worst case preprocess size so that the render context can size the per frame preprocess buffers:
+        VkGeneratedCommandsPipelineInfoEXT generatedCommandsPipelineInfo{ VK_STRUCTURE_TYPE_GENERATED_COMMANDS_PIPELINE_INFO_EXT };
+        generatedCommandsPipelineInfo.pipeline = pLayout->pipeline;
+
+        VkGeneratedCommandsMemoryRequirementsInfoEXT memoryRequirementsInfo{ VK_STRUCTURE_TYPE_GENERATED_COMMANDS_MEMORY_REQUIREMENTS_INFO_EXT };
+        memoryRequirementsInfo.pNext                    = pLayout->executionSet == VK_NULL_HANDLE ? &generatedCommandsPipelineInfo : nullptr;
+        memoryRequirementsInfo.indirectExecutionSet     = pLayout->executionSet;
+        memoryRequirementsInfo.indirectCommandsLayout   = pLayout->layout;
+        memoryRequirementsInfo.maxSequenceCount         = parameters.maxSequenceCount;
+        memoryRequirementsInfo.maxDrawCount             = 0u;
+
+        VkMemoryRequirements2 memoryRequirements{ VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2 };
+        m_pVulkan->vkGetGeneratedCommandsMemoryRequirementsEXT( m_device, &memoryRequirementsInfo, &memoryRequirements );
+        pLayout->preprocessSize         = memoryRequirements.memoryRequirements.size;
+        pLayout->preprocessAlignment    = max<uint64>( memoryRequirements.memoryRequirements.alignment, 1u );
+
+        {
+            MutexLock lock( &m_generatedCommandsMutex );
+            m_maxGeneratedCommandsPreprocessSize        = max( m_maxGeneratedCommandsPreprocessSize, pLayout->preprocessSize );
+            m_maxGeneratedCommandsPreprocessAlignment   = max( m_maxGeneratedCommandsPreprocessAlignment, pLayout->preprocessAlignment );
+            m_generatedCommandsPreprocessMemoryTypeBits &= memoryRequirements.memoryRequirements.memoryTypeBits;
+            KEEN_ASSERT( m_generatedCommandsPreprocessMemoryTypeBits != 0u );
+        }
+
+        return pLayout;
+    }
+
+    uint64 VulkanGraphicsObjects::getMaxGeneratedCommandsPreprocessSize()
+    {
+        MutexLock lock( &m_generatedCommandsMutex );
+        return m_maxGeneratedCommandsPreprocessSize;
+    }
+
+    VulkanBuffer* VulkanGraphicsObjects::createGeneratedCommandsPreprocessBuffer( uint64 sizeInBytes, const DebugName& debugName )
+    {
+        KEEN_PROFILE_CPU( Vk_createGeneratedCommandsPreprocessBuffer );
+        KEEN_DISABLE_FLOATINGPOINT_EXCEPTIONS_SCOPE;
+
+        KEEN_ASSERT( m_pVulkan->EXT_device_generated_commands );
+
+        uint32 memoryTypeBits;
+        uint32 alignment;
+        {
+            MutexLock lock( &m_generatedCommandsMutex );
+            memoryTypeBits  = m_generatedCommandsPreprocessMemoryTypeBits;
+            alignment       = rangecheck_cast<uint32>( m_maxGeneratedCommandsPreprocessAlignment );
+        }
+
+        VulkanBuffer* pBuffer = allocateDeviceObject<VulkanBuffer>();
+        if( pBuffer == nullptr )
+        {
+            return nullptr;
+        }
+
+        // :JK: the preprocess usage only exists as a VkBufferUsageFlags2 bit (maintenance5)
+        VkBufferUsageFlags2CreateInfoKHR usageFlags2{ VK_STRUCTURE_TYPE_BUFFER_USAGE_FLAGS_2_CREATE_INFO_KHR };
+        usageFlags2.usage = VK_BUFFER_USAGE_2_PREPROCESS_BUFFER_BIT_EXT | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT_KHR;
+
+        VkBufferCreateInfo bufferCreateInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        bufferCreateInfo.pNext  = &usageFlags2;
+        bufferCreateInfo.size   = sizeInBytes;
+        bufferCreateInfo.usage  = VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+
+        VulkanGpuBufferResult allocationResult;
+        // the memory type has to fit the requirements of all indirect commands layouts (vkGetGeneratedCommandsMemoryRequirementsEXT):
+        if( !vulkan::allocateGpuBuffer( &allocationResult, m_pGpuAllocator, VulkanGpuMemoryUsage::Auto_PreferDevice, {}, alignment, memoryTypeBits, bufferCreateInfo, debugName ) )
+        {
+            freeDeviceObject( pBuffer );
+            return nullptr;
+        }
+
+        pBuffer->buffer         = allocationResult.buffer;
+        pBuffer->allocation     = allocationResult.allocationInfo;
+        pBuffer->deviceAddress  = vulkan::getBufferDeviceAddress( m_pVulkan, m_device, pBuffer->buffer );
+        KEEN_ASSERT( pBuffer->deviceAddress != 0u );
+
+        vulkan::setObjectName( m_pVulkan, m_device, (VkObjectHandle)pBuffer->buffer, VK_OBJECT_TYPE_BUFFER, debugName );
+
+        graphics::initializeDeviceObject( pBuffer, GraphicsDeviceObjectType::Buffer, debugName );
+
+        KEEN_PROFILE_COUNTER_INC( m_vulkanBufferCount );
+        return pBuffer;
+    }
+
+    GraphicsMemoryRequirements VulkanGraphicsObjects::queryTextureMemoryRequirements( const VulkanTexture* pTexture )
+    {
+        KEEN_DISABLE_FLOATINGPOINT_EXCEPTIONS_SCOPE;
+
+        VkImageMemoryRequirementsInfo2 imageRequirementsInfo{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2, nullptr, pTexture->image };
+
+        VkMemoryDedicatedRequirements dedicatedRequirements{ VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS };
+        VkMemoryRequirements2 memoryRequirements{ VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2, &dedicatedRequirements };
+
+        m_pVulkan->vkGetImageMemoryRequirements2( m_device, &imageRequirementsInfo, &memoryRequirements );
         return vulkan::createGraphicsMemoryRequirements( memoryRequirements.memoryRequirements, dedicatedRequirements.prefersDedicatedAllocation == VK_TRUE, dedicatedRequirements.requiresDedicatedAllocation == VK_TRUE );
     }
 
@@ -1509,7 +2181,8 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
                 KEEN_ASSERT( pNonConstBuffer->sizeInBytes <= pBinding->memoryRange.size );
                 if( pDeviceMemory->mappedMemory.isValid() )
                 {
-                    pNonConstBuffer->pMappedMemory  = pDeviceMemory->mappedMemory.pStart + pBinding->memoryRange.offset;
+                    pNonConstBuffer->pMappedMemory      = pDeviceMemory->mappedMemory.pStart + pBinding->memoryRange.offset;
+                    pNonConstBuffer->uploadCopyKernel   = pDeviceMemory->uploadCopyKernel;
                 }
                 pNonConstBuffer->pBoundDeviceMemory = pDeviceMemory;
                 pNonConstBuffer->boundMemoryOffset  = pBinding->memoryRange.offset;
@@ -1595,6 +2268,14 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         {
             poolSizes.pushBack( VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, descriptorPoolSizes.storageBufferDescriptorCount } );
         }
+        if( descriptorPoolSizes.uniformBufferDynamicDescriptorCount > 0u )
+        {
+            poolSizes.pushBack( VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, descriptorPoolSizes.uniformBufferDynamicDescriptorCount } );
+        }
+        if( descriptorPoolSizes.storageBufferDynamicDescriptorCount > 0u )
+        {
+            poolSizes.pushBack( VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, descriptorPoolSizes.storageBufferDynamicDescriptorCount } );
+        }
         if( descriptorPoolSizes.samplerDescriptorCount > 0u )
         {
             poolSizes.pushBack( VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_SAMPLER, descriptorPoolSizes.samplerDescriptorCount } );
@@ -1607,6 +2288,19 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         {
             poolSizes.pushBack( VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, descriptorPoolSizes.storageImageDescriptorCount } );
         }
+        if( m_pVulkan->KHR_dynamic_rendering_local_read && descriptorPoolSizes.inputAttachmentDescriptorCount > 0u )
+        {
+            poolSizes.pushBack( VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, descriptorPoolSizes.inputAttachmentDescriptorCount } );
+        }
+
+        // :JK: the descriptor count of inline uniform blocks is in bytes:
+        VkDescriptorPoolInlineUniformBlockCreateInfoEXT inlineUniformBlockCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_INLINE_UNIFORM_BLOCK_CREATE_INFO_EXT };
+        const bool hasInlineUniformBlocks = m_pVulkan->EXT_inline_uniform_block && descriptorPoolSizes.inlineUniformBlockBindingCount > 0u && descriptorPoolSizes.inlineUniformBlockSize > 0u;
+        if( hasInlineUniformBlocks )
+        {
+            poolSizes.pushBack( VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT, descriptorPoolSizes.inlineUniformBlockSize } );
+            inlineUniformBlockCreateInfo.maxInlineUniformBlockBindings = descriptorPoolSizes.inlineUniformBlockBindingCount;
+        }
 
         if( poolSizes.isEmpty() )
         {
@@ -1619,6 +2313,10 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         descriptorPoolCreateInfo.poolSizeCount  = (uint32)poolSizes.getSize();
         descriptorPoolCreateInfo.pPoolSizes     = poolSizes.getStart();
         descriptorPoolCreateInfo.flags          = type == VulkanDescriptorPoolType::Static ? VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT : 0u;
+        if( hasInlineUniformBlocks )
+        {
+            descriptorPoolCreateInfo.pNext      = &inlineUniformBlockCreateInfo;
+        }
 
         const VulkanResult result = m_pVulkan->vkCreateDescriptorPool( m_device, &descriptorPoolCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pDescriptorPool->pool );
         if( result.hasError() )
@@ -1765,23 +2463,59 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         }
 #endif
 
+        VkPipelineCache pipelineCache = m_pipelineCache;
+        VkPipelineBinaryKHR pipelineBinaries[ VulkanMaxPipelineBinaryCount ] = {};
+        VkPipelineBinaryInfoKHR pipelineBinaryInfo{ VK_STRUCTURE_TYPE_PIPELINE_BINARY_INFO_KHR };
+        VkPipelineCreateFlags2CreateInfoKHR createFlags2Info{ VK_STRUCTURE_TYPE_PIPELINE_CREATE_FLAGS_2_CREATE_INFO_KHR };
+        VulkanPipelineBinaryKey pipelineBinaryKey{};
+        uint64 pipelineBinaryHash = 0u;
+        uint32 pipelineBinaryCount = 0u;
+        if( m_usePipelineBinaries )
+        {
+            pipelineCache = VK_NULL_HANDLE;
+
+            pipelineBinaryHash  = ( vulkan::computeComputePipelineKey( parameters ).value ^ pPipelineLayout->layoutHash ) * 0x100000001b3ull;
+            pipelineBinaryCount = acquirePipelineBinaries( pipelineBinaries, &pipelineBinaryKey, pipelineBinaryHash, &pipelineCreateInfo, parameters.debugName );
+
+            pipelineBinaryInfo.binaryCount          = pipelineBinaryCount;
+            pipelineBinaryInfo.pPipelineBinaries    = pipelineBinaries;
+            if( pipelineBinaryCount > 0u )
+            {
+                pipelineCreateInfo.pNext = &pipelineBinaryInfo;
+            }
+            else if( pipelineBinaryKey.size > 0u )
+            {
+                // :JK: VkPipelineCreateFlags2CreateInfoKHR replaces pipelineCreateInfo.flags
+                createFlags2Info.flags  = (VkPipelineCreateFlags2KHR)pipelineCreateInfo.flags | VK_PIPELINE_CREATE_2_CAPTURE_DATA_BIT_KHR;
+                pipelineCreateInfo.pNext = &createFlags2Info;
+            }
+        }
+
 #ifndef KEEN_BUILD_MASTER
         const SystemTimer timer;
 #endif
 
         VkPipeline pipeline = VK_NULL_HANDLE;
-        VulkanResult result = pVulkan->vkCreateComputePipelines( device, m_pipelineCache, 1u, &pipelineCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pipeline );
+        VulkanResult result = pVulkan->vkCreateComputePipelines( device, pipelineCache, 1u, &pipelineCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pipeline );
         if( result.hasError() || pipeline == VK_NULL_HANDLE )   // :JK: pipeline shouldn't be null if vkCreateComputePipelines succeeds - but we had crashdumps suggesting that this happens
         {
             KEEN_TRACE_WARNING( "[graphics] vkCompileComputePipeline of pipeline '%s' failed with error '%s'. Trying again without pipeline cache.\n", parameters.debugName, result );
+            pipelineBinaryInfo.binaryCount = 0u;
             result = pVulkan->vkCreateComputePipelines( device, VK_NULL_HANDLE, 1u, &pipelineCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pipeline );
             if( result.hasError() || pipeline == VK_NULL_HANDLE )
             {
                 KEEN_TRACE_WARNING( "[graphics] vkCompileComputePipeline of pipeline '%s' failed with error '%s' (pipeline cache was skipped).\n", parameters.debugName, result );
+                vulkan::destroyPipelineBinaries( pVulkan, pipelineBinaries, pipelineBinaryCount, m_pSharedData->pVulkanAllocationCallbacks );
                 return result.getErrorId();
             }
         }
 
+        vulkan::destroyPipelineBinaries( pVulkan, pipelineBinaries, pipelineBinaryCount, m_pSharedData->pVulkanAllocationCallbacks );
+        if( isBitmaskSet( createFlags2Info.flags, VK_PIPELINE_CREATE_2_CAPTURE_DATA_BIT_KHR ) )
+        {
+            storePipelineBinaries( pipeline, pipelineBinaryHash, pipelineBinaryKey, parameters.debugName );
+        }
+
 #ifndef KEEN_BUILD_MASTER
         const Time elapsedTime = timer.getElapsedTime();
         if( elapsedTime > 1_s )
@@ -1797,6 +2531,13 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
 
         vulkan::setObjectName( pVulkan, device, (VkObjectHandle)pPipeline->pipeline, VK_OBJECT_TYPE_PIPELINE, parameters.debugName );
 
+#if KEEN_USING( KEEN_COMPILED_SHADER_INFO )
+        if( m_collectPipelineStatistics )
+        {
+            recordPipelineStatistics( pipeline, VK_SHADER_STAGE_COMPUTE_BIT, parameters.debugName, vulkan::computeComputePipelinePermutationKey( parameters ), calculateFnv1a64Hash( parameters.shaderCode.pStart, parameters.shaderCode.size ).value );
+        }
+#endif
+
         return ErrorId_Ok;
     }
 
@@ -1815,16 +2556,46 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         VkDevice device = m_device;
         VulkanApi* pVulkan = m_pVulkan;
 
-        const bool hasTessellation = shaderModules.tcShader != VK_NULL_HANDLE;
+        // mesh pipelines replace the whole vertex/tessellation front end (including the vertex input + input assembly state)
+        const bool isMeshPipeline = shaderModules.meshShader != VK_NULL_HANDLE;
+        const bool hasTessellation = !isMeshPipeline && shaderModules.tcShader != VK_NULL_HANDLE;
+
+        if( isMeshPipeline && !pVulkan->EXT_mesh_shader )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Render pipeline '%k' uses a mesh shader but VK_EXT_mesh_shader is not enabled!\n", parameters.debugName );
+            return ErrorId_NotSupported;
+        }
         
         DynamicArray<VkPipelineShaderStageCreateInfo, 5u> shaderStageCreateInfos;
 
-        VkPipelineShaderStageCreateInfo* pVertexShaderStageCreateInfo = shaderStageCreateInfos.pushBack();
-        zeroValue( pVertexShaderStageCreateInfo );
-        pVertexShaderStageCreateInfo->sType     = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        pVertexShaderStageCreateInfo->stage     = VK_SHADER_STAGE_VERTEX_BIT;
-        pVertexShaderStageCreateInfo->module    = shaderModules.vertexShader;
-        pVertexShaderStageCreateInfo->pName     = graphics::getEntryPointName( parameters.entryPointId, parameters.vsEntryPoint, GraphicsPipelineStage::Vertex ).getStart();
+        if( isMeshPipeline )
+        {
+            if( shaderModules.taskShader != VK_NULL_HANDLE )
+            {
+                VkPipelineShaderStageCreateInfo* pTaskShaderStageCreateInfo = shaderStageCreateInfos.pushBack();
+                zeroValue( pTaskShaderStageCreateInfo );
+                pTaskShaderStageCreateInfo->sType   = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+                pTaskShaderStageCreateInfo->stage   = VK_SHADER_STAGE_TASK_BIT_EXT;
+                pTaskShaderStageCreateInfo->module  = shaderModules.taskShader;
+                pTaskShaderStageCreateInfo->pName   = graphics::getEntryPointName( parameters.entryPointId, parameters.tsEntryPoint, GraphicsPipelineStage::MS_Task ).getStart();
+            }
+
+            VkPipelineShaderStageCreateInfo* pMeshShaderStageCreateInfo = shaderStageCreateInfos.pushBack();
+            zeroValue( pMeshShaderStageCreateInfo );
+            pMeshShaderStageCreateInfo->sType   = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            pMeshShaderStageCreateInfo->stage   = VK_SHADER_STAGE_MESH_BIT_EXT;
+            pMeshShaderStageCreateInfo->module  = shaderModules.meshShader;
+            pMeshShaderStageCreateInfo->pName   = graphics::getEntryPointName( parameters.entryPointId, parameters.msEntryPoint, GraphicsPipelineStage::MS_Mesh ).getStart();
+        }
+        else
+        {
+            VkPipelineShaderStageCreateInfo* pVertexShaderStageCreateInfo = shaderStageCreateInfos.pushBack();
+            zeroValue( pVertexShaderStageCreateInfo );
+            pVertexShaderStageCreateInfo->sType     = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            pVertexShaderStageCreateInfo->stage     = VK_SHADER_STAGE_VERTEX_BIT;
+            pVertexShaderStageCreateInfo->module    = shaderModules.vertexShader;
+            pVertexShaderStageCreateInfo->pName     = graphics::getEntryPointName( parameters.entryPointId, parameters.vsEntryPoint, GraphicsPipelineStage::Vertex ).getStart();
+        }
 
         if( hasTessellation )
         {
@@ -1853,43 +2624,37 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
             pFragmentShaderStageCreateInfo->pName   = graphics::getEntryPointName( parameters.entryPointId, parameters.fsEntryPoint, GraphicsPipelineStage::Fragment ).getStart();
         }
 
-        VkVertexInputAttributeDescription vertexAttributeDescriptions[ VertexAttributeId_Count ];
-        VkVertexInputBindingDescription vertexInputBindingDescription;
+        VkVertexInputAttributeDescription2EXT vertexAttributeDescriptions2[ VertexAttributeId_Count ];
+        VkVertexInputBindingDescription2EXT vertexInputBindingDescriptions2[ GraphicsLimits_MaxVertexStreamCount ];
         uint32 vertexAttributeDescriptionCount = 0u;
         uint32 vertexInputBindingDescriptionCount = 0u;
-
-        const VertexFormat* pVertexFormat = parameters.pVertexFormat;
-        if( pVertexFormat != nullptr )
+        if( !isMeshPipeline )
         {
-            for( size_t attributeId = 0u; attributeId < VertexAttributeId_Count; ++attributeId )
-            {
-                if( !pVertexFormat->hasAttribute( attributeId ) )
-                {
-                    continue;
-                }
-                const VertexFormat::AttributeInfo& attribute = pVertexFormat->attributeInfos[ attributeId ];
-
-                KEEN_ASSERT( attribute.format < VertexAttributeFormat_Count );
-
-                const VkFormat vulkanFormat = vulkan::getVertexAttributeFormat( attribute.format );
-                KEEN_ASSERT( vulkanFormat != VK_FORMAT_UNDEFINED );
+            vulkan::fillVertexInputDescriptions( &vertexInputBindingDescriptionCount, vertexInputBindingDescriptions2, &vertexAttributeDescriptionCount, vertexAttributeDescriptions2, parameters );
+        }
 
-                vertexAttributeDescriptions[ vertexAttributeDescriptionCount ].location = (uint32)attributeId;
-                vertexAttributeDescriptions[ vertexAttributeDescriptionCount ].binding  = 0u;
-                vertexAttributeDescriptions[ vertexAttributeDescriptionCount ].format   = vulkanFormat;
-                vertexAttributeDescriptions[ vertexAttributeDescriptionCount ].offset   = attribute.offset;
+        // the pipeline wants the version 1 structs:
+        VkVertexInputAttributeDescription vertexAttributeDescriptions[ VertexAttributeId_Count ];
+        for( size_t i = 0u; i < vertexAttributeDescriptionCount; ++i )
+        {
+            KEEN_ASSERT( vertexAttributeDescriptions2[ i ].format != VK_FORMAT_UNDEFINED );
 
-                vertexAttributeDescriptionCount++;
-            }
+            vertexAttributeDescriptions[ i ].location   = vertexAttributeDescriptions2[ i ].location;
+            vertexAttributeDescriptions[ i ].binding    = vertexAttributeDescriptions2[ i ].binding;
+            vertexAttributeDescriptions[ i ].format     = vertexAttributeDescriptions2[ i ].format;
+            vertexAttributeDescriptions[ i ].offset     = vertexAttributeDescriptions2[ i ].offset;
+        }
 
-            vertexInputBindingDescription.binding   = 0u;
-            vertexInputBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-            vertexInputBindingDescription.stride    = pVertexFormat->stride;
-            vertexInputBindingDescriptionCount = 1u;
+        VkVertexInputBindingDescription vertexInputBindingDescriptions[ GraphicsLimits_MaxVertexStreamCount ];
+        for( size_t i = 0u; i < vertexInputBindingDescriptionCount; ++i )
+        {
+            vertexInputBindingDescriptions[ i ].binding     = vertexInputBindingDescriptions2[ i ].binding;
+            vertexInputBindingDescriptions[ i ].inputRate   = vertexInputBindingDescriptions2[ i ].inputRate;
+            vertexInputBindingDescriptions[ i ].stride      = vertexInputBindingDescriptions2[ i ].stride;
         }
 
         VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
-        vertexInputStateCreateInfo.pVertexBindingDescriptions       = &vertexInputBindingDescription;
+        vertexInputStateCreateInfo.pVertexBindingDescriptions       = vertexInputBindingDescriptions;
         vertexInputStateCreateInfo.vertexBindingDescriptionCount    = vertexInputBindingDescriptionCount;
         vertexInputStateCreateInfo.pVertexAttributeDescriptions     = vertexAttributeDescriptions;
         vertexInputStateCreateInfo.vertexAttributeDescriptionCount  = vertexAttributeDescriptionCount;
@@ -1992,8 +2757,11 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         VkGraphicsPipelineCreateInfo pipelineCreateInfo = { VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO };
         pipelineCreateInfo.stageCount           = rangecheck_cast<uint32>( shaderStageCreateInfos.getSize() );
         pipelineCreateInfo.pStages              = shaderStageCreateInfos.getStart();
-        pipelineCreateInfo.pVertexInputState    = &vertexInputStateCreateInfo;
-        pipelineCreateInfo.pInputAssemblyState  = &inputAssemblyStateCreateInfo;
+        if( !isMeshPipeline )
+        {
+            pipelineCreateInfo.pVertexInputState    = &vertexInputStateCreateInfo;
+            pipelineCreateInfo.pInputAssemblyState  = &inputAssemblyStateCreateInfo;
+        }
         if( hasTessellation )
         {
             pipelineCreateInfo.pTessellationState = &tessellationStateCreateInfo;
@@ -2004,7 +2772,7 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         pipelineCreateInfo.pMultisampleState    = &multisampleStateCreateInfo;
         pipelineCreateInfo.pColorBlendState     = &colorBlendStateCreateInfo;       // pass nullptr to disable rasterization
 
-        DynamicArray<VkDynamicState, 16u> dynamicStates;
+        DynamicArray<VkDynamicState, VulkanMaxDynamicStateCount> dynamicStates;
 
         if( parameters.dynamicState.isSet( GraphicsDynamicStateFlag::Viewport ) )
         {
@@ -2031,6 +2799,13 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
             dynamicStates.pushBack( VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK );
         }
 
+        if( parameters.dynamicState.isSet( GraphicsDynamicStateFlag::ShadingRate ) && pVulkan->KHR_fragment_shading_rate )
+        {
+            dynamicStates.pushBack( VK_DYNAMIC_STATE_FRAGMENT_SHADING_RATE_KHR );
+        }
+
+        vulkan::addExtendedDynamicStates( &dynamicStates, pPipeline->dynamicStateFeatures, isMeshPipeline, parameters.useDynamicVertexStrides );
+
         VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO };
         dynamicStateCreateInfo.dynamicStateCount    = (uint32)dynamicStates.getSize();
         dynamicStateCreateInfo.pDynamicStates       = dynamicStates.getStart();
@@ -2052,7 +2827,7 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
             const bool hasStencil                       = image::hasStencil( parameters.renderTargetFormat.depthStencilTargetFormat );
             const bool hasDepth                         = image::hasDepth( parameters.renderTargetFormat.depthStencilTargetFormat );
             const VkFormat depthStencilFormat           = vulkan::getVulkanFormat( parameters.renderTargetFormat.depthStencilTargetFormat );
-            renderingCreateInfo.viewMask                = 0u;
+            renderingCreateInfo.viewMask                = parameters.viewMask;
             renderingCreateInfo.colorAttachmentCount    = colorTargetCount;
             renderingCreateInfo.pColorAttachmentFormats = colorAttachmentFormats;
             renderingCreateInfo.depthAttachmentFormat   = hasDepth ? depthStencilFormat : VK_FORMAT_UNDEFINED;
@@ -2060,6 +2835,32 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
 
             pipelineCreateInfo.pNext = &renderingCreateInfo;
         }
+        const void** ppNextCreateInfo = &renderingCreateInfo.pNext;
+
+        // pipelines used inside a rendering scope that reads its own attachments:
+        VkRenderingInputAttachmentIndexInfoKHR inputAttachmentIndexInfo{ VK_STRUCTURE_TYPE_RENDERING_INPUT_ATTACHMENT_INDEX_INFO_KHR };
+        uint32 colorInputAttachmentIndices[ GraphicsLimits_MaxColorTargetCount ];
+        uint32 depthInputAttachmentIndex;
+        uint32 stencilInputAttachmentIndex;
+        if( parameters.inputAttachmentIndices.isEnabled )
+        {
+            vulkan::fillRenderingInputAttachmentIndexInfo( &inputAttachmentIndexInfo, colorInputAttachmentIndices, &depthInputAttachmentIndex, &stencilInputAttachmentIndex, parameters.inputAttachmentIndices, colorTargetCount );
+            vulkan::appendToStructChain( &ppNextCreateInfo, &inputAttachmentIndexInfo );
+        }
+
+        VkPipelineFragmentShadingRateStateCreateInfoKHR shadingRateStateCreateInfo{ VK_STRUCTURE_TYPE_PIPELINE_FRAGMENT_SHADING_RATE_STATE_CREATE_INFO_KHR };
+        if( pVulkan->KHR_fragment_shading_rate )
+        {
+            shadingRateStateCreateInfo.fragmentSize      = vulkan::getFragmentShadingRateSize( parameters.shadingRate );
+            shadingRateStateCreateInfo.combinerOps[ 0u ] = vulkan::getFragmentShadingRateCombinerOp( parameters.shadingRateCombiners[ 0u ] );
+            shadingRateStateCreateInfo.combinerOps[ 1u ] = vulkan::getFragmentShadingRateCombinerOp( parameters.shadingRateCombiners[ 1u ] );
+            vulkan::appendToStructChain( &ppNextCreateInfo, &shadingRateStateCreateInfo );
+
+            if( parameters.useShadingRateAttachment )
+            {
+                pipelineCreateInfo.flags |= VK_PIPELINE_CREATE_RENDERING_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR;
+            }
+        }
 
         pipelineCreateInfo.layout               = pPipelineLayout->pipelineLayout;
         pipelineCreateInfo.subpass              = 0u;
@@ -2073,25 +2874,76 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         }
 #endif
 
+        // :JK: VkPipelineCreateFlags2CreateInfoKHR replaces pipelineCreateInfo.flags - so this has to come after all other flags
+        VkPipelineCreateFlags2CreateInfoKHR createFlags2Info{ VK_STRUCTURE_TYPE_PIPELINE_CREATE_FLAGS_2_CREATE_INFO_KHR };
+        if( parameters.isIndirectBindable )
+        {
+            KEEN_ASSERT( pVulkan->EXT_device_generated_commands );
+            createFlags2Info.flags = (VkPipelineCreateFlags2KHR)pipelineCreateInfo.flags | VK_PIPELINE_CREATE_2_INDIRECT_BINDABLE_BIT_EXT;
+            vulkan::appendToStructChain( &ppNextCreateInfo, &createFlags2Info );
+        }
+
+        // the pipeline key has to be queried from the complete create info - so this comes last:
+        VkPipelineCache pipelineCache = m_pipelineCache;
+        VkPipelineBinaryKHR pipelineBinaries[ VulkanMaxPipelineBinaryCount ] = {};
+        VkPipelineBinaryInfoKHR pipelineBinaryInfo{ VK_STRUCTURE_TYPE_PIPELINE_BINARY_INFO_KHR };
+        VulkanPipelineBinaryKey pipelineBinaryKey{};
+        uint64 pipelineBinaryHash = 0u;
+        uint32 pipelineBinaryCount = 0u;
+        if( m_usePipelineBinaries )
+        {
+            pipelineCache = VK_NULL_HANDLE;
+
+            pipelineBinaryHash  = ( vulkan::computeRenderPipelineKey( parameters, pPipeline->dynamicStateFeatures ).value ^ pPipelineLayout->layoutHash ) * 0x100000001b3ull;
+            pipelineBinaryCount = acquirePipelineBinaries( pipelineBinaries, &pipelineBinaryKey, pipelineBinaryHash, &pipelineCreateInfo, parameters.debugName );
+
+            pipelineBinaryInfo.binaryCount          = pipelineBinaryCount;
+            pipelineBinaryInfo.pPipelineBinaries    = pipelineBinaries;
+            if( pipelineBinaryCount > 0u )
+            {
+                vulkan::appendToStructChain( &ppNextCreateInfo, &pipelineBinaryInfo );
+            }
+            else if( pipelineBinaryKey.size > 0u )
+            {
+                if( !parameters.isIndirectBindable )
+                {
+                    createFlags2Info.flags = (VkPipelineCreateFlags2KHR)pipelineCreateInfo.flags;
+                    vulkan::appendToStructChain( &ppNextCreateInfo, &createFlags2Info );
+                }
+                createFlags2Info.flags |= VK_PIPELINE_CREATE_2_CAPTURE_DATA_BIT_KHR;
+            }
+        }
+
 #ifndef KEEN_BUILD_MASTER
         const SystemTimer timer;
 #endif
 
         VkPipeline pipeline = VK_NULL_HANDLE;
-        VulkanResult result = pVulkan->vkCreateGraphicsPipelines( device, m_pipelineCache, 1u, &pipelineCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pipeline );
+        VulkanResult result = pVulkan->vkCreateGraphicsPipelines( device, pipelineCache, 1u, &pipelineCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pipeline );
         if( result.hasError() || pipeline == VK_NULL_HANDLE )
         {
             KEEN_TRACE_WARNING( "[graphics] vkCreateGraphicsPipelines of pipeline '%s' failed with error '%s'. Trying again without pipeline cache.\n", parameters.debugName, result );
+
+            // :JK: a binary count of zero disables the VkPipelineBinaryInfoKHR - the archived binaries might be the problem as well
+            pipelineBinaryInfo.binaryCount = 0u;
             result = pVulkan->vkCreateGraphicsPipelines( device, VK_NULL_HANDLE, 1u, &pipelineCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pipeline );
             if( result.hasError() || pipeline == VK_NULL_HANDLE )
             {
                 KEEN_TRACE_WARNING( "[graphics] vkCreateGraphicsPipelines of pipeline '%s' failed with error '%s' (pipeline cache was skipped).\n", parameters.debugName, result );
+                vulkan::destroyPipelineBinaries( pVulkan, pipelineBinaries, pipelineBinaryCount, m_pSharedData->pVulkanAllocationCallbacks );
                 return result.getErrorId();
             }
         }
 
         KEEN_ASSERT( pipeline != VK_NULL_HANDLE );
 
+        // the pipeline doesn't reference the binaries it was created from:
+        vulkan::destroyPipelineBinaries( pVulkan, pipelineBinaries, pipelineBinaryCount, m_pSharedData->pVulkanAllocationCallbacks );
+        if( isBitmaskSet( createFlags2Info.flags, VK_PIPELINE_CREATE_2_CAPTURE_DATA_BIT_KHR ) )
+        {
+            storePipelineBinaries( pipeline, pipelineBinaryHash, pipelineBinaryKey, parameters.debugName );
+        }
+
 #ifndef KEEN_BUILD_MASTER
         const Time elapsedTime = timer.getElapsedTime();
         if( elapsedTime > 1_s )
@@ -2104,9 +2956,396 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
 
         vulkan::setObjectName( pVulkan, device, (VkObjectHandle)pPipeline->pipeline, VK_OBJECT_TYPE_PIPELINE, parameters.debugName );
 
+#if KEEN_USING( KEEN_COMPILED_SHADER_INFO )
+        if( m_collectPipelineStatistics )
+        {
+            const ConstMemoryBlock shaderCodes[] = { parameters.vertexShaderCode, parameters.tcShaderCode, parameters.teShaderCode, parameters.fragmentShaderCode, parameters.taskShaderCode, parameters.meshShaderCode };
+            const VkShaderModule shaderStageModules[] = { shaderModules.vertexShader, shaderModules.tcShader, shaderModules.teShader, shaderModules.fragmentShader, shaderModules.taskShader, shaderModules.meshShader };
+            const VkShaderStageFlagBits shaderStageBits[] = { VK_SHADER_STAGE_VERTEX_BIT, VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT, VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT, VK_SHADER_STAGE_FRAGMENT_BIT, VK_SHADER_STAGE_TASK_BIT_EXT, VK_SHADER_STAGE_MESH_BIT_EXT };
+
+            VkShaderStageFlags shaderStages = 0u;
+            uint64 shaderCodeHash = 0u;
+            for( size_t i = 0u; i < KEEN_COUNTOF( shaderStageModules ); ++i )
+            {
+                if( shaderStageModules[ i ] != VK_NULL_HANDLE )
+                {
+                    shaderStages |= shaderStageBits[ i ];
+                    shaderCodeHash = ( shaderCodeHash ^ calculateFnv1a64Hash( shaderCodes[ i ].pStart, shaderCodes[ i ].size ).value ) * 0x100000001b3ull;
+                }
+            }
+
+            recordPipelineStatistics( pipeline, shaderStages, parameters.debugName, vulkan::computeRenderPipelinePermutationKey( parameters ), shaderCodeHash );
+        }
+#endif
+
         return ErrorId_Ok;
     }
 
+    ErrorId VulkanGraphicsObjects::createRenderPipelineShaderObjects( VulkanRenderPipeline* pPipeline, const GraphicsRenderPipelineParameters& parameters )
+    {
+        KEEN_PROFILE_CPU( Vk_CreateRenderPipelineShaderObjects );
+
+        KEEN_DISABLE_FLOATINGPOINT_EXCEPTIONS_SCOPE;
+
+        const VulkanPipelineLayout* pPipelineLayout = (const VulkanPipelineLayout*)parameters.pPipelineLayout;
+#if KEEN_USING( KEEN_GRAPHICS_VALIDATION )
+        KEEN_VERIFY( graphics::validateDeviceObject( pPipelineLayout, GraphicsDeviceObjectType::PipelineLayout ) );
+#endif
+
+        const bool isMeshPipeline = isConstMemoryBlockValid( parameters.meshShaderCode );
+        const bool hasTessellation = !isMeshPipeline && isConstMemoryBlockValid( parameters.tcShaderCode );
+
+        if( isMeshPipeline && !m_pVulkan->EXT_mesh_shader )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Render pipeline '%k' uses a mesh shader but VK_EXT_mesh_shader is not enabled!\n", parameters.debugName );
+            return ErrorId_NotSupported;
+        }
+
+        struct ShaderStageInfo
+        {
+            VulkanShaderObjectStage     stage;
+            ConstMemoryBlock            code;
+            const char*                 pEntryPoint;
+            VkShaderStageFlags          nextStages;
+        };
+
+        DynamicArray<ShaderStageInfo, 4u> stageInfos;
+        if( isMeshPipeline )
+        {
+            if( isConstMemoryBlockValid( parameters.taskShaderCode ) )
+            {
+                stageInfos.pushBack( { VulkanShaderObjectStage_Task, parameters.taskShaderCode, graphics::getEntryPointName( parameters.entryPointId, parameters.tsEntryPoint, GraphicsPipelineStage::MS_Task ).getStart(), VK_SHADER_STAGE_MESH_BIT_EXT } );
+            }
+            stageInfos.pushBack( { VulkanShaderObjectStage_Mesh, parameters.meshShaderCode, graphics::getEntryPointName( parameters.entryPointId, parameters.msEntryPoint, GraphicsPipelineStage::MS_Mesh ).getStart(), VK_SHADER_STAGE_FRAGMENT_BIT } );
+        }
+        else
+        {
+            stageInfos.pushBack( { VulkanShaderObjectStage_Vertex, parameters.vertexShaderCode, graphics::getEntryPointName( parameters.entryPointId, parameters.vsEntryPoint, GraphicsPipelineStage::Vertex ).getStart(), hasTessellation ? (VkShaderStageFlags)VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT : (VkShaderStageFlags)VK_SHADER_STAGE_FRAGMENT_BIT } );
+            if( hasTessellation )
+            {
+                stageInfos.pushBack( { VulkanShaderObjectStage_TessellationControl, parameters.tcShaderCode, graphics::getEntryPointName( parameters.entryPointId, parameters.tcEntryPoint, GraphicsPipelineStage::TS_Control ).getStart(), VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT } );
+                stageInfos.pushBack( { VulkanShaderObjectStage_TessellationEvaluation, parameters.teShaderCode, graphics::getEntryPointName( parameters.entryPointId, parameters.teEntryPoint, GraphicsPipelineStage::TS_Evaluation ).getStart(), VK_SHADER_STAGE_FRAGMENT_BIT } );
+            }
+        }
+        if( isConstMemoryBlockValid( parameters.fragmentShaderCode ) )
+        {
+            stageInfos.pushBack( { VulkanShaderObjectStage_Fragment, parameters.fragmentShaderCode, graphics::getEntryPointName( parameters.entryPointId, parameters.fsEntryPoint, GraphicsPipelineStage::Fragment ).getStart(), 0u } );
+        }
+
+        // :JK: linking the stages lets the driver optimize across them - this is still much faster than a full pipeline compile
+        const VkShaderCreateFlagsEXT linkFlags = stageInfos.getSize() > 1u ? VK_SHADER_CREATE_LINK_STAGE_BIT_EXT : 0u;
+
+        VkShaderCreateInfoEXT createInfos[ 4u ];
+        for( size_t i = 0u; i < stageInfos.getSize(); ++i )
+        {
+            const ShaderStageInfo& stageInfo = stageInfos[ i ];
+            KEEN_ASSERT( isConstMemoryBlockValid( stageInfo.code ) );
+
+            VkShaderCreateInfoEXT* pCreateInfo = &createInfos[ i ];
+            zeroValue( pCreateInfo );
+            pCreateInfo->sType                  = VK_STRUCTURE_TYPE_SHADER_CREATE_INFO_EXT;
+            pCreateInfo->flags                  = linkFlags;
+            pCreateInfo->stage                  = vulkan::getShaderObjectStageFlagBits( stageInfo.stage );
+            pCreateInfo->nextStage              = stageInfo.nextStages;
+            pCreateInfo->codeType               = VK_SHADER_CODE_TYPE_SPIRV_EXT;
+            pCreateInfo->codeSize               = stageInfo.code.size;
+            pCreateInfo->pCode                  = stageInfo.code.pStart;
+            pCreateInfo->pName                  = stageInfo.pEntryPoint;
+            pCreateInfo->setLayoutCount         = pPipelineLayout->setLayoutCount;
+            pCreateInfo->pSetLayouts            = pPipelineLayout->setLayouts;
+            if( pPipelineLayout->pushConstantRangeCount > 0u )
+            {
+                pCreateInfo->pushConstantRangeCount = pPipelineLayout->pushConstantRangeCount;
+                pCreateInfo->pPushConstantRanges    = pPipelineLayout->pushConstantRanges;
+            }
+
+            if( stageInfo.stage == VulkanShaderObjectStage_Mesh && !isConstMemoryBlockValid( parameters.taskShaderCode ) )
+            {
+                pCreateInfo->flags |= VK_SHADER_CREATE_NO_TASK_SHADER_BIT_EXT;
+            }
+            if( stageInfo.stage == VulkanShaderObjectStage_Fragment && parameters.useShadingRateAttachment && m_pVulkan->KHR_fragment_shading_rate )
+            {
+                pCreateInfo->flags |= VK_SHADER_CREATE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_EXT;
+            }
+        }
+
+        VkShaderEXT shaders[ 4u ] = {};
+        const VulkanResult result = m_pVulkan->vkCreateShadersEXT( m_device, stageInfos.getCount32(), createInfos, m_pSharedData->pVulkanAllocationCallbacks, shaders );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_WARNING( "[graphics] vkCreateShadersEXT of pipeline '%k' failed with error '%s'\n", parameters.debugName, result );
+
+            // :JK: the shaders that were created before the failing one are still valid
+            for( size_t i = 0u; i < stageInfos.getSize(); ++i )
+            {
+                if( shaders[ i ] != VK_NULL_HANDLE )
+                {
+                    m_pVulkan->vkDestroyShaderEXT( m_device, shaders[ i ], m_pSharedData->pVulkanAllocationCallbacks );
+                }
+            }
+            return result.getErrorId();
+        }
+
+        for( size_t i = 0u; i < stageInfos.getSize(); ++i )
+        {
+            pPipeline->shaderObjects.shaders[ stageInfos[ i ].stage ] = shaders[ i ];
+            vulkan::setObjectName( m_pVulkan, m_device, (VkObjectHandle)shaders[ i ], VK_OBJECT_TYPE_SHADER_EXT, parameters.debugName );
+        }
+
+        return ErrorId_Ok;
+    }
+
+#if KEEN_USING( KEEN_COMPILED_SHADER_INFO )
+    void VulkanGraphicsObjects::recordPipelineStatistics( VkPipeline pipeline, VkShaderStageFlags shaderStages, const DebugName& debugName, HashKey64 permutationKey, uint64 shaderCodeHash )
+    {
+        KEEN_PROFILE_CPU( Vk_recordPipelineStatistics );
+
+        // :JK: the name + the permutation key identify a pipeline between two builds (the shader code is what changes). the name alone is
+        // shared by all render state permutations of a material
+        const StringView pipelineName = createStringView( debugName.getCName() );
+        if( !pipelineName.hasElements() )
+        {
+            return;
+        }
+
+        VulkanPipelineStatistics statistics;
+        vulkan::collectPipelineStatistics( &statistics, m_pVulkan, pipeline, shaderStages );
+        if( statistics.stageMask == 0u )
+        {
+            return;
+        }
+        statistics.pipelineHash     = ( calculateFnv1a64Hash( pipelineName ).value ^ permutationKey.value ) * 0x100000001b3ull;
+        statistics.shaderCodeHash   = shaderCodeHash;
+        statistics.debugName        = debugName;
+
+        MutexLock lock( &m_pipelineStatisticsMutex );
+        if( !vulkan::updatePipelineStatistics( &m_pipelineStatistics, statistics ) )
+        {
+            KEEN_TRACE_WARNING( "[graphics] Could not store the statistics of pipeline '%k'\n", debugName );
+        }
+    }
+
+    void VulkanGraphicsObjects::storePipelineStatistics()
+    {
+        KEEN_PROFILE_CPU( Vk_storePipelineStatistics );
+
+        const uint32 vendorId = m_pSharedData->deviceProperties.vendorID;
+        const uint32 deviceId = m_pSharedData->deviceProperties.deviceID;
+
+        // the database of the last run is the baseline - pipelines that were not created in this run are kept:
+        VulkanPipelineStatisticsSet database;
+        vulkan::createPipelineStatisticsSet( &database, m_pAllocator );
+
+        bool hasBaseline = false;
+        Array<uint8> baselineData;
+        if( os::readWholeFile( &baselineData, m_pAllocator, m_pipelineStatisticsPath ).isOk() )
+        {
+            uint32 baselineVendorId = 0u;
+            uint32 baselineDeviceId = 0u;
+            const Result<void> readResult = vulkan::readPipelineStatisticsDatabase( &database, &baselineVendorId, &baselineDeviceId, baselineData.getMemory() );
+            if( readResult.hasError() )
+            {
+                KEEN_TRACE_WARNING( "[graphics] Pipeline statistics database '%s' is invalid (error=%k). Rebuilding now!\n", m_pipelineStatisticsPath, readResult.getError() );
+            }
+            else if( baselineVendorId != vendorId || baselineDeviceId != deviceId )
+            {
+                KEEN_TRACE_INFO( "[graphics] Pipeline statistics database '%s' was recorded on a different device. Rebuilding now!\n", m_pipelineStatisticsPath );
+            }
+            else
+            {
+                hasBaseline = true;
+
+                DynamicArray<VulkanPipelineStatisticsRegression> regressions;
+                regressions.create( m_pAllocator );
+
+                const VulkanPipelineStatisticsThresholds thresholds;
+                vulkan::comparePipelineStatistics( &regressions, &database, m_pipelineStatistics.pipelines, thresholds );
+
+                for( size_t i = 0u; i < regressions.getCount(); ++i )
+                {
+                    const VulkanPipelineStatisticsRegression& regression = regressions[ i ];
+                    const VulkanPipelineStageStatistics& baseline   = regression.pBaseline->stages[ (size_t)regression.stage ];
+                    const VulkanPipelineStageStatistics& current    = regression.pCurrent->stages[ (size_t)regression.stage ];
+
+                    KEEN_TRACE_WARNING( "[graphics] Pipeline '%k' %s stage got worse: registers %d -> %d, scalar registers %d -> %d, spilled registers %d -> %d, scratch %,d -> %,d bytes\n",
+                        regression.pCurrent->debugName, vulkan::getPipelineStatisticsStageName( regression.stage ),
+                        baseline.registerCount, current.registerCount,
+                        baseline.scalarRegisterCount, current.scalarRegisterCount,
+                        baseline.spilledRegisterCount, current.spilledRegisterCount,
+                        baseline.scratchSizeInBytes, current.scratchSizeInBytes );
+                }
+
+                if( regressions.hasElements() )
+                {
+                    KEEN_TRACE_WARNING( "[graphics] %d pipeline stages regressed compared to '%s'\n", regressions.getCount(), m_pipelineStatisticsPath );
+                }
+                regressions.destroy();
+
+                for( size_t i = 0u; i < m_pipelineStatistics.pipelines.getCount(); ++i )
+                {
+                    vulkan::updatePipelineStatistics( &database, m_pipelineStatistics.pipelines[ i ] );
+                }
+            }
+        }
+
+        // without a valid baseline only the pipelines of this run are stored:
+        Array<uint8> databaseData;
+        const Result<void> writeDatabaseResult = vulkan::writePipelineStatisticsDatabase( &databaseData, m_pAllocator, hasBaseline ? database.pipelines : m_pipelineStatistics.pipelines, vendorId, deviceId );
+        vulkan::destroyPipelineStatisticsSet( &database );
+
+        if( writeDatabaseResult.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Could not serialize the pipeline statistics database, error=%k\n", writeDatabaseResult.getError() );
+            return;
+        }
+
+        const Result<void> directoryResult = os::createDirectoryTree( m_pipelineStatisticsPath.getDirectoryPath() );
+        const Result<void> writeResult = directoryResult.hasError() ? directoryResult : os::writeWholeFile( m_pipelineStatisticsPath, databaseData.getMemory() );
+        if( writeResult.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Could not store pipeline statistics database '%s', error=%k\n", m_pipelineStatisticsPath, writeResult.getError() );
+        }
+    }
+#endif
+
+    ErrorId VulkanGraphicsObjects::mergePipelineCacheFiles( ArrayView<const ConstMemoryBlock> cacheFiles )
+    {
+        KEEN_PROFILE_CPU( Vk_mergePipelineCacheFiles );
+
+        VulkanPipelineCacheMergeResult mergeResult;
+        if( m_usePipelineBinaries )
+        {
+            // :JK: there is no VkPipelineCache in this case - the workers run with the same setup and wrote pipeline binary archives:
+            MutexLock lock( &m_pipelineBinaryMutex );
+            const Result<void> result = vulkan::mergePipelineBinaryArchiveFiles( &mergeResult, &m_pipelineBinaryArchive, m_pAllocator, cacheFiles );
+            if( result.hasError() )
+            {
+                return result.getError();
+            }
+
+            KEEN_TRACE_INFO( "[graphics] Merged %d pipeline binary archives (%,k) into '%s', skipped %d\n", mergeResult.mergedCacheCount, mergeResult.mergedDataSize, m_pipelineBinaryArchivePath, mergeResult.skippedCacheCount );
+            return ErrorId_Ok;
+        }
+
+        if( m_pipelineCache == VK_NULL_HANDLE )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Can't merge pipeline caches without a pipeline cache (enableVulkanPipelineCache and a pipeline cache directory are needed)\n" );
+            return ErrorId_InvalidState;
+        }
+
+        const Result<void> result = vulkan::mergePipelineCacheFiles( &mergeResult, m_pVulkan, m_device, m_pipelineCache, m_pSharedData->deviceProperties, cacheFiles, m_pSharedData->pVulkanAllocationCallbacks );
+        if( result.hasError() )
+        {
+            return result.getError();
+        }
+
+        KEEN_TRACE_INFO( "[graphics] Merged %d pipeline caches (%,k) into '%s', skipped %d\n", mergeResult.mergedCacheCount, mergeResult.mergedDataSize, m_pipelineCachePath, mergeResult.skippedCacheCount );
+        return ErrorId_Ok;
+    }
+
+    ErrorId VulkanGraphicsObjects::buildPipelineCache( const VulkanPipelineCacheWorkerLauncher& launcher, uint32 workerCount )
+    {
+        KEEN_PROFILE_CPU( Vk_buildPipelineCache );
+
+        if( !m_usePipelineBinaries && m_pipelineCache == VK_NULL_HANDLE )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Can't build the pipeline cache without a pipeline cache (enableVulkanPipelineCache and a pipeline cache directory are needed)\n" );
+            return ErrorId_InvalidState;
+        }
+
+        DynamicArray<ConstMemoryBlock> workerFiles;
+        workerFiles.create( m_pAllocator );
+        if( !workerFiles.trySetCapacity( workerCount ) )
+        {
+            workerFiles.destroy();
+            return ErrorId_OutOfMemory;
+        }
+
+        const uint32 failedWorkerCount = vulkan::runPipelineCacheWorkers( &workerFiles, launcher, workerCount );
+
+        // the files of the workers that succeeded are merged in any case - so a failed worker only costs its part of the pipelines:
+        const ErrorId error = mergePipelineCacheFiles( workerFiles );
+        workerFiles.destroy();
+
+        if( error != ErrorId_Ok )
+        {
+            return error;
+        }
+        if( failedWorkerCount > 0u )
+        {
+            KEEN_TRACE_ERROR( "[graphics] %d of %d pipeline cache workers failed\n", failedWorkerCount, workerCount );
+            return ErrorId_Generic;
+        }
+        return ErrorId_Ok;
+    }
+
+    uint32 VulkanGraphicsObjects::acquirePipelineBinaries( VkPipelineBinaryKHR* pBinaries, VulkanPipelineBinaryKey* pPipelineKey, uint64 pipelineHash, const void* pPipelineCreateInfo, const DebugName& debugName )
+    {
+        KEEN_PROFILE_CPU( Vk_acquirePipelineBinaries );
+
+        if( !vulkan::getPipelineBinaryKey( pPipelineKey, m_pVulkan, pPipelineCreateInfo ) )
+        {
+            // :JK: without a key we can neither validate nor capture binaries - the pipeline is simply compiled
+            zeroValue( pPipelineKey );
+            return 0u;
+        }
+
+        MutexLock lock( &m_pipelineBinaryMutex );
+        const VulkanPipelineBinaryRecord* pRecord = vulkan::findPipelineBinaryRecord( &m_pipelineBinaryArchive, pipelineHash );
+        if( pRecord == nullptr )
+        {
+            return 0u;
+        }
+
+        if( !vulkan::isPipelineBinaryKeyEqual( pRecord->pipelineKey, *pPipelineKey ) )
+        {
+            KEEN_TRACE_INFO( "[graphics] Pipeline binaries of pipeline '%k' are out of date. Recompiling now!\n", debugName );
+            return 0u;
+        }
+
+        return vulkan::createPipelineBinaries( pBinaries, m_pVulkan, m_pipelineBinaryArchive, *pRecord, m_pSharedData->pVulkanAllocationCallbacks );
+    }
+
+    void VulkanGraphicsObjects::storePipelineBinaries( VkPipeline pipeline, uint64 pipelineHash, const VulkanPipelineBinaryKey& pipelineKey, const DebugName& debugName )
+    {
+        KEEN_PROFILE_CPU( Vk_storePipelineBinaries );
+
+        Array<uint8> binaryData;
+        DynamicArray<VulkanPipelineBinaryKey, VulkanMaxPipelineBinaryCount> binaryKeys;
+        DynamicArray<ConstMemoryBlock, VulkanMaxPipelineBinaryCount> binaryBlocks;
+        if( !vulkan::capturePipelineBinaries( &binaryData, &binaryKeys, &binaryBlocks, m_pAllocator, m_pVulkan, pipeline, m_pSharedData->pVulkanAllocationCallbacks ) )
+        {
+            KEEN_TRACE_WARNING( "[graphics] Could not capture the pipeline binaries of pipeline '%k'\n", debugName );
+            return;
+        }
+
+        MutexLock lock( &m_pipelineBinaryMutex );
+        if( !vulkan::addPipelineBinaryRecord( &m_pipelineBinaryArchive, pipelineHash, pipelineKey, binaryKeys, binaryBlocks ) )
+        {
+            KEEN_TRACE_WARNING( "[graphics] Could not store the pipeline binaries of pipeline '%k'\n", debugName );
+        }
+    }
+
+    void VulkanGraphicsObjects::storePipelineBinaryArchive()
+    {
+        KEEN_PROFILE_CPU( Vk_storePipelineBinaryArchive );
+
+        Array<uint8> archiveData;
+        const Result<void> writeArchiveResult = vulkan::writePipelineBinaryArchive( &archiveData, m_pAllocator, m_pipelineBinaryArchive, VulkanPipelineBinaryMaxUnusedSessionCount );
+        if( writeArchiveResult.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Could not serialize the pipeline binary archive, error=%k\n", writeArchiveResult.getError() );
+            return;
+        }
+
+        const Result<void> directoryResult = os::createDirectoryTree( m_pipelineBinaryArchivePath.getDirectoryPath() );
+        const Result<void> writeResult = directoryResult.hasError() ? directoryResult : os::writeWholeFile( m_pipelineBinaryArchivePath, archiveData.getMemory() );
+        if( writeResult.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Could not store pipeline binary archive '%s', error=%k\n", m_pipelineBinaryArchivePath, writeResult.getError() );
+        }
+    }
+
     void VulkanGraphicsObjects::destroyDeviceObject( GraphicsDeviceObject* pObject )
     {
         KEEN_ASSERT( pObject != nullptr );
@@ -2154,6 +3393,10 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
             destroyQueryPool( (VulkanQueryPool*)pObject );
             break;
 
+        case GraphicsDeviceObjectType::IndirectCommandsLayout:
+            destroyIndirectCommandsLayout( (VulkanIndirectCommandsLayout*)pObject );
+            break;
+
         case GraphicsDeviceObjectType::ComputePipeline:
             destroyComputePipeline( (VulkanComputePipeline*)pObject );
             break;
@@ -2232,6 +3475,14 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         {
             m_pVulkan->vkDestroyShaderModule( m_device, shaderModules.teShader, m_pSharedData->pVulkanAllocationCallbacks );
         }
+        if( shaderModules.taskShader != VK_NULL_HANDLE )
+        {
+            m_pVulkan->vkDestroyShaderModule( m_device, shaderModules.taskShader, m_pSharedData->pVulkanAllocationCallbacks );
+        }
+        if( shaderModules.meshShader != VK_NULL_HANDLE )
+        {
+            m_pVulkan->vkDestroyShaderModule( m_device, shaderModules.meshShader, m_pSharedData->pVulkanAllocationCallbacks );
+        }
     }
 
     Result<void> VulkanGraphicsObjects::prepareRenderPipelineCompileParameters( RenderPipelineShaderModules* pShaderModules, const GraphicsRenderPipelineParameters& parameters )
@@ -2246,6 +3497,8 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
             error = createShaderModule( &pShaderModules->tcShader, parameters.tcShaderCode, DebugName::createFormatted( "%k_tcs", parameters.debugName ) );
             error = createShaderModule( &pShaderModules->teShader, parameters.teShaderCode, DebugName::createFormatted( "%k_tes", parameters.debugName ) );
             error = createShaderModule( &pShaderModules->fragmentShader, parameters.fragmentShaderCode, DebugName::createFormatted( "%k_fs", parameters.debugName ) );
+            error = createShaderModule( &pShaderModules->taskShader, parameters.taskShaderCode, DebugName::createFormatted( "%k_ts", parameters.debugName ) );
+            error = createShaderModule( &pShaderModules->meshShader, parameters.meshShaderCode, DebugName::createFormatted( "%k_ms", parameters.debugName ) );
             if( error.hasError() )
             {
                 return error.getError();
@@ -2255,6 +3508,93 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         return ErrorId_Ok;
     }
 
+    bool VulkanGraphicsObjects::acquireSharedRenderPipeline( VulkanRenderPipeline* pRenderPipeline )
+    {
+        MutexLock lock( &m_sharedRenderPipelineMutex );
+
+        const SharedRenderPipelineMap::InsertResult insertResult = m_sharedRenderPipelines.insertKey( pRenderPipeline->sharedPipelineKey );
+        KEEN_ASSERT( insertResult.pValue != nullptr );
+
+        SharedRenderPipeline* pSharedPipeline = insertResult.pValue;
+        if( insertResult.isNew )
+        {
+            pSharedPipeline->pipeline       = VK_NULL_HANDLE;
+            pSharedPipeline->referenceCount = 0u;
+        }
+
+        if( pSharedPipeline->pipeline == VK_NULL_HANDLE )
+        {
+            return false;
+        }
+
+        pSharedPipeline->referenceCount++;
+        pRenderPipeline->pipeline           = pSharedPipeline->pipeline;
+        pRenderPipeline->isSharedPipeline   = true;
+        return true;
+    }
+
+    void VulkanGraphicsObjects::registerSharedRenderPipeline( VulkanRenderPipeline* pRenderPipeline )
+    {
+        KEEN_ASSERT( pRenderPipeline->pipeline != VK_NULL_HANDLE );
+
+        VkPipeline duplicatePipeline = VK_NULL_HANDLE;
+        {
+            MutexLock lock( &m_sharedRenderPipelineMutex );
+
+            const SharedRenderPipelineMap::InsertResult insertResult = m_sharedRenderPipelines.insertKey( pRenderPipeline->sharedPipelineKey );
+            KEEN_ASSERT( insertResult.pValue != nullptr );
+
+            SharedRenderPipeline* pSharedPipeline = insertResult.pValue;
+            if( insertResult.isNew || pSharedPipeline->pipeline == VK_NULL_HANDLE )
+            {
+                pSharedPipeline->pipeline       = pRenderPipeline->pipeline;
+                pSharedPipeline->referenceCount = 1u;
+            }
+            else
+            {
+                // :JK: another thread compiled the same pipeline in the meantime - use that one
+                duplicatePipeline               = pRenderPipeline->pipeline;
+                pRenderPipeline->pipeline       = pSharedPipeline->pipeline;
+                pSharedPipeline->referenceCount++;
+            }
+            pRenderPipeline->isSharedPipeline = true;
+        }
+
+        if( duplicatePipeline != VK_NULL_HANDLE )
+        {
+            m_pVulkan->vkDestroyPipeline( m_device, duplicatePipeline, m_pSharedData->pVulkanAllocationCallbacks );
+        }
+    }
+
+    void VulkanGraphicsObjects::releaseSharedRenderPipeline( VulkanRenderPipeline* pRenderPipeline )
+    {
+        VkPipeline unusedPipeline = VK_NULL_HANDLE;
+        {
+            MutexLock lock( &m_sharedRenderPipelineMutex );
+
+            const SharedRenderPipelineMap::InsertResult insertResult = m_sharedRenderPipelines.insertKey( pRenderPipeline->sharedPipelineKey );
+            KEEN_ASSERT( !insertResult.isNew );
+
+            SharedRenderPipeline* pSharedPipeline = insertResult.pValue;
+            KEEN_ASSERT( pSharedPipeline->pipeline == pRenderPipeline->pipeline );
+            KEEN_ASSERT( pSharedPipeline->referenceCount > 0u );
+            pSharedPipeline->referenceCount--;
+
+            // the map entry is kept - a pipeline with the same key will just be compiled again
+            if( pSharedPipeline->referenceCount == 0u )
+            {
+                unusedPipeline              = pSharedPipeline->pipeline;
+                pSharedPipeline->pipeline   = VK_NULL_HANDLE;
+            }
+        }
+
+        if( unusedPipeline != VK_NULL_HANDLE )
+        {
+            m_pVulkan->vkDestroyPipeline( m_device, unusedPipeline, m_pSharedData->pVulkanAllocationCallbacks );
+        }
+        pRenderPipeline->pipeline = VK_NULL_HANDLE;
+    }
+
     void VulkanGraphicsObjects::destroySwapChain( VulkanSwapChainWrapper* pSwapChainWrapper )
     {
         KEEN_DISABLE_FLOATINGPOINT_EXCEPTIONS_SCOPE;
@@ -2279,7 +3619,21 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
     {
         KEEN_DISABLE_FLOATINGPOINT_EXCEPTIONS_SCOPE;
 
-        if( pRenderPipeline->pipeline != VK_NULL_HANDLE )
+        if( pRenderPipeline->isShaderObjectPipeline )
+        {
+            for( size_t i = 0u; i < VulkanShaderObjectStage_Count; ++i )
+            {
+                if( pRenderPipeline->shaderObjects.shaders[ i ] != VK_NULL_HANDLE )
+                {
+                    m_pVulkan->vkDestroyShaderEXT( m_device, pRenderPipeline->shaderObjects.shaders[ i ], m_pSharedData->pVulkanAllocationCallbacks );
+                }
+            }
+        }
+        else if( pRenderPipeline->isSharedPipeline )
+        {
+            releaseSharedRenderPipeline( pRenderPipeline );
+        }
+        else if( pRenderPipeline->pipeline != VK_NULL_HANDLE )
         {
             m_pVulkan->vkDestroyPipeline( m_device, pRenderPipeline->pipeline, m_pSharedData->pVulkanAllocationCallbacks );
         }
@@ -2328,6 +3682,10 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         {
             m_pVulkan->vkDestroyBuffer( m_device, pBuffer->buffer, m_pSharedData->pVulkanAllocationCallbacks );
         }
+        if( pBuffer->importedMemory != VK_NULL_HANDLE )
+        {
+            m_pVulkan->vkFreeMemory( m_device, pBuffer->importedMemory, m_pSharedData->pVulkanAllocationCallbacks );
+        }
         freeDeviceObject( pBuffer );
 
         KEEN_PROFILE_COUNTER_DEC( m_vulkanBufferCount );
@@ -2353,6 +3711,10 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
                 m_pVulkan->vkDestroyImage( m_device, pTexture->image, m_pSharedData->pVulkanAllocationCallbacks );
             }
         }
+        if( pTexture->exportableMemory.memory != VK_NULL_HANDLE )
+        {
+            m_pVulkan->vkFreeMemory( m_device, pTexture->exportableMemory.memory, m_pSharedData->pVulkanAllocationCallbacks );
+        }
         freeDeviceObject( pTexture );
 
         KEEN_PROFILE_COUNTER_DEC( m_vulkanTextureCount );
@@ -2413,6 +3775,22 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
         KEEN_PROFILE_COUNTER_DEC( m_vulkanQueryPoolCount );
     }
 
+    void VulkanGraphicsObjects::destroyIndirectCommandsLayout( VulkanIndirectCommandsLayout* pLayout )
+    {
+        KEEN_DISABLE_FLOATINGPOINT_EXCEPTIONS_SCOPE;
+
+        if( pLayout->executionSet != VK_NULL_HANDLE )
+        {
+            m_pVulkan->vkDestroyIndirectExecutionSetEXT( m_device, pLayout->executionSet, m_pSharedData->pVulkanAllocationCallbacks );
+        }
+        if( pLayout->layout != VK_NULL_HANDLE )
+        {
+            m_pVulkan->vkDestroyIndirectCommandsLayoutEXT( m_device, pLayout->layout, m_pSharedData->pVulkanAllocationCallbacks );
+        }
+        freeDeviceObject( pLayout );
+        KEEN_PROFILE_COUNTER_DEC( m_vulkanIndirectCommandsLayoutCount );
+    }
+
     void VulkanGraphicsObjects::destroyComputePipeline( VulkanComputePipeline* pComputePipeline )
     {
         KEEN_DISABLE_FLOATINGPOINT_EXCEPTIONS_SCOPE;
@@ -2481,10 +3859,30 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
 
     Result<void> VulkanGraphicsObjects::fillVkBufferCreateInfo( VkBufferCreateInfo* pBufferCreateInfo, const GraphicsBufferParameters& parameters )
     {
+        if( parameters.usage.isSet( GraphicsBufferUsageFlag::ConditionalRenderingPredicate ) && !m_pVulkan->EXT_conditional_rendering )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Can't create buffer '%k': conditional rendering is not supported\n", parameters.debugName );
+            return ErrorId_NotSupported;
+        }
+
         pBufferCreateInfo->sType    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         pBufferCreateInfo->size     = parameters.sizeInBytes;
         pBufferCreateInfo->usage    = vulkan::getBufferUsageFlags( parameters.usage );
 
+        // storage buffers get a device address so they can be referenced from the bindless buffer address table
+        // :JK: only for buffers we allocate ourselves - user device memory is not allocated with VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT
+        if( parameters.usage.isSet( GraphicsBufferUsageFlag::StorageBuffer ) && parameters.allocateMemory && m_pSharedData->deviceFeatures_1_2.bufferDeviceAddress == VK_TRUE )
+        {
+            pBufferCreateInfo->usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        }
+
+        // device generated commands read the argument buffer (and the vertex/index buffers written by the gpu) through device addresses
+        if( m_pVulkan->EXT_device_generated_commands && parameters.allocateMemory &&
+            ( parameters.usage.isSet( GraphicsBufferUsageFlag::ArgumentBuffer ) || parameters.usage.isSet( GraphicsBufferUsageFlag::VertexBuffer ) || parameters.usage.isSet( GraphicsBufferUsageFlag::IndexBuffer ) ) )
+        {
+            pBufferCreateInfo->usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        }
+
         return ErrorId_Ok;
     }
 
@@ -2514,6 +3912,46 @@ KEEN_ASSERT( parameters.debugName.hasElements() );
 
         pImageCreateInfo->usage = vulkan::getImageUsageMask( parameters.usageMask );
 
+        // local read attachments are bound as input attachments inside their own rendering scope:
+        if( parameters.flags.isSet( GraphicsTextureFlag::LocalReadAttachment ) )
+        {
+            if( !m_pSharedData->info.supportedFeatures.isSet( GraphicsFeature::RenderingLocalRead ) )
+            {
+                KEEN_TRACE_ERROR( "[graphics] Texture '%k': local read attachments are not supported by the device\n", parameters.debugName );
+                return ErrorId_NotSupported;
+            }
+            pImageCreateInfo->usage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+        }
+
+#if defined( VK_EXT_host_image_copy )
+        // :JK: the flag is only a hint - textures that can't be host copied are uploaded through staging memory
+        if( parameters.flags.isSet( GraphicsTextureFlag::HostTransfer ) && m_pVulkan->EXT_host_image_copy && pImageCreateInfo->samples == VK_SAMPLE_COUNT_1_BIT )
+        {
+            VkFormatProperties3 formatProperties3{ VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_3 };
+            VkFormatProperties2 formatProperties2{ VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2, &formatProperties3 };
+            m_pVulkan->vkGetPhysicalDeviceFormatProperties2( m_physicalDevice, vulkanFormat, &formatProperties2 );
+            if( ( formatProperties3.optimalTilingFeatures & VK_FORMAT_FEATURE_2_HOST_IMAGE_TRANSFER_BIT_EXT ) != 0u )
+            {
+                // the host transfer usage can force a layout that is slower for the gpu (i.e. no compression) - a texture that is sampled
+                // every frame is better off with one staging upload:
+                VkPhysicalDeviceImageFormatInfo2 imageFormatInfo{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_FORMAT_INFO_2 };
+                imageFormatInfo.format  = vulkanFormat;
+                imageFormatInfo.type    = pImageCreateInfo->imageType;
+                imageFormatInfo.tiling  = pImageCreateInfo->tiling;
+                imageFormatInfo.usage   = pImageCreateInfo->usage | VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT;
+                imageFormatInfo.flags   = pImageCreateInfo->flags;
+
+                VkHostImageCopyDevicePerformanceQueryEXT performanceQuery{ VK_STRUCTURE_TYPE_HOST_IMAGE_COPY_DEVICE_PERFORMANCE_QUERY_EXT };
+                VkImageFormatProperties2 imageFormatProperties{ VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2, &performanceQuery };
+                const VulkanResult result = m_pVulkan->vkGetPhysicalDeviceImageFormatProperties2( m_physicalDevice, &imageFormatInfo, &imageFormatProperties );
+                if( result.isOk() && performanceQuery.optimalDeviceAccess )
+                {
+                    pImageCreateInfo->usage |= VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT;
+                }
+            }
+        }
+#endif
+
         return ErrorId_Ok;
     }
 
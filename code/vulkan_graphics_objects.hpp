@@ -2,6 +2,9 @@
 #define KEEN_VULKAN_GRAPHICS_OBJECTS_HPP_INCLUDED
 
 #include "vulkan_types.hpp"
+#include "vulkan_pipeline_statistics.hpp"
+#include "vulkan_pipeline_binary.hpp"
+#include "vulkan_pipeline_cache_builder.hpp"
 #include "keen/task/task_types.hpp"
 #include "keen/base/map.hpp"
 #include "keen/base/mutex.hpp"
@@ -17,9 +20,14 @@ namespace keen
         uint32          descriptorSetCount = DefaultDescriptorSetCount;
         uint32          uniformBufferDescriptorCount = DefaultDescriptorSetCount * 2u;
         uint32          storageBufferDescriptorCount = DefaultDescriptorSetCount * 2u;
+        uint32          uniformBufferDynamicDescriptorCount = DefaultDescriptorSetCount;
+        uint32          storageBufferDynamicDescriptorCount = DefaultDescriptorSetCount;
+        uint32          inlineUniformBlockBindingCount = DefaultDescriptorSetCount;
+        uint32          inlineUniformBlockSize = DefaultDescriptorSetCount * 128u;     // in bytes - only used if inline uniform blocks are supported
         uint32          samplerDescriptorCount = DefaultDescriptorSetCount * 4u;
         uint32          sampledImageDescriptorCount = DefaultDescriptorSetCount * 16u;
         uint32          storageImageDescriptorCount = DefaultDescriptorSetCount * 16u;
+        uint32          inputAttachmentDescriptorCount = DefaultDescriptorSetCount * 4u;     // only used if rendering local read is supported
         uint32          accelerationStructureDescriptorCount = 0u;
     };
 
@@ -48,6 +56,7 @@ namespace keen
         bool                        enableBindlessDescriptors = false;
         uint32                      bindlessTextureCount = 0u;
         uint32                      bindlessSamplerCount = 0u;
+        uint32                      bindlessStorageBufferCount = 0u;
     };
 
     enum VulkanDepthFormat
@@ -80,11 +89,24 @@ namespace keen
         VulkanTexture*                      createTexture( const GraphicsTextureParameters& parameters );
         VulkanTexture*                      createTextureView( const GraphicsTextureViewParameters& parameters );
         VulkanBuffer*                       createBuffer( const GraphicsBufferParameters& parameters );
+        VulkanBuffer*                       createHostMemoryBuffer( ConstMemoryBlock hostMemory, const DebugName& debugName );
         VulkanSampler*                      createSampler( const GraphicsSamplerParameters& parameters, DebugName debugName );
         VulkanDescriptorSetLayout*          createDescriptorSetLayout( const GraphicsDescriptorSetLayoutParameters& parameters );
         VulkanDescriptorSet*                createStaticDescriptorSet( const GraphicsDescriptorSetParameters& parameters );
         VulkanDescriptorSet*                createDynamicDescriptorSet( VulkanFrame* pFrame, const GraphicsDescriptorSetParameters& parameters );
         VulkanQueryPool*                    createQueryPool( const GraphicsQueryPoolParameters& parameters );
+        VulkanIndirectCommandsLayout*       createIndirectCommandsLayout( const GraphicsIndirectCommandsLayoutParameters& parameters );
+
+        // preprocess buffers for device generated commands - the memory type and alignment fit all layouts created so far:
+        uint64                              getMaxGeneratedCommandsPreprocessSize();
+        VulkanBuffer*                       createGeneratedCommandsPreprocessBuffer( uint64 sizeInBytes, const DebugName& debugName );
+
+        // offline pipeline cache builder: merges the files of the worker processes into our pipeline cache (which is written on shutdown). these are
+        // the vk_pipeline_binaries.bin files if the device uses pipeline binaries and the vk_pipeline_cache.bin files otherwise:
+        ErrorId                             mergePipelineCacheFiles( ArrayView<const ConstMemoryBlock> cacheFiles );
+
+        // starts the worker processes, waits for them and merges their files:
+        ErrorId                             buildPipelineCache( const VulkanPipelineCacheWorkerLauncher& launcher, uint32 workerCount );
 
         GraphicsMemoryRequirements          queryTextureMemoryRequirements( const VulkanTexture* pTexture );
         GraphicsMemoryRequirements          queryBufferMemoryRequirements( const VulkanBuffer* pBuffer );
@@ -114,6 +136,13 @@ namespace keen
         using MemoryRequirementsMap         = Map< HashKey64, VkMemoryRequirements >;
         using StaticSamplerMap              = Map< HashKey32, VulkanSampler* >;
 
+        struct SharedRenderPipeline
+        {
+            VkPipeline                  pipeline;
+            uint32                      referenceCount;
+        };
+        using SharedRenderPipelineMap       = Map< HashKey64, SharedRenderPipeline >;
+
         VulkanSampler*                      createStaticSampler( const GraphicsSamplerParameters& parameters );
 
         MemoryAllocator*                m_pAllocator;
@@ -139,9 +168,19 @@ namespace keen
 
         StaticSamplerMap                m_staticSamplerMap;
 
+        // only used with extended dynamic state - render pipelines with the same key use the same VkPipeline:
+        Mutex                           m_sharedRenderPipelineMutex;
+        SharedRenderPipelineMap         m_sharedRenderPipelines;
+
         PathName                        m_pipelineCachePath;
         VkPipelineCache                 m_pipelineCache;
 
+        // with VK_KHR_pipeline_binary the pipelines are created from our own archive instead of the pipeline cache:
+        bool                            m_usePipelineBinaries;
+        PathName                        m_pipelineBinaryArchivePath;
+        Mutex                           m_pipelineBinaryMutex;
+        VulkanPipelineBinaryArchive     m_pipelineBinaryArchive;
+
         VkDescriptorSetLayout           m_emptyDescriptorSetLayout;
         VkDescriptorSetLayout           m_bindlessDescriptorSetLayout;
 
@@ -155,10 +194,25 @@ namespace keen
 
         Mutex                           m_freeObjectListMutex;
 
+        Mutex                           m_generatedCommandsMutex;
+        uint64                          m_maxGeneratedCommandsPreprocessSize;
+        uint64                          m_maxGeneratedCommandsPreprocessAlignment;
+        uint32                          m_generatedCommandsPreprocessMemoryTypeBits;
+
+        uint32_atomic                   m_objectGeneration;     // last generation given to a created object
+
+#if KEEN_USING( KEEN_COMPILED_SHADER_INFO )
+        bool                            m_collectPipelineStatistics;
+        PathName                        m_pipelineStatisticsPath;
+        Mutex                           m_pipelineStatisticsMutex;
+        VulkanPipelineStatisticsSet     m_pipelineStatistics;
+#endif
+
         VkFormat                        m_depthFormats[ VulkanDepthFormat_Count ];
 
         uint32                          m_nextBufferId;
         uint32                          m_nextTextureId;
+        uint32                          m_nextPipelineLayoutId;
 
 #if KEEN_USING( KEEN_PROFILER )
         uint32_atomic                   m_vulkanDeviceMemoryCount;
@@ -173,6 +227,7 @@ namespace keen
         uint32_atomic                   m_vulkanQueryPoolCount;
         uint32_atomic                   m_vulkanComputePipelineCount;
         uint32_atomic                   m_vulkanDescriptorPoolCount;
+        uint32_atomic                   m_vulkanIndirectCommandsLayoutCount;
 #endif
 
         MemoryBlock                     allocateDeviceObjectBase( GraphicsDeviceObjectType type );
@@ -190,9 +245,22 @@ namespace keen
                     return nullptr;
                 }
                 KEEN_ASSERT_SLOW( objectMemory.size == sizeof( T ) );
-                return callDefaultConstructor( (T*)objectMemory.pStart );
+                T* pObject = callDefaultConstructor( (T*)objectMemory.pStart );
+                setObjectGeneration( pObject, atomic::add_uint32_ordered( &m_objectGeneration, 1u ) );
+                return pObject;
             }
 
+        // objects that cached command buffers can reference get a unique generation - their key contains it (see vulkan::combineCommandBufferKey):
+        static void                     setObjectGeneration( void*, uint32 ) {}
+        static void                     setObjectGeneration( VulkanPipelineLayout* pObject, uint32 generation ) { pObject->objectGeneration = generation; }
+        static void                     setObjectGeneration( VulkanRenderPipeline* pObject, uint32 generation ) { pObject->objectGeneration = generation; }
+        static void                     setObjectGeneration( VulkanComputePipeline* pObject, uint32 generation ) { pObject->objectGeneration = generation; }
+        static void                     setObjectGeneration( VulkanTexture* pObject, uint32 generation ) { pObject->objectGeneration = generation; }
+        static void                     setObjectGeneration( VulkanBuffer* pObject, uint32 generation ) { pObject->objectGeneration = generation; }
+        static void                     setObjectGeneration( VulkanDescriptorSet* pObject, uint32 generation ) { pObject->objectGeneration = generation; }
+        static void                     setObjectGeneration( VulkanQueryPool* pObject, uint32 generation ) { pObject->objectGeneration = generation; }
+        static void                     setObjectGeneration( VulkanIndirectCommandsLayout* pObject, uint32 generation ) { pObject->objectGeneration = generation; }
+
         template<typename T>
             inline void                 freeDeviceObject( T* pObject ) 
             { 
@@ -206,12 +274,18 @@ namespace keen
             VkShaderModule              tcShader;
             VkShaderModule              teShader;
             VkShaderModule              fragmentShader;
+            VkShaderModule              taskShader;
+            VkShaderModule              meshShader;
         };
 
         ErrorId                             createShaderModule( VkShaderModule* pShaderModule, ConstMemoryBlock shaderCode, const DebugName& debugName );
         Result<void>                        prepareRenderPipelineCompileParameters( RenderPipelineShaderModules* pShaderModules, const GraphicsRenderPipelineParameters& parameters );
         void                                destroyShaderModules( const RenderPipelineShaderModules& shaderModules );
 
+        bool                                acquireSharedRenderPipeline( VulkanRenderPipeline* pRenderPipeline );
+        void                                registerSharedRenderPipeline( VulkanRenderPipeline* pRenderPipeline );
+        void                                releaseSharedRenderPipeline( VulkanRenderPipeline* pRenderPipeline );
+
         void                                destroySwapChain( VulkanSwapChainWrapper* pSwapChain );
         void                                destroyRenderPipeline( VulkanRenderPipeline* pRenderPipeline );
         void                                destroyComputePipeline( VulkanComputePipeline* pComputePipeline );
@@ -222,14 +296,26 @@ namespace keen
         void                                destroyDescriptorSetLayout( VulkanDescriptorSetLayout* pLayout );
         void                                destroyDescriptorSet( StaticVulkanDescriptorSet* pDesciptorSet );
         void                                destroyQueryPool( VulkanQueryPool* pQueryPool );
+        void                                destroyIndirectCommandsLayout( VulkanIndirectCommandsLayout* pLayout );
 
         bool                                createDefaultTextureView( VulkanTexture* pTexture );
 
         static GraphicsDescriptorSet*       allocateDescriptorSet( VulkanFrame* pFrame, const GraphicsDescriptorSetParameters& parameters );
 
         ErrorId                             compileRenderPipeline( VulkanRenderPipeline* pPipeline, const GraphicsRenderPipelineParameters& parameters, const RenderPipelineShaderModules& shaderModules );
+        ErrorId                             createRenderPipelineShaderObjects( VulkanRenderPipeline* pPipeline, const GraphicsRenderPipelineParameters& parameters );
         ErrorId                             compileComputePipeline( VulkanComputePipeline* pPipeline, const GraphicsComputePipelineParameters& parameters, VkShaderModule computeShader );
 
+        // returns the number of binaries created from the archive - zero if the pipeline has to be compiled. pPipelineKey is empty if it could not be queried:
+        uint32                              acquirePipelineBinaries( VkPipelineBinaryKHR* pBinaries, VulkanPipelineBinaryKey* pPipelineKey, uint64 pipelineHash, const void* pPipelineCreateInfo, const DebugName& debugName );
+        void                                storePipelineBinaries( VkPipeline pipeline, uint64 pipelineHash, const VulkanPipelineBinaryKey& pipelineKey, const DebugName& debugName );
+        void                                storePipelineBinaryArchive();
+
+#if KEEN_USING( KEEN_COMPILED_SHADER_INFO )
+        void                                recordPipelineStatistics( VkPipeline pipeline, VkShaderStageFlags shaderStages, const DebugName& debugName, HashKey64 permutationKey, uint64 shaderCodeHash );
+        void                                storePipelineStatistics();
+#endif
+
         VkFormat                            findFirstMatchingDepthStencilFormat( const ArrayView<const VkFormat>& candidates, bool usedAsShaderInput ) const;
 
         Result<void>                        fillVkBufferCreateInfo( VkBufferCreateInfo* pBufferCreateInfo, const GraphicsBufferParameters& parameters );
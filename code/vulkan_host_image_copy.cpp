@@ -0,0 +1,151 @@
+#include "vulkan_host_image_copy.hpp"
+#include "vulkan_types.hpp"
+
+namespace keen
+{
+
+    VulkanTextureUploadPath vulkan::selectTextureUploadPath( const VulkanHostImageCopyInfo& info, const VulkanTextureUploadRequest& request )
+    {
+        if( !info.isSupported || !request.isHostTransferTexture )
+        {
+            return VulkanTextureUploadPath::Staging;
+        }
+
+        // :JK: the host copy runs on the calling thread - large textures are better off with the dma engine of the transfer queue
+        if( request.dataSize == 0u || request.dataSize > info.maxCopySize )
+        {
+            return VulkanTextureUploadPath::Staging;
+        }
+
+        // the copy is done in the final layout (that saves a second transition) - so that has to be a valid host copy target:
+        for( size_t i = 0u; i < info.copyDstLayouts.getCount(); ++i )
+        {
+            if( info.copyDstLayouts[ i ] == request.layout )
+            {
+                return VulkanTextureUploadPath::HostImageCopy;
+            }
+        }
+        return VulkanTextureUploadPath::Staging;
+    }
+
+    // several regions can cover the same subresource (i.e. tiles of one mip level) - each subresource must only be transitioned once, the second
+    // transition would start from the wrong layout. returns the aspects of the layer that no previous region of the same level covered:
+    static GraphicsTextureAspectFlagMask getUntransitionedAspects( ArrayView<const GraphicsHostTextureCopyRegion> regions, size_t regionIndex, uint32 layer )
+    {
+        const GraphicsTextureRegion& region = regions[ regionIndex ].textureRegion;
+        GraphicsTextureAspectFlagMask aspects = region.aspectMask;
+        for( size_t i = 0u; i < regionIndex; ++i )
+        {
+            const GraphicsTextureRegion& previousRegion = regions[ i ].textureRegion;
+            if( previousRegion.level == region.level && layer >= previousRegion.baseLayer && layer - previousRegion.baseLayer < previousRegion.layerCount )
+            {
+                aspects.value &= ~previousRegion.aspectMask.value;
+            }
+        }
+        return aspects;
+    }
+
+    Result<void> vulkan::copyMemoryToImage( VulkanApi* pVulkan, VkDevice device, const VulkanTexture* pTexture, ArrayView<const GraphicsHostTextureCopyRegion> regions, VkImageLayout oldLayout, VkImageLayout newLayout )
+    {
+#if defined( VK_EXT_host_image_copy )
+        KEEN_ASSERT( pVulkan->EXT_host_image_copy );
+
+        constexpr size_t BatchSize = 16u;
+
+        // :JK: the copy is done in the final layout - so there is only one transition (and none if the texture already is in that layout)
+        if( oldLayout != newLayout )
+        {
+            DynamicArray<VkHostImageLayoutTransitionInfoEXT, BatchSize> transitions;
+            for( size_t regionIndex = 0u; regionIndex < regions.getCount(); ++regionIndex )
+            {
+                const GraphicsTextureRegion& region = regions[ regionIndex ].textureRegion;
+
+                // consecutive layers with the same untransitioned aspects are transitioned together:
+                uint32 layer = region.baseLayer;
+                while( layer < region.baseLayer + region.layerCount )
+                {
+                    const GraphicsTextureAspectFlagMask aspects = getUntransitionedAspects( regions, regionIndex, layer );
+                    uint32 layerCount = 1u;
+                    while( layer + layerCount < region.baseLayer + region.layerCount && getUntransitionedAspects( regions, regionIndex, layer + layerCount ).value == aspects.value )
+                    {
+                        layerCount++;
+                    }
+
+                    if( aspects.value != 0u )
+                    {
+                        VkHostImageLayoutTransitionInfoEXT transition{ VK_STRUCTURE_TYPE_HOST_IMAGE_LAYOUT_TRANSITION_INFO_EXT };
+                        transition.image                            = pTexture->image;
+                        transition.oldLayout                        = oldLayout;
+                        transition.newLayout                        = newLayout;
+                        transition.subresourceRange.aspectMask      = getImageAspectFlags( aspects );
+                        transition.subresourceRange.baseMipLevel    = region.level;
+                        transition.subresourceRange.levelCount      = 1u;
+                        transition.subresourceRange.baseArrayLayer  = layer;
+                        transition.subresourceRange.layerCount      = layerCount;
+                        transitions.pushBack( transition );
+                    }
+                    layer += layerCount;
+
+                    const bool isLastTransition = regionIndex + 1u == regions.getCount() && layer == region.baseLayer + region.layerCount;
+                    if( transitions.getRemainingCapacity() == 0u || ( isLastTransition && transitions.hasElements() ) )
+                    {
+                        const VulkanResult result = pVulkan->vkTransitionImageLayoutEXT( device, rangecheck_cast<uint32>( transitions.getCount() ), transitions.getStart() );
+                        if( result.hasError() )
+                        {
+                            KEEN_TRACE_ERROR( "[graphics] vkTransitionImageLayoutEXT failed with error '%s'\n", result );
+                            return result.getErrorId();
+                        }
+                        transitions.clear();
+                    }
+                }
+            }
+        }
+
+        for( size_t batchStart = 0u; batchStart < regions.getCount(); batchStart += BatchSize )
+        {
+            const size_t batchRegionCount = min( regions.getCount() - batchStart, BatchSize );
+
+            StaticArray<VkMemoryToImageCopyEXT, BatchSize> copyRegions;
+            for( size_t batchRegionIndex = 0u; batchRegionIndex < batchRegionCount; ++batchRegionIndex )
+            {
+                const GraphicsHostTextureCopyRegion& region = regions[ batchStart + batchRegionIndex ];
+                KEEN_ASSERT( region.pData != nullptr );
+
+                VkMemoryToImageCopyEXT* pCopyRegion = &copyRegions[ batchRegionIndex ];
+                pCopyRegion->sType              = VK_STRUCTURE_TYPE_MEMORY_TO_IMAGE_COPY_EXT;
+                pCopyRegion->pNext              = nullptr;
+                pCopyRegion->pHostPointer       = region.pData;
+                pCopyRegion->memoryRowLength    = 0u;   // tightly packed
+                pCopyRegion->memoryImageHeight  = 0u;
+                fillVkImageSubresourceLayers( &pCopyRegion->imageSubresource, region.textureRegion );
+                pCopyRegion->imageOffset        = createOffset3d( region.textureRegion.offset );
+                pCopyRegion->imageExtent        = createExtent3d( region.textureRegion.size );
+            }
+
+            VkCopyMemoryToImageInfoEXT copyInfo{ VK_STRUCTURE_TYPE_COPY_MEMORY_TO_IMAGE_INFO_EXT };
+            copyInfo.dstImage       = pTexture->image;
+            copyInfo.dstImageLayout = newLayout;
+            copyInfo.regionCount    = rangecheck_cast<uint32>( batchRegionCount );
+            copyInfo.pRegions       = copyRegions.getStart();
+
+            const VulkanResult result = pVulkan->vkCopyMemoryToImageEXT( device, &copyInfo );
+            if( result.hasError() )
+            {
+                KEEN_TRACE_ERROR( "[graphics] vkCopyMemoryToImageEXT failed with error '%s'\n", result );
+                return result.getErrorId();
+            }
+        }
+
+        return ErrorId_Ok;
+#else
+        KEEN_UNUSED1( pVulkan );
+        KEEN_UNUSED1( device );
+        KEEN_UNUSED1( pTexture );
+        KEEN_UNUSED1( regions );
+        KEEN_UNUSED1( oldLayout );
+        KEEN_UNUSED1( newLayout );
+        return ErrorId_NotSupported;
+#endif
+    }
+
+}
@@ -0,0 +1,45 @@
+#ifndef KEEN_VULKAN_HOST_IMAGE_COPY_HPP_INCLUDED
+#define KEEN_VULKAN_HOST_IMAGE_COPY_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+
+namespace keen
+{
+    struct VulkanTexture;
+
+    constexpr size_t VulkanMaxHostImageCopyLayoutCount  = 32u;
+    constexpr uint64 VulkanDefaultMaxHostImageCopySize  = 16ull * 1024ull * 1024ull;
+
+    enum class VulkanTextureUploadPath : uint8
+    {
+        Staging,            // staging buffer + vkCmdCopyBufferToImage in a transfer batch
+        HostImageCopy,      // vkCopyMemoryToImageEXT directly from the calling thread (VK_EXT_host_image_copy)
+    };
+
+    struct VulkanHostImageCopyInfo
+    {
+        bool8                                                               isSupported = false;
+        uint64                                                              maxCopySize = 0u;  // larger uploads use the staging path - the copy blocks the calling thread
+        DynamicArray<VkImageLayout, VulkanMaxHostImageCopyLayoutCount>      copyDstLayouts;     // layouts vkCopyMemoryToImageEXT can write to
+    };
+
+    struct VulkanTextureUploadRequest
+    {
+        bool8                       isHostTransferTexture = false;     // created with VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT
+        uint64                      dataSize = 0u;
+        VkImageLayout               layout = VK_IMAGE_LAYOUT_UNDEFINED; // the layout the texture is in after the upload
+    };
+
+    namespace vulkan
+    {
+
+        VulkanTextureUploadPath     selectTextureUploadPath( const VulkanHostImageCopyInfo& info, const VulkanTextureUploadRequest& request );
+
+        // :JK: the texture must not be accessed by the gpu while this runs - the caller has to make sure of that (i.e. a freshly created texture)
+        Result<void>                copyMemoryToImage( VulkanApi* pVulkan, VkDevice device, const VulkanTexture* pTexture, ArrayView<const GraphicsHostTextureCopyRegion> regions, VkImageLayout oldLayout, VkImageLayout newLayout );
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "vulkan_host_image_copy.hpp"
+
+#include "keen/base/unit_test.hpp"
+
+
+namespace keen
+{
+    class VulkanHostImageCopyTestFixture : public UnitTest
+    {
+    public:
+        VulkanHostImageCopyTestFixture()
+        {
+            // :JK: roughly what current desktop drivers report
+            m_info.isSupported  = true;
+            m_info.maxCopySize  = VulkanDefaultMaxHostImageCopySize;
+            m_info.copyDstLayouts.pushBack( VK_IMAGE_LAYOUT_GENERAL );
+            m_info.copyDstLayouts.pushBack( VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+            m_info.copyDstLayouts.pushBack( VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+
+            m_request.isHostTransferTexture = true;
+            m_request.dataSize              = 256u * 256u * 4u;
+            m_request.layout                = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+
+    protected:
+        VulkanHostImageCopyInfo     m_info;
+        VulkanTextureUploadRequest  m_request;
+
+        bool isHostImageCopy() const
+        {
+            return vulkan::selectTextureUploadPath( m_info, m_request ) == VulkanTextureUploadPath::HostImageCopy;
+        }
+    };
+
+    KEEN_UNIT_TEST_F( VulkanHostImageCopyTestFixture, testHostImageCopy )
+    {
+        KEEN_UT_CHECK( isHostImageCopy() );
+
+        // the size limit is inclusive:
+        m_request.dataSize = m_info.maxCopySize;
+        KEEN_UT_CHECK( isHostImageCopy() );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanHostImageCopyTestFixture, testStagingFallback )
+    {
+        // device without VK_EXT_host_image_copy:
+        m_info.isSupported = false;
+        KEEN_UT_CHECK( !isHostImageCopy() );
+        m_info.isSupported = true;
+
+        // texture without the host transfer usage (flag not set or format not supported):
+        m_request.isHostTransferTexture = false;
+        KEEN_UT_CHECK( !isHostImageCopy() );
+        m_request.isHostTransferTexture = true;
+
+        // large uploads would block the calling thread for too long:
+        m_request.dataSize = m_info.maxCopySize + 1u;
+        KEEN_UT_CHECK( !isHostImageCopy() );
+        m_request.dataSize = 0u;
+        KEEN_UT_CHECK( !isHostImageCopy() );
+        m_request.dataSize = 1024u;
+
+        // the final layout is not a host copy destination:
+        m_request.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        KEEN_UT_CHECK( !isHostImageCopy() );
+
+        m_info.copyDstLayouts.clear();
+        m_request.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        KEEN_UT_CHECK( !isHostImageCopy() );
+    }
+
+}
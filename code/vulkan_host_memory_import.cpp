@@ -0,0 +1,44 @@
+#include "vulkan_host_memory_import.hpp"
+
+namespace keen
+{
+
+    bool vulkan::isHostMemoryImportable( const VulkanHostMemoryImportInfo& info, ConstMemoryBlock hostMemory )
+    {
+        if( !info.isSupported || hostMemory.pStart == nullptr || hostMemory.size == 0u )
+        {
+            return false;
+        }
+
+        // :JK: we don't round the range to whole pages ourselves - the pages around it might not be mapped (i.e. the end of a file mapping)
+        KEEN_ASSERT( info.minImportAlignment > 0u );
+        const uint64 address = (uint64)(uintptr_t)hostMemory.pStart;
+        return ( address % info.minImportAlignment ) == 0u && ( (uint64)hostMemory.size % info.minImportAlignment ) == 0u;
+    }
+
+    Optional<uint32> vulkan::selectHostMemoryImportType( const VkPhysicalDeviceMemoryProperties& memoryProperties, uint32 memoryTypeBits )
+    {
+        // the memory stays in system ram anyway - so prefer the types of the host heaps (uma devices only have device local types):
+        Optional<uint32> hostMemoryTypeIndex;
+        Optional<uint32> deviceLocalMemoryTypeIndex;
+        for( uint32 memoryTypeIndex = 0u; memoryTypeIndex < memoryProperties.memoryTypeCount; ++memoryTypeIndex )
+        {
+            if( ( memoryTypeBits & ( 1u << memoryTypeIndex ) ) == 0u )
+            {
+                continue;
+            }
+
+            const bool isDeviceLocal = isBitmaskSet( memoryProperties.memoryTypes[ memoryTypeIndex ].propertyFlags, (VkMemoryPropertyFlags)VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+            if( !isDeviceLocal && hostMemoryTypeIndex.isClear() )
+            {
+                hostMemoryTypeIndex = memoryTypeIndex;
+            }
+            else if( isDeviceLocal && deviceLocalMemoryTypeIndex.isClear() )
+            {
+                deviceLocalMemoryTypeIndex = memoryTypeIndex;
+            }
+        }
+        return hostMemoryTypeIndex.isSet() ? hostMemoryTypeIndex : deviceLocalMemoryTypeIndex;
+    }
+
+}
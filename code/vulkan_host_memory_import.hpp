@@ -0,0 +1,29 @@
+#ifndef KEEN_VULKAN_HOST_MEMORY_IMPORT_HPP_INCLUDED
+#define KEEN_VULKAN_HOST_MEMORY_IMPORT_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+
+namespace keen
+{
+    // per transfer batch - the imported buffers are destroyed when the batch has finished:
+    constexpr size_t VulkanMaxTransferBatchHostMemoryImportCount = 64u;
+
+    struct VulkanHostMemoryImportInfo
+    {
+        bool8                       isSupported = false;
+        uint64                      minImportAlignment = 0u;    // address and size of an imported range have to be multiples of this (usually the page size)
+    };
+
+    namespace vulkan
+    {
+
+        bool                        isHostMemoryImportable( const VulkanHostMemoryImportInfo& info, ConstMemoryBlock hostMemory );
+
+        // memoryTypeBits: allowed by both vkGetMemoryHostPointerPropertiesEXT and the buffer memory requirements
+        Optional<uint32>            selectHostMemoryImportType( const VkPhysicalDeviceMemoryProperties& memoryProperties, uint32 memoryTypeBits );
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,85 @@
+#include "vulkan_host_memory_import.hpp"
+
+#include "keen/base/unit_test.hpp"
+
+
+namespace keen
+{
+    class VulkanHostMemoryImportTestFixture : public UnitTest
+    {
+    public:
+        VulkanHostMemoryImportTestFixture()
+        {
+            m_info.isSupported          = true;
+            m_info.minImportAlignment   = 4096u;
+
+            zeroValue( &m_memoryProperties );
+        }
+
+    protected:
+        VulkanHostMemoryImportInfo          m_info;
+        VkPhysicalDeviceMemoryProperties    m_memoryProperties;
+
+        bool isImportable( uintptr_t address, size_t size ) const
+        {
+            return vulkan::isHostMemoryImportable( m_info, createConstMemoryBlock( (const void*)address, size ) );
+        }
+
+        void addMemoryType( VkMemoryPropertyFlags propertyFlags )
+        {
+            m_memoryProperties.memoryTypes[ m_memoryProperties.memoryTypeCount ].propertyFlags = propertyFlags;
+            m_memoryProperties.memoryTypeCount++;
+        }
+    };
+
+    KEEN_UNIT_TEST_F( VulkanHostMemoryImportTestFixture, testImportAlignment )
+    {
+        KEEN_UT_CHECK( isImportable( 0x10000u, 4096u ) );
+        KEEN_UT_CHECK( isImportable( 0x11000u, 64u * 4096u ) );
+
+        // address or size not page aligned:
+        KEEN_UT_CHECK( !isImportable( 0x10010u, 4096u ) );
+        KEEN_UT_CHECK( !isImportable( 0x10000u, 4000u ) );
+        KEEN_UT_CHECK( !isImportable( 0x10000u, 0u ) );
+        KEEN_UT_CHECK( !isImportable( 0u, 4096u ) );
+
+        // some drivers need larger alignments than the page size:
+        m_info.minImportAlignment = 64u * 1024u;
+        KEEN_UT_CHECK( !isImportable( 0x11000u, 64u * 1024u ) );
+        KEEN_UT_CHECK( isImportable( 0x20000u, 64u * 1024u ) );
+
+        // device without VK_EXT_external_memory_host:
+        m_info.isSupported = false;
+        KEEN_UT_CHECK( !isImportable( 0x20000u, 64u * 1024u ) );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanHostMemoryImportTestFixture, testImportMemoryType )
+    {
+        // typical discrete gpu:
+        addMemoryType( VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+        addMemoryType( VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+        addMemoryType( VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT );
+        addMemoryType( VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+
+        Optional<uint32> memoryTypeIndex = vulkan::selectHostMemoryImportType( m_memoryProperties, 0xfu );
+        KEEN_UT_CHECK( memoryTypeIndex.isSet() );
+        KEEN_UT_COMPARE_UINT32( memoryTypeIndex.get(), 1u );
+
+        memoryTypeIndex = vulkan::selectHostMemoryImportType( m_memoryProperties, 0x4u );
+        KEEN_UT_CHECK( memoryTypeIndex.isSet() );
+        KEEN_UT_COMPARE_UINT32( memoryTypeIndex.get(), 2u );
+
+        // only device local types allowed (i.e. an uma device):
+        memoryTypeIndex = vulkan::selectHostMemoryImportType( m_memoryProperties, 0x9u );
+        KEEN_UT_CHECK( memoryTypeIndex.isSet() );
+        KEEN_UT_COMPARE_UINT32( memoryTypeIndex.get(), 0u );
+
+        memoryTypeIndex = vulkan::selectHostMemoryImportType( m_memoryProperties, 0x0u );
+        KEEN_UT_CHECK( memoryTypeIndex.isClear() );
+
+        // bits of types the device doesn't have are ignored:
+        memoryTypeIndex = vulkan::selectHostMemoryImportType( m_memoryProperties, 0x10u );
+        KEEN_UT_CHECK( memoryTypeIndex.isClear() );
+    }
+
+}
@@ -0,0 +1,172 @@
+#include "vulkan_mip_generator.hpp"
+#include "vulkan_synchronization.hpp"
+#include "vulkan_types.hpp"
+
+namespace keen
+{
+
+    // :JK: every barrier of the mip chain touches at most two level ranges of the same texture
+    struct VulkanMipImageBarrierBatch
+    {
+        VkPipelineStageFlags    srcStageMask = 0u;
+        VkPipelineStageFlags    dstStageMask = 0u;
+        VkImageMemoryBarrier    barriers[ 2u ];
+        uint32                  barrierCount = 0u;
+    };
+
+    static void addMipImageBarrier( VulkanMipImageBarrierBatch* pBatch, const GraphicsTexture* pTexture, const GraphicsTextureSubresourceRange& subresourceRange, uint32 firstMipLevel, uint32 mipLevelCount,
+        GraphicsTextureLayout oldLayout, GraphicsAccessMask oldAccessMask, GraphicsTextureLayout newLayout, GraphicsAccessMask newAccessMask, GraphicsOptionalShaderStageMask optionalShaderStages )
+    {
+        KEEN_ASSERT( pBatch->barrierCount < KEEN_COUNTOF( pBatch->barriers ) );
+
+        GraphicsTextureBarrier barrier{};
+        barrier.pTexture                        = pTexture;
+        barrier.subresourceRange                = subresourceRange;
+        barrier.subresourceRange.firstMipLevel  = firstMipLevel;
+        barrier.subresourceRange.mipLevelCount  = mipLevelCount;
+        barrier.oldLayout                       = oldLayout;
+        barrier.newLayout                       = newLayout;
+        barrier.oldAccessMask                   = oldAccessMask;
+        barrier.newAccessMask                   = newAccessMask;
+
+        const VulkanImageMemoryBarrier imageMemoryBarrier = vulkan::getVulkanImageMemoryBarrier( barrier, optionalShaderStages );
+        pBatch->srcStageMask |= imageMemoryBarrier.srcStageMask;
+        pBatch->dstStageMask |= imageMemoryBarrier.dstStageMask;
+        pBatch->barriers[ pBatch->barrierCount ] = imageMemoryBarrier.barrier;
+        pBatch->barrierCount++;
+    }
+
+    static void writeMipImageBarriers( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, const VulkanMipImageBarrierBatch& batch )
+    {
+        KEEN_ASSERT( batch.barrierCount > 0u );
+        pVulkan->vkCmdPipelineBarrier( commandBuffer, batch.srcStageMask, batch.dstStageMask, 0u, 0u, nullptr, 0u, nullptr, batch.barrierCount, batch.barriers );
+    }
+
+    static VkOffset3D getMipLevelExtentOffset( const GraphicsTexture* pTexture, uint32 mipLevel )
+    {
+        const uint32 width  = max( (uint32)pTexture->width >> mipLevel, 1u );
+        const uint32 height = max( (uint32)pTexture->height >> mipLevel, 1u );
+        const uint32 depth  = max( (uint32)pTexture->depth >> mipLevel, 1u );
+        return vulkan::createOffset3d( (sint32)width, (sint32)height, (sint32)depth );
+    }
+
+    VulkanMipGenerationMode vulkan::getMipGenerationMode( VkFormatFeatureFlags formatFeatures )
+    {
+        if( !isBitmaskSet( formatFeatures, (VkFormatFeatureFlags)( VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT ) ) )
+        {
+            return VulkanMipGenerationMode::Unsupported;
+        }
+        if( isBitmaskSet( formatFeatures, (VkFormatFeatureFlags)VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT ) )
+        {
+            return VulkanMipGenerationMode::LinearBlit;
+        }
+        return VulkanMipGenerationMode::NearestBlit;
+    }
+
+    bool vulkan::canGenerateMips( const GraphicsTexture* pTexture, GraphicsQueueId queueId )
+    {
+        // the transfer queue doesn't have to support blits:
+        if( queueId != GraphicsQueueId::Main )
+        {
+            return false;
+        }
+
+        GraphicsTextureSubresourceRange subresourceRange;
+        graphics::resolveViewedTextureSubresourceRange( &pTexture, &subresourceRange );
+        if( pTexture->sampleCount != 1u ||
+            !pTexture->usageMask.isSet( GraphicsTextureUsageFlag::TransferSource ) ||
+            !pTexture->usageMask.isSet( GraphicsTextureUsageFlag::TransferTarget ) )
+        {
+            return false;
+        }
+        return getMipGenerationMode( ( (const VulkanTexture*)pTexture )->formatFeatures ) != VulkanMipGenerationMode::Unsupported;
+    }
+
+    bool vulkan::writeGenerateMips( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, const VulkanGenerateMipsParameters& parameters, GraphicsOptionalShaderStageMask optionalShaderStages )
+    {
+        // :JK: blits are done on the image - so a view is resolved to the texture it views
+        const GraphicsTexture* pTexture                     = parameters.pTexture;
+        GraphicsTextureSubresourceRange subresourceRange    = parameters.subresourceRange;
+        graphics::resolveViewedTextureSubresourceRange( &pTexture, &subresourceRange );
+
+        const VulkanTexture* pVulkanTexture = (const VulkanTexture*)pTexture;
+        const VulkanMipGenerationMode mode = getMipGenerationMode( pVulkanTexture->formatFeatures );
+        KEEN_ASSERT( subresourceRange.aspectMask == GraphicsTextureAspectFlag::Color );
+        KEEN_ASSERT( subresourceRange.firstMipLevel + subresourceRange.mipLevelCount <= pTexture->levelCount );
+
+        const uint32 firstMipLevel  = subresourceRange.firstMipLevel;
+        const uint32 lastMipLevel   = firstMipLevel + subresourceRange.mipLevelCount - 1u;
+        if( mode == VulkanMipGenerationMode::Unsupported )
+        {
+            // the following commands expect newLayout - so the transition is done without generating anything:
+            VulkanMipImageBarrierBatch batch;
+            addMipImageBarrier( &batch, pTexture, subresourceRange, firstMipLevel, 1u, parameters.oldLayout, parameters.oldAccessMask, parameters.newLayout, parameters.newAccessMask, optionalShaderStages );
+            if( lastMipLevel > firstMipLevel )
+            {
+                addMipImageBarrier( &batch, pTexture, subresourceRange, firstMipLevel + 1u, lastMipLevel - firstMipLevel,
+                    GraphicsTextureLayout::Undefined, parameters.oldAccessMask, parameters.newLayout, parameters.newAccessMask, optionalShaderStages );
+            }
+            writeMipImageBarriers( pVulkan, commandBuffer, batch );
+            return false;
+        }
+        if( subresourceRange.mipLevelCount < 2u )
+        {
+            // nothing to generate - only the layout transition remains:
+            VulkanMipImageBarrierBatch batch;
+            addMipImageBarrier( &batch, pTexture, subresourceRange, firstMipLevel, 1u, parameters.oldLayout, parameters.oldAccessMask, parameters.newLayout, parameters.newAccessMask, optionalShaderStages );
+            writeMipImageBarriers( pVulkan, commandBuffer, batch );
+            return true;
+        }
+
+        // source level -> transfer source, all generated levels -> transfer target (their contents are discarded):
+        {
+            VulkanMipImageBarrierBatch batch;
+            addMipImageBarrier( &batch, pTexture, subresourceRange, firstMipLevel, 1u,
+                parameters.oldLayout, parameters.oldAccessMask, GraphicsTextureLayout::TransferSourceOptimal, GraphicsAccessFlag::Transfer_Read, optionalShaderStages );
+            addMipImageBarrier( &batch, pTexture, subresourceRange, firstMipLevel + 1u, lastMipLevel - firstMipLevel,
+                GraphicsTextureLayout::Undefined, parameters.oldAccessMask, GraphicsTextureLayout::TransferTargetOptimal, GraphicsAccessFlag::Transfer_Write, optionalShaderStages );
+            writeMipImageBarriers( pVulkan, commandBuffer, batch );
+        }
+
+        const VkFilter filter = ( mode == VulkanMipGenerationMode::LinearBlit ) ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+
+        for( uint32 mipLevel = firstMipLevel + 1u; mipLevel <= lastMipLevel; ++mipLevel )
+        {
+            VkImageBlit region;
+            region.srcSubresource.aspectMask        = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.srcSubresource.mipLevel          = mipLevel - 1u;
+            region.srcSubresource.baseArrayLayer    = subresourceRange.firstArrayLayer;
+            region.srcSubresource.layerCount        = subresourceRange.arrayLayerCount;
+            region.srcOffsets[ 0u ]                 = createOffset3d( 0, 0, 0 );
+            region.srcOffsets[ 1u ]                 = getMipLevelExtentOffset( pTexture, mipLevel - 1u );
+            region.dstSubresource                   = region.srcSubresource;
+            region.dstSubresource.mipLevel          = mipLevel;
+            region.dstOffsets[ 0u ]                 = createOffset3d( 0, 0, 0 );
+            region.dstOffsets[ 1u ]                 = getMipLevelExtentOffset( pTexture, mipLevel );
+
+            pVulkan->vkCmdBlitImage( commandBuffer, pVulkanTexture->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, pVulkanTexture->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1u, &region, filter );
+
+            if( mipLevel < lastMipLevel )
+            {
+                // the level that was just written is the source of the next blit:
+                VulkanMipImageBarrierBatch batch;
+                addMipImageBarrier( &batch, pTexture, subresourceRange, mipLevel, 1u,
+                    GraphicsTextureLayout::TransferTargetOptimal, GraphicsAccessFlag::Transfer_Write, GraphicsTextureLayout::TransferSourceOptimal, GraphicsAccessFlag::Transfer_Read, optionalShaderStages );
+                writeMipImageBarriers( pVulkan, commandBuffer, batch );
+            }
+        }
+
+        // all levels but the last are transfer sources now - the last one is still a transfer target:
+        {
+            VulkanMipImageBarrierBatch batch;
+            addMipImageBarrier( &batch, pTexture, subresourceRange, firstMipLevel, lastMipLevel - firstMipLevel,
+                GraphicsTextureLayout::TransferSourceOptimal, GraphicsAccessFlag::Transfer_Read, parameters.newLayout, parameters.newAccessMask, optionalShaderStages );
+            addMipImageBarrier( &batch, pTexture, subresourceRange, lastMipLevel, 1u,
+                GraphicsTextureLayout::TransferTargetOptimal, GraphicsAccessFlag::Transfer_Write, parameters.newLayout, parameters.newAccessMask, optionalShaderStages );
+            writeMipImageBarriers( pVulkan, commandBuffer, batch );
+        }
+
+        return true;
+    }
+
+}
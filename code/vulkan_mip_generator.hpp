@@ -0,0 +1,43 @@
+#ifndef KEEN_VULKAN_MIP_GENERATOR_HPP_INCLUDED
+#define KEEN_VULKAN_MIP_GENERATOR_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+
+namespace keen
+{
+
+    enum class VulkanMipGenerationMode : uint8
+    {
+        Unsupported,        // the format can't be blitted (depth/stencil, compressed and most packed formats)
+        LinearBlit,
+        NearestBlit,        // the format can be blitted but not linearly filtered (i.e. integer formats)
+    };
+
+    struct VulkanGenerateMipsParameters
+    {
+        const GraphicsTexture*          pTexture = nullptr;
+        GraphicsTextureSubresourceRange subresourceRange;                               // the first mip level is the source - every further level is filtered from the previous one
+        GraphicsTextureLayout           oldLayout = GraphicsTextureLayout::Undefined;   // of the source level - the contents of the other levels are discarded
+        GraphicsAccessMask              oldAccessMask;
+        GraphicsTextureLayout           newLayout = GraphicsTextureLayout::Undefined;   // of all levels in the subresource range
+        GraphicsAccessMask              newAccessMask;
+    };
+
+    namespace vulkan
+    {
+
+        VulkanMipGenerationMode     getMipGenerationMode( VkFormatFeatureFlags formatFeatures );
+
+        // GenerateMips commands have to be rejected when they are recorded for a texture where this returns false (views are resolved to their
+        // texture). vkCmdBlitImage needs a blittable format, the transfer source + target usage, a single sample and a graphics queue:
+        bool                        canGenerateMips( const GraphicsTexture* pTexture, GraphicsQueueId queueId );
+
+        // :JK: records a vkCmdBlitImage chain (each level is filtered from the previous one) with the barriers between the levels. returns false
+        // if the texture format does not support blits - the levels are still transitioned to newLayout so the layout tracking stays valid
+        bool                        writeGenerateMips( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, const VulkanGenerateMipsParameters& parameters, GraphicsOptionalShaderStageMask optionalShaderStages );
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,234 @@
+#include "vulkan_mip_generator.hpp"
+#include "vulkan_stub_api_ut.hpp"
+#include "vulkan_types.hpp"
+
+
+namespace keen
+{
+    enum class VulkanRecordedMipCommandType : uint8
+    {
+        PipelineBarrier,
+        BlitImage,
+    };
+
+    struct VulkanRecordedMipCommand
+    {
+        VulkanRecordedMipCommandType    type;
+
+        // PipelineBarrier:
+        VkPipelineStageFlags            srcStageMask;
+        VkPipelineStageFlags            dstStageMask;
+        uint32                          imageBarrierCount;
+        VkImageMemoryBarrier            imageBarriers[ 2u ];
+
+        // BlitImage:
+        VkImageBlit                     region;
+        VkFilter                        filter;
+    };
+
+    struct VulkanRecordedMipCommands
+    {
+        uint32                          commandCount;
+        VulkanRecordedMipCommand        commands[ 32u ];
+    };
+
+    static VulkanRecordedMipCommands s_recordedCommands;
+
+    static VKAPI_ATTR void VKAPI_CALL recordPipelineBarrier( VkCommandBuffer, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkDependencyFlags, uint32_t, const VkMemoryBarrier*, uint32_t, const VkBufferMemoryBarrier*, uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier* pImageMemoryBarriers )
+    {
+        KEEN_ASSERT( s_recordedCommands.commandCount < KEEN_COUNTOF( s_recordedCommands.commands ) );
+        VulkanRecordedMipCommand* pCommand = &s_recordedCommands.commands[ s_recordedCommands.commandCount++ ];
+        pCommand->type              = VulkanRecordedMipCommandType::PipelineBarrier;
+        pCommand->srcStageMask      = srcStageMask;
+        pCommand->dstStageMask      = dstStageMask;
+        pCommand->imageBarrierCount = imageMemoryBarrierCount;
+        for( uint32 i = 0u; i < imageMemoryBarrierCount && i < KEEN_COUNTOF( pCommand->imageBarriers ); ++i )
+        {
+            pCommand->imageBarriers[ i ] = pImageMemoryBarriers[ i ];
+        }
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordBlitImage( VkCommandBuffer, VkImage, VkImageLayout srcImageLayout, VkImage, VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageBlit* pRegions, VkFilter filter )
+    {
+        KEEN_ASSERT( s_recordedCommands.commandCount < KEEN_COUNTOF( s_recordedCommands.commands ) );
+        KEEN_ASSERT( srcImageLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL );
+        KEEN_ASSERT( dstImageLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+        KEEN_ASSERT( regionCount == 1u );
+        VulkanRecordedMipCommand* pCommand = &s_recordedCommands.commands[ s_recordedCommands.commandCount++ ];
+        pCommand->type      = VulkanRecordedMipCommandType::BlitImage;
+        pCommand->region    = pRegions[ 0u ];
+        pCommand->filter    = filter;
+    }
+
+    class VulkanMipGeneratorTestFixture : public VulkanStubApiTestFixture
+    {
+    public:
+        VulkanMipGeneratorTestFixture()
+        {
+            m_vulkan.vkCmdPipelineBarrier   = recordPipelineBarrier;
+            m_vulkan.vkCmdBlitImage         = recordBlitImage;
+
+            m_texture.image             = createStubHandle<VkImage>( 0x1000u );
+            m_texture.width             = 64u;
+            m_texture.height            = 32u;
+            m_texture.depth             = 1u;
+            m_texture.levelCount        = 4u;
+            m_texture.layerCount        = 1u;
+            m_texture.sampleCount       = 1u;
+            m_texture.usageMask         = { GraphicsTextureUsageFlag::TransferSource, GraphicsTextureUsageFlag::TransferTarget, GraphicsTextureUsageFlag::Render_ShaderResource };
+            m_texture.formatFeatures    = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+
+            m_parameters.pTexture                           = &m_texture;
+            m_parameters.subresourceRange.firstMipLevel     = 0u;
+            m_parameters.subresourceRange.mipLevelCount     = 4u;
+            m_parameters.oldLayout                          = GraphicsTextureLayout::ColorAttachmentOptimal;
+            m_parameters.oldAccessMask                      = GraphicsAccessFlag::ColorAttachment_Write;
+            m_parameters.newLayout                          = GraphicsTextureLayout::ShaderReadOnlyOptimal;
+            m_parameters.newAccessMask                      = GraphicsAccessFlag::FS_Read_SampledImage;
+        }
+
+    protected:
+        VulkanTexture                   m_texture{};
+        VulkanGenerateMipsParameters    m_parameters;
+
+        bool generateMips()
+        {
+            zeroValue( &s_recordedCommands );
+            return vulkan::writeGenerateMips( &m_vulkan, VK_NULL_HANDLE, m_parameters, {} );
+        }
+
+        void checkBlit( const VulkanRecordedMipCommand& command, uint32 targetMipLevel, sint32 targetWidth, sint32 targetHeight, VkFilter filter )
+        {
+            KEEN_UT_CHECK( command.type == VulkanRecordedMipCommandType::BlitImage );
+            KEEN_UT_COMPARE_UINT32( command.region.srcSubresource.mipLevel, targetMipLevel - 1u );
+            KEEN_UT_COMPARE_UINT32( command.region.dstSubresource.mipLevel, targetMipLevel );
+            KEEN_UT_COMPARE_UINT32( (uint32)command.region.dstOffsets[ 1u ].x, (uint32)targetWidth );
+            KEEN_UT_COMPARE_UINT32( (uint32)command.region.dstOffsets[ 1u ].y, (uint32)targetHeight );
+            KEEN_UT_COMPARE_UINT32( (uint32)command.region.dstOffsets[ 1u ].z, 1u );
+            KEEN_UT_COMPARE_UINT32( command.filter, filter );
+        }
+
+        void checkImageBarrier( const VkImageMemoryBarrier& barrier, uint32 baseMipLevel, uint32 levelCount, VkImageLayout oldLayout, VkImageLayout newLayout )
+        {
+            KEEN_UT_COMPARE_UINT32( barrier.subresourceRange.baseMipLevel, baseMipLevel );
+            KEEN_UT_COMPARE_UINT32( barrier.subresourceRange.levelCount, levelCount );
+            KEEN_UT_COMPARE_UINT32( barrier.oldLayout, oldLayout );
+            KEEN_UT_COMPARE_UINT32( barrier.newLayout, newLayout );
+        }
+    };
+
+    KEEN_UNIT_TEST_F( VulkanMipGeneratorTestFixture, testBlitChain )
+    {
+        KEEN_UT_CHECK( generateMips() );
+
+        // initial transition, three blits with a barrier between each of them and the final transition:
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.commandCount, 7u );
+
+        const VulkanRecordedMipCommand& initialBarrier = s_recordedCommands.commands[ 0u ];
+        KEEN_UT_CHECK( initialBarrier.type == VulkanRecordedMipCommandType::PipelineBarrier );
+        KEEN_UT_COMPARE_UINT32( initialBarrier.imageBarrierCount, 2u );
+        KEEN_UT_COMPARE_UINT32( initialBarrier.srcStageMask, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT );
+        KEEN_UT_COMPARE_UINT32( initialBarrier.dstStageMask, VK_PIPELINE_STAGE_TRANSFER_BIT );
+        checkImageBarrier( initialBarrier.imageBarriers[ 0u ], 0u, 1u, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL );
+        checkImageBarrier( initialBarrier.imageBarriers[ 1u ], 1u, 3u, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+
+        checkBlit( s_recordedCommands.commands[ 1u ], 1u, 32, 16, VK_FILTER_LINEAR );
+
+        const VulkanRecordedMipCommand& levelBarrier = s_recordedCommands.commands[ 2u ];
+        KEEN_UT_CHECK( levelBarrier.type == VulkanRecordedMipCommandType::PipelineBarrier );
+        KEEN_UT_COMPARE_UINT32( levelBarrier.imageBarrierCount, 1u );
+        KEEN_UT_COMPARE_UINT32( levelBarrier.srcStageMask, VK_PIPELINE_STAGE_TRANSFER_BIT );
+        KEEN_UT_COMPARE_UINT32( levelBarrier.dstStageMask, VK_PIPELINE_STAGE_TRANSFER_BIT );
+        KEEN_UT_COMPARE_UINT32( levelBarrier.imageBarriers[ 0u ].srcAccessMask, VK_ACCESS_TRANSFER_WRITE_BIT );
+        KEEN_UT_COMPARE_UINT32( levelBarrier.imageBarriers[ 0u ].dstAccessMask, VK_ACCESS_TRANSFER_READ_BIT );
+        checkImageBarrier( levelBarrier.imageBarriers[ 0u ], 1u, 1u, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL );
+
+        checkBlit( s_recordedCommands.commands[ 3u ], 2u, 16, 8, VK_FILTER_LINEAR );
+        KEEN_UT_CHECK( s_recordedCommands.commands[ 4u ].type == VulkanRecordedMipCommandType::PipelineBarrier );
+        checkImageBarrier( s_recordedCommands.commands[ 4u ].imageBarriers[ 0u ], 2u, 1u, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL );
+        checkBlit( s_recordedCommands.commands[ 5u ], 3u, 8, 4, VK_FILTER_LINEAR );
+
+        // the last level was never a blit source - so it is transitioned separately:
+        const VulkanRecordedMipCommand& finalBarrier = s_recordedCommands.commands[ 6u ];
+        KEEN_UT_CHECK( finalBarrier.type == VulkanRecordedMipCommandType::PipelineBarrier );
+        KEEN_UT_COMPARE_UINT32( finalBarrier.imageBarrierCount, 2u );
+        KEEN_UT_COMPARE_UINT32( finalBarrier.srcStageMask, VK_PIPELINE_STAGE_TRANSFER_BIT );
+        KEEN_UT_COMPARE_UINT32( finalBarrier.dstStageMask, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT );
+        checkImageBarrier( finalBarrier.imageBarriers[ 0u ], 0u, 3u, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+        checkImageBarrier( finalBarrier.imageBarriers[ 1u ], 3u, 1u, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanMipGeneratorTestFixture, testPartialChainWithOddSize )
+    {
+        m_texture.width     = 5u;
+        m_texture.height    = 3u;
+
+        // level 1 is the source - so only level 2 (1x1) is generated:
+        m_parameters.subresourceRange.firstMipLevel = 1u;
+        m_parameters.subresourceRange.mipLevelCount = 2u;
+        KEEN_UT_CHECK( generateMips() );
+
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.commandCount, 3u );
+        checkImageBarrier( s_recordedCommands.commands[ 0u ].imageBarriers[ 0u ], 1u, 1u, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL );
+        checkImageBarrier( s_recordedCommands.commands[ 0u ].imageBarriers[ 1u ], 2u, 1u, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+
+        const VulkanRecordedMipCommand& blit = s_recordedCommands.commands[ 1u ];
+        checkBlit( blit, 2u, 1, 1, VK_FILTER_LINEAR );
+        KEEN_UT_COMPARE_UINT32( (uint32)blit.region.srcOffsets[ 1u ].x, 2u );
+        KEEN_UT_COMPARE_UINT32( (uint32)blit.region.srcOffsets[ 1u ].y, 1u );
+
+        checkImageBarrier( s_recordedCommands.commands[ 2u ].imageBarriers[ 0u ], 1u, 1u, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+        checkImageBarrier( s_recordedCommands.commands[ 2u ].imageBarriers[ 1u ], 2u, 1u, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanMipGeneratorTestFixture, testFormatSupport )
+    {
+        // integer formats can be blitted - but not filtered:
+        m_texture.formatFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+        KEEN_UT_CHECK( generateMips() );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.commandCount, 7u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.commands[ 1u ].filter, VK_FILTER_NEAREST );
+
+        KEEN_UT_CHECK( vulkan::canGenerateMips( &m_texture, GraphicsQueueId::Main ) );
+
+        // no blit support - only the transition to the new layout is recorded:
+        m_texture.formatFeatures = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        KEEN_UT_CHECK( !vulkan::canGenerateMips( &m_texture, GraphicsQueueId::Main ) );
+        KEEN_UT_CHECK( !generateMips() );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.commandCount, 1u );
+        KEEN_UT_CHECK( s_recordedCommands.commands[ 0u ].type == VulkanRecordedMipCommandType::PipelineBarrier );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.commands[ 0u ].imageBarrierCount, 2u );
+        checkImageBarrier( s_recordedCommands.commands[ 0u ].imageBarriers[ 0u ], 0u, 1u, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+        checkImageBarrier( s_recordedCommands.commands[ 0u ].imageBarriers[ 1u ], 1u, 3u, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanMipGeneratorTestFixture, testTextureSupport )
+    {
+        KEEN_UT_CHECK( vulkan::canGenerateMips( &m_texture, GraphicsQueueId::Main ) );
+
+        // blits need a graphics queue:
+        KEEN_UT_CHECK( !vulkan::canGenerateMips( &m_texture, GraphicsQueueId::Transfer ) );
+
+        // multisampled textures can't be blitted:
+        m_texture.sampleCount = 4u;
+        KEEN_UT_CHECK( !vulkan::canGenerateMips( &m_texture, GraphicsQueueId::Main ) );
+        m_texture.sampleCount = 1u;
+
+        // the levels are read and written by transfer commands:
+        m_texture.usageMask = { GraphicsTextureUsageFlag::TransferTarget, GraphicsTextureUsageFlag::Render_ShaderResource };
+        KEEN_UT_CHECK( !vulkan::canGenerateMips( &m_texture, GraphicsQueueId::Main ) );
+        m_texture.usageMask = { GraphicsTextureUsageFlag::TransferSource, GraphicsTextureUsageFlag::Render_ShaderResource };
+        KEEN_UT_CHECK( !vulkan::canGenerateMips( &m_texture, GraphicsQueueId::Main ) );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanMipGeneratorTestFixture, testSingleLevel )
+    {
+        // without levels to generate only the layout transition is recorded:
+        m_parameters.subresourceRange.mipLevelCount = 1u;
+        KEEN_UT_CHECK( generateMips() );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.commandCount, 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.commands[ 0u ].imageBarrierCount, 1u );
+        checkImageBarrier( s_recordedCommands.commands[ 0u ].imageBarriers[ 0u ], 0u, 1u, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+    }
+
+}
@@ -0,0 +1,480 @@
+#include "vulkan_pipeline_binary.hpp"
+
+#include "keen/base/array.hpp"
+#include "keen/base/profiler.hpp"
+
+namespace keen
+{
+    constexpr fourcc VulkanPipelineBinaryArchiveMagic = "VKPB"_4cc;
+    constexpr uint32 VulkanPipelineBinaryArchiveVersion = 1u;
+
+    constexpr uint32 VulkanInvalidPipelineBinaryRecordIndex = 0xffffffffu;
+
+    struct VulkanPipelineBinaryArchiveHeader
+    {
+        uint32                              magic;              // VulkanPipelineBinaryArchiveMagic
+        uint32                              version;            // VulkanPipelineBinaryArchiveVersion
+        VulkanPipelineBinaryKey             globalKey;          // equal to vkGetPipelineKeyKHR( device, nullptr )
+        uint32                              session;
+        uint32                              recordCount;
+        uint32                              binaryCount;
+        uint32                              reserved;
+        uint64                              dataSize;
+    };
+
+    // the index: recordCount records followed by binaryCount binaries - the binaries of a record are stored consecutively:
+    struct VulkanPipelineBinaryArchiveRecord
+    {
+        uint64                              pipelineHash;
+        VulkanPipelineBinaryKey             pipelineKey;
+        uint32                              lastUsedSession;
+        uint32                              firstBinary;
+        uint32                              binaryCount;
+    };
+
+    struct VulkanPipelineBinaryArchiveBinary
+    {
+        VulkanPipelineBinaryKey             key;
+        uint32                              reserved;
+        uint64                              dataOffset;         // relative to the start of the data section
+        uint64                              dataSize;
+    };
+
+    static bool isPipelineBinaryRecordUsed( const VulkanPipelineBinaryArchive& archive, const VulkanPipelineBinaryRecord& record, uint32 maxUnusedSessionCount )
+    {
+        return archive.session - record.lastUsedSession <= maxUnusedSessionCount;
+    }
+
+    static void fillPipelineBinaryKey( VulkanPipelineBinaryKey* pTarget, const VkPipelineBinaryKeyKHR& key )
+    {
+        zeroValue( pTarget );
+        pTarget->size = min( key.keySize, VulkanPipelineBinaryKeySize );
+        copyMemoryNonOverlapping( pTarget->data, key.key, pTarget->size );
+    }
+
+    void vulkan::createPipelineBinaryArchive( VulkanPipelineBinaryArchive* pArchive, MemoryAllocator* pAllocator, const VulkanPipelineBinaryKey& globalKey )
+    {
+        pArchive->globalKey = globalKey;
+        pArchive->session   = 1u;
+        pArchive->records.create( pAllocator );
+        pArchive->data.create( pAllocator );
+        pArchive->recordIndices.create( pAllocator, 1024u );
+    }
+
+    void vulkan::destroyPipelineBinaryArchive( VulkanPipelineBinaryArchive* pArchive )
+    {
+        pArchive->data.destroy();
+        pArchive->records.destroy();
+    }
+
+    Result<void> vulkan::readPipelineBinaryArchive( VulkanPipelineBinaryArchive* pArchive, ConstMemoryBlock data )
+    {
+        KEEN_ASSERT( pArchive->records.getSize() == 0u );
+
+        if( data.size < sizeof( VulkanPipelineBinaryArchiveHeader ) )
+        {
+            return ErrorId_BufferTooSmall;
+        }
+
+        VulkanPipelineBinaryArchiveHeader header;
+        copyMemoryNonOverlapping( &header, data.pStart, sizeof( header ) );
+        if( header.magic != VulkanPipelineBinaryArchiveMagic )
+        {
+            return ErrorId_Generic;
+        }
+        if( header.version != VulkanPipelineBinaryArchiveVersion || !isPipelineBinaryKeyEqual( header.globalKey, pArchive->globalKey ) )
+        {
+            return ErrorId_WrongVersion;
+        }
+
+        const size_t indexSize = header.recordCount * sizeof( VulkanPipelineBinaryArchiveRecord ) + header.binaryCount * sizeof( VulkanPipelineBinaryArchiveBinary );
+        if( data.size - sizeof( header ) < indexSize || data.size - sizeof( header ) - indexSize < header.dataSize )
+        {
+            return ErrorId_BufferTooSmall;
+        }
+
+        const uint8* pRecordSource  = data.pStart + sizeof( header );
+        const uint8* pBinarySource  = pRecordSource + header.recordCount * sizeof( VulkanPipelineBinaryArchiveRecord );
+        const uint8* pDataSource    = pBinarySource + header.binaryCount * sizeof( VulkanPipelineBinaryArchiveBinary );
+
+        const size_t dataSize = rangecheck_cast<size_t>( header.dataSize );
+        if( !pArchive->data.trySetCapacity( dataSize ) || !pArchive->records.trySetCapacity( header.recordCount ) )
+        {
+            return ErrorId_OutOfMemory;
+        }
+        pArchive->data.setSize( dataSize, 0u );
+        copyMemoryNonOverlapping( pArchive->data.getStart(), pDataSource, dataSize );
+
+        for( uint32 recordIndex = 0u; recordIndex < header.recordCount; ++recordIndex )
+        {
+            VulkanPipelineBinaryArchiveRecord archiveRecord;
+            copyMemoryNonOverlapping( &archiveRecord, pRecordSource + recordIndex * sizeof( archiveRecord ), sizeof( archiveRecord ) );
+
+            if( archiveRecord.binaryCount == 0u || archiveRecord.binaryCount > VulkanMaxPipelineBinaryCount ||
+                archiveRecord.firstBinary > header.binaryCount || header.binaryCount - archiveRecord.firstBinary < archiveRecord.binaryCount )
+            {
+                pArchive->records.clear();
+                pArchive->data.clear();
+                return ErrorId_Generic;
+            }
+
+            VulkanPipelineBinaryRecord* pRecord = pArchive->records.pushBackZero();
+            pRecord->pipelineHash       = archiveRecord.pipelineHash;
+            pRecord->pipelineKey        = archiveRecord.pipelineKey;
+            pRecord->lastUsedSession    = archiveRecord.lastUsedSession;
+            pRecord->binaryCount        = archiveRecord.binaryCount;
+
+            for( uint32 binaryIndex = 0u; binaryIndex < archiveRecord.binaryCount; ++binaryIndex )
+            {
+                VulkanPipelineBinaryArchiveBinary archiveBinary;
+                copyMemoryNonOverlapping( &archiveBinary, pBinarySource + ( archiveRecord.firstBinary + binaryIndex ) * sizeof( archiveBinary ), sizeof( archiveBinary ) );
+
+                if( archiveBinary.dataOffset > header.dataSize || header.dataSize - archiveBinary.dataOffset < archiveBinary.dataSize )
+                {
+                    pArchive->records.clear();
+                    pArchive->data.clear();
+                    return ErrorId_Generic;
+                }
+
+                pRecord->binaries[ binaryIndex ].key        = archiveBinary.key;
+                pRecord->binaries[ binaryIndex ].dataOffset = archiveBinary.dataOffset;
+                pRecord->binaries[ binaryIndex ].dataSize   = archiveBinary.dataSize;
+            }
+        }
+
+        // the index is only filled once all records are known to be valid:
+        for( uint32 recordIndex = 0u; recordIndex < header.recordCount; ++recordIndex )
+        {
+            const Map<HashKey64, uint32>::InsertResult insertResult = pArchive->recordIndices.insertKey( HashKey64{ pArchive->records[ recordIndex ].pipelineHash } );
+            if( insertResult.pValue != nullptr )
+            {
+                *insertResult.pValue = recordIndex;
+            }
+        }
+
+        // the archive is now used by the next session:
+        pArchive->session = header.session + 1u;
+
+        return ErrorId_Ok;
+    }
+
+    Result<void> vulkan::writePipelineBinaryArchive( Array<uint8>* pData, MemoryAllocator* pAllocator, const VulkanPipelineBinaryArchive& archive, uint32 maxUnusedSessionCount )
+    {
+        KEEN_PROFILE_CPU( Vk_WritePipelineBinaryArchive );
+
+        VulkanPipelineBinaryArchiveHeader header{};
+        header.magic        = VulkanPipelineBinaryArchiveMagic;
+        header.version      = VulkanPipelineBinaryArchiveVersion;
+        header.globalKey    = archive.globalKey;
+        header.session      = archive.session;
+
+        for( size_t i = 0u; i < archive.records.getSize(); ++i )
+        {
+            const VulkanPipelineBinaryRecord& record = archive.records[ i ];
+            if( !isPipelineBinaryRecordUsed( archive, record, maxUnusedSessionCount ) )
+            {
+                continue;
+            }
+
+            header.recordCount++;
+            header.binaryCount += record.binaryCount;
+            for( uint32 binaryIndex = 0u; binaryIndex < record.binaryCount; ++binaryIndex )
+            {
+                header.dataSize += record.binaries[ binaryIndex ].dataSize;
+            }
+        }
+
+        const size_t indexSize = header.recordCount * sizeof( VulkanPipelineBinaryArchiveRecord ) + header.binaryCount * sizeof( VulkanPipelineBinaryArchiveBinary );
+        const size_t dataSize = sizeof( header ) + indexSize + rangecheck_cast<size_t>( header.dataSize );
+        if( !pData->tryCreate( pAllocator, dataSize ) )
+        {
+            return ErrorId_OutOfMemory;
+        }
+
+        // :JK: the index entries are packed - so everything is copied instead of written through pointers
+        uint8* pTarget          = pData->getStart();
+        uint8* pRecordTarget    = pTarget + sizeof( header );
+        uint8* pBinaryTarget    = pRecordTarget + header.recordCount * sizeof( VulkanPipelineBinaryArchiveRecord );
+        uint8* pDataStart       = pBinaryTarget + header.binaryCount * sizeof( VulkanPipelineBinaryArchiveBinary );
+        uint8* pDataTarget      = pDataStart;
+        copyMemoryNonOverlapping( pTarget, &header, sizeof( header ) );
+
+        uint32 binaryCount = 0u;
+        for( size_t i = 0u; i < archive.records.getSize(); ++i )
+        {
+            const VulkanPipelineBinaryRecord& record = archive.records[ i ];
+            if( !isPipelineBinaryRecordUsed( archive, record, maxUnusedSessionCount ) )
+            {
+                continue;
+            }
+
+            VulkanPipelineBinaryArchiveRecord archiveRecord{};
+            archiveRecord.pipelineHash      = record.pipelineHash;
+            archiveRecord.pipelineKey       = record.pipelineKey;
+            archiveRecord.lastUsedSession   = record.lastUsedSession;
+            archiveRecord.firstBinary       = binaryCount;
+            archiveRecord.binaryCount       = record.binaryCount;
+            copyMemoryNonOverlapping( pRecordTarget, &archiveRecord, sizeof( archiveRecord ) );
+            pRecordTarget += sizeof( archiveRecord );
+
+            for( uint32 binaryIndex = 0u; binaryIndex < record.binaryCount; ++binaryIndex )
+            {
+                const VulkanPipelineBinary& binary = record.binaries[ binaryIndex ];
+
+                VulkanPipelineBinaryArchiveBinary archiveBinary{};
+                archiveBinary.key           = binary.key;
+                archiveBinary.dataOffset    = (uint64)( pDataTarget - pDataStart );
+                archiveBinary.dataSize      = binary.dataSize;
+                copyMemoryNonOverlapping( pBinaryTarget, &archiveBinary, sizeof( archiveBinary ) );
+                pBinaryTarget += sizeof( archiveBinary );
+
+                copyMemoryNonOverlapping( pDataTarget, archive.data.getStart() + binary.dataOffset, rangecheck_cast<size_t>( binary.dataSize ) );
+                pDataTarget += binary.dataSize;
+            }
+            binaryCount += record.binaryCount;
+        }
+        KEEN_ASSERT( pDataTarget == pData->getStart() + dataSize );
+
+        return ErrorId_Ok;
+    }
+
+    const VulkanPipelineBinaryRecord* vulkan::findPipelineBinaryRecord( VulkanPipelineBinaryArchive* pArchive, uint64 pipelineHash )
+    {
+        const Map<HashKey64, uint32>::InsertResult insertResult = pArchive->recordIndices.insertKey( HashKey64{ pipelineHash } );
+        if( insertResult.pValue == nullptr )
+        {
+            return nullptr;
+        }
+        if( insertResult.isNew )
+        {
+            *insertResult.pValue = VulkanInvalidPipelineBinaryRecordIndex;
+        }
+        if( *insertResult.pValue == VulkanInvalidPipelineBinaryRecordIndex )
+        {
+            return nullptr;
+        }
+
+        VulkanPipelineBinaryRecord* pRecord = &pArchive->records[ *insertResult.pValue ];
+        pRecord->lastUsedSession = pArchive->session;
+        return pRecord;
+    }
+
+    bool vulkan::addPipelineBinaryRecord( VulkanPipelineBinaryArchive* pArchive, uint64 pipelineHash, const VulkanPipelineBinaryKey& pipelineKey, ArrayView<const VulkanPipelineBinaryKey> binaryKeys, ArrayView<const ConstMemoryBlock> binaryData )
+    {
+        KEEN_ASSERT( binaryKeys.getSize() == binaryData.getSize() );
+        KEEN_ASSERT( binaryKeys.hasElements() && binaryKeys.getSize() <= VulkanMaxPipelineBinaryCount );
+
+        size_t totalDataSize = 0u;
+        for( size_t i = 0u; i < binaryData.getSize(); ++i )
+        {
+            totalDataSize += binaryData[ i ].size;
+        }
+
+        const size_t dataOffset = pArchive->data.getSize();
+        if( !pArchive->data.trySetCapacity( dataOffset + totalDataSize ) )
+        {
+            return false;
+        }
+
+        const Map<HashKey64, uint32>::InsertResult insertResult = pArchive->recordIndices.insertKey( HashKey64{ pipelineHash } );
+        if( insertResult.pValue == nullptr )
+        {
+            return false;
+        }
+
+        VulkanPipelineBinaryRecord* pRecord = nullptr;
+        if( insertResult.isNew || *insertResult.pValue == VulkanInvalidPipelineBinaryRecordIndex )
+        {
+            *insertResult.pValue = VulkanInvalidPipelineBinaryRecordIndex;
+
+            pRecord = pArchive->records.pushBackZero();
+            if( pRecord == nullptr )
+            {
+                return false;
+            }
+            *insertResult.pValue = (uint32)( pArchive->records.getSize() - 1u );
+        }
+        else
+        {
+            // :JK: the data of the replaced binaries stays in the archive until it is written the next time
+            pRecord = &pArchive->records[ *insertResult.pValue ];
+        }
+
+        pRecord->pipelineHash       = pipelineHash;
+        pRecord->pipelineKey        = pipelineKey;
+        pRecord->lastUsedSession    = pArchive->session;
+        pRecord->binaryCount        = binaryKeys.getCount32();
+
+        pArchive->data.setSize( dataOffset + totalDataSize, 0u );
+
+        uint64 binaryDataOffset = dataOffset;
+        for( size_t i = 0u; i < binaryKeys.getSize(); ++i )
+        {
+            pRecord->binaries[ i ].key          = binaryKeys[ i ];
+            pRecord->binaries[ i ].dataOffset   = binaryDataOffset;
+            pRecord->binaries[ i ].dataSize     = binaryData[ i ].size;
+
+            copyMemoryNonOverlapping( pArchive->data.getStart() + binaryDataOffset, binaryData[ i ].pStart, binaryData[ i ].size );
+            binaryDataOffset += binaryData[ i ].size;
+        }
+
+        return true;
+    }
+
+    bool vulkan::isPipelineBinaryKeyEqual( const VulkanPipelineBinaryKey& lhs, const VulkanPipelineBinaryKey& rhs )
+    {
+        return lhs.size == rhs.size && isMemoryBlockEqual( createConstMemoryBlockFromArray( lhs.data ), createConstMemoryBlockFromArray( rhs.data ) );
+    }
+
+    bool vulkan::getPipelineBinaryKey( VulkanPipelineBinaryKey* pKey, VulkanApi* pVulkan, const void* pPipelineCreateInfo )
+    {
+        VkPipelineCreateInfoKHR pipelineCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_CREATE_INFO_KHR };
+        pipelineCreateInfo.pNext = const_cast<void*>( pPipelineCreateInfo );
+
+        VkPipelineBinaryKeyKHR key = { VK_STRUCTURE_TYPE_PIPELINE_BINARY_KEY_KHR };
+        const VulkanResult result = pVulkan->vkGetPipelineKeyKHR( pVulkan->device, pPipelineCreateInfo != nullptr ? &pipelineCreateInfo : nullptr, &key );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkGetPipelineKeyKHR failed with error '%s'\n", result );
+            return false;
+        }
+
+        fillPipelineBinaryKey( pKey, key );
+        return true;
+    }
+
+    uint32 vulkan::createPipelineBinaries( VkPipelineBinaryKHR* pBinaries, VulkanApi* pVulkan, const VulkanPipelineBinaryArchive& archive, const VulkanPipelineBinaryRecord& record, const VkAllocationCallbacks* pAllocationCallbacks )
+    {
+        KEEN_ASSERT( record.binaryCount <= VulkanMaxPipelineBinaryCount );
+
+        VkPipelineBinaryKeyKHR binaryKeys[ VulkanMaxPipelineBinaryCount ];
+        VkPipelineBinaryDataKHR binaryData[ VulkanMaxPipelineBinaryCount ];
+        for( uint32 i = 0u; i < record.binaryCount; ++i )
+        {
+            const VulkanPipelineBinary& binary = record.binaries[ i ];
+
+            binaryKeys[ i ] = { VK_STRUCTURE_TYPE_PIPELINE_BINARY_KEY_KHR };
+            binaryKeys[ i ].keySize = binary.key.size;
+            copyMemoryNonOverlapping( binaryKeys[ i ].key, binary.key.data, binary.key.size );
+
+            binaryData[ i ].dataSize    = rangecheck_cast<size_t>( binary.dataSize );
+            binaryData[ i ].pData       = const_cast<uint8*>( archive.data.getStart() + binary.dataOffset );
+        }
+
+        VkPipelineBinaryKeysAndDataKHR keysAndData = {};
+        keysAndData.binaryCount         = record.binaryCount;
+        keysAndData.pPipelineBinaryKeys = binaryKeys;
+        keysAndData.pPipelineBinaryData = binaryData;
+
+        VkPipelineBinaryCreateInfoKHR createInfo = { VK_STRUCTURE_TYPE_PIPELINE_BINARY_CREATE_INFO_KHR };
+        createInfo.pKeysAndDataInfo = &keysAndData;
+
+        VkPipelineBinaryHandlesInfoKHR handlesInfo = { VK_STRUCTURE_TYPE_PIPELINE_BINARY_HANDLES_INFO_KHR };
+        handlesInfo.pipelineBinaryCount = record.binaryCount;
+        handlesInfo.pPipelineBinaries   = pBinaries;
+
+        const VulkanResult result = pVulkan->vkCreatePipelineBinariesKHR( pVulkan->device, &createInfo, pAllocationCallbacks, &handlesInfo );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_WARNING( "[graphics] vkCreatePipelineBinariesKHR failed with error '%s'\n", result );
+            return 0u;
+        }
+        return handlesInfo.pipelineBinaryCount;
+    }
+
+    void vulkan::destroyPipelineBinaries( VulkanApi* pVulkan, const VkPipelineBinaryKHR* pBinaries, uint32 binaryCount, const VkAllocationCallbacks* pAllocationCallbacks )
+    {
+        for( uint32 i = 0u; i < binaryCount; ++i )
+        {
+            if( pBinaries[ i ] != VK_NULL_HANDLE )
+            {
+                pVulkan->vkDestroyPipelineBinaryKHR( pVulkan->device, pBinaries[ i ], pAllocationCallbacks );
+            }
+        }
+    }
+
+    bool vulkan::capturePipelineBinaries( Array<uint8>* pData, DynamicArray<VulkanPipelineBinaryKey, VulkanMaxPipelineBinaryCount>* pKeys, DynamicArray<ConstMemoryBlock, VulkanMaxPipelineBinaryCount>* pBinaryData, MemoryAllocator* pAllocator, VulkanApi* pVulkan, VkPipeline pipeline, const VkAllocationCallbacks* pAllocationCallbacks )
+    {
+        KEEN_PROFILE_CPU( Vk_CapturePipelineBinaries );
+
+        VkPipelineBinaryCreateInfoKHR createInfo = { VK_STRUCTURE_TYPE_PIPELINE_BINARY_CREATE_INFO_KHR };
+        createInfo.pipeline = pipeline;
+
+        VkPipelineBinaryKHR binaries[ VulkanMaxPipelineBinaryCount ] = {};
+        VkPipelineBinaryHandlesInfoKHR handlesInfo = { VK_STRUCTURE_TYPE_PIPELINE_BINARY_HANDLES_INFO_KHR };
+
+        VulkanResult result = pVulkan->vkCreatePipelineBinariesKHR( pVulkan->device, &createInfo, pAllocationCallbacks, &handlesInfo );
+        if( result.isOk() && handlesInfo.pipelineBinaryCount > 0u && handlesInfo.pipelineBinaryCount <= VulkanMaxPipelineBinaryCount )
+        {
+            handlesInfo.pPipelineBinaries = binaries;
+            result = pVulkan->vkCreatePipelineBinariesKHR( pVulkan->device, &createInfo, pAllocationCallbacks, &handlesInfo );
+        }
+        else if( result.isOk() )
+        {
+            KEEN_TRACE_WARNING( "[graphics] Pipeline has an unsupported number of binaries (%d)\n", handlesInfo.pipelineBinaryCount );
+            handlesInfo.pipelineBinaryCount = 0u;
+        }
+
+        // :JK: the binaries keep their own copy - the driver can free the captured data right away
+        VkReleaseCapturedPipelineDataInfoKHR releaseInfo = { VK_STRUCTURE_TYPE_RELEASE_CAPTURED_PIPELINE_DATA_INFO_KHR };
+        releaseInfo.pipeline = pipeline;
+        pVulkan->vkReleaseCapturedPipelineDataKHR( pVulkan->device, &releaseInfo, pAllocationCallbacks );
+
+        if( result.hasError() )
+        {
+            KEEN_TRACE_WARNING( "[graphics] vkCreatePipelineBinariesKHR failed with error '%s'\n", result );
+            destroyPipelineBinaries( pVulkan, binaries, VulkanMaxPipelineBinaryCount, pAllocationCallbacks );
+            return false;
+        }
+
+        const uint32 binaryCount = handlesInfo.pipelineBinaryCount;
+
+        VkPipelineBinaryKeyKHR binaryKeys[ VulkanMaxPipelineBinaryCount ];
+        size_t binaryDataSizes[ VulkanMaxPipelineBinaryCount ];
+        size_t totalDataSize = 0u;
+        bool isOk = binaryCount > 0u;
+        for( uint32 i = 0u; i < binaryCount && isOk; ++i )
+        {
+            VkPipelineBinaryDataInfoKHR dataInfo = { VK_STRUCTURE_TYPE_PIPELINE_BINARY_DATA_INFO_KHR };
+            dataInfo.pipelineBinary = binaries[ i ];
+
+            binaryKeys[ i ]         = { VK_STRUCTURE_TYPE_PIPELINE_BINARY_KEY_KHR };
+            binaryDataSizes[ i ]    = 0u;
+            result = pVulkan->vkGetPipelineBinaryDataKHR( pVulkan->device, &dataInfo, &binaryKeys[ i ], &binaryDataSizes[ i ], nullptr );
+            isOk = result.isOk();
+            totalDataSize += binaryDataSizes[ i ];
+        }
+
+        if( isOk && !pData->tryCreate( pAllocator, totalDataSize ) )
+        {
+            isOk = false;
+        }
+
+        size_t dataOffset = 0u;
+        for( uint32 i = 0u; i < binaryCount && isOk; ++i )
+        {
+            VkPipelineBinaryDataInfoKHR dataInfo = { VK_STRUCTURE_TYPE_PIPELINE_BINARY_DATA_INFO_KHR };
+            dataInfo.pipelineBinary = binaries[ i ];
+
+            result = pVulkan->vkGetPipelineBinaryDataKHR( pVulkan->device, &dataInfo, &binaryKeys[ i ], &binaryDataSizes[ i ], pData->getStart() + dataOffset );
+            isOk = result.isOk();
+            if( !isOk )
+            {
+                break;
+            }
+
+            fillPipelineBinaryKey( pKeys->pushBack(), binaryKeys[ i ] );
+            pBinaryData->pushBack( createConstMemoryBlock( pData->getStart() + dataOffset, binaryDataSizes[ i ] ) );
+            dataOffset += binaryDataSizes[ i ];
+        }
+
+        if( !isOk )
+        {
+            KEEN_TRACE_WARNING( "[graphics] vkGetPipelineBinaryDataKHR failed with error '%s'\n", result );
+        }
+
+        destroyPipelineBinaries( pVulkan, binaries, binaryCount, pAllocationCallbacks );
+        return isOk;
+    }
+
+}
@@ -0,0 +1,79 @@
+#ifndef KEEN_VULKAN_PIPELINE_BINARY_HPP_INCLUDED
+#define KEEN_VULKAN_PIPELINE_BINARY_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+#include "keen/base/map.hpp"
+
+namespace keen
+{
+
+    constexpr uint32 VulkanPipelineBinaryKeySize    = 32u;      // VK_MAX_PIPELINE_BINARY_KEY_SIZE_KHR
+    constexpr uint32 VulkanMaxPipelineBinaryCount   = 4u;       // per pipeline - the drivers we know return a single binary
+
+    struct VulkanPipelineBinaryKey
+    {
+        uint32                          size;
+        uint8                           data[ VulkanPipelineBinaryKeySize ];    // unused bytes are zero
+    };
+
+    struct VulkanPipelineBinary
+    {
+        VulkanPipelineBinaryKey         key;
+        uint64                          dataOffset;             // into VulkanPipelineBinaryArchive::data
+        uint64                          dataSize;
+    };
+
+    struct VulkanPipelineBinaryRecord
+    {
+        uint64                          pipelineHash;           // our hash of the pipeline parameters - stays the same between runs
+        VulkanPipelineBinaryKey         pipelineKey;            // vkGetPipelineKeyKHR of the create info - the binaries are only used if this still matches
+        uint32                          lastUsedSession;
+        uint32                          binaryCount;
+        VulkanPipelineBinary            binaries[ VulkanMaxPipelineBinaryCount ];
+    };
+
+    // all binaries of the pipelines created on one device. stored as a header, the record index, the binary index and the binary data:
+    struct VulkanPipelineBinaryArchive
+    {
+        VulkanPipelineBinaryKey                     globalKey;          // vkGetPipelineKeyKHR without create info - changes with the driver
+        uint32                                      session;            // incremented every time the archive is loaded
+        DynamicArray<VulkanPipelineBinaryRecord>    records;
+        DynamicArray<uint8>                         data;
+        Map<HashKey64, uint32>                      recordIndices;
+    };
+
+    namespace vulkan
+    {
+
+        void            createPipelineBinaryArchive( VulkanPipelineBinaryArchive* pArchive, MemoryAllocator* pAllocator, const VulkanPipelineBinaryKey& globalKey );
+        void            destroyPipelineBinaryArchive( VulkanPipelineBinaryArchive* pArchive );
+
+        // the archive has to be empty. returns ErrorId_WrongVersion if the archive was written with a different global key (e.g. after a driver update):
+        Result<void>    readPipelineBinaryArchive( VulkanPipelineBinaryArchive* pArchive, ConstMemoryBlock data );
+
+        // records that were not used in the last maxUnusedSessionCount sessions are not written (and their data is dropped):
+        Result<void>    writePipelineBinaryArchive( Array<uint8>* pData, MemoryAllocator* pAllocator, const VulkanPipelineBinaryArchive& archive, uint32 maxUnusedSessionCount );
+
+        // marks the record as used in the current session. the pointer is only valid until the next record is added:
+        const VulkanPipelineBinaryRecord*   findPipelineBinaryRecord( VulkanPipelineBinaryArchive* pArchive, uint64 pipelineHash );
+
+        // replaces the record with the same pipeline hash:
+        bool            addPipelineBinaryRecord( VulkanPipelineBinaryArchive* pArchive, uint64 pipelineHash, const VulkanPipelineBinaryKey& pipelineKey, ArrayView<const VulkanPipelineBinaryKey> binaryKeys, ArrayView<const ConstMemoryBlock> binaryData );
+
+        bool            isPipelineBinaryKeyEqual( const VulkanPipelineBinaryKey& lhs, const VulkanPipelineBinaryKey& rhs );
+
+        // pPipelineCreateInfo is a Vk*PipelineCreateInfo or nullptr for the global key:
+        bool            getPipelineBinaryKey( VulkanPipelineBinaryKey* pKey, VulkanApi* pVulkan, const void* pPipelineCreateInfo );
+
+        // creates the VkPipelineBinaryKHRs of the record - returns the number of binaries (zero on error):
+        uint32          createPipelineBinaries( VkPipelineBinaryKHR* pBinaries, VulkanApi* pVulkan, const VulkanPipelineBinaryArchive& archive, const VulkanPipelineBinaryRecord& record, const VkAllocationCallbacks* pAllocationCallbacks );
+        void            destroyPipelineBinaries( VulkanApi* pVulkan, const VkPipelineBinaryKHR* pBinaries, uint32 binaryCount, const VkAllocationCallbacks* pAllocationCallbacks );
+
+        // pipeline has to be created with VK_PIPELINE_CREATE_2_CAPTURE_DATA_BIT_KHR. the captured data of the pipeline is released in any case:
+        bool            capturePipelineBinaries( Array<uint8>* pData, DynamicArray<VulkanPipelineBinaryKey, VulkanMaxPipelineBinaryCount>* pKeys, DynamicArray<ConstMemoryBlock, VulkanMaxPipelineBinaryCount>* pBinaryData, MemoryAllocator* pAllocator, VulkanApi* pVulkan, VkPipeline pipeline, const VkAllocationCallbacks* pAllocationCallbacks );
+
+    }
+
+}
+
+#endif
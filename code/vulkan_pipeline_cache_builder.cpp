@@ -0,0 +1,1079 @@
+#include "vulkan_pipeline_cache_builder.hpp"
+
+#include "global/graphics_device.hpp"
+
+#include "keen/base/array.hpp"
+#include "keen/base/profiler.hpp"
+#include "keen/base/tls_allocator_scope.hpp"
+
+namespace keen
+{
+    constexpr fourcc VulkanPipelineListMagic = "VKPL"_4cc;
+    constexpr uint32 VulkanPipelineListVersion = 5u;
+
+    enum VulkanPipelineListSection
+    {
+        VulkanPipelineListSection_DescriptorSetLayouts,
+        VulkanPipelineListSection_Bindings,
+        VulkanPipelineListSection_StaticSamplers,
+        VulkanPipelineListSection_PipelineLayouts,
+        VulkanPipelineListSection_VertexFormats,
+        VulkanPipelineListSection_RenderPipelines,
+        VulkanPipelineListSection_ComputePipelines,
+        VulkanPipelineListSection_Data,
+
+        VulkanPipelineListSection_Count
+    };
+
+    struct VulkanPipelineListHeader
+    {
+        uint32                              magic;              // VulkanPipelineListMagic
+        uint32                              version;            // VulkanPipelineListVersion
+        uint32                              elementSizes[ VulkanPipelineListSection_Count ];
+        uint32                              elementCounts[ VulkanPipelineListSection_Count ];
+    };
+
+    static const uint32 s_pipelineListElementSizes[ VulkanPipelineListSection_Count ] =
+    {
+        (uint32)sizeof( VulkanPipelineListDescriptorSetLayout ),
+        (uint32)sizeof( GraphicsDescriptorSetLayoutBinding ),
+        (uint32)sizeof( GraphicsSamplerParameters ),
+        (uint32)sizeof( VulkanPipelineListPipelineLayout ),
+        (uint32)sizeof( VertexFormat ),
+        (uint32)sizeof( VulkanPipelineListRenderPipeline ),
+        (uint32)sizeof( VulkanPipelineListComputePipeline ),
+        1u,
+    };
+
+    static bool addPipelineListBlob( VulkanPipelineListBlob* pBlob, VulkanPipelineList* pList, ConstMemoryBlock memory, bool isString )
+    {
+        if( !isConstMemoryBlockValid( memory ) )
+        {
+            pBlob->offset   = 0u;
+            pBlob->size     = VulkanInvalidPipelineListIndex;
+            return true;
+        }
+
+        // :JK: most pipelines share their shaders with other permutations - so every blob is only stored once
+        const HashKey64 blobKey{ calculateFnv1a64Hash( memory.pStart, memory.size ).value ^ ( isString ? 1u : 0u ) };
+        const Map<HashKey64, VulkanPipelineListBlob>::InsertResult insertResult = pList->blobs.insertKey( blobKey );
+        if( insertResult.pValue == nullptr )
+        {
+            return false;
+        }
+        if( !insertResult.isNew && insertResult.pValue->size == memory.size &&
+            isMemoryBlockEqual( createConstMemoryBlock( pList->data.getStart() + insertResult.pValue->offset, insertResult.pValue->size ), memory ) )
+        {
+            *pBlob = *insertResult.pValue;
+            return true;
+        }
+
+        // strings keep their zero terminator (which is not part of the size):
+        const size_t offset     = pList->data.getSize();
+        const size_t storedSize = memory.size + ( isString ? 1u : 0u );
+        if( offset + storedSize >= VulkanInvalidPipelineListIndex || !pList->data.trySetCapacity( offset + storedSize ) )
+        {
+            return false;
+        }
+        pList->data.setSize( offset + storedSize, 0u );
+        copyMemoryNonOverlapping( pList->data.getStart() + offset, memory.pStart, memory.size );
+
+        pBlob->offset           = (uint32)offset;
+        pBlob->size             = (uint32)memory.size;
+        *insertResult.pValue    = *pBlob;
+        return true;
+    }
+
+    static bool addPipelineListString( VulkanPipelineListBlob* pBlob, VulkanPipelineList* pList, const char* pString, size_t size )
+    {
+        if( pString == nullptr )
+        {
+            return addPipelineListBlob( pBlob, pList, InvalidConstMemoryBlock, true );
+        }
+        return addPipelineListBlob( pBlob, pList, createConstMemoryBlock( pString, size ), true );
+    }
+
+    static bool addPipelineListDebugName( VulkanPipelineListBlob* pBlob, VulkanPipelineList* pList, const DebugName& debugName )
+    {
+        const char* pName = debugName.getCName();
+        if( pName == nullptr || pName[ 0u ] == '\0' )
+        {
+            return addPipelineListString( pBlob, pList, nullptr, 0u );
+        }
+        return addPipelineListString( pBlob, pList, pName, createStringView( pName ).getSize() );
+    }
+
+    static ConstMemoryBlock getPipelineListBlob( const VulkanPipelineList& list, const VulkanPipelineListBlob& blob )
+    {
+        if( blob.size == VulkanInvalidPipelineListIndex )
+        {
+            return InvalidConstMemoryBlock;
+        }
+        return createConstMemoryBlock( list.data.getStart() + blob.offset, blob.size );
+    }
+
+    static GraphicsShaderEntryPointName getPipelineListEntryPoint( const VulkanPipelineList& list, const VulkanPipelineListBlob& blob )
+    {
+        GraphicsShaderEntryPointName entryPoint;
+        if( blob.size != VulkanInvalidPipelineListIndex )
+        {
+            entryPoint.pStart   = (const char*)list.data.getStart() + blob.offset;
+            entryPoint.size     = blob.size;
+        }
+        return entryPoint;
+    }
+
+    static DebugName getPipelineListDebugName( const VulkanPipelineList& list, const VulkanPipelineListBlob& blob )
+    {
+        if( blob.size == VulkanInvalidPipelineListIndex )
+        {
+            return EmptyDebugName;
+        }
+        return DebugName::createFormatted( "%s", (const char*)list.data.getStart() + blob.offset );
+    }
+
+    static bool isPipelineListBlobValid( const VulkanPipelineList& list, const VulkanPipelineListBlob& blob, bool isString )
+    {
+        if( blob.size == VulkanInvalidPipelineListIndex )
+        {
+            return true;
+        }
+
+        const size_t storedSize = (size_t)blob.size + ( isString ? 1u : 0u );
+        if( blob.offset > list.data.getSize() || list.data.getSize() - blob.offset < storedSize )
+        {
+            return false;
+        }
+        return !isString || list.data[ blob.offset + blob.size ] == 0u;
+    }
+
+    static const VertexFormat* getPipelineListVertexFormat( const VulkanPipelineList& list, uint32 vertexFormatIndex )
+    {
+        return vertexFormatIndex != VulkanInvalidPipelineListIndex ? &list.vertexFormats[ vertexFormatIndex ] : nullptr;
+    }
+
+    static uint64 getPipelineListBlobCost( const VulkanPipelineListBlob& blob )
+    {
+        return blob.size != VulkanInvalidPipelineListIndex ? blob.size : 0u;
+    }
+
+    static void fillPipelineListStencilState( VulkanPipelineListStencilState* pState, const GraphicsStencilParameters& parameters )
+    {
+        pState->testMask    = parameters.testMask;
+        pState->writeMask   = parameters.writeMask;
+        pState->testEnabled = parameters.testEnabled ? 1u : 0u;
+        pState->testFunc    = (uint8)parameters.testFunc;
+        pState->opFail      = (uint8)parameters.opFail;
+        pState->opDepthFail = (uint8)parameters.opDepthFail;
+        pState->opDepthPass = (uint8)parameters.opDepthPass;
+    }
+
+    static void getPipelineListStencilParameters( GraphicsStencilParameters* pParameters, const VulkanPipelineListStencilState& state )
+    {
+        pParameters->testMask       = state.testMask;
+        pParameters->writeMask      = state.writeMask;
+        pParameters->testEnabled    = state.testEnabled != 0u;
+        pParameters->testFunc       = (GraphicsComparisonFunction)state.testFunc;
+        pParameters->opFail         = (GraphicsStencilOperation)state.opFail;
+        pParameters->opDepthFail    = (GraphicsStencilOperation)state.opDepthFail;
+        pParameters->opDepthPass    = (GraphicsStencilOperation)state.opDepthPass;
+    }
+
+    template<typename T>
+    static uint8* writePipelineListSection( uint8* pTarget, const DynamicArray<T>& elements )
+    {
+        const size_t size = elements.getSize() * sizeof( T );
+        if( size > 0u )
+        {
+            copyMemoryNonOverlapping( pTarget, elements.getStart(), size );
+        }
+        return pTarget + size;
+    }
+
+    template<typename T>
+    static bool readPipelineListSection( DynamicArray<T>* pElements, const uint8** ppSource, uint32 count )
+    {
+        if( !pElements->trySetCapacity( count ) )
+        {
+            return false;
+        }
+        pElements->setSize( count, T{} );
+
+        const size_t size = count * sizeof( T );
+        if( size > 0u )
+        {
+            copyMemoryNonOverlapping( pElements->getStart(), *ppSource, size );
+        }
+        *ppSource += size;
+        return true;
+    }
+
+    static bool isPipelineListValid( const VulkanPipelineList& list )
+    {
+        for( size_t i = 0u; i < list.descriptorSetLayouts.getSize(); ++i )
+        {
+            const VulkanPipelineListDescriptorSetLayout& layout = list.descriptorSetLayouts[ i ];
+            if( layout.firstBinding > list.bindings.getSize() || list.bindings.getSize() - layout.firstBinding < layout.bindingCount ||
+                layout.firstStaticSampler > list.staticSamplers.getSize() || list.staticSamplers.getSize() - layout.firstStaticSampler < layout.staticSamplerCount )
+            {
+                return false;
+            }
+        }
+
+        for( size_t i = 0u; i < list.pipelineLayouts.getSize(); ++i )
+        {
+            const VulkanPipelineListPipelineLayout& layout = list.pipelineLayouts[ i ];
+            if( layout.descriptorSetLayoutCount > GraphicsLimits_MaxDescriptorSetSlotCount || layout.pushConstantRangeCount > GraphicsLimits_MaxPushConstantRangeCount )
+            {
+                return false;
+            }
+            for( size_t setIndex = 0u; setIndex < layout.descriptorSetLayoutCount; ++setIndex )
+            {
+                if( layout.setLayoutIndices[ setIndex ] >= list.descriptorSetLayouts.getSize() )
+                {
+                    return false;
+                }
+            }
+        }
+
+        for( size_t i = 0u; i < list.renderPipelines.getSize(); ++i )
+        {
+            const VulkanPipelineListRenderPipeline& pipeline = list.renderPipelines[ i ];
+            if( pipeline.pipelineLayoutIndex >= list.pipelineLayouts.getSize() ||
+                pipeline.additionalVertexStreamCount >= GraphicsLimits_MaxVertexStreamCount ||
+                !isPipelineListBlobValid( list, pipeline.debugName, true ) )
+            {
+                return false;
+            }
+            for( size_t stream = 0u; stream < GraphicsLimits_MaxVertexStreamCount; ++stream )
+            {
+                if( pipeline.vertexFormatIndices[ stream ] != VulkanInvalidPipelineListIndex && pipeline.vertexFormatIndices[ stream ] >= list.vertexFormats.getSize() )
+                {
+                    return false;
+                }
+            }
+            for( size_t stage = 0u; stage < VulkanPipelineListRenderStage_Count; ++stage )
+            {
+                if( !isPipelineListBlobValid( list, pipeline.shaderCode[ stage ], false ) || !isPipelineListBlobValid( list, pipeline.entryPoints[ stage ], true ) )
+                {
+                    return false;
+                }
+            }
+        }
+
+        for( size_t i = 0u; i < list.computePipelines.getSize(); ++i )
+        {
+            const VulkanPipelineListComputePipeline& pipeline = list.computePipelines[ i ];
+            if( pipeline.pipelineLayoutIndex >= list.pipelineLayouts.getSize() ||
+                !isPipelineListBlobValid( list, pipeline.shaderCode, false ) ||
+                !isPipelineListBlobValid( list, pipeline.entryPoint, true ) ||
+                !isPipelineListBlobValid( list, pipeline.debugName, true ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static void clearPipelineList( VulkanPipelineList* pList )
+    {
+        pList->descriptorSetLayouts.clear();
+        pList->bindings.clear();
+        pList->staticSamplers.clear();
+        pList->pipelineLayouts.clear();
+        pList->vertexFormats.clear();
+        pList->renderPipelines.clear();
+        pList->computePipelines.clear();
+        pList->data.clear();
+    }
+
+    void vulkan::createPipelineList( VulkanPipelineList* pList, MemoryAllocator* pAllocator )
+    {
+        pList->descriptorSetLayouts.create( pAllocator );
+        pList->bindings.create( pAllocator );
+        pList->staticSamplers.create( pAllocator );
+        pList->pipelineLayouts.create( pAllocator );
+        pList->vertexFormats.create( pAllocator );
+        pList->renderPipelines.create( pAllocator );
+        pList->computePipelines.create( pAllocator );
+        pList->data.create( pAllocator );
+        pList->blobs.create( pAllocator, 1024u );
+    }
+
+    void vulkan::destroyPipelineList( VulkanPipelineList* pList )
+    {
+        pList->data.destroy();
+        pList->computePipelines.destroy();
+        pList->renderPipelines.destroy();
+        pList->vertexFormats.destroy();
+        pList->pipelineLayouts.destroy();
+        pList->staticSamplers.destroy();
+        pList->bindings.destroy();
+        pList->descriptorSetLayouts.destroy();
+    }
+
+    uint32 vulkan::addPipelineListDescriptorSetLayout( VulkanPipelineList* pList, const GraphicsDescriptorSetLayoutParameters& parameters )
+    {
+        const size_t firstBinding       = pList->bindings.getSize();
+        const size_t firstStaticSampler = pList->staticSamplers.getSize();
+        if( !pList->bindings.trySetCapacity( firstBinding + parameters.bindings.getSize() ) ||
+            !pList->staticSamplers.trySetCapacity( firstStaticSampler + parameters.staticSamplers.getSize() ) )
+        {
+            return VulkanInvalidPipelineListIndex;
+        }
+
+        VulkanPipelineListDescriptorSetLayout* pLayout = pList->descriptorSetLayouts.pushBackZero();
+        if( pLayout == nullptr )
+        {
+            return VulkanInvalidPipelineListIndex;
+        }
+
+        for( size_t i = 0u; i < parameters.bindings.getSize(); ++i )
+        {
+            pList->bindings.pushBack( parameters.bindings[ i ] );
+        }
+        for( size_t i = 0u; i < parameters.staticSamplers.getSize(); ++i )
+        {
+            pList->staticSamplers.pushBack( parameters.staticSamplers[ i ] );
+        }
+
+        pLayout->firstBinding       = (uint32)firstBinding;
+        pLayout->bindingCount       = parameters.bindings.getCount32();
+        pLayout->firstStaticSampler = (uint32)firstStaticSampler;
+        pLayout->staticSamplerCount = parameters.staticSamplers.getCount32();
+
+        return pList->descriptorSetLayouts.getCount32() - 1u;
+    }
+
+    uint32 vulkan::addPipelineListPipelineLayout( VulkanPipelineList* pList, const GraphicsPipelineLayoutParameters& parameters, ArrayView<const uint32> setLayoutIndices )
+    {
+        KEEN_ASSERT( setLayoutIndices.getSize() == parameters.descriptorSetLayoutCount );
+
+        VulkanPipelineListPipelineLayout* pLayout = pList->pipelineLayouts.pushBackZero();
+        if( pLayout == nullptr )
+        {
+            return VulkanInvalidPipelineListIndex;
+        }
+
+        for( size_t i = 0u; i < GraphicsLimits_MaxDescriptorSetSlotCount; ++i )
+        {
+            pLayout->setLayoutIndices[ i ] = i < setLayoutIndices.getSize() ? setLayoutIndices[ i ] : VulkanInvalidPipelineListIndex;
+        }
+        pLayout->descriptorSetLayoutCount   = parameters.descriptorSetLayoutCount;
+        pLayout->pushConstantRangeCount     = parameters.pushConstantRangeCount;
+        for( size_t i = 0u; i < GraphicsLimits_MaxPushConstantRangeCount; ++i )
+        {
+            pLayout->pushConstantRanges[ i ].stageMask  = parameters.pushConstantRanges[ i ].stageMask.value;
+            pLayout->pushConstantRanges[ i ].offset     = parameters.pushConstantRanges[ i ].offset;
+            pLayout->pushConstantRanges[ i ].size       = parameters.pushConstantRanges[ i ].size;
+        }
+        pLayout->pushConstantsStageMask     = parameters.pushConstantsStageMask.value;
+        pLayout->pushConstantsSize          = parameters.pushConstantsSize;
+        pLayout->useBindlessDescriptors     = parameters.useBindlessDescriptors ? 1u : 0u;
+
+        return pList->pipelineLayouts.getCount32() - 1u;
+    }
+
+    uint32 vulkan::addPipelineListVertexFormat( VulkanPipelineList* pList, const VertexFormat& vertexFormat )
+    {
+        VertexFormat* pVertexFormat = pList->vertexFormats.pushBack( vertexFormat );
+        if( pVertexFormat == nullptr )
+        {
+            return VulkanInvalidPipelineListIndex;
+        }
+        return pList->vertexFormats.getCount32() - 1u;
+    }
+
+    uint32 vulkan::addPipelineListRenderPipeline( VulkanPipelineList* pList, const GraphicsRenderPipelineParameters& parameters, uint32 pipelineLayoutIndex, ArrayView<const uint32> vertexFormatIndices )
+    {
+        KEEN_ASSERT( pipelineLayoutIndex < pList->pipelineLayouts.getSize() );
+        KEEN_ASSERT( vertexFormatIndices.getSize() <= (size_t)parameters.additionalVertexStreamCount + 1u );
+
+        VulkanPipelineListRenderPipeline pipeline;
+        zeroValue( &pipeline );
+        pipeline.pipelineLayoutIndex    = pipelineLayoutIndex;
+        for( size_t stream = 0u; stream < GraphicsLimits_MaxVertexStreamCount; ++stream )
+        {
+            pipeline.vertexFormatIndices[ stream ] = stream < vertexFormatIndices.getSize() ? vertexFormatIndices[ stream ] : VulkanInvalidPipelineListIndex;
+        }
+
+        const ConstMemoryBlock shaderCode[] = { parameters.vertexShaderCode, parameters.tcShaderCode, parameters.teShaderCode, parameters.fragmentShaderCode, parameters.taskShaderCode, parameters.meshShaderCode };
+        const GraphicsShaderEntryPointName* entryPoints[] = { &parameters.vsEntryPoint, &parameters.tcEntryPoint, &parameters.teEntryPoint, &parameters.fsEntryPoint, &parameters.tsEntryPoint, &parameters.msEntryPoint };
+        KEEN_STATIC_ASSERT( KEEN_COUNTOF( shaderCode ) == VulkanPipelineListRenderStage_Count );
+        KEEN_STATIC_ASSERT( KEEN_COUNTOF( entryPoints ) == VulkanPipelineListRenderStage_Count );
+
+        for( size_t stage = 0u; stage < VulkanPipelineListRenderStage_Count; ++stage )
+        {
+            if( !addPipelineListBlob( &pipeline.shaderCode[ stage ], pList, shaderCode[ stage ], false ) ||
+                !addPipelineListString( &pipeline.entryPoints[ stage ], pList, entryPoints[ stage ]->pStart, entryPoints[ stage ]->size ) )
+            {
+                return VulkanInvalidPipelineListIndex;
+            }
+        }
+        if( !addPipelineListDebugName( &pipeline.debugName, pList, parameters.debugName ) )
+        {
+            return VulkanInvalidPipelineListIndex;
+        }
+
+        for( size_t i = 0u; i < GraphicsLimits_MaxColorTargetCount; ++i )
+        {
+            pipeline.colorTargetFormats[ i ]    = (uint32)parameters.renderTargetFormat.colorTargetFormats[ i ];
+            pipeline.colorWriteMask[ i ]        = parameters.colorWriteMask[ i ].value;
+            pipeline.colorInputIndices[ i ]     = parameters.inputAttachmentIndices.colorInputIndices[ i ];
+        }
+        pipeline.depthStencilTargetFormat   = (uint32)parameters.renderTargetFormat.depthStencilTargetFormat;
+        pipeline.viewMask                   = parameters.viewMask;
+        pipeline.constDepthBias             = parameters.constDepthBias;
+        pipeline.slopeDepthBias             = parameters.slopeDepthBias;
+
+        fillPipelineListStencilState( &pipeline.frontStencil, parameters.frontStencil );
+        fillPipelineListStencilState( &pipeline.backStencil, parameters.backStencil );
+        for( size_t stream = 0u; stream < GraphicsLimits_MaxVertexStreamCount - 1u; ++stream )
+        {
+            pipeline.additionalVertexStreamInputRates[ stream ] = (uint8)parameters.additionalVertexStreams[ stream ].inputRate;
+        }
+        pipeline.additionalVertexStreamCount    = parameters.additionalVertexStreamCount;
+        pipeline.useDynamicVertexStrides        = parameters.useDynamicVertexStrides ? 1u : 0u;
+        pipeline.primitiveType                  = (uint8)parameters.primitiveType;
+        pipeline.patchSize                      = parameters.patchSize;
+        pipeline.cullMode                       = (uint8)parameters.cullMode;
+        pipeline.fillMode                       = (uint8)parameters.fillMode;
+        pipeline.windingOrder                   = (uint8)parameters.windingOrder;
+        pipeline.dynamicState                   = parameters.dynamicState.value;
+        pipeline.sampleCount                    = parameters.sampleCount;
+        pipeline.blendOp                        = (uint8)parameters.blendOp;
+        pipeline.blendSourceFactor              = (uint8)parameters.blendSourceFactor;
+        pipeline.blendDestFactor                = (uint8)parameters.blendDestFactor;
+        pipeline.sampleShading                  = parameters.sampleShading ? 1u : 0u;
+        pipeline.alphaToCoverage                = parameters.alphaToCoverage ? 1u : 0u;
+        pipeline.depthComparisonFunction        = (uint8)parameters.depthComparisonFunction;
+        pipeline.depthWriteEnabled              = parameters.depthWriteEnabled ? 1u : 0u;
+        pipeline.enableScissorTest              = parameters.enableScissorTest ? 1u : 0u;
+        pipeline.shadingRate                    = (uint8)parameters.shadingRate;
+        pipeline.shadingRateCombiners[ 0u ]     = (uint8)parameters.shadingRateCombiners[ 0u ];
+        pipeline.shadingRateCombiners[ 1u ]     = (uint8)parameters.shadingRateCombiners[ 1u ];
+        pipeline.useShadingRateAttachment       = parameters.useShadingRateAttachment ? 1u : 0u;
+        pipeline.isIndirectBindable             = parameters.isIndirectBindable ? 1u : 0u;
+        pipeline.inputAttachmentIndicesEnabled  = parameters.inputAttachmentIndices.isEnabled ? 1u : 0u;
+        pipeline.depthInputIndex                = parameters.inputAttachmentIndices.depthInputIndex;
+        pipeline.stencilInputIndex              = parameters.inputAttachmentIndices.stencilInputIndex;
+        pipeline.entryPointId                   = (uint8)parameters.entryPointId;
+
+        if( pList->renderPipelines.pushBack( pipeline ) == nullptr )
+        {
+            return VulkanInvalidPipelineListIndex;
+        }
+        return pList->renderPipelines.getCount32() - 1u;
+    }
+
+    uint32 vulkan::addPipelineListComputePipeline( VulkanPipelineList* pList, const GraphicsComputePipelineParameters& parameters, uint32 pipelineLayoutIndex )
+    {
+        KEEN_ASSERT( pipelineLayoutIndex < pList->pipelineLayouts.getSize() );
+
+        VulkanPipelineListComputePipeline pipeline;
+        zeroValue( &pipeline );
+        pipeline.pipelineLayoutIndex = pipelineLayoutIndex;
+
+        if( !addPipelineListBlob( &pipeline.shaderCode, pList, parameters.shaderCode, false ) ||
+            !addPipelineListString( &pipeline.entryPoint, pList, parameters.entryPoint.pStart, parameters.entryPoint.size ) ||
+            !addPipelineListDebugName( &pipeline.debugName, pList, parameters.debugName ) )
+        {
+            return VulkanInvalidPipelineListIndex;
+        }
+
+        pipeline.entryPointId = (uint8)parameters.entryPointId;
+
+        if( pList->computePipelines.pushBack( pipeline ) == nullptr )
+        {
+            return VulkanInvalidPipelineListIndex;
+        }
+        return pList->computePipelines.getCount32() - 1u;
+    }
+
+    Result<void> vulkan::writePipelineList( Array<uint8>* pData, MemoryAllocator* pAllocator, const VulkanPipelineList& list )
+    {
+        VulkanPipelineListHeader header{};
+        header.magic    = VulkanPipelineListMagic;
+        header.version  = VulkanPipelineListVersion;
+        header.elementCounts[ VulkanPipelineListSection_DescriptorSetLayouts ]  = list.descriptorSetLayouts.getCount32();
+        header.elementCounts[ VulkanPipelineListSection_Bindings ]              = list.bindings.getCount32();
+        header.elementCounts[ VulkanPipelineListSection_StaticSamplers ]        = list.staticSamplers.getCount32();
+        header.elementCounts[ VulkanPipelineListSection_PipelineLayouts ]       = list.pipelineLayouts.getCount32();
+        header.elementCounts[ VulkanPipelineListSection_VertexFormats ]         = list.vertexFormats.getCount32();
+        header.elementCounts[ VulkanPipelineListSection_RenderPipelines ]       = list.renderPipelines.getCount32();
+        header.elementCounts[ VulkanPipelineListSection_ComputePipelines ]      = list.computePipelines.getCount32();
+        header.elementCounts[ VulkanPipelineListSection_Data ]                  = list.data.getCount32();
+
+        size_t dataSize = sizeof( header );
+        for( size_t i = 0u; i < VulkanPipelineListSection_Count; ++i )
+        {
+            header.elementSizes[ i ] = s_pipelineListElementSizes[ i ];
+            dataSize += (size_t)header.elementSizes[ i ] * header.elementCounts[ i ];
+        }
+
+        if( !pData->tryCreate( pAllocator, dataSize ) )
+        {
+            return ErrorId_OutOfMemory;
+        }
+
+        uint8* pTarget = pData->getStart();
+        copyMemoryNonOverlapping( pTarget, &header, sizeof( header ) );
+        pTarget += sizeof( header );
+
+        pTarget = writePipelineListSection( pTarget, list.descriptorSetLayouts );
+        pTarget = writePipelineListSection( pTarget, list.bindings );
+        pTarget = writePipelineListSection( pTarget, list.staticSamplers );
+        pTarget = writePipelineListSection( pTarget, list.pipelineLayouts );
+        pTarget = writePipelineListSection( pTarget, list.vertexFormats );
+        pTarget = writePipelineListSection( pTarget, list.renderPipelines );
+        pTarget = writePipelineListSection( pTarget, list.computePipelines );
+        pTarget = writePipelineListSection( pTarget, list.data );
+        KEEN_ASSERT( pTarget == pData->getStart() + dataSize );
+
+        return ErrorId_Ok;
+    }
+
+    Result<void> vulkan::readPipelineList( VulkanPipelineList* pList, ConstMemoryBlock data )
+    {
+        KEEN_ASSERT( getPipelineListPipelineCount( *pList ) == 0u );
+
+        if( data.size < sizeof( VulkanPipelineListHeader ) )
+        {
+            return ErrorId_BufferTooSmall;
+        }
+
+        VulkanPipelineListHeader header;
+        copyMemoryNonOverlapping( &header, data.pStart, sizeof( header ) );
+        if( header.magic != VulkanPipelineListMagic )
+        {
+            return ErrorId_Generic;
+        }
+        if( header.version != VulkanPipelineListVersion )
+        {
+            return ErrorId_WrongVersion;
+        }
+
+        size_t sectionSize = 0u;
+        for( size_t i = 0u; i < VulkanPipelineListSection_Count; ++i )
+        {
+            // written by a build with different parameter structs:
+            if( header.elementSizes[ i ] != s_pipelineListElementSizes[ i ] )
+            {
+                return ErrorId_WrongVersion;
+            }
+            sectionSize += (size_t)header.elementSizes[ i ] * header.elementCounts[ i ];
+        }
+        if( data.size - sizeof( header ) < sectionSize )
+        {
+            return ErrorId_BufferTooSmall;
+        }
+
+        const uint8* pSource = data.pStart + sizeof( header );
+        if( !readPipelineListSection( &pList->descriptorSetLayouts, &pSource, header.elementCounts[ VulkanPipelineListSection_DescriptorSetLayouts ] ) ||
+            !readPipelineListSection( &pList->bindings, &pSource, header.elementCounts[ VulkanPipelineListSection_Bindings ] ) ||
+            !readPipelineListSection( &pList->staticSamplers, &pSource, header.elementCounts[ VulkanPipelineListSection_StaticSamplers ] ) ||
+            !readPipelineListSection( &pList->pipelineLayouts, &pSource, header.elementCounts[ VulkanPipelineListSection_PipelineLayouts ] ) ||
+            !readPipelineListSection( &pList->vertexFormats, &pSource, header.elementCounts[ VulkanPipelineListSection_VertexFormats ] ) ||
+            !readPipelineListSection( &pList->renderPipelines, &pSource, header.elementCounts[ VulkanPipelineListSection_RenderPipelines ] ) ||
+            !readPipelineListSection( &pList->computePipelines, &pSource, header.elementCounts[ VulkanPipelineListSection_ComputePipelines ] ) ||
+            !readPipelineListSection( &pList->data, &pSource, header.elementCounts[ VulkanPipelineListSection_Data ] ) )
+        {
+            clearPipelineList( pList );
+            return ErrorId_OutOfMemory;
+        }
+
+        if( !isPipelineListValid( *pList ) )
+        {
+            clearPipelineList( pList );
+            return ErrorId_Generic;
+        }
+
+        return ErrorId_Ok;
+    }
+
+    size_t vulkan::getPipelineListPipelineCount( const VulkanPipelineList& list )
+    {
+        return list.renderPipelines.getSize() + list.computePipelines.getSize();
+    }
+
+    void vulkan::getPipelineListDescriptorSetLayoutParameters( GraphicsDescriptorSetLayoutParameters* pParameters, const VulkanPipelineList& list, size_t layoutIndex )
+    {
+        const VulkanPipelineListDescriptorSetLayout& layout = list.descriptorSetLayouts[ layoutIndex ];
+
+        *pParameters = GraphicsDescriptorSetLayoutParameters{};
+        pParameters->debugName      = DebugName::createFormatted( "PipelineListSetLayout#%d", layoutIndex );
+        pParameters->bindings       = createArrayView( list.bindings.getStart() + layout.firstBinding, layout.bindingCount );
+        pParameters->staticSamplers = createArrayView( list.staticSamplers.getStart() + layout.firstStaticSampler, layout.staticSamplerCount );
+    }
+
+    void vulkan::getPipelineListPipelineLayoutParameters( GraphicsPipelineLayoutParameters* pParameters, const VulkanPipelineList& list, size_t layoutIndex )
+    {
+        const VulkanPipelineListPipelineLayout& layout = list.pipelineLayouts[ layoutIndex ];
+
+        *pParameters = GraphicsPipelineLayoutParameters{};
+        pParameters->descriptorSetLayoutCount       = layout.descriptorSetLayoutCount;
+        pParameters->pushConstantsStageMask.value   = layout.pushConstantsStageMask;
+        pParameters->pushConstantsSize              = layout.pushConstantsSize;
+        for( size_t i = 0u; i < GraphicsLimits_MaxPushConstantRangeCount; ++i )
+        {
+            pParameters->pushConstantRanges[ i ].stageMask.value    = layout.pushConstantRanges[ i ].stageMask;
+            pParameters->pushConstantRanges[ i ].offset             = layout.pushConstantRanges[ i ].offset;
+            pParameters->pushConstantRanges[ i ].size               = layout.pushConstantRanges[ i ].size;
+        }
+        pParameters->pushConstantRangeCount         = layout.pushConstantRangeCount;
+        pParameters->useBindlessDescriptors         = layout.useBindlessDescriptors != 0u;
+        pParameters->debugName                      = DebugName::createFormatted( "PipelineListLayout#%d", layoutIndex );
+    }
+
+    void vulkan::getPipelineListRenderPipelineParameters( GraphicsRenderPipelineParameters* pParameters, const VulkanPipelineList& list, size_t pipelineIndex )
+    {
+        const VulkanPipelineListRenderPipeline& pipeline = list.renderPipelines[ pipelineIndex ];
+
+        *pParameters = GraphicsRenderPipelineParameters{};
+        for( size_t i = 0u; i < GraphicsLimits_MaxColorTargetCount; ++i )
+        {
+            pParameters->renderTargetFormat.colorTargetFormats[ i ]         = (PixelFormat)pipeline.colorTargetFormats[ i ];
+            pParameters->colorWriteMask[ i ].value                          = pipeline.colorWriteMask[ i ];
+            pParameters->inputAttachmentIndices.colorInputIndices[ i ]      = pipeline.colorInputIndices[ i ];
+        }
+        pParameters->renderTargetFormat.depthStencilTargetFormat    = (PixelFormat)pipeline.depthStencilTargetFormat;
+        pParameters->viewMask                                       = pipeline.viewMask;
+        pParameters->constDepthBias                                 = pipeline.constDepthBias;
+        pParameters->slopeDepthBias                                 = pipeline.slopeDepthBias;
+
+        getPipelineListStencilParameters( &pParameters->frontStencil, pipeline.frontStencil );
+        getPipelineListStencilParameters( &pParameters->backStencil, pipeline.backStencil );
+        for( size_t stream = 0u; stream < GraphicsLimits_MaxVertexStreamCount - 1u; ++stream )
+        {
+            pParameters->additionalVertexStreams[ stream ].inputRate = (GraphicsVertexInputRate)pipeline.additionalVertexStreamInputRates[ stream ];
+        }
+        pParameters->additionalVertexStreamCount                    = pipeline.additionalVertexStreamCount;
+        pParameters->useDynamicVertexStrides                        = pipeline.useDynamicVertexStrides != 0u;
+        pParameters->primitiveType                                  = (GraphicsPrimitiveType)pipeline.primitiveType;
+        pParameters->patchSize                                      = pipeline.patchSize;
+        pParameters->cullMode                                       = (GraphicsCullMode)pipeline.cullMode;
+        pParameters->fillMode                                       = (GraphicsFillMode)pipeline.fillMode;
+        pParameters->windingOrder                                   = (GraphicsWindingOrder)pipeline.windingOrder;
+        pParameters->dynamicState.value                             = pipeline.dynamicState;
+        pParameters->sampleCount                                    = pipeline.sampleCount;
+        pParameters->blendOp                                        = (GraphicsBlendOperation)pipeline.blendOp;
+        pParameters->blendSourceFactor                              = (GraphicsBlendFactor)pipeline.blendSourceFactor;
+        pParameters->blendDestFactor                                = (GraphicsBlendFactor)pipeline.blendDestFactor;
+        pParameters->sampleShading                                  = pipeline.sampleShading != 0u;
+        pParameters->alphaToCoverage                                = pipeline.alphaToCoverage != 0u;
+        pParameters->depthComparisonFunction                        = (GraphicsComparisonFunction)pipeline.depthComparisonFunction;
+        pParameters->depthWriteEnabled                              = pipeline.depthWriteEnabled != 0u;
+        pParameters->enableScissorTest                              = pipeline.enableScissorTest != 0u;
+        pParameters->shadingRate                                    = (GraphicsShadingRate)pipeline.shadingRate;
+        pParameters->shadingRateCombiners[ 0u ]                     = (GraphicsShadingRateCombiner)pipeline.shadingRateCombiners[ 0u ];
+        pParameters->shadingRateCombiners[ 1u ]                     = (GraphicsShadingRateCombiner)pipeline.shadingRateCombiners[ 1u ];
+        pParameters->useShadingRateAttachment                       = pipeline.useShadingRateAttachment != 0u;
+        pParameters->isIndirectBindable                             = pipeline.isIndirectBindable != 0u;
+        pParameters->inputAttachmentIndices.isEnabled               = pipeline.inputAttachmentIndicesEnabled != 0u;
+        pParameters->inputAttachmentIndices.depthInputIndex         = pipeline.depthInputIndex;
+        pParameters->inputAttachmentIndices.stencilInputIndex       = pipeline.stencilInputIndex;
+        pParameters->entryPointId                                   = (GraphicsPipelineEntryPointId)pipeline.entryPointId;
+
+        pParameters->vertexShaderCode   = getPipelineListBlob( list, pipeline.shaderCode[ VulkanPipelineListRenderStage_Vertex ] );
+        pParameters->tcShaderCode       = getPipelineListBlob( list, pipeline.shaderCode[ VulkanPipelineListRenderStage_TessellationControl ] );
+        pParameters->teShaderCode       = getPipelineListBlob( list, pipeline.shaderCode[ VulkanPipelineListRenderStage_TessellationEvaluation ] );
+        pParameters->fragmentShaderCode = getPipelineListBlob( list, pipeline.shaderCode[ VulkanPipelineListRenderStage_Fragment ] );
+        pParameters->taskShaderCode     = getPipelineListBlob( list, pipeline.shaderCode[ VulkanPipelineListRenderStage_Task ] );
+        pParameters->meshShaderCode     = getPipelineListBlob( list, pipeline.shaderCode[ VulkanPipelineListRenderStage_Mesh ] );
+        pParameters->vsEntryPoint       = getPipelineListEntryPoint( list, pipeline.entryPoints[ VulkanPipelineListRenderStage_Vertex ] );
+        pParameters->tcEntryPoint       = getPipelineListEntryPoint( list, pipeline.entryPoints[ VulkanPipelineListRenderStage_TessellationControl ] );
+        pParameters->teEntryPoint       = getPipelineListEntryPoint( list, pipeline.entryPoints[ VulkanPipelineListRenderStage_TessellationEvaluation ] );
+        pParameters->fsEntryPoint       = getPipelineListEntryPoint( list, pipeline.entryPoints[ VulkanPipelineListRenderStage_Fragment ] );
+        pParameters->tsEntryPoint       = getPipelineListEntryPoint( list, pipeline.entryPoints[ VulkanPipelineListRenderStage_Task ] );
+        pParameters->msEntryPoint       = getPipelineListEntryPoint( list, pipeline.entryPoints[ VulkanPipelineListRenderStage_Mesh ] );
+        pParameters->pVertexFormat      = getPipelineListVertexFormat( list, pipeline.vertexFormatIndices[ 0u ] );
+        for( size_t stream = 1u; stream < GraphicsLimits_MaxVertexStreamCount; ++stream )
+        {
+            pParameters->additionalVertexStreams[ stream - 1u ].pFormat = getPipelineListVertexFormat( list, pipeline.vertexFormatIndices[ stream ] );
+        }
+        pParameters->debugName          = getPipelineListDebugName( list, pipeline.debugName );
+    }
+
+    void vulkan::getPipelineListComputePipelineParameters( GraphicsComputePipelineParameters* pParameters, const VulkanPipelineList& list, size_t pipelineIndex )
+    {
+        const VulkanPipelineListComputePipeline& pipeline = list.computePipelines[ pipelineIndex ];
+
+        *pParameters = GraphicsComputePipelineParameters{};
+        pParameters->shaderCode     = getPipelineListBlob( list, pipeline.shaderCode );
+        pParameters->entryPoint     = getPipelineListEntryPoint( list, pipeline.entryPoint );
+        pParameters->entryPointId   = (GraphicsPipelineEntryPointId)pipeline.entryPointId;
+        pParameters->debugName      = getPipelineListDebugName( list, pipeline.debugName );
+    }
+
+    uint64 vulkan::getPipelineListCompileCost( const VulkanPipelineList& list, size_t pipelineIndex )
+    {
+        if( pipelineIndex < list.renderPipelines.getSize() )
+        {
+            const VulkanPipelineListRenderPipeline& pipeline = list.renderPipelines[ pipelineIndex ];
+
+            uint64 cost = 0u;
+            for( size_t stage = 0u; stage < VulkanPipelineListRenderStage_Count; ++stage )
+            {
+                cost += getPipelineListBlobCost( pipeline.shaderCode[ stage ] );
+            }
+            return cost;
+        }
+
+        return getPipelineListBlobCost( list.computePipelines[ pipelineIndex - list.renderPipelines.getSize() ].shaderCode );
+    }
+
+    bool vulkan::splitPipelineList( VulkanPipelineCacheBuilderWork* pWork, MemoryAllocator* pAllocator, const VulkanPipelineList& list, uint32 workerCount )
+    {
+        KEEN_ASSERT( workerCount > 0u );
+
+        const size_t pipelineCount = getPipelineListPipelineCount( list );
+
+        pWork->pipelineWorkers.create( pAllocator );
+        pWork->workerCosts.create( pAllocator );
+        if( !pWork->pipelineWorkers.trySetCapacity( pipelineCount ) || !pWork->workerCosts.trySetCapacity( workerCount ) )
+        {
+            return false;
+        }
+        pWork->workerCosts.setSize( workerCount, 0u );
+
+        for( size_t pipelineIndex = 0u; pipelineIndex < pipelineCount; ++pipelineIndex )
+        {
+            uint32 workerIndex = 0u;
+            for( uint32 i = 1u; i < workerCount; ++i )
+            {
+                if( pWork->workerCosts[ i ] < pWork->workerCosts[ workerIndex ] )
+                {
+                    workerIndex = i;
+                }
+            }
+
+            // :JK: +1 so that pipelines without shader code (which shouldn't exist) are still distributed
+            pWork->workerCosts[ workerIndex ] += getPipelineListCompileCost( list, pipelineIndex ) + 1u;
+            pWork->pipelineWorkers.pushBack( workerIndex );
+        }
+
+        return true;
+    }
+
+    void vulkan::destroyPipelineCacheBuilderWork( VulkanPipelineCacheBuilderWork* pWork )
+    {
+        pWork->workerCosts.destroy();
+        pWork->pipelineWorkers.destroy();
+    }
+
+    Result<void> vulkan::compilePipelineList( GraphicsDevice* pDevice, MemoryAllocator* pAllocator, const VulkanPipelineList& list, const VulkanPipelineCacheBuilderWork& work, uint32 workerIndex )
+    {
+        KEEN_PROFILE_CPU( Vk_compilePipelineList );
+        KEEN_ASSERT( work.pipelineWorkers.getSize() == getPipelineListPipelineCount( list ) );
+
+        Array<GraphicsDescriptorSetLayout*> setLayouts;
+        Array<GraphicsPipelineLayout*> pipelineLayouts;
+        DynamicArray<GraphicsDeviceObject*> pipelines;
+        pipelines.create( pAllocator );
+        if( !setLayouts.tryCreateWithValue( pAllocator, list.descriptorSetLayouts.getSize(), nullptr ) ||
+            !pipelineLayouts.tryCreateWithValue( pAllocator, list.pipelineLayouts.getSize(), nullptr ) ||
+            !pipelines.trySetCapacity( work.pipelineWorkers.getSize() ) )
+        {
+            pipelines.destroy();
+            return ErrorId_OutOfMemory;
+        }
+
+        // the layouts are cheap - so every worker simply creates all of them:
+        ErrorId error = ErrorId_Ok;
+        for( size_t i = 0u; i < setLayouts.getSize(); ++i )
+        {
+            GraphicsDescriptorSetLayoutParameters parameters;
+            getPipelineListDescriptorSetLayoutParameters( &parameters, list, i );
+            setLayouts[ i ] = pDevice->createDescriptorSetLayout( parameters );
+            if( setLayouts[ i ] == nullptr )
+            {
+                error = ErrorId_Generic;
+            }
+        }
+
+        for( size_t i = 0u; i < pipelineLayouts.getSize() && error == ErrorId_Ok; ++i )
+        {
+            const VulkanPipelineListPipelineLayout& layout = list.pipelineLayouts[ i ];
+
+            GraphicsPipelineLayoutParameters parameters;
+            getPipelineListPipelineLayoutParameters( &parameters, list, i );
+            for( size_t setIndex = 0u; setIndex < parameters.descriptorSetLayoutCount; ++setIndex )
+            {
+                parameters.descriptorSetLayouts[ setIndex ] = setLayouts[ layout.setLayoutIndices[ setIndex ] ];
+            }
+
+            pipelineLayouts[ i ] = pDevice->createPipelineLayout( parameters );
+            if( pipelineLayouts[ i ] == nullptr )
+            {
+                error = ErrorId_Generic;
+            }
+        }
+
+        if( error != ErrorId_Ok )
+        {
+            KEEN_TRACE_ERROR( "[graphics] Could not create the pipeline layouts of the pipeline list\n" );
+        }
+
+        uint32 failedPipelineCount = 0u;
+        for( size_t pipelineIndex = 0u; pipelineIndex < work.pipelineWorkers.getSize() && error == ErrorId_Ok; ++pipelineIndex )
+        {
+            if( work.pipelineWorkers[ pipelineIndex ] != workerIndex )
+            {
+                continue;
+            }
+
+            GraphicsDeviceObject* pPipeline = nullptr;
+            DebugName debugName;
+            if( pipelineIndex < list.renderPipelines.getSize() )
+            {
+                GraphicsRenderPipelineParameters parameters;
+                getPipelineListRenderPipelineParameters( &parameters, list, pipelineIndex );
+                parameters.pPipelineLayout = pipelineLayouts[ list.renderPipelines[ pipelineIndex ].pipelineLayoutIndex ];
+                debugName = parameters.debugName;
+
+                pPipeline = pDevice->createRenderPipeline( parameters );
+            }
+            else
+            {
+                const size_t computePipelineIndex = pipelineIndex - list.renderPipelines.getSize();
+
+                GraphicsComputePipelineParameters parameters;
+                getPipelineListComputePipelineParameters( &parameters, list, computePipelineIndex );
+                parameters.pPipelineLayout = pipelineLayouts[ list.computePipelines[ computePipelineIndex ].pipelineLayoutIndex ];
+                debugName = parameters.debugName;
+
+                pPipeline = pDevice->createComputePipeline( parameters );
+            }
+
+            if( pPipeline == nullptr )
+            {
+                KEEN_TRACE_WARNING( "[graphics] Could not compile pipeline '%k' of the pipeline list\n", debugName );
+                failedPipelineCount++;
+                continue;
+            }
+            pipelines.pushBack( pPipeline );
+        }
+
+        KEEN_TRACE_INFO( "[graphics] Pipeline cache worker %d compiled %d pipelines (%d failed)\n", workerIndex, pipelines.getCount(), failedPipelineCount );
+
+        // pipelines first - the layouts are still referenced by them:
+        for( size_t i = 0u; i < pipelineLayouts.getSize(); ++i )
+        {
+            if( pipelineLayouts[ i ] != nullptr )
+            {
+                pipelines.pushBack( pipelineLayouts[ i ] );
+            }
+        }
+        for( size_t i = 0u; i < setLayouts.getSize(); ++i )
+        {
+            if( setLayouts[ i ] != nullptr )
+            {
+                pipelines.pushBack( setLayouts[ i ] );
+            }
+        }
+        pDevice->waitForGpuIdle( pipelines );
+        pipelines.destroy();
+
+        if( error == ErrorId_Ok && failedPipelineCount > 0u )
+        {
+            error = ErrorId_Generic;
+        }
+        return error;
+    }
+
+    void vulkan::fillPipelineCacheHeader( VulkanPipelineCacheHeader* pHeader, const VkPhysicalDeviceProperties& deviceProperties, ConstMemoryBlock cacheData )
+    {
+        pHeader->magic          = VulkanPipelineCacheHeaderMagic;
+        pHeader->headerVersion  = VulkanPipelineCacheHeaderVersion;
+        pHeader->dataSize       = rangecheck_cast<uint32>( cacheData.size );
+        pHeader->dataHash       = calculateFnv1a32Hash( cacheData.pStart, cacheData.size ).value;
+
+        pHeader->driverVersion  = deviceProperties.driverVersion;
+        pHeader->deviceId       = deviceProperties.deviceID;
+        pHeader->vendorId       = deviceProperties.vendorID;
+        pHeader->driverABI      = sizeof( void* );
+        copyMemoryBlockNonOverlapping( pHeader->uuid.getMemory(), createConstMemoryBlockFromArray( deviceProperties.pipelineCacheUUID ) );
+    }
+
+    Result<ConstMemoryBlock> vulkan::getPipelineCacheFileData( ConstMemoryBlock fileData, const VkPhysicalDeviceProperties& deviceProperties )
+    {
+        if( fileData.size < sizeof( VulkanPipelineCacheHeader ) )
+        {
+            return ErrorId_BufferTooSmall;
+        }
+
+        VulkanPipelineCacheHeader header;
+        copyMemoryNonOverlapping( &header, fileData.pStart, sizeof( header ) );
+        if( header.magic != VulkanPipelineCacheHeaderMagic )
+        {
+            return ErrorId_Generic;
+        }
+        if( header.headerVersion != VulkanPipelineCacheHeaderVersion ||
+            header.vendorId != deviceProperties.vendorID ||
+            header.deviceId != deviceProperties.deviceID ||
+            header.driverVersion != deviceProperties.driverVersion ||
+            header.driverABI != sizeof( void* ) ||
+            !isMemoryBlockEqual( header.uuid.getConstMemory(), createConstMemoryBlockFromArray( deviceProperties.pipelineCacheUUID ) ) )
+        {
+            return ErrorId_WrongVersion;
+        }
+        if( fileData.size - sizeof( header ) < header.dataSize )
+        {
+            return ErrorId_BufferTooSmall;
+        }
+
+        const ConstMemoryBlock cacheData = createConstMemoryBlock( fileData.pStart + sizeof( header ), header.dataSize );
+        if( calculateFnv1a32Hash( cacheData.pStart, cacheData.size ).value != header.dataHash )
+        {
+            return ErrorId_Generic;
+        }
+        return cacheData;
+    }
+
+    Result<void> vulkan::mergePipelineCacheFiles( VulkanPipelineCacheMergeResult* pResult, VulkanApi* pVulkan, VkDevice device, VkPipelineCache targetCache, const VkPhysicalDeviceProperties& deviceProperties, ArrayView<const ConstMemoryBlock> cacheFiles, const VkAllocationCallbacks* pAllocationCallbacks )
+    {
+        KEEN_PROFILE_CPU( Vk_mergePipelineCacheFiles );
+        KEEN_ASSERT( targetCache != VK_NULL_HANDLE );
+
+        zeroValue( pResult );
+
+        TlsStackAllocatorScope stackAllocator;
+
+        Array<VkPipelineCache> sourceCaches;
+        if( !sourceCaches.tryCreateWithValue( &stackAllocator, cacheFiles.getSize(), VK_NULL_HANDLE ) )
+        {
+            return ErrorId_OutOfMemory;
+        }
+
+        uint32 sourceCacheCount = 0u;
+        for( size_t i = 0u; i < cacheFiles.getSize(); ++i )
+        {
+            const Result<ConstMemoryBlock> dataResult = getPipelineCacheFileData( cacheFiles[ i ], deviceProperties );
+            if( dataResult.hasError() )
+            {
+                KEEN_TRACE_WARNING( "[graphics] Skipping pipeline cache %d: it was not written for this device and driver (error=%k)\n", i, dataResult.getError() );
+                pResult->skippedCacheCount++;
+                continue;
+            }
+
+            VkPipelineCacheCreateInfo createInfo = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+            createInfo.initialDataSize  = dataResult.getValue().size;
+            createInfo.pInitialData     = dataResult.getValue().pStart;
+
+            VkPipelineCache sourceCache = VK_NULL_HANDLE;
+            const VulkanResult createResult = pVulkan->vkCreatePipelineCache( device, &createInfo, pAllocationCallbacks, &sourceCache );
+            if( createResult.hasError() )
+            {
+                KEEN_TRACE_WARNING( "[graphics] Skipping pipeline cache %d: vkCreatePipelineCache failed with error '%s'\n", i, createResult );
+                pResult->skippedCacheCount++;
+                continue;
+            }
+
+            sourceCaches[ sourceCacheCount++ ]  = sourceCache;
+            pResult->mergedDataSize             += createInfo.initialDataSize;
+        }
+
+        VulkanResult mergeResult( VK_SUCCESS );
+        if( sourceCacheCount > 0u )
+        {
+            mergeResult = pVulkan->vkMergePipelineCaches( device, targetCache, sourceCacheCount, sourceCaches.getStart() );
+        }
+
+        for( uint32 i = 0u; i < sourceCacheCount; ++i )
+        {
+            pVulkan->vkDestroyPipelineCache( device, sourceCaches[ i ], pAllocationCallbacks );
+        }
+
+        if( mergeResult.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkMergePipelineCaches failed with error '%s'\n", mergeResult );
+            pResult->mergedDataSize = 0u;
+            return mergeResult.getErrorId();
+        }
+
+        pResult->mergedCacheCount = sourceCacheCount;
+        return ErrorId_Ok;
+    }
+
+    Result<void> vulkan::mergePipelineBinaryArchiveFiles( VulkanPipelineCacheMergeResult* pResult, VulkanPipelineBinaryArchive* pTargetArchive, MemoryAllocator* pAllocator, ArrayView<const ConstMemoryBlock> archiveFiles )
+    {
+        KEEN_PROFILE_CPU( Vk_mergePipelineBinaryArchiveFiles );
+
+        zeroValue( pResult );
+
+        for( size_t i = 0u; i < archiveFiles.getSize(); ++i )
+        {
+            VulkanPipelineBinaryArchive sourceArchive;
+            createPipelineBinaryArchive( &sourceArchive, pAllocator, pTargetArchive->globalKey );
+
+            const Result<void> readResult = readPipelineBinaryArchive( &sourceArchive, archiveFiles[ i ] );
+            if( readResult.hasError() )
+            {
+                KEEN_TRACE_WARNING( "[graphics] Skipping pipeline binary archive %d: it was not written for this device and driver (error=%k)\n", i, readResult.getError() );
+                destroyPipelineBinaryArchive( &sourceArchive );
+                pResult->skippedCacheCount++;
+                continue;
+            }
+
+            for( size_t recordIndex = 0u; recordIndex < sourceArchive.records.getSize(); ++recordIndex )
+            {
+                const VulkanPipelineBinaryRecord& record = sourceArchive.records[ recordIndex ];
+
+                VulkanPipelineBinaryKey binaryKeys[ VulkanMaxPipelineBinaryCount ];
+                ConstMemoryBlock binaryData[ VulkanMaxPipelineBinaryCount ];
+                for( size_t binaryIndex = 0u; binaryIndex < record.binaryCount; ++binaryIndex )
+                {
+                    const VulkanPipelineBinary& binary = record.binaries[ binaryIndex ];
+                    binaryKeys[ binaryIndex ] = binary.key;
+                    binaryData[ binaryIndex ] = createConstMemoryBlock( sourceArchive.data.getStart() + binary.dataOffset, rangecheck_cast<size_t>( binary.dataSize ) );
+                    pResult->mergedDataSize += binaryData[ binaryIndex ].size;
+                }
+
+                if( !addPipelineBinaryRecord( pTargetArchive, record.pipelineHash, record.pipelineKey, createArrayView( binaryKeys, record.binaryCount ), createArrayView( binaryData, record.binaryCount ) ) )
+                {
+                    destroyPipelineBinaryArchive( &sourceArchive );
+                    pResult->mergedDataSize = 0u;
+                    return ErrorId_OutOfMemory;
+                }
+            }
+
+            destroyPipelineBinaryArchive( &sourceArchive );
+            pResult->mergedCacheCount++;
+        }
+
+        return ErrorId_Ok;
+    }
+
+    uint32 vulkan::runPipelineCacheWorkers( DynamicArray<ConstMemoryBlock>* pWorkerFiles, const VulkanPipelineCacheWorkerLauncher& launcher, uint32 workerCount )
+    {
+        KEEN_PROFILE_CPU( Vk_runPipelineCacheWorkers );
+        KEEN_ASSERT( workerCount > 0u );
+
+        // :JK: all workers run at the same time - every worker splits the list itself and only compiles its part
+        uint32 failedWorkerCount = 0u;
+        uint32 startedWorkerCount = 0u;
+        for( ; startedWorkerCount < workerCount; ++startedWorkerCount )
+        {
+            if( !launcher.pStartWorker( launcher.pUserData, startedWorkerCount, workerCount ) )
+            {
+                KEEN_TRACE_ERROR( "[graphics] Could not start pipeline cache worker %d\n", startedWorkerCount );
+                break;
+            }
+        }
+        failedWorkerCount += workerCount - startedWorkerCount;
+
+        for( uint32 workerIndex = 0u; workerIndex < startedWorkerCount; ++workerIndex )
+        {
+            const ConstMemoryBlock workerFile = launcher.pWaitForWorker( launcher.pUserData, workerIndex );
+            if( !isConstMemoryBlockValid( workerFile ) || pWorkerFiles->pushBack( workerFile ) == nullptr )
+            {
+                KEEN_TRACE_ERROR( "[graphics] Pipeline cache worker %d failed\n", workerIndex );
+                failedWorkerCount++;
+            }
+        }
+
+        return failedWorkerCount;
+    }
+
+}
@@ -0,0 +1,247 @@
+#ifndef KEEN_VULKAN_PIPELINE_CACHE_BUILDER_HPP_INCLUDED
+#define KEEN_VULKAN_PIPELINE_CACHE_BUILDER_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+#include "vulkan_pipeline_binary.hpp"
+#include "keen/base/map.hpp"
+#include "keen/base/static_array.hpp"
+
+namespace keen
+{
+    class GraphicsDevice;
+
+    constexpr fourcc VulkanPipelineCacheHeaderMagic = "VKPC"_4cc;
+    constexpr uint64 VulkanPipelineCacheHeaderVersion = 3ull;
+
+    // the header in front of the vkGetPipelineCacheData blob in vk_pipeline_cache.bin:
+    struct VulkanPipelineCacheHeader
+    {
+        uint32                              magic;              // VulkanPipelineCacheHeaderMagic
+        uint32                              dataSize;           // equal to *pDataSize returned by vkGetPipelineCacheData
+        uint64                              headerVersion;      // random seed VulkanPipelineCacheHeaderVersion
+        uint64                              dataHash;           // a hash of pipeline cache data
+
+        uint32                              vendorId;           // equal to VkPhysicalDeviceProperties::vendorID
+        uint32                              deviceId;           // equal to VkPhysicalDeviceProperties::deviceID
+        uint32                              driverVersion;      // equal to VkPhysicalDeviceProperties::driverVersion
+        uint32                              driverABI;          // equal to sizeof(void*)
+
+        StaticArray<uint8, VK_UUID_SIZE>    uuid;               // equal to VkPhysicalDeviceProperties::pipelineCacheUUID
+    };
+
+    constexpr uint32 VulkanInvalidPipelineListIndex = 0xffffffffu;
+
+    // a range in VulkanPipelineList::data. shader code and strings are stored only once:
+    struct VulkanPipelineListBlob
+    {
+        uint32                              offset;
+        uint32                              size;               // VulkanInvalidPipelineListIndex for an invalid memory block
+    };
+
+    struct VulkanPipelineListDescriptorSetLayout
+    {
+        uint32                              firstBinding;
+        uint32                              bindingCount;
+        uint32                              firstStaticSampler;
+        uint32                              staticSamplerCount;
+    };
+
+    struct VulkanPipelineListPushConstantRange
+    {
+        uint16                              stageMask;
+        uint16                              offset;
+        uint16                              size;
+    };
+
+    struct VulkanPipelineListPipelineLayout
+    {
+        uint32                              setLayoutIndices[ GraphicsLimits_MaxDescriptorSetSlotCount ];
+        uint32                              descriptorSetLayoutCount;
+        uint32                              pushConstantRangeCount;
+        VulkanPipelineListPushConstantRange pushConstantRanges[ GraphicsLimits_MaxPushConstantRangeCount ];
+        uint16                              pushConstantsStageMask;
+        uint16                              pushConstantsSize;
+        uint8                               useBindlessDescriptors;
+    };
+
+    enum VulkanPipelineListRenderStage
+    {
+        VulkanPipelineListRenderStage_Vertex,
+        VulkanPipelineListRenderStage_TessellationControl,
+        VulkanPipelineListRenderStage_TessellationEvaluation,
+        VulkanPipelineListRenderStage_Fragment,
+        VulkanPipelineListRenderStage_Task,
+        VulkanPipelineListRenderStage_Mesh,
+
+        VulkanPipelineListRenderStage_Count
+    };
+
+    struct VulkanPipelineListStencilState
+    {
+        uint8                               testMask;
+        uint8                               writeMask;
+        uint8                               testEnabled;
+        uint8                               testFunc;
+        uint8                               opFail;
+        uint8                               opDepthFail;
+        uint8                               opDepthPass;
+    };
+
+    // the fields of GraphicsRenderPipelineParameters without the pointers (the enums are stored with their values):
+    struct VulkanPipelineListRenderPipeline
+    {
+        uint32                              pipelineLayoutIndex;
+        uint32                              vertexFormatIndices[ GraphicsLimits_MaxVertexStreamCount ];    // per vertex stream - VulkanInvalidPipelineListIndex if the stream has no vertex format
+        VulkanPipelineListBlob              shaderCode[ VulkanPipelineListRenderStage_Count ];
+        VulkanPipelineListBlob              entryPoints[ VulkanPipelineListRenderStage_Count ];
+        VulkanPipelineListBlob              debugName;
+
+        uint32                              colorTargetFormats[ GraphicsLimits_MaxColorTargetCount ];
+        uint32                              depthStencilTargetFormat;
+        uint32                              viewMask;
+        float32                             constDepthBias;
+        float32                             slopeDepthBias;
+
+        VulkanPipelineListStencilState      frontStencil;
+        VulkanPipelineListStencilState      backStencil;
+        uint8                               additionalVertexStreamInputRates[ GraphicsLimits_MaxVertexStreamCount - 1u ];
+        uint8                               additionalVertexStreamCount;
+        uint8                               useDynamicVertexStrides;
+        uint8                               primitiveType;
+        uint8                               patchSize;
+        uint8                               cullMode;
+        uint8                               fillMode;
+        uint8                               windingOrder;
+        uint8                               dynamicState;
+        uint8                               sampleCount;
+        uint8                               colorWriteMask[ GraphicsLimits_MaxColorTargetCount ];
+        uint8                               blendOp;
+        uint8                               blendSourceFactor;
+        uint8                               blendDestFactor;
+        uint8                               sampleShading;
+        uint8                               alphaToCoverage;
+        uint8                               depthComparisonFunction;
+        uint8                               depthWriteEnabled;
+        uint8                               enableScissorTest;
+        uint8                               shadingRate;
+        uint8                               shadingRateCombiners[ 2u ];
+        uint8                               useShadingRateAttachment;
+        uint8                               isIndirectBindable;
+        uint8                               inputAttachmentIndicesEnabled;
+        uint8                               colorInputIndices[ GraphicsLimits_MaxColorTargetCount ];
+        uint8                               depthInputIndex;
+        uint8                               stencilInputIndex;
+        uint8                               entryPointId;
+    };
+
+    struct VulkanPipelineListComputePipeline
+    {
+        uint32                              pipelineLayoutIndex;
+        VulkanPipelineListBlob              shaderCode;
+        VulkanPipelineListBlob              entryPoint;
+        VulkanPipelineListBlob              debugName;
+        uint8                               entryPointId;
+    };
+
+    // all pipelines (and the layouts they need) that are compiled into the offline pipeline cache. written by the game, read by the cache builder.
+    // :JK: the layouts and pipelines are converted field by field into the records above (zeroed first, so the padding is deterministic). only
+    // the pointer free value structs (bindings, samplers, vertex formats) are stored as they are - the header stores the element sizes to catch a mismatch
+    struct VulkanPipelineList
+    {
+        DynamicArray<VulkanPipelineListDescriptorSetLayout> descriptorSetLayouts;
+        DynamicArray<GraphicsDescriptorSetLayoutBinding>    bindings;
+        DynamicArray<GraphicsSamplerParameters>             staticSamplers;
+        DynamicArray<VulkanPipelineListPipelineLayout>      pipelineLayouts;
+        DynamicArray<VertexFormat>                          vertexFormats;
+        DynamicArray<VulkanPipelineListRenderPipeline>      renderPipelines;
+        DynamicArray<VulkanPipelineListComputePipeline>     computePipelines;
+        DynamicArray<uint8>                                 data;
+
+        Map<HashKey64, VulkanPipelineListBlob>              blobs;  // only used while adding
+    };
+
+    // what a worker process has to do: pipeline indices are render pipelines first, then compute pipelines
+    struct VulkanPipelineCacheBuilderWork
+    {
+        DynamicArray<uint32>                pipelineWorkers;    // worker index per pipeline
+        DynamicArray<uint64>                workerCosts;        // estimated compile cost per worker
+    };
+
+    struct VulkanPipelineCacheMergeResult
+    {
+        uint32                              mergedCacheCount;
+        uint32                              skippedCacheCount;  // invalid or from a different device/driver
+        size_t                              mergedDataSize;     // sum of the merged blobs (without headers)
+    };
+
+    // starts worker workerIndex of workerCount - usually the game executable with a command line that makes it read the pipeline list,
+    // call compilePipelineList and shut the device down (which writes the cache file of the worker):
+    typedef bool( *VulkanStartPipelineCacheWorkerFunction )( void* pUserData, uint32 workerIndex, uint32 workerCount );
+
+    // waits until the worker exited and returns the file its device wrote (vk_pipeline_cache.bin or vk_pipeline_binaries.bin if the device
+    // uses pipeline binaries). an invalid block if the worker failed - the memory has to stay valid until the files are merged:
+    typedef ConstMemoryBlock( *VulkanWaitForPipelineCacheWorkerFunction )( void* pUserData, uint32 workerIndex );
+
+    struct VulkanPipelineCacheWorkerLauncher
+    {
+        VulkanStartPipelineCacheWorkerFunction      pStartWorker;
+        VulkanWaitForPipelineCacheWorkerFunction    pWaitForWorker;
+        void*                                       pUserData;
+    };
+
+    namespace vulkan
+    {
+
+        void            createPipelineList( VulkanPipelineList* pList, MemoryAllocator* pAllocator );
+        void            destroyPipelineList( VulkanPipelineList* pList );
+
+        // the add functions return the index to reference the object (or VulkanInvalidPipelineListIndex if out of memory):
+        uint32          addPipelineListDescriptorSetLayout( VulkanPipelineList* pList, const GraphicsDescriptorSetLayoutParameters& parameters );
+        uint32          addPipelineListPipelineLayout( VulkanPipelineList* pList, const GraphicsPipelineLayoutParameters& parameters, ArrayView<const uint32> setLayoutIndices );
+        uint32          addPipelineListVertexFormat( VulkanPipelineList* pList, const VertexFormat& vertexFormat );
+        uint32          addPipelineListRenderPipeline( VulkanPipelineList* pList, const GraphicsRenderPipelineParameters& parameters, uint32 pipelineLayoutIndex, ArrayView<const uint32> vertexFormatIndices );
+        uint32          addPipelineListComputePipeline( VulkanPipelineList* pList, const GraphicsComputePipelineParameters& parameters, uint32 pipelineLayoutIndex );
+
+        Result<void>    writePipelineList( Array<uint8>* pData, MemoryAllocator* pAllocator, const VulkanPipelineList& list );
+
+        // the list has to be empty:
+        Result<void>    readPipelineList( VulkanPipelineList* pList, ConstMemoryBlock data );
+
+        size_t          getPipelineListPipelineCount( const VulkanPipelineList& list );
+
+        // the returned parameters point into the list - the pointer members have to be filled by the caller (see compilePipelineList):
+        void            getPipelineListDescriptorSetLayoutParameters( GraphicsDescriptorSetLayoutParameters* pParameters, const VulkanPipelineList& list, size_t layoutIndex );
+        void            getPipelineListPipelineLayoutParameters( GraphicsPipelineLayoutParameters* pParameters, const VulkanPipelineList& list, size_t layoutIndex );
+        void            getPipelineListRenderPipelineParameters( GraphicsRenderPipelineParameters* pParameters, const VulkanPipelineList& list, size_t pipelineIndex );
+        void            getPipelineListComputePipelineParameters( GraphicsComputePipelineParameters* pParameters, const VulkanPipelineList& list, size_t pipelineIndex );
+
+        // estimated compile cost of a pipeline (the size of the shader code):
+        uint64          getPipelineListCompileCost( const VulkanPipelineList& list, size_t pipelineIndex );
+
+        // assigns every pipeline to one of the workers - each pipeline goes to the worker with the smallest cost so far:
+        bool            splitPipelineList( VulkanPipelineCacheBuilderWork* pWork, MemoryAllocator* pAllocator, const VulkanPipelineList& list, uint32 workerCount );
+        void            destroyPipelineCacheBuilderWork( VulkanPipelineCacheBuilderWork* pWork );
+
+        // worker: creates all pipelines of the worker on the device. the pipeline cache of the device is written on shutdown as usual:
+        Result<void>    compilePipelineList( GraphicsDevice* pDevice, MemoryAllocator* pAllocator, const VulkanPipelineList& list, const VulkanPipelineCacheBuilderWork& work, uint32 workerIndex );
+
+        void            fillPipelineCacheHeader( VulkanPipelineCacheHeader* pHeader, const VkPhysicalDeviceProperties& deviceProperties, ConstMemoryBlock cacheData );
+
+        // returns the vkGetPipelineCacheData blob of a vk_pipeline_cache.bin file - or an error if the file was not written for this device + driver:
+        Result<ConstMemoryBlock>    getPipelineCacheFileData( ConstMemoryBlock fileData, const VkPhysicalDeviceProperties& deviceProperties );
+
+        // merges the vk_pipeline_cache.bin files of all workers into targetCache. invalid files are skipped:
+        Result<void>    mergePipelineCacheFiles( VulkanPipelineCacheMergeResult* pResult, VulkanApi* pVulkan, VkDevice device, VkPipelineCache targetCache, const VkPhysicalDeviceProperties& deviceProperties, ArrayView<const ConstMemoryBlock> cacheFiles, const VkAllocationCallbacks* pAllocationCallbacks );
+
+        // same for devices that use pipeline binaries instead of a VkPipelineCache: merges the vk_pipeline_binaries.bin files of all workers
+        // into pTargetArchive. files that were written with a different global key (other device or driver) are skipped:
+        Result<void>    mergePipelineBinaryArchiveFiles( VulkanPipelineCacheMergeResult* pResult, VulkanPipelineBinaryArchive* pTargetArchive, MemoryAllocator* pAllocator, ArrayView<const ConstMemoryBlock> archiveFiles );
+
+        // starts all workers and waits until they are done. pWorkerFiles gets the file of every worker that succeeded - returns the number of failed workers:
+        uint32          runPipelineCacheWorkers( DynamicArray<ConstMemoryBlock>* pWorkerFiles, const VulkanPipelineCacheWorkerLauncher& launcher, uint32 workerCount );
+
+    }
+
+}
+
+#endif
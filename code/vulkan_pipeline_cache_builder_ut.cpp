@@ -0,0 +1,454 @@
+#include "vulkan_pipeline_cache_builder.hpp"
+#include "vulkan_stub_api_ut.hpp"
+
+#include "keen/base/array.hpp"
+#include "keen/base/tls_allocator_scope.hpp"
+
+
+namespace keen
+{
+    struct VulkanRecordedPipelineCacheCalls
+    {
+        uint32                  createCount;
+        uint32                  destroyCount;
+        uint32                  mergeCount;
+        uint32                  mergedSourceCount;
+        size_t                  createdDataSize;
+        VkPipelineCache         mergeTarget;
+    };
+
+    static VulkanRecordedPipelineCacheCalls s_recordedCalls;
+
+    static VKAPI_ATTR VkResult VKAPI_CALL recordCreatePipelineCache( VkDevice, const VkPipelineCacheCreateInfo* pCreateInfo, const VkAllocationCallbacks*, VkPipelineCache* pPipelineCache )
+    {
+        s_recordedCalls.createCount++;
+        s_recordedCalls.createdDataSize += pCreateInfo->initialDataSize;
+        *pPipelineCache = (VkPipelineCache)(uintptr_t)( 0x100u + s_recordedCalls.createCount );
+        return VK_SUCCESS;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordDestroyPipelineCache( VkDevice, VkPipelineCache, const VkAllocationCallbacks* )
+    {
+        s_recordedCalls.destroyCount++;
+    }
+
+    static VKAPI_ATTR VkResult VKAPI_CALL recordMergePipelineCaches( VkDevice, VkPipelineCache dstCache, uint32_t srcCacheCount, const VkPipelineCache* pSrcCaches )
+    {
+        s_recordedCalls.mergeCount++;
+        s_recordedCalls.mergedSourceCount   += srcCacheCount;
+        s_recordedCalls.mergeTarget         = dstCache;
+        for( uint32 i = 0u; i < srcCacheCount; ++i )
+        {
+            if( pSrcCaches[ i ] == VK_NULL_HANDLE )
+            {
+                return VK_ERROR_INITIALIZATION_FAILED;
+            }
+        }
+        return VK_SUCCESS;
+    }
+
+    // the launcher of runPipelineCacheWorkers - the worker failingWorkerIndex doesn't produce a file:
+    struct VulkanRecordedWorkerCalls
+    {
+        uint32                  startCount;
+        uint32                  waitCount;
+        uint32                  workerCount;
+        uint32                  failingWorkerIndex;
+        uint8                   workerFiles[ 4u ][ 16u ];
+    };
+
+    static VulkanRecordedWorkerCalls s_recordedWorkerCalls;
+
+    static bool recordStartWorker( void* pUserData, uint32 workerIndex, uint32 workerCount )
+    {
+        KEEN_UNUSED1( pUserData );
+        KEEN_ASSERT( workerIndex == s_recordedWorkerCalls.startCount );
+        s_recordedWorkerCalls.startCount++;
+        s_recordedWorkerCalls.workerCount = workerCount;
+        return true;
+    }
+
+    static ConstMemoryBlock recordWaitForWorker( void* pUserData, uint32 workerIndex )
+    {
+        KEEN_UNUSED1( pUserData );
+        s_recordedWorkerCalls.waitCount++;
+        if( workerIndex == s_recordedWorkerCalls.failingWorkerIndex )
+        {
+            return InvalidConstMemoryBlock;
+        }
+        return createConstMemoryBlockFromArray( s_recordedWorkerCalls.workerFiles[ workerIndex ] );
+    }
+
+    class VulkanPipelineCacheBuilderTestFixture : public VulkanStubApiTestFixture
+    {
+    public:
+        VulkanPipelineCacheBuilderTestFixture()
+        {
+            m_vulkan.vkCreatePipelineCache  = recordCreatePipelineCache;
+            m_vulkan.vkDestroyPipelineCache = recordDestroyPipelineCache;
+            m_vulkan.vkMergePipelineCaches  = recordMergePipelineCaches;
+
+            zeroValue( &m_deviceProperties );
+            m_deviceProperties.vendorID         = 0x1002u;
+            m_deviceProperties.deviceID         = 0x73bfu;
+            m_deviceProperties.driverVersion    = 0x00800010u;
+            for( size_t i = 0u; i < VK_UUID_SIZE; ++i )
+            {
+                m_deviceProperties.pipelineCacheUUID[ i ] = (uint8)( 0x40u + i );
+            }
+
+            // :JK: the shader code is never looked at
+            for( size_t i = 0u; i < KEEN_COUNTOF( m_vertexShaderCode ); ++i )
+            {
+                m_vertexShaderCode[ i ]     = (uint8)i;
+                m_fragmentShaderCode[ i ]   = (uint8)( 255u - i );
+                m_computeShaderCode[ i ]    = (uint8)( i * 3u );
+            }
+
+            m_bindings[ 0u ].type                       = GraphicsDescriptorType::UniformBuffer;
+            m_bindings[ 0u ].stageMask                  = GraphicsPipelineStageMask{ GraphicsPipelineStage::Vertex };
+            m_bindings[ 1u ].type                       = GraphicsDescriptorType::StructuredBuffer;
+            m_bindings[ 1u ].stageMask                  = GraphicsPipelineStageMask{ GraphicsPipelineStage::Compute };
+            m_bindings[ 1u ].arraySizeOrBufferStride    = 16u;
+        }
+
+    protected:
+        VkPhysicalDeviceProperties              m_deviceProperties;
+        uint8                                   m_vertexShaderCode[ 64u ];
+        uint8                                   m_fragmentShaderCode[ 64u ];
+        uint8                                   m_computeShaderCode[ 64u ];
+        GraphicsDescriptorSetLayoutBinding      m_bindings[ 2u ];
+
+        void fillPipelineList( VulkanPipelineList* pList )
+        {
+            GraphicsDescriptorSetLayoutParameters setLayoutParameters;
+            setLayoutParameters.bindings = m_bindings;
+            const uint32 setLayoutIndex = vulkan::addPipelineListDescriptorSetLayout( pList, setLayoutParameters );
+
+            GraphicsPipelineLayoutParameters layoutParameters;
+            layoutParameters.descriptorSetLayouts[ 0u ] = (const GraphicsDescriptorSetLayout*)this;
+            layoutParameters.descriptorSetLayoutCount   = 1u;
+            layoutParameters.pushConstantsSize          = 16u;
+            layoutParameters.pushConstantRanges[ 0u ]   = { GraphicsPipelineStageMask{ GraphicsPipelineStage::Fragment }, 16u, 8u };
+            layoutParameters.pushConstantRangeCount     = 1u;
+            const uint32 layoutIndex = vulkan::addPipelineListPipelineLayout( pList, layoutParameters, createArrayView( &setLayoutIndex, 1u ) );
+
+            // two permutations with the same shaders + one compute pipeline:
+            GraphicsRenderPipelineParameters renderParameters;
+            renderParameters.vertexShaderCode   = createConstMemoryBlockFromArray( m_vertexShaderCode );
+            renderParameters.fragmentShaderCode = createConstMemoryBlockFromArray( m_fragmentShaderCode );
+            renderParameters.vsEntryPoint       = { "mainVS", 6u };
+            renderParameters.pPipelineLayout    = (const GraphicsPipelineLayout*)this;
+            renderParameters.setRenderTargetFormat( PixelFormat::R8G8B8A8_unorm, PixelFormat::D32_sfloat );
+            renderParameters.setRasterizerState( GraphicsCullMode::Front, GraphicsFillMode::Solid, GraphicsWindingOrder::Ccw );
+            renderParameters.frontStencil.set( true, GraphicsComparisonFunction::Equal, 0x0fu, 0xf0u, GraphicsStencilOperation::Keep, GraphicsStencilOperation::Keep, GraphicsStencilOperation::Replace );
+            renderParameters.slopeDepthBias     = 1.5f;
+            renderParameters.viewMask           = 3u;
+            vulkan::addPipelineListRenderPipeline( pList, renderParameters, layoutIndex, {} );
+
+            renderParameters.setRasterizerState( GraphicsCullMode::None, GraphicsFillMode::Wireframe, GraphicsWindingOrder::Ccw );
+            vulkan::addPipelineListRenderPipeline( pList, renderParameters, layoutIndex, {} );
+
+            GraphicsComputePipelineParameters computeParameters;
+            computeParameters.shaderCode        = createConstMemoryBlockFromArray( m_computeShaderCode );
+            computeParameters.pPipelineLayout   = (const GraphicsPipelineLayout*)this;
+            vulkan::addPipelineListComputePipeline( pList, computeParameters, layoutIndex );
+        }
+
+        ConstMemoryBlock createCacheFile( uint8* pFile, size_t fileSize, const VkPhysicalDeviceProperties& deviceProperties, uint8 fillValue )
+        {
+            KEEN_ASSERT( fileSize > sizeof( VulkanPipelineCacheHeader ) );
+            for( size_t i = sizeof( VulkanPipelineCacheHeader ); i < fileSize; ++i )
+            {
+                pFile[ i ] = fillValue;
+            }
+
+            VulkanPipelineCacheHeader header;
+            zeroValue( &header );
+            vulkan::fillPipelineCacheHeader( &header, deviceProperties, createConstMemoryBlock( pFile + sizeof( header ), fileSize - sizeof( header ) ) );
+            copyMemoryNonOverlapping( pFile, &header, sizeof( header ) );
+            return createConstMemoryBlock( pFile, fileSize );
+        }
+    };
+
+    KEEN_UNIT_TEST_F( VulkanPipelineCacheBuilderTestFixture, testPipelineListRoundTrip )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        VulkanPipelineList list;
+        vulkan::createPipelineList( &list, &stackAllocator );
+        fillPipelineList( &list );
+
+        // the shared shader code and entry point are only stored once:
+        KEEN_UT_COMPARE_UINT32( list.data.getCount32(), 64u + 64u + 7u + 64u );
+
+        Array<uint8> data;
+        KEEN_UT_CHECK( !vulkan::writePipelineList( &data, &stackAllocator, list ).hasError() );
+
+        VulkanPipelineList readList;
+        vulkan::createPipelineList( &readList, &stackAllocator );
+        KEEN_UT_CHECK( !vulkan::readPipelineList( &readList, data.getMemory() ).hasError() );
+
+        KEEN_UT_COMPARE_UINT32( (uint32)vulkan::getPipelineListPipelineCount( readList ), 3u );
+        KEEN_UT_COMPARE_UINT32( readList.descriptorSetLayouts.getCount32(), 1u );
+        KEEN_UT_COMPARE_UINT32( readList.bindings.getCount32(), 2u );
+        KEEN_UT_COMPARE_UINT32( readList.bindings[ 1u ].arraySizeOrBufferStride, 16u );
+        KEEN_UT_COMPARE_UINT32( readList.pipelineLayouts.getCount32(), 1u );
+        KEEN_UT_COMPARE_UINT32( readList.pipelineLayouts[ 0u ].setLayoutIndices[ 0u ], 0u );
+
+        GraphicsPipelineLayoutParameters layoutParameters;
+        vulkan::getPipelineListPipelineLayoutParameters( &layoutParameters, readList, 0u );
+        KEEN_UT_COMPARE_UINT32( layoutParameters.descriptorSetLayoutCount, 1u );
+        KEEN_UT_CHECK( layoutParameters.descriptorSetLayouts[ 0u ] == nullptr );
+        KEEN_UT_COMPARE_UINT32( layoutParameters.pushConstantsSize, 16u );
+        KEEN_UT_COMPARE_UINT32( layoutParameters.pushConstantRangeCount, 1u );
+        KEEN_UT_CHECK( layoutParameters.pushConstantRanges[ 0u ].stageMask.value == GraphicsPipelineStageMask{ GraphicsPipelineStage::Fragment }.value );
+        KEEN_UT_COMPARE_UINT32( layoutParameters.pushConstantRanges[ 0u ].offset, 16u );
+        KEEN_UT_COMPARE_UINT32( layoutParameters.pushConstantRanges[ 0u ].size, 8u );
+
+        GraphicsRenderPipelineParameters renderParameters;
+        vulkan::getPipelineListRenderPipelineParameters( &renderParameters, readList, 1u );
+        KEEN_UT_CHECK( isMemoryBlockEqual( renderParameters.vertexShaderCode, createConstMemoryBlockFromArray( m_vertexShaderCode ) ) );
+        KEEN_UT_CHECK( isMemoryBlockEqual( renderParameters.fragmentShaderCode, createConstMemoryBlockFromArray( m_fragmentShaderCode ) ) );
+        KEEN_UT_CHECK( !isConstMemoryBlockValid( renderParameters.meshShaderCode ) );
+        KEEN_UT_COMPARE_UINT32( (uint32)renderParameters.vsEntryPoint.size, 6u );
+        KEEN_UT_COMPARE_UINT32( renderParameters.vsEntryPoint.pStart[ 6u ], 0u );
+        KEEN_UT_CHECK( renderParameters.fsEntryPoint.pStart == nullptr );
+        KEEN_UT_CHECK( renderParameters.cullMode == GraphicsCullMode::None );
+        KEEN_UT_CHECK( renderParameters.fillMode == GraphicsFillMode::Wireframe );
+        KEEN_UT_CHECK( renderParameters.renderTargetFormat.colorTargetFormats[ 0u ] == PixelFormat::R8G8B8A8_unorm );
+        KEEN_UT_CHECK( renderParameters.renderTargetFormat.colorTargetFormats[ 1u ] == PixelFormat::None );
+        KEEN_UT_CHECK( renderParameters.renderTargetFormat.depthStencilTargetFormat == PixelFormat::D32_sfloat );
+        KEEN_UT_CHECK( renderParameters.frontStencil.testEnabled );
+        KEEN_UT_CHECK( renderParameters.frontStencil.testFunc == GraphicsComparisonFunction::Equal );
+        KEEN_UT_COMPARE_UINT32( renderParameters.frontStencil.testMask, 0x0fu );
+        KEEN_UT_COMPARE_UINT32( renderParameters.frontStencil.writeMask, 0xf0u );
+        KEEN_UT_CHECK( renderParameters.frontStencil.opDepthPass == GraphicsStencilOperation::Replace );
+        KEEN_UT_CHECK( !renderParameters.backStencil.testEnabled );
+        KEEN_UT_CHECK( renderParameters.slopeDepthBias == 1.5f );
+        KEEN_UT_COMPARE_UINT32( renderParameters.viewMask, 3u );
+        KEEN_UT_CHECK( renderParameters.dynamicState.value == GraphicsRenderPipelineParameters{}.dynamicState.value );
+        KEEN_UT_CHECK( renderParameters.colorWriteMask[ 0u ].value == GraphicsColorWriteMask_All.value );
+        KEEN_UT_CHECK( renderParameters.pPipelineLayout == nullptr );
+        KEEN_UT_CHECK( renderParameters.pVertexFormat == nullptr );
+
+        GraphicsComputePipelineParameters computeParameters;
+        vulkan::getPipelineListComputePipelineParameters( &computeParameters, readList, 0u );
+        KEEN_UT_CHECK( isMemoryBlockEqual( computeParameters.shaderCode, createConstMemoryBlockFromArray( m_computeShaderCode ) ) );
+
+        KEEN_UT_COMPARE_UINT32( (uint32)vulkan::getPipelineListCompileCost( readList, 0u ), 128u );
+        KEEN_UT_COMPARE_UINT32( (uint32)vulkan::getPipelineListCompileCost( readList, 2u ), 64u );
+
+        vulkan::destroyPipelineList( &readList );
+        vulkan::destroyPipelineList( &list );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanPipelineCacheBuilderTestFixture, testInvalidPipelineList )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        VulkanPipelineList list;
+        vulkan::createPipelineList( &list, &stackAllocator );
+        fillPipelineList( &list );
+
+        Array<uint8> data;
+        KEEN_UT_CHECK( !vulkan::writePipelineList( &data, &stackAllocator, list ).hasError() );
+
+        VulkanPipelineList readList;
+        vulkan::createPipelineList( &readList, &stackAllocator );
+
+        // truncated:
+        KEEN_UT_CHECK( vulkan::readPipelineList( &readList, createConstMemoryBlock( data.getStart(), data.getSize() - 1u ) ).getError() == ErrorId_BufferTooSmall );
+        KEEN_UT_COMPARE_UINT32( (uint32)vulkan::getPipelineListPipelineCount( readList ), 0u );
+
+        // written with a different version:
+        data[ 4u ] ^= 0xffu;
+        KEEN_UT_CHECK( vulkan::readPipelineList( &readList, data.getMemory() ).getError() == ErrorId_WrongVersion );
+        data[ 4u ] ^= 0xffu;
+
+        // the compute pipeline references a pipeline layout that doesn't exist:
+        list.computePipelines[ 0u ].pipelineLayoutIndex = 7u;
+        Array<uint8> brokenData;
+        KEEN_UT_CHECK( !vulkan::writePipelineList( &brokenData, &stackAllocator, list ).hasError() );
+        KEEN_UT_CHECK( vulkan::readPipelineList( &readList, brokenData.getMemory() ).hasError() );
+        KEEN_UT_COMPARE_UINT32( (uint32)vulkan::getPipelineListPipelineCount( readList ), 0u );
+
+        KEEN_UT_CHECK( !vulkan::readPipelineList( &readList, data.getMemory() ).hasError() );
+
+        vulkan::destroyPipelineList( &readList );
+        vulkan::destroyPipelineList( &list );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanPipelineCacheBuilderTestFixture, testSplitPipelineList )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        VulkanPipelineList list;
+        vulkan::createPipelineList( &list, &stackAllocator );
+        fillPipelineList( &list );
+        fillPipelineList( &list );
+
+        VulkanPipelineCacheBuilderWork work;
+        KEEN_UT_CHECK( vulkan::splitPipelineList( &work, &stackAllocator, list, 3u ) );
+        KEEN_UT_COMPARE_UINT32( work.pipelineWorkers.getCount32(), 6u );
+        KEEN_UT_COMPARE_UINT32( work.workerCosts.getCount32(), 3u );
+
+        // every pipeline is compiled by exactly one worker and every worker got something to do:
+        uint64 workerCosts[ 3u ] = {};
+        for( size_t i = 0u; i < work.pipelineWorkers.getSize(); ++i )
+        {
+            KEEN_UT_CHECK( work.pipelineWorkers[ i ] < 3u );
+            workerCosts[ work.pipelineWorkers[ i ] ] += vulkan::getPipelineListCompileCost( list, i ) + 1u;
+        }
+        for( size_t i = 0u; i < 3u; ++i )
+        {
+            KEEN_UT_CHECK( workerCosts[ i ] == work.workerCosts[ i ] );
+            KEEN_UT_CHECK( workerCosts[ i ] > 0u );
+        }
+
+        // the same list is always split the same way (every worker process splits the list itself):
+        VulkanPipelineCacheBuilderWork otherWork;
+        KEEN_UT_CHECK( vulkan::splitPipelineList( &otherWork, &stackAllocator, list, 3u ) );
+        for( size_t i = 0u; i < work.pipelineWorkers.getSize(); ++i )
+        {
+            KEEN_UT_COMPARE_UINT32( otherWork.pipelineWorkers[ i ], work.pipelineWorkers[ i ] );
+        }
+
+        vulkan::destroyPipelineCacheBuilderWork( &otherWork );
+        vulkan::destroyPipelineCacheBuilderWork( &work );
+        vulkan::destroyPipelineList( &list );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanPipelineCacheBuilderTestFixture, testMergePipelineCacheFiles )
+    {
+        uint8 validFile0[ 128u ];
+        uint8 validFile1[ 96u ];
+        uint8 otherDeviceFile[ 128u ];
+        uint8 corruptFile[ 128u ];
+
+        VkPhysicalDeviceProperties otherDeviceProperties = m_deviceProperties;
+        otherDeviceProperties.deviceID++;
+
+        const ConstMemoryBlock cacheFiles[] =
+        {
+            createCacheFile( validFile0, sizeof( validFile0 ), m_deviceProperties, 0x11u ),
+            createCacheFile( otherDeviceFile, sizeof( otherDeviceFile ), otherDeviceProperties, 0x22u ),
+            createCacheFile( corruptFile, sizeof( corruptFile ), m_deviceProperties, 0x33u ),
+            createCacheFile( validFile1, sizeof( validFile1 ), m_deviceProperties, 0x44u ),
+        };
+        corruptFile[ sizeof( corruptFile ) - 1u ] ^= 0xffu;
+
+        KEEN_UT_CHECK( vulkan::getPipelineCacheFileData( cacheFiles[ 1u ], m_deviceProperties ).getError() == ErrorId_WrongVersion );
+        KEEN_UT_CHECK( vulkan::getPipelineCacheFileData( cacheFiles[ 2u ], m_deviceProperties ).hasError() );
+
+        zeroValue( &s_recordedCalls );
+        const VkPipelineCache targetCache = createStubHandle<VkPipelineCache>( 0x1u );
+
+        VulkanPipelineCacheMergeResult mergeResult;
+        const Result<void> result = vulkan::mergePipelineCacheFiles( &mergeResult, &m_vulkan, VK_NULL_HANDLE, targetCache, m_deviceProperties, cacheFiles, nullptr );
+        KEEN_UT_CHECK( !result.hasError() );
+
+        KEEN_UT_COMPARE_UINT32( mergeResult.mergedCacheCount, 2u );
+        KEEN_UT_COMPARE_UINT32( mergeResult.skippedCacheCount, 2u );
+        KEEN_UT_COMPARE_UINT32( (uint32)mergeResult.mergedDataSize, (uint32)( sizeof( validFile0 ) + sizeof( validFile1 ) - 2u * sizeof( VulkanPipelineCacheHeader ) ) );
+
+        // one merge call into the target cache - and every temporary cache is destroyed again:
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.mergeCount, 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.mergedSourceCount, 2u );
+        KEEN_UT_CHECK( s_recordedCalls.mergeTarget == targetCache );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.createCount, 2u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.destroyCount, 2u );
+        KEEN_UT_COMPARE_UINT32( (uint32)s_recordedCalls.createdDataSize, (uint32)mergeResult.mergedDataSize );
+
+        // nothing valid to merge:
+        zeroValue( &s_recordedCalls );
+        KEEN_UT_CHECK( !vulkan::mergePipelineCacheFiles( &mergeResult, &m_vulkan, VK_NULL_HANDLE, targetCache, m_deviceProperties, createArrayView( &cacheFiles[ 1u ], 1u ), nullptr ).hasError() );
+        KEEN_UT_COMPARE_UINT32( mergeResult.mergedCacheCount, 0u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCalls.mergeCount, 0u );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanPipelineCacheBuilderTestFixture, testMergePipelineBinaryArchiveFiles )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        VulkanPipelineBinaryKey globalKey;
+        zeroValue( &globalKey );
+        globalKey.size          = 4u;
+        globalKey.data[ 0u ]    = 0x42u;
+
+        VulkanPipelineBinaryKey otherGlobalKey = globalKey;
+        otherGlobalKey.data[ 0u ]++;
+
+        VulkanPipelineBinaryKey binaryKey;
+        zeroValue( &binaryKey );
+        binaryKey.size = 1u;
+
+        // two workers with their own pipeline that both compiled pipeline 2 + one worker that ran on a different device:
+        Array<uint8> archiveFiles[ 3u ];
+        const VulkanPipelineBinaryKey* workerGlobalKeys[] = { &globalKey, &globalKey, &otherGlobalKey };
+        for( size_t workerIndex = 0u; workerIndex < KEEN_COUNTOF( archiveFiles ); ++workerIndex )
+        {
+            VulkanPipelineBinaryArchive workerArchive;
+            vulkan::createPipelineBinaryArchive( &workerArchive, &stackAllocator, *workerGlobalKeys[ workerIndex ] );
+
+            const ConstMemoryBlock binaryData = createConstMemoryBlockFromArray( m_computeShaderCode );
+            KEEN_UT_CHECK( vulkan::addPipelineBinaryRecord( &workerArchive, 10u + workerIndex, binaryKey, createArrayView( &binaryKey, 1u ), createArrayView( &binaryData, 1u ) ) );
+            KEEN_UT_CHECK( vulkan::addPipelineBinaryRecord( &workerArchive, 2u, binaryKey, createArrayView( &binaryKey, 1u ), createArrayView( &binaryData, 1u ) ) );
+            KEEN_UT_CHECK( vulkan::writePipelineBinaryArchive( &archiveFiles[ workerIndex ], &stackAllocator, workerArchive, 0u ).isOk() );
+
+            vulkan::destroyPipelineBinaryArchive( &workerArchive );
+        }
+
+        VulkanPipelineBinaryArchive targetArchive;
+        vulkan::createPipelineBinaryArchive( &targetArchive, &stackAllocator, globalKey );
+
+        const ConstMemoryBlock files[] = { archiveFiles[ 0u ].getMemory(), archiveFiles[ 1u ].getMemory(), archiveFiles[ 2u ].getMemory() };
+        VulkanPipelineCacheMergeResult mergeResult;
+        KEEN_UT_CHECK( vulkan::mergePipelineBinaryArchiveFiles( &mergeResult, &targetArchive, &stackAllocator, files ).isOk() );
+        KEEN_UT_COMPARE_UINT32( mergeResult.mergedCacheCount, 2u );
+        KEEN_UT_COMPARE_UINT32( mergeResult.skippedCacheCount, 1u );
+
+        // the pipeline that both workers compiled is only stored once:
+        KEEN_UT_COMPARE_UINT32( targetArchive.records.getCount32(), 3u );
+        KEEN_UT_CHECK( vulkan::findPipelineBinaryRecord( &targetArchive, 2u ) != nullptr );
+        KEEN_UT_CHECK( vulkan::findPipelineBinaryRecord( &targetArchive, 11u ) != nullptr );
+        KEEN_UT_CHECK( vulkan::findPipelineBinaryRecord( &targetArchive, 12u ) == nullptr );
+
+        const VulkanPipelineBinaryRecord* pRecord = vulkan::findPipelineBinaryRecord( &targetArchive, 10u );
+        KEEN_UT_CHECK( pRecord != nullptr && pRecord->binaryCount == 1u && pRecord->binaries[ 0u ].dataSize == sizeof( m_computeShaderCode ) );
+
+        vulkan::destroyPipelineBinaryArchive( &targetArchive );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanPipelineCacheBuilderTestFixture, testRunPipelineCacheWorkers )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        zeroValue( &s_recordedWorkerCalls );
+        s_recordedWorkerCalls.failingWorkerIndex = 2u;
+
+        VulkanPipelineCacheWorkerLauncher launcher;
+        launcher.pStartWorker   = recordStartWorker;
+        launcher.pWaitForWorker = recordWaitForWorker;
+        launcher.pUserData      = nullptr;
+
+        DynamicArray<ConstMemoryBlock> workerFiles;
+        workerFiles.create( &stackAllocator );
+        KEEN_UT_CHECK( workerFiles.trySetCapacity( 4u ) );
+
+        // every worker is started before the first one is waited for - the failed worker is reported but the others are still returned:
+        KEEN_UT_COMPARE_UINT32( vulkan::runPipelineCacheWorkers( &workerFiles, launcher, 4u ), 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedWorkerCalls.startCount, 4u );
+        KEEN_UT_COMPARE_UINT32( s_recordedWorkerCalls.waitCount, 4u );
+        KEEN_UT_COMPARE_UINT32( s_recordedWorkerCalls.workerCount, 4u );
+        KEEN_UT_COMPARE_UINT32( workerFiles.getCount32(), 3u );
+        if( workerFiles.getCount32() == 3u )
+        {
+            KEEN_UT_CHECK( workerFiles[ 0u ].pStart == s_recordedWorkerCalls.workerFiles[ 0u ] );
+            KEEN_UT_CHECK( workerFiles[ 2u ].pStart == s_recordedWorkerCalls.workerFiles[ 3u ] );
+        }
+
+        workerFiles.destroy();
+    }
+
+}
@@ -0,0 +1,474 @@
+#include "vulkan_pipeline_key.hpp"
+
+#include "keen/base/tls_allocator_scope.hpp"
+
+namespace keen
+{
+
+    static uint64 combinePipelineKey( uint64 key, const void* pData, size_t size )
+    {
+        // fnv1a style combine - same as the command buffer content hash:
+        const uint64 dataHash = size > 0u ? calculateFnv1a64Hash( pData, size ).value : 0u;
+        return ( key ^ dataHash ^ size ) * 0x100000001b3ull;
+    }
+
+    template<typename T>
+    static uint64 combinePipelineKeyValue( uint64 key, const T& value )
+    {
+        return combinePipelineKey( key, &value, sizeof( value ) );
+    }
+
+    static uint64 combinePipelineKeyShaderCode( uint64 key, ConstMemoryBlock shaderCode )
+    {
+        if( !isConstMemoryBlockValid( shaderCode ) )
+        {
+            return combinePipelineKey( key, nullptr, 0u );
+        }
+        return combinePipelineKey( key, shaderCode.pStart, shaderCode.size );
+    }
+
+    // the permutation key only contains which stages exist - the code changes between builds:
+    static uint64 combinePipelineKeyShaderStage( uint64 key, ConstMemoryBlock shaderCode, bool includeShaderCode )
+    {
+        if( !includeShaderCode )
+        {
+            return combinePipelineKeyValue( key, isConstMemoryBlockValid( shaderCode ) );
+        }
+        return combinePipelineKeyShaderCode( key, shaderCode );
+    }
+
+    static uint64 combinePipelineKeyEntryPoint( uint64 key, const GraphicsShaderEntryPointName& entryPoint )
+    {
+        return combinePipelineKey( key, entryPoint.pStart, entryPoint.pStart != nullptr ? entryPoint.size : 0u );
+    }
+
+    static uint64 combinePipelineKeyStencil( uint64 key, const GraphicsStencilParameters& stencil )
+    {
+        key = combinePipelineKeyValue( key, stencil.testFunc );
+        key = combinePipelineKeyValue( key, stencil.opFail );
+        key = combinePipelineKeyValue( key, stencil.opDepthFail );
+        key = combinePipelineKeyValue( key, stencil.opDepthPass );
+        return key;
+    }
+
+    // pipelines with a dynamic topology still have to be created with a topology of the same class:
+    static VkPrimitiveTopology getPrimitiveTopologyClass( GraphicsPrimitiveType primitiveType )
+    {
+        switch( primitiveType )
+        {
+        case GraphicsPrimitiveType::TriangleList:
+        case GraphicsPrimitiveType::TriangleStrip:  return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        case GraphicsPrimitiveType::LineList:       return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+        case GraphicsPrimitiveType::PatchList:      return VK_PRIMITIVE_TOPOLOGY_PATCH_LIST;
+        default:                                    return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+        }
+    }
+
+    // vertex stream 0 is the pVertexFormat of the pipeline:
+    static const VertexFormat* getVertexStreamFormat( const GraphicsRenderPipelineParameters& parameters, size_t streamIndex )
+    {
+        KEEN_ASSERT( streamIndex <= parameters.additionalVertexStreamCount );
+        return streamIndex == 0u ? parameters.pVertexFormat : parameters.additionalVertexStreams[ streamIndex - 1u ].pFormat;
+    }
+
+    static GraphicsVertexInputRate getVertexStreamInputRate( const GraphicsRenderPipelineParameters& parameters, size_t streamIndex )
+    {
+        return streamIndex == 0u ? GraphicsVertexInputRate::Vertex : parameters.additionalVertexStreams[ streamIndex - 1u ].inputRate;
+    }
+
+    static HashKey64 calculateRenderPipelineKey( const GraphicsRenderPipelineParameters& parameters, VulkanDynamicStateFeatureMask features, bool includeShaderCode )
+    {
+        const bool isMeshPipeline = isConstMemoryBlockValid( parameters.meshShaderCode );
+
+        uint64 key = 0xcbf29ce484222325ull;
+
+        // always static: the shader stages, the attachment formats and the multisample state
+        key = combinePipelineKeyShaderStage( key, parameters.vertexShaderCode, includeShaderCode );
+        key = combinePipelineKeyShaderStage( key, parameters.tcShaderCode, includeShaderCode );
+        key = combinePipelineKeyShaderStage( key, parameters.teShaderCode, includeShaderCode );
+        key = combinePipelineKeyShaderStage( key, parameters.fragmentShaderCode, includeShaderCode );
+        key = combinePipelineKeyShaderStage( key, parameters.taskShaderCode, includeShaderCode );
+        key = combinePipelineKeyShaderStage( key, parameters.meshShaderCode, includeShaderCode );
+        key = combinePipelineKeyValue( key, parameters.entryPointId );
+        key = combinePipelineKeyEntryPoint( key, parameters.vsEntryPoint );
+        key = combinePipelineKeyEntryPoint( key, parameters.tcEntryPoint );
+        key = combinePipelineKeyEntryPoint( key, parameters.teEntryPoint );
+        key = combinePipelineKeyEntryPoint( key, parameters.fsEntryPoint );
+        key = combinePipelineKeyEntryPoint( key, parameters.tsEntryPoint );
+        key = combinePipelineKeyEntryPoint( key, parameters.msEntryPoint );
+
+        const uint8 colorTargetCount = parameters.renderTargetFormat.getColorTargetCount();
+        for( size_t i = 0u; i < colorTargetCount; ++i )
+        {
+            key = combinePipelineKeyValue( key, parameters.renderTargetFormat.colorTargetFormats[ i ] );
+        }
+        key = combinePipelineKeyValue( key, parameters.renderTargetFormat.depthStencilTargetFormat );
+
+        key = combinePipelineKeyValue( key, parameters.sampleCount );
+        key = combinePipelineKeyValue( key, parameters.sampleShading );
+        key = combinePipelineKeyValue( key, parameters.patchSize );
+        key = combinePipelineKeyValue( key, parameters.dynamicState.value );
+        key = combinePipelineKeyValue( key, parameters.shadingRate );
+        key = combinePipelineKeyValue( key, parameters.shadingRateCombiners );
+        key = combinePipelineKeyValue( key, parameters.useShadingRateAttachment );
+        key = combinePipelineKeyValue( key, parameters.isIndirectBindable );
+        key = combinePipelineKeyValue( key, parameters.viewMask );
+
+        key = combinePipelineKeyValue( key, parameters.inputAttachmentIndices.isEnabled );
+        if( parameters.inputAttachmentIndices.isEnabled )
+        {
+            key = combinePipelineKey( key, parameters.inputAttachmentIndices.colorInputIndices, colorTargetCount );
+            key = combinePipelineKeyValue( key, parameters.inputAttachmentIndices.depthInputIndex );
+            key = combinePipelineKeyValue( key, parameters.inputAttachmentIndices.stencilInputIndex );
+        }
+
+        // the stencil masks are part of the pipeline unless they are already dynamic:
+        if( !parameters.dynamicState.isSet( GraphicsDynamicStateFlag::StencilCompareMask ) )
+        {
+            key = combinePipelineKeyValue( key, parameters.frontStencil.testMask );
+        }
+        if( !parameters.dynamicState.isSet( GraphicsDynamicStateFlag::StencilWriteMask ) )
+        {
+            key = combinePipelineKeyValue( key, parameters.frontStencil.writeMask );
+        }
+
+        if( !isMeshPipeline )
+        {
+            if( features.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) )
+            {
+                key = combinePipelineKeyValue( key, getPrimitiveTopologyClass( parameters.primitiveType ) );
+            }
+            else
+            {
+                key = combinePipelineKeyValue( key, parameters.primitiveType );
+            }
+
+            // dynamic strides change the dynamic state list of the VkPipeline:
+            const bool hasDynamicVertexStrides = parameters.useDynamicVertexStrides && features.isSet( VulkanDynamicStateFeature::ExtendedDynamicState );
+            key = combinePipelineKeyValue( key, hasDynamicVertexStrides );
+
+            if( !features.isSet( VulkanDynamicStateFeature::VertexInputDynamicState ) )
+            {
+                key = combinePipelineKeyValue( key, parameters.additionalVertexStreamCount );
+                for( size_t streamIndex = 0u; streamIndex <= parameters.additionalVertexStreamCount; ++streamIndex )
+                {
+                    const VertexFormat* pVertexFormat = getVertexStreamFormat( parameters, streamIndex );
+                    if( pVertexFormat == nullptr )
+                    {
+                        key = combinePipelineKey( key, nullptr, 0u );
+                        continue;
+                    }
+
+                    key = combinePipelineKeyValue( key, getVertexStreamInputRate( parameters, streamIndex ) );
+                    if( !hasDynamicVertexStrides )
+                    {
+                        key = combinePipelineKeyValue( key, pVertexFormat->stride );
+                    }
+                    for( size_t attributeId = 0u; attributeId < VertexAttributeId_Count; ++attributeId )
+                    {
+                        if( pVertexFormat->hasAttribute( attributeId ) )
+                        {
+                            key = combinePipelineKeyValue( key, attributeId );
+                            key = combinePipelineKeyValue( key, pVertexFormat->attributeInfos[ attributeId ].format );
+                            key = combinePipelineKeyValue( key, pVertexFormat->attributeInfos[ attributeId ].offset );
+                        }
+                    }
+                }
+            }
+        }
+
+        if( !features.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) )
+        {
+            key = combinePipelineKeyValue( key, parameters.cullMode );
+            key = combinePipelineKeyValue( key, parameters.windingOrder );
+            key = combinePipelineKeyValue( key, parameters.depthComparisonFunction );
+            key = combinePipelineKeyValue( key, parameters.depthWriteEnabled );
+            key = combinePipelineKeyValue( key, parameters.frontStencil.testEnabled || parameters.backStencil.testEnabled );
+            key = combinePipelineKeyStencil( key, parameters.frontStencil );
+            key = combinePipelineKeyStencil( key, parameters.backStencil );
+        }
+
+        if( !features.isSet( VulkanDynamicStateFeature::ExtendedDynamicState2 ) )
+        {
+            key = combinePipelineKeyValue( key, parameters.constDepthBias );
+            key = combinePipelineKeyValue( key, parameters.slopeDepthBias );
+        }
+
+        if( !features.isSet( VulkanDynamicStateFeature::ExtendedDynamicState3 ) )
+        {
+            key = combinePipelineKeyValue( key, parameters.fillMode );
+            key = combinePipelineKeyValue( key, parameters.alphaToCoverage );
+
+            if( colorTargetCount > 0u )
+            {
+                key = combinePipelineKeyValue( key, parameters.blendOp );
+                if( parameters.blendOp != GraphicsBlendOperation::None )
+                {
+                    key = combinePipelineKeyValue( key, parameters.blendSourceFactor );
+                    key = combinePipelineKeyValue( key, parameters.blendDestFactor );
+                }
+                for( size_t i = 0u; i < colorTargetCount; ++i )
+                {
+                    key = combinePipelineKeyValue( key, parameters.colorWriteMask[ i ].value );
+                }
+            }
+        }
+
+        return HashKey64{ key };
+    }
+
+    HashKey64 vulkan::computeRenderPipelineKey( const GraphicsRenderPipelineParameters& parameters, VulkanDynamicStateFeatureMask features )
+    {
+        return calculateRenderPipelineKey( parameters, features, true );
+    }
+
+    HashKey64 vulkan::computeRenderPipelinePermutationKey( const GraphicsRenderPipelineParameters& parameters )
+    {
+        // :JK: without any dynamic state features all render state is hashed - so the key doesn't depend on the device or on
+        // vulkan/EnableExtendedDynamicState and matches between two runs
+        return calculateRenderPipelineKey( parameters, VulkanDynamicStateFeatureMask{}, false );
+    }
+
+    static HashKey64 calculateComputePipelineKey( const GraphicsComputePipelineParameters& parameters, bool includeShaderCode )
+    {
+        uint64 key = 0xcbf29ce484222325ull;
+        key = combinePipelineKeyShaderStage( key, parameters.shaderCode, includeShaderCode );
+        key = combinePipelineKeyValue( key, parameters.entryPointId );
+        key = combinePipelineKeyEntryPoint( key, parameters.entryPoint );
+        return HashKey64{ key };
+    }
+
+    HashKey64 vulkan::computeComputePipelineKey( const GraphicsComputePipelineParameters& parameters )
+    {
+        return calculateComputePipelineKey( parameters, true );
+    }
+
+    HashKey64 vulkan::computeComputePipelinePermutationKey( const GraphicsComputePipelineParameters& parameters )
+    {
+        return calculateComputePipelineKey( parameters, false );
+    }
+
+    size_t vulkan::countUniqueRenderPipelineKeys( ArrayView<const GraphicsRenderPipelineParameters> parameters, VulkanDynamicStateFeatureMask features )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        Set<HashKey64> keys;
+        if( !keys.tryCreate( &stackAllocator, parameters.getCount() ) )
+        {
+            return parameters.getCount();
+        }
+
+        for( size_t i = 0u; i < parameters.getCount(); ++i )
+        {
+            const HashKey64 key = computeRenderPipelineKey( parameters[ i ], features );
+            if( !keys.find( key ) )
+            {
+                keys.insert( key );
+            }
+        }
+
+        return keys.getCount();
+    }
+
+    void vulkan::fillRenderPipelineDynamicState( VulkanRenderPipelineDynamicState* pState, const GraphicsRenderPipelineParameters& parameters )
+    {
+        zeroValue( pState );
+
+        pState->isMeshPipeline          = isConstMemoryBlockValid( parameters.meshShaderCode );
+        pState->cullMode                = vulkan::getCullModeFlagBits( parameters.cullMode );
+        pState->frontFace               = vulkan::getFrontFace( parameters.windingOrder );
+        pState->primitiveTopology       = vulkan::getPrimitiveTopology( parameters.primitiveType );
+        pState->polygonMode             = vulkan::getPolygonMode( parameters.fillMode );
+
+        // same as the baked pipeline state in compileRenderPipeline:
+        const bool depthTestEnabled     = parameters.depthComparisonFunction != GraphicsComparisonFunction::Always;
+        pState->depthTestEnable         = (VkBool32)( depthTestEnabled || parameters.depthWriteEnabled );
+        pState->depthWriteEnable        = (VkBool32)parameters.depthWriteEnabled;
+        pState->depthCompareOp          = vulkan::getCompareOp( parameters.depthComparisonFunction );
+        pState->depthBiasEnable         = ( ( parameters.slopeDepthBias != 0.0f ) || ( parameters.constDepthBias != 0.0f ) ) ? VK_TRUE : VK_FALSE;
+        pState->depthBiasConstantFactor = parameters.constDepthBias;
+        pState->depthBiasSlopeFactor    = parameters.slopeDepthBias;
+
+        pState->stencilTestEnable       = (VkBool32)( parameters.frontStencil.testEnabled || parameters.backStencil.testEnabled );
+        pState->frontStencil.failOp     = vulkan::getStencilOp( parameters.frontStencil.opFail );
+        pState->frontStencil.passOp     = vulkan::getStencilOp( parameters.frontStencil.opDepthPass );
+        pState->frontStencil.depthFailOp = vulkan::getStencilOp( parameters.frontStencil.opDepthFail );
+        pState->frontStencil.compareOp  = vulkan::getCompareOp( parameters.frontStencil.testFunc );
+        pState->backStencil.failOp      = vulkan::getStencilOp( parameters.backStencil.opFail );
+        pState->backStencil.passOp      = vulkan::getStencilOp( parameters.backStencil.opDepthPass );
+        pState->backStencil.depthFailOp = vulkan::getStencilOp( parameters.backStencil.opDepthFail );
+        pState->backStencil.compareOp   = vulkan::getCompareOp( parameters.backStencil.testFunc );
+
+        const uint8 colorTargetCount    = parameters.renderTargetFormat.getColorTargetCount();
+        const bool blendingEnabled      = parameters.blendOp != GraphicsBlendOperation::None && colorTargetCount > 0u;
+
+        pState->colorAttachmentCount    = colorTargetCount;
+        for( size_t i = 0u; i < colorTargetCount; ++i )
+        {
+            VkColorBlendEquationEXT* pEquation = &pState->colorBlendEquation[ i ];
+            pEquation->srcColorBlendFactor  = vulkan::getBlendFactor( parameters.blendSourceFactor );
+            pEquation->dstColorBlendFactor  = vulkan::getBlendFactor( parameters.blendDestFactor );
+            pEquation->colorBlendOp         = vulkan::getBlendOp( parameters.blendOp );
+            pEquation->srcAlphaBlendFactor  = vulkan::getBlendFactor( parameters.blendSourceFactor );
+            pEquation->dstAlphaBlendFactor  = vulkan::getBlendFactor( parameters.blendDestFactor );
+            pEquation->alphaBlendOp         = vulkan::getBlendOp( parameters.blendOp );
+
+            pState->colorBlendEnable[ i ]   = blendingEnabled ? VK_TRUE : VK_FALSE;
+            pState->colorWriteMask[ i ]     = vulkan::getColorComponentFlagBits( parameters.colorWriteMask[ i ] );
+        }
+        pState->alphaToCoverageEnable   = (VkBool32)parameters.alphaToCoverage;
+
+        if( !pState->isMeshPipeline )
+        {
+            fillVertexInputDescriptions( &pState->vertexBindingCount, pState->vertexBindings, &pState->vertexAttributeCount, pState->vertexAttributes, parameters );
+            pState->hasDynamicVertexStrides = parameters.useDynamicVertexStrides;
+        }
+    }
+
+    bool vulkan::fillVertexInputDescriptions( uint32* pBindingCount, VkVertexInputBindingDescription2EXT* pBindings, uint32* pAttributeCount, VkVertexInputAttributeDescription2EXT* pAttributes, const GraphicsRenderPipelineParameters& parameters )
+    {
+        KEEN_ASSERT( parameters.additionalVertexStreamCount < GraphicsLimits_MaxVertexStreamCount );
+
+        *pBindingCount      = 0u;
+        *pAttributeCount    = 0u;
+
+        uint32 usedAttributeMask = 0u;
+        bool result = true;
+
+        for( size_t streamIndex = 0u; streamIndex <= parameters.additionalVertexStreamCount; ++streamIndex )
+        {
+            const VertexFormat* pVertexFormat = getVertexStreamFormat( parameters, streamIndex );
+            if( pVertexFormat == nullptr )
+            {
+                // :JK: an empty stream keeps the binding numbers of the following streams stable
+                continue;
+            }
+
+            for( size_t attributeId = 0u; attributeId < VertexAttributeId_Count; ++attributeId )
+            {
+                if( !pVertexFormat->hasAttribute( attributeId ) )
+                {
+                    continue;
+                }
+                if( ( usedAttributeMask & ( 1u << attributeId ) ) != 0u )
+                {
+                    result = false;
+                    continue;
+                }
+                usedAttributeMask |= 1u << attributeId;
+
+                const VertexFormat::AttributeInfo& attribute = pVertexFormat->attributeInfos[ attributeId ];
+                KEEN_ASSERT( attribute.format < VertexAttributeFormat_Count );
+
+                VkVertexInputAttributeDescription2EXT* pAttribute = &pAttributes[ *pAttributeCount ];
+                pAttribute->sType       = VK_STRUCTURE_TYPE_VERTEX_INPUT_ATTRIBUTE_DESCRIPTION_2_EXT;
+                pAttribute->pNext       = nullptr;
+                pAttribute->location    = (uint32)attributeId;
+                pAttribute->binding     = (uint32)streamIndex;
+                pAttribute->format      = vulkan::getVertexAttributeFormat( attribute.format );
+                pAttribute->offset      = attribute.offset;
+
+                ( *pAttributeCount )++;
+            }
+
+            VkVertexInputBindingDescription2EXT* pBinding = &pBindings[ *pBindingCount ];
+            pBinding->sType     = VK_STRUCTURE_TYPE_VERTEX_INPUT_BINDING_DESCRIPTION_2_EXT;
+            pBinding->pNext     = nullptr;
+            pBinding->binding   = (uint32)streamIndex;
+            pBinding->stride    = pVertexFormat->stride;
+            pBinding->inputRate = getVertexStreamInputRate( parameters, streamIndex ) == GraphicsVertexInputRate::Instance ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX;
+            pBinding->divisor   = 1u;
+
+            ( *pBindingCount )++;
+        }
+
+        return result;
+    }
+
+    void vulkan::addExtendedDynamicStates( DynamicArray<VkDynamicState, VulkanMaxDynamicStateCount>* pDynamicStates, VulkanDynamicStateFeatureMask features, bool isMeshPipeline, bool hasDynamicVertexStrides )
+    {
+        if( features.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) )
+        {
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_CULL_MODE_EXT );
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_FRONT_FACE_EXT );
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT );
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT );
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT );
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT );
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_STENCIL_OP_EXT );
+
+            // mesh pipelines don't have an input assembly state:
+            if( !isMeshPipeline )
+            {
+                pDynamicStates->pushBack( VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT );
+                if( hasDynamicVertexStrides )
+                {
+                    pDynamicStates->pushBack( VK_DYNAMIC_STATE_VERTEX_INPUT_BINDING_STRIDE_EXT );
+                }
+            }
+        }
+
+        if( features.isSet( VulkanDynamicStateFeature::ExtendedDynamicState2 ) )
+        {
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT );
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_DEPTH_BIAS );
+        }
+
+        if( features.isSet( VulkanDynamicStateFeature::ExtendedDynamicState3 ) )
+        {
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_POLYGON_MODE_EXT );
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT );
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT );
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT );
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_ALPHA_TO_COVERAGE_ENABLE_EXT );
+        }
+
+        if( features.isSet( VulkanDynamicStateFeature::VertexInputDynamicState ) && !isMeshPipeline )
+        {
+            pDynamicStates->pushBack( VK_DYNAMIC_STATE_VERTEX_INPUT_EXT );
+        }
+    }
+
+    void vulkan::writeRenderPipelineDynamicState( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, VulkanDynamicStateFeatureMask features, const VulkanRenderPipelineDynamicState& state )
+    {
+        if( features.isSet( VulkanDynamicStateFeature::ExtendedDynamicState ) )
+        {
+            pVulkan->vkCmdSetCullModeEXT( commandBuffer, state.cullMode );
+            pVulkan->vkCmdSetFrontFaceEXT( commandBuffer, state.frontFace );
+            pVulkan->vkCmdSetDepthTestEnableEXT( commandBuffer, state.depthTestEnable );
+            pVulkan->vkCmdSetDepthWriteEnableEXT( commandBuffer, state.depthWriteEnable );
+            pVulkan->vkCmdSetDepthCompareOpEXT( commandBuffer, state.depthCompareOp );
+            pVulkan->vkCmdSetStencilTestEnableEXT( commandBuffer, state.stencilTestEnable );
+            pVulkan->vkCmdSetStencilOpEXT( commandBuffer, VK_STENCIL_FACE_FRONT_BIT, state.frontStencil.failOp, state.frontStencil.passOp, state.frontStencil.depthFailOp, state.frontStencil.compareOp );
+            pVulkan->vkCmdSetStencilOpEXT( commandBuffer, VK_STENCIL_FACE_BACK_BIT, state.backStencil.failOp, state.backStencil.passOp, state.backStencil.depthFailOp, state.backStencil.compareOp );
+            if( !state.isMeshPipeline )
+            {
+                pVulkan->vkCmdSetPrimitiveTopologyEXT( commandBuffer, state.primitiveTopology );
+            }
+        }
+
+        if( features.isSet( VulkanDynamicStateFeature::ExtendedDynamicState2 ) )
+        {
+            pVulkan->vkCmdSetDepthBiasEnableEXT( commandBuffer, state.depthBiasEnable );
+            pVulkan->vkCmdSetDepthBias( commandBuffer, state.depthBiasConstantFactor, 0.0f, state.depthBiasSlopeFactor );
+        }
+
+        if( features.isSet( VulkanDynamicStateFeature::ExtendedDynamicState3 ) )
+        {
+            pVulkan->vkCmdSetPolygonModeEXT( commandBuffer, state.polygonMode );
+            pVulkan->vkCmdSetAlphaToCoverageEnableEXT( commandBuffer, state.alphaToCoverageEnable );
+            if( state.colorAttachmentCount > 0u )
+            {
+                pVulkan->vkCmdSetColorBlendEnableEXT( commandBuffer, 0u, state.colorAttachmentCount, state.colorBlendEnable );
+                pVulkan->vkCmdSetColorBlendEquationEXT( commandBuffer, 0u, state.colorAttachmentCount, state.colorBlendEquation );
+                pVulkan->vkCmdSetColorWriteMaskEXT( commandBuffer, 0u, state.colorAttachmentCount, state.colorWriteMask );
+            }
+        }
+
+        if( features.isSet( VulkanDynamicStateFeature::VertexInputDynamicState ) && !state.isMeshPipeline )
+        {
+            pVulkan->vkCmdSetVertexInputEXT( commandBuffer, state.vertexBindingCount, state.vertexBindings, state.vertexAttributeCount, state.vertexAttributes );
+        }
+    }
+
+}
@@ -0,0 +1,87 @@
+#ifndef KEEN_VULKAN_PIPELINE_KEY_HPP_INCLUDED
+#define KEEN_VULKAN_PIPELINE_KEY_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+
+namespace keen
+{
+
+    enum class VulkanDynamicStateFeature : uint8
+    {
+        ExtendedDynamicState,       // cull mode, front face, topology (inside a topology class), depth + stencil test state
+        ExtendedDynamicState2,      // depth bias enable (the bias values are always dynamic then)
+        ExtendedDynamicState3,      // polygon mode, blend enable, blend equation, color write mask, alpha to coverage
+        VertexInputDynamicState,    // vertex bindings + attributes
+    };
+
+    using VulkanDynamicStateFeatureMask = Bitmask8<VulkanDynamicStateFeature>;
+
+    constexpr uint32 VulkanMaxDynamicStateCount = 32u;
+
+    // the render state that is not part of the pipeline key - set when the pipeline is bound and can be overridden by the set state commands:
+    struct VulkanRenderPipelineDynamicState
+    {
+        bool8                               isMeshPipeline;     // no topology + vertex input state
+
+        VkCullModeFlags                     cullMode;
+        VkFrontFace                         frontFace;
+        VkPrimitiveTopology                 primitiveTopology;
+        VkPolygonMode                       polygonMode;
+
+        VkBool32                            depthTestEnable;
+        VkBool32                            depthWriteEnable;
+        VkCompareOp                         depthCompareOp;
+        VkBool32                            depthBiasEnable;
+        float32                             depthBiasConstantFactor;
+        float32                             depthBiasSlopeFactor;
+
+        VkBool32                            stencilTestEnable;
+        VkStencilOpState                    frontStencil;       // only the ops and the compare op are used
+        VkStencilOpState                    backStencil;
+
+        uint32                              colorAttachmentCount;
+        VkBool32                            colorBlendEnable[ GraphicsLimits_MaxColorTargetCount ];
+        VkColorBlendEquationEXT             colorBlendEquation[ GraphicsLimits_MaxColorTargetCount ];
+        VkColorComponentFlags               colorWriteMask[ GraphicsLimits_MaxColorTargetCount ];
+        VkBool32                            alphaToCoverageEnable;
+
+        uint32                              vertexBindingCount;
+        uint32                              vertexAttributeCount;
+        VkVertexInputBindingDescription2EXT vertexBindings[ GraphicsLimits_MaxVertexStreamCount ];
+        VkVertexInputAttributeDescription2EXT   vertexAttributes[ VertexAttributeId_Count ];
+        bool8                               hasDynamicVertexStrides;    // the strides come from the bind vertex buffers command
+    };
+
+    namespace vulkan
+    {
+
+        // hash over the render pipeline parameters that still end up in the VkPipeline with the given dynamic state features.
+        // :JK: the pipeline layout is not part of the key - the caller has to mix in something that identifies the layout
+        HashKey64       computeRenderPipelineKey( const GraphicsRenderPipelineParameters& parameters, VulkanDynamicStateFeatureMask features );
+
+        // hash over the compute shader + entry point. same as above: the pipeline layout is not part of the key
+        HashKey64       computeComputePipelineKey( const GraphicsComputePipelineParameters& parameters );
+
+        // same as above without the shader code - identifies a pipeline permutation between two builds (see recordPipelineStatistics):
+        HashKey64       computeRenderPipelinePermutationKey( const GraphicsRenderPipelineParameters& parameters );
+        HashKey64       computeComputePipelinePermutationKey( const GraphicsComputePipelineParameters& parameters );
+
+        // number of different VkPipelines needed for the given parameter sets (all using the same pipeline layout):
+        size_t          countUniqueRenderPipelineKeys( ArrayView<const GraphicsRenderPipelineParameters> parameters, VulkanDynamicStateFeatureMask features );
+
+        void            fillRenderPipelineDynamicState( VulkanRenderPipelineDynamicState* pState, const GraphicsRenderPipelineParameters& parameters );
+
+        // the vertex bindings (binding i is vertex stream i) and attributes of all vertex streams. returns false if two streams share an attribute:
+        bool            fillVertexInputDescriptions( uint32* pBindingCount, VkVertexInputBindingDescription2EXT* pBindings, uint32* pAttributeCount, VkVertexInputAttributeDescription2EXT* pAttributes, const GraphicsRenderPipelineParameters& parameters );
+
+        // the VkDynamicStates that have to be added to the pipeline for the given features:
+        void            addExtendedDynamicStates( DynamicArray<VkDynamicState, VulkanMaxDynamicStateCount>* pDynamicStates, VulkanDynamicStateFeatureMask features, bool isMeshPipeline, bool hasDynamicVertexStrides );
+
+        // sets the dynamic part of the render pipeline state for the given features:
+        void            writeRenderPipelineDynamicState( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, VulkanDynamicStateFeatureMask features, const VulkanRenderPipelineDynamicState& state );
+
+    }
+
+}
+
+#endif
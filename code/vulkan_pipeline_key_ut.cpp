@@ -0,0 +1,191 @@
+#include "vulkan_pipeline_key.hpp"
+
+#include "keen/base/unit_test.hpp"
+
+
+namespace keen
+{
+    class VulkanPipelineKeyTestFixture : public UnitTest
+    {
+    public:
+        VulkanPipelineKeyTestFixture()
+        {
+            // :JK: the shader code is only hashed - so any data works
+            for( size_t i = 0u; i < KEEN_COUNTOF( m_vertexShaderCode ); ++i )
+            {
+                m_vertexShaderCode[ i ]     = (uint8)i;
+                m_fragmentShaderCode[ i ]   = (uint8)( 255u - i );
+            }
+
+            m_baseParameters.vertexShaderCode   = createConstMemoryBlockFromArray( m_vertexShaderCode );
+            m_baseParameters.fragmentShaderCode = createConstMemoryBlockFromArray( m_fragmentShaderCode );
+            m_baseParameters.pPipelineLayout    = (const GraphicsPipelineLayout*)this;
+            m_baseParameters.setRenderTargetFormat( PixelFormat::R8G8B8A8_unorm, PixelFormat::D32_sfloat );
+
+            // every combination of cull mode, depth state, blend state and (triangle) topology:
+            const GraphicsCullMode cullModes[] = { GraphicsCullMode::None, GraphicsCullMode::Front, GraphicsCullMode::Back };
+            const GraphicsComparisonFunction depthFunctions[] = { GraphicsComparisonFunction::Always, GraphicsComparisonFunction::Less };
+            const GraphicsBlendOperation blendOps[] = { GraphicsBlendOperation::None, GraphicsBlendOperation::Add };
+            const GraphicsPrimitiveType primitiveTypes[] = { GraphicsPrimitiveType::TriangleList, GraphicsPrimitiveType::TriangleStrip };
+
+            size_t index = 0u;
+            for( size_t cullIndex = 0u; cullIndex < KEEN_COUNTOF( cullModes ); ++cullIndex )
+            {
+                for( size_t depthIndex = 0u; depthIndex < KEEN_COUNTOF( depthFunctions ); ++depthIndex )
+                {
+                    for( size_t depthWrite = 0u; depthWrite < 2u; ++depthWrite )
+                    {
+                        for( size_t blendIndex = 0u; blendIndex < KEEN_COUNTOF( blendOps ); ++blendIndex )
+                        {
+                            for( size_t primitiveIndex = 0u; primitiveIndex < KEEN_COUNTOF( primitiveTypes ); ++primitiveIndex )
+                            {
+                                GraphicsRenderPipelineParameters* pParameters = &m_permutations[ index++ ];
+                                *pParameters = m_baseParameters;
+                                pParameters->setRasterizerState( cullModes[ cullIndex ], GraphicsFillMode::Solid, GraphicsWindingOrder::Ccw );
+                                pParameters->setDepthState( depthFunctions[ depthIndex ], depthWrite != 0u );
+                                pParameters->setBlendState( blendOps[ blendIndex ], GraphicsBlendFactor::SrcAlpha, GraphicsBlendFactor::InvSrcAlpha );
+                                pParameters->setPrimitiveType( primitiveTypes[ primitiveIndex ] );
+                            }
+                        }
+                    }
+                }
+            }
+            KEEN_ASSERT( index == KEEN_COUNTOF( m_permutations ) );
+        }
+
+    protected:
+        uint8                               m_vertexShaderCode[ 64u ];
+        uint8                               m_fragmentShaderCode[ 64u ];
+        GraphicsRenderPipelineParameters    m_baseParameters;
+        GraphicsRenderPipelineParameters    m_permutations[ 48u ];
+    };
+
+    KEEN_UNIT_TEST_F( VulkanPipelineKeyTestFixture, testPermutationCount )
+    {
+        const VulkanDynamicStateFeatureMask noFeatures = {};
+        const VulkanDynamicStateFeatureMask extendedDynamicState = { VulkanDynamicStateFeature::ExtendedDynamicState };
+        const VulkanDynamicStateFeatureMask extendedDynamicState123 = { VulkanDynamicStateFeature::ExtendedDynamicState, VulkanDynamicStateFeature::ExtendedDynamicState2, VulkanDynamicStateFeature::ExtendedDynamicState3 };
+
+        // without dynamic state every permutation is its own pipeline:
+        KEEN_UT_COMPARE_UINT32( (uint32)vulkan::countUniqueRenderPipelineKeys( m_permutations, noFeatures ), 48u );
+
+        // cull mode, depth state and topology are dynamic - only the blend enable remains:
+        KEEN_UT_COMPARE_UINT32( (uint32)vulkan::countUniqueRenderPipelineKeys( m_permutations, extendedDynamicState ), 2u );
+
+        KEEN_UT_COMPARE_UINT32( (uint32)vulkan::countUniqueRenderPipelineKeys( m_permutations, extendedDynamicState123 ), 1u );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanPipelineKeyTestFixture, testStaticState )
+    {
+        const VulkanDynamicStateFeatureMask allFeatures = { VulkanDynamicStateFeature::ExtendedDynamicState, VulkanDynamicStateFeature::ExtendedDynamicState2, VulkanDynamicStateFeature::ExtendedDynamicState3, VulkanDynamicStateFeature::VertexInputDynamicState };
+
+        const HashKey64 baseKey = vulkan::computeRenderPipelineKey( m_baseParameters, allFeatures );
+        KEEN_UT_CHECK( baseKey == vulkan::computeRenderPipelineKey( m_baseParameters, allFeatures ) );
+
+        // shader code, attachment formats, sample count and topology class always need a new pipeline:
+        {
+            GraphicsRenderPipelineParameters parameters = m_baseParameters;
+            parameters.fragmentShaderCode = createConstMemoryBlockFromArray( m_vertexShaderCode );
+            KEEN_UT_CHECK( baseKey != vulkan::computeRenderPipelineKey( parameters, allFeatures ) );
+        }
+        {
+            GraphicsRenderPipelineParameters parameters = m_baseParameters;
+            parameters.setRenderTargetFormat( PixelFormat::R16G16B16A16_sfloat, PixelFormat::D32_sfloat );
+            KEEN_UT_CHECK( baseKey != vulkan::computeRenderPipelineKey( parameters, allFeatures ) );
+        }
+        {
+            GraphicsRenderPipelineParameters parameters = m_baseParameters;
+            parameters.sampleCount = 4u;
+            KEEN_UT_CHECK( baseKey != vulkan::computeRenderPipelineKey( parameters, allFeatures ) );
+        }
+        {
+            GraphicsRenderPipelineParameters parameters = m_baseParameters;
+            parameters.setPrimitiveType( GraphicsPrimitiveType::LineList );
+            KEEN_UT_CHECK( baseKey != vulkan::computeRenderPipelineKey( parameters, allFeatures ) );
+        }
+
+        // the depth bias is only dynamic with extended dynamic state 2:
+        {
+            GraphicsRenderPipelineParameters parameters = m_baseParameters;
+            parameters.constDepthBias = 1.0f;
+            KEEN_UT_CHECK( baseKey == vulkan::computeRenderPipelineKey( parameters, allFeatures ) );
+
+            const VulkanDynamicStateFeatureMask extendedDynamicState = { VulkanDynamicStateFeature::ExtendedDynamicState };
+            KEEN_UT_CHECK( vulkan::computeRenderPipelineKey( m_baseParameters, extendedDynamicState ) != vulkan::computeRenderPipelineKey( parameters, extendedDynamicState ) );
+        }
+    }
+
+    KEEN_UNIT_TEST_F( VulkanPipelineKeyTestFixture, testPermutationKey )
+    {
+        const VulkanDynamicStateFeatureMask noFeatures = {};
+        const HashKey64 baseKey = vulkan::computeRenderPipelinePermutationKey( m_baseParameters );
+
+        // a shader change is the same permutation:
+        {
+            GraphicsRenderPipelineParameters parameters = m_baseParameters;
+            parameters.fragmentShaderCode = createConstMemoryBlockFromArray( m_vertexShaderCode );
+            KEEN_UT_CHECK( baseKey == vulkan::computeRenderPipelinePermutationKey( parameters ) );
+            KEEN_UT_CHECK( vulkan::computeRenderPipelineKey( m_baseParameters, noFeatures ) != vulkan::computeRenderPipelineKey( parameters, noFeatures ) );
+        }
+
+        // .. but a missing stage or different state is not:
+        {
+            GraphicsRenderPipelineParameters parameters = m_baseParameters;
+            parameters.fragmentShaderCode = {};
+            KEEN_UT_CHECK( baseKey != vulkan::computeRenderPipelinePermutationKey( parameters ) );
+        }
+        for( size_t i = 1u; i < KEEN_COUNTOF( m_permutations ); ++i )
+        {
+            KEEN_UT_CHECK( vulkan::computeRenderPipelinePermutationKey( m_permutations[ 0u ] ) != vulkan::computeRenderPipelinePermutationKey( m_permutations[ i ] ) );
+        }
+    }
+
+    KEEN_UNIT_TEST_F( VulkanPipelineKeyTestFixture, testDynamicStateValues )
+    {
+        GraphicsRenderPipelineParameters parameters = m_baseParameters;
+        parameters.setRasterizerState( GraphicsCullMode::Front, GraphicsFillMode::Wireframe, GraphicsWindingOrder::Cw );
+        parameters.setDepthState( GraphicsComparisonFunction::Always, true );
+        parameters.setBlendState( GraphicsBlendOperation::Add, GraphicsBlendFactor::One, GraphicsBlendFactor::One, GraphicsColorWriteMask_RGB );
+        parameters.setPrimitiveType( GraphicsPrimitiveType::TriangleStrip );
+
+        VulkanRenderPipelineDynamicState state;
+        vulkan::fillRenderPipelineDynamicState( &state, parameters );
+
+        KEEN_UT_COMPARE_UINT32( state.cullMode, VK_CULL_MODE_FRONT_BIT );
+        KEEN_UT_COMPARE_UINT32( state.frontFace, vulkan::getFrontFace( GraphicsWindingOrder::Cw ) );
+        KEEN_UT_COMPARE_UINT32( state.polygonMode, VK_POLYGON_MODE_LINE );
+        KEEN_UT_COMPARE_UINT32( state.primitiveTopology, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP );
+
+        // depth writes need the depth test to be enabled:
+        KEEN_UT_COMPARE_UINT32( state.depthTestEnable, VK_TRUE );
+        KEEN_UT_COMPARE_UINT32( state.depthWriteEnable, VK_TRUE );
+        KEEN_UT_COMPARE_UINT32( state.depthCompareOp, VK_COMPARE_OP_ALWAYS );
+        KEEN_UT_COMPARE_UINT32( state.depthBiasEnable, VK_FALSE );
+
+        KEEN_UT_COMPARE_UINT32( state.colorAttachmentCount, 1u );
+        KEEN_UT_COMPARE_UINT32( state.colorBlendEnable[ 0u ], VK_TRUE );
+        KEEN_UT_COMPARE_UINT32( state.colorBlendEquation[ 0u ].colorBlendOp, VK_BLEND_OP_ADD );
+        KEEN_UT_COMPARE_UINT32( state.colorWriteMask[ 0u ], VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT );
+        KEEN_UT_COMPARE_UINT32( state.vertexBindingCount, 0u );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanPipelineKeyTestFixture, testDynamicStateList )
+    {
+        DynamicArray<VkDynamicState, VulkanMaxDynamicStateCount> dynamicStates;
+
+        const VulkanDynamicStateFeatureMask allFeatures = { VulkanDynamicStateFeature::ExtendedDynamicState, VulkanDynamicStateFeature::ExtendedDynamicState2, VulkanDynamicStateFeature::ExtendedDynamicState3, VulkanDynamicStateFeature::VertexInputDynamicState };
+        vulkan::addExtendedDynamicStates( &dynamicStates, allFeatures, false, false );
+        KEEN_UT_COMPARE_UINT32( (uint32)dynamicStates.getSize(), 16u );
+
+        // dynamic vertex strides add the binding stride:
+        dynamicStates.clear();
+        vulkan::addExtendedDynamicStates( &dynamicStates, allFeatures, false, true );
+        KEEN_UT_COMPARE_UINT32( (uint32)dynamicStates.getSize(), 17u );
+
+        // mesh pipelines have neither a topology nor a vertex input state:
+        dynamicStates.clear();
+        vulkan::addExtendedDynamicStates( &dynamicStates, allFeatures, true, true );
+        KEEN_UT_COMPARE_UINT32( (uint32)dynamicStates.getSize(), 14u );
+    }
+
+}
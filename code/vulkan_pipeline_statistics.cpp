@@ -0,0 +1,456 @@
+#include "vulkan_pipeline_statistics.hpp"
+
+#include "keen/base/array.hpp"
+#include "keen/base/profiler.hpp"
+#include "keen/base/tls_allocator_scope.hpp"
+
+namespace keen
+{
+    constexpr fourcc VulkanPipelineStatisticsDatabaseMagic = "VKPS"_4cc;
+    constexpr uint32 VulkanPipelineStatisticsDatabaseVersion = 2u;      // 2: the pipeline hash contains the permutation key
+    constexpr uint32 VulkanInvalidPipelineStatisticsIndex = 0xffffffffu;
+
+    struct VulkanPipelineStatisticsDatabaseHeader
+    {
+        uint32                              magic;              // VulkanPipelineStatisticsDatabaseMagic
+        uint32                              version;            // VulkanPipelineStatisticsDatabaseVersion
+        uint32                              vendorId;           // equal to VkPhysicalDeviceProperties::vendorID
+        uint32                              deviceId;           // equal to VkPhysicalDeviceProperties::deviceID
+        uint32                              pipelineCount;
+        uint32                              reserved;
+    };
+
+    // each pipeline is stored as a record header followed by one VulkanPipelineStageStatistics per set bit in stageMask:
+    struct VulkanPipelineStatisticsRecordHeader
+    {
+        uint64                              pipelineHash;
+        uint64                              shaderCodeHash;
+        uint32                              stageMask;
+        uint32                              reserved;
+    };
+
+    static const VkShaderStageFlagBits s_pipelineStatisticsStageFlags[] =
+    {
+        VK_SHADER_STAGE_VERTEX_BIT,
+        VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
+        VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT,
+        VK_SHADER_STAGE_FRAGMENT_BIT,
+        VK_SHADER_STAGE_TASK_BIT_EXT,
+        VK_SHADER_STAGE_MESH_BIT_EXT,
+        VK_SHADER_STAGE_COMPUTE_BIT,
+    };
+    KEEN_STATIC_ASSERT( KEEN_COUNTOF( s_pipelineStatisticsStageFlags ) == (size_t)VulkanPipelineStatisticsStage::Count );
+
+    static uint32 getPipelineStatisticsStageCount( uint32 stageMask )
+    {
+        uint32 stageCount = 0u;
+        for( uint32 stageIndex = 0u; stageIndex < (uint32)VulkanPipelineStatisticsStage::Count; ++stageIndex )
+        {
+            if( stageMask & ( 1u << stageIndex ) )
+            {
+                stageCount++;
+            }
+        }
+        return stageCount;
+    }
+
+    static bool getStatisticValue( uint32* pValue, const VkPipelineExecutableStatisticKHR& statistic )
+    {
+        switch( statistic.format )
+        {
+        case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_UINT64_KHR:
+            *pValue = (uint32)min<uint64>( statistic.value.u64, 0xffffffffu );
+            return true;
+
+        case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_INT64_KHR:
+            *pValue = (uint32)min<int64>( max<int64>( statistic.value.i64, 0 ), 0xffffffff );
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    // :JK: there are no standardized statistic names - these are the ones used by the nvidia, radv and anv drivers
+    static void fillPipelineStageStatistics( VulkanPipelineStageStatistics* pStageStatistics, const ArrayView<const VkPipelineExecutableStatisticKHR> statistics )
+    {
+        uint32 codeSize = 0u;
+        bool hasInstructionCount = false;
+
+        for( size_t statisticIndex = 0u; statisticIndex < statistics.getSize(); ++statisticIndex )
+        {
+            const VkPipelineExecutableStatisticKHR& statistic = statistics[ statisticIndex ];
+
+            uint32 value;
+            if( !getStatisticValue( &value, statistic ) )
+            {
+                continue;
+            }
+
+            const StringView statisticName = createStringView( statistic.name );
+
+            if( statisticName == "Register Count"_s || statisticName == "VGPRs"_s )
+            {
+                pStageStatistics->registerCount = value;
+            }
+            else if( statisticName == "SGPRs"_s )
+            {
+                pStageStatistics->scalarRegisterCount = value;
+            }
+            else if( statisticName == "Spilled VGPRs"_s || statisticName == "Spilled SGPRs"_s || statisticName == "Spill Count"_s )
+            {
+                pStageStatistics->spilledRegisterCount += value;
+            }
+            else if( statisticName == "Local Memory Size"_s || statisticName == "Scratch size"_s || statisticName == "Scratch Memory Size"_s )
+            {
+                pStageStatistics->scratchSizeInBytes = value;
+            }
+            else if( statisticName == "Instructions"_s || statisticName == "Instruction Count"_s )
+            {
+                pStageStatistics->instructionCount = value;
+                hasInstructionCount = true;
+            }
+            else if( statisticName == "Binary Size"_s || statisticName == "Code size"_s )
+            {
+                codeSize = value;
+            }
+        }
+
+        if( !hasInstructionCount )
+        {
+            pStageStatistics->instructionCount = codeSize;
+        }
+    }
+
+    static void collectPipelineStatisticsKHR( VulkanPipelineStatistics* pStatistics, VulkanApi* pVulkan, VkPipeline pipeline )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        VkPipelineInfoKHR pipelineInfo = { VK_STRUCTURE_TYPE_PIPELINE_INFO_KHR };
+        pipelineInfo.pipeline = pipeline;
+
+        uint32 executableCount = 0u;
+        Array<VkPipelineExecutablePropertiesKHR, 8u> executableProperties;
+        if( pVulkan->vkGetPipelineExecutablePropertiesKHR( pVulkan->device, &pipelineInfo, &executableCount, NULL ) != VK_SUCCESS ||
+            !executableProperties.tryCreateWithValue( &stackAllocator, executableCount, { VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_PROPERTIES_KHR } ) ||
+            pVulkan->vkGetPipelineExecutablePropertiesKHR( pVulkan->device, &pipelineInfo, &executableCount, executableProperties.getStart() ) != VK_SUCCESS )
+        {
+            return;
+        }
+
+        for( uint32 executableIndex = 0u; executableIndex < executableCount; ++executableIndex )
+        {
+            VkPipelineExecutableInfoKHR executableInfo = { VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_INFO_KHR };
+            executableInfo.pipeline         = pipeline;
+            executableInfo.executableIndex  = executableIndex;
+
+            uint32 statisticsCount = 0u;
+            Array<VkPipelineExecutableStatisticKHR, 32u> statistics;
+            if( pVulkan->vkGetPipelineExecutableStatisticsKHR( pVulkan->device, &executableInfo, &statisticsCount, NULL ) != VK_SUCCESS ||
+                !statistics.tryCreateWithValue( &stackAllocator, statisticsCount, { VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_STATISTIC_KHR } ) ||
+                pVulkan->vkGetPipelineExecutableStatisticsKHR( pVulkan->device, &executableInfo, &statisticsCount, statistics.getStart() ) != VK_SUCCESS )
+            {
+                continue;
+            }
+
+            VulkanPipelineStageStatistics stageStatistics{};
+            fillPipelineStageStatistics( &stageStatistics, statistics );
+
+            // :JK: merged stages (e.g. vertex + geometry on amd) get the same statistics
+            for( uint32 stageIndex = 0u; stageIndex < (uint32)VulkanPipelineStatisticsStage::Count; ++stageIndex )
+            {
+                if( isBitmaskSet( executableProperties[ executableIndex ].stages, s_pipelineStatisticsStageFlags[ stageIndex ] ) )
+                {
+                    pStatistics->stages[ stageIndex ] = stageStatistics;
+                    pStatistics->stageMask |= 1u << stageIndex;
+                }
+            }
+        }
+    }
+
+    static void collectPipelineStatisticsAMD( VulkanPipelineStatistics* pStatistics, VulkanApi* pVulkan, VkPipeline pipeline, VkShaderStageFlags shaderStages )
+    {
+        for( uint32 stageIndex = 0u; stageIndex < (uint32)VulkanPipelineStatisticsStage::Count; ++stageIndex )
+        {
+            const VkShaderStageFlagBits shaderStage = s_pipelineStatisticsStageFlags[ stageIndex ];
+            if( !isBitmaskSet( shaderStages, shaderStage ) || ( pStatistics->stageMask & ( 1u << stageIndex ) ) )
+            {
+                continue;
+            }
+
+            VkShaderStatisticsInfoAMD statistics;
+            size_t dataSize = sizeof( statistics );
+            if( pVulkan->vkGetShaderInfoAMD( pVulkan->device, pipeline, shaderStage, VK_SHADER_INFO_TYPE_STATISTICS_AMD, &dataSize, &statistics ) != VK_SUCCESS )
+            {
+                continue;
+            }
+
+            VulkanPipelineStageStatistics* pStageStatistics = &pStatistics->stages[ stageIndex ];
+            pStageStatistics->registerCount         = statistics.resourceUsage.numUsedVgprs;
+            pStageStatistics->scalarRegisterCount   = statistics.resourceUsage.numUsedSgprs;
+            pStageStatistics->scratchSizeInBytes    = (uint32)statistics.resourceUsage.scratchMemUsageInBytes;
+            pStatistics->stageMask |= 1u << stageIndex;
+        }
+    }
+
+    void vulkan::collectPipelineStatistics( VulkanPipelineStatistics* pStatistics, VulkanApi* pVulkan, VkPipeline pipeline, VkShaderStageFlags shaderStages )
+    {
+        KEEN_PROFILE_CPU( Vk_collectPipelineStatistics );
+
+        pStatistics->stageMask = 0u;
+        for( size_t stageIndex = 0u; stageIndex < (size_t)VulkanPipelineStatisticsStage::Count; ++stageIndex )
+        {
+            zeroValue( &pStatistics->stages[ stageIndex ] );
+        }
+
+        if( pVulkan->KHR_pipeline_executable_properties )
+        {
+            collectPipelineStatisticsKHR( pStatistics, pVulkan, pipeline );
+        }
+
+        // amd shader info only fills the stages the executable statistics didn't cover:
+        if( pVulkan->AMD_shader_info )
+        {
+            collectPipelineStatisticsAMD( pStatistics, pVulkan, pipeline, shaderStages );
+        }
+    }
+
+    void vulkan::createPipelineStatisticsSet( VulkanPipelineStatisticsSet* pSet, MemoryAllocator* pAllocator )
+    {
+        pSet->pipelines.create( pAllocator );
+        pSet->pipelineIndices.create( pAllocator, 1024u );
+    }
+
+    void vulkan::destroyPipelineStatisticsSet( VulkanPipelineStatisticsSet* pSet )
+    {
+        pSet->pipelines.destroy();
+    }
+
+    bool vulkan::updatePipelineStatistics( VulkanPipelineStatisticsSet* pSet, const VulkanPipelineStatistics& statistics )
+    {
+        const Map<HashKey64, uint32>::InsertResult insertResult = pSet->pipelineIndices.insertKey( HashKey64{ statistics.pipelineHash } );
+        if( insertResult.pValue == nullptr )
+        {
+            return false;
+        }
+
+        if( !insertResult.isNew && *insertResult.pValue != VulkanInvalidPipelineStatisticsIndex )
+        {
+            pSet->pipelines[ *insertResult.pValue ] = statistics;
+            return true;
+        }
+
+        *insertResult.pValue = VulkanInvalidPipelineStatisticsIndex;
+
+        VulkanPipelineStatistics* pNewStatistics = pSet->pipelines.pushBackZero();
+        if( pNewStatistics == nullptr )
+        {
+            return false;
+        }
+        *pNewStatistics = statistics;
+        *insertResult.pValue = (uint32)( pSet->pipelines.getCount() - 1u );
+        return true;
+    }
+
+    const VulkanPipelineStatistics* vulkan::findPipelineStatistics( VulkanPipelineStatisticsSet* pSet, uint64 pipelineHash )
+    {
+        const Map<HashKey64, uint32>::InsertResult insertResult = pSet->pipelineIndices.insertKey( HashKey64{ pipelineHash } );
+        if( insertResult.pValue == nullptr )
+        {
+            return nullptr;
+        }
+        if( insertResult.isNew )
+        {
+            *insertResult.pValue = VulkanInvalidPipelineStatisticsIndex;
+        }
+        if( *insertResult.pValue == VulkanInvalidPipelineStatisticsIndex )
+        {
+            return nullptr;
+        }
+        return &pSet->pipelines[ *insertResult.pValue ];
+    }
+
+    Result<void> vulkan::writePipelineStatisticsDatabase( Array<uint8>* pData, MemoryAllocator* pAllocator, ArrayView<const VulkanPipelineStatistics> pipelines, uint32 vendorId, uint32 deviceId )
+    {
+        size_t dataSize = sizeof( VulkanPipelineStatisticsDatabaseHeader );
+        for( size_t i = 0u; i < pipelines.getSize(); ++i )
+        {
+            dataSize += sizeof( VulkanPipelineStatisticsRecordHeader ) + getPipelineStatisticsStageCount( pipelines[ i ].stageMask ) * sizeof( VulkanPipelineStageStatistics );
+        }
+
+        if( !pData->tryCreate( pAllocator, dataSize ) )
+        {
+            return ErrorId_OutOfMemory;
+        }
+
+        VulkanPipelineStatisticsDatabaseHeader header{};
+        header.magic            = VulkanPipelineStatisticsDatabaseMagic;
+        header.version          = VulkanPipelineStatisticsDatabaseVersion;
+        header.vendorId         = vendorId;
+        header.deviceId         = deviceId;
+        header.pipelineCount    = rangecheck_cast<uint32>( pipelines.getSize() );
+
+        // :JK: the records are packed - so everything is copied instead of written through pointers
+        uint8* pTarget = pData->getStart();
+        copyMemoryNonOverlapping( pTarget, &header, sizeof( header ) );
+        pTarget += sizeof( header );
+
+        for( size_t i = 0u; i < pipelines.getSize(); ++i )
+        {
+            const VulkanPipelineStatistics& pipeline = pipelines[ i ];
+
+            VulkanPipelineStatisticsRecordHeader recordHeader{};
+            recordHeader.pipelineHash   = pipeline.pipelineHash;
+            recordHeader.shaderCodeHash = pipeline.shaderCodeHash;
+            recordHeader.stageMask      = pipeline.stageMask;
+            copyMemoryNonOverlapping( pTarget, &recordHeader, sizeof( recordHeader ) );
+            pTarget += sizeof( recordHeader );
+
+            for( uint32 stageIndex = 0u; stageIndex < (uint32)VulkanPipelineStatisticsStage::Count; ++stageIndex )
+            {
+                if( pipeline.stageMask & ( 1u << stageIndex ) )
+                {
+                    copyMemoryNonOverlapping( pTarget, &pipeline.stages[ stageIndex ], sizeof( VulkanPipelineStageStatistics ) );
+                    pTarget += sizeof( VulkanPipelineStageStatistics );
+                }
+            }
+        }
+        KEEN_ASSERT( pTarget == pData->getStart() + dataSize );
+
+        return ErrorId_Ok;
+    }
+
+    Result<void> vulkan::readPipelineStatisticsDatabase( VulkanPipelineStatisticsSet* pSet, uint32* pVendorId, uint32* pDeviceId, ConstMemoryBlock data )
+    {
+        if( data.size < sizeof( VulkanPipelineStatisticsDatabaseHeader ) )
+        {
+            return ErrorId_BufferTooSmall;
+        }
+
+        VulkanPipelineStatisticsDatabaseHeader header;
+        copyMemoryNonOverlapping( &header, data.pStart, sizeof( header ) );
+        if( header.magic != VulkanPipelineStatisticsDatabaseMagic )
+        {
+            return ErrorId_Generic;
+        }
+        if( header.version != VulkanPipelineStatisticsDatabaseVersion )
+        {
+            return ErrorId_WrongVersion;
+        }
+
+        *pVendorId  = header.vendorId;
+        *pDeviceId  = header.deviceId;
+
+        const uint8* pSource    = data.pStart + sizeof( header );
+        const uint8* pEnd       = data.pStart + data.size;
+        for( uint32 pipelineIndex = 0u; pipelineIndex < header.pipelineCount; ++pipelineIndex )
+        {
+            if( (size_t)( pEnd - pSource ) < sizeof( VulkanPipelineStatisticsRecordHeader ) )
+            {
+                return ErrorId_BufferTooSmall;
+            }
+
+            VulkanPipelineStatisticsRecordHeader recordHeader;
+            copyMemoryNonOverlapping( &recordHeader, pSource, sizeof( recordHeader ) );
+            pSource += sizeof( recordHeader );
+
+            const uint32 stageMask = recordHeader.stageMask & ( ( 1u << (uint32)VulkanPipelineStatisticsStage::Count ) - 1u );
+            if( (size_t)( pEnd - pSource ) < getPipelineStatisticsStageCount( stageMask ) * sizeof( VulkanPipelineStageStatistics ) )
+            {
+                return ErrorId_BufferTooSmall;
+            }
+
+            VulkanPipelineStatistics pipeline{};
+            pipeline.pipelineHash   = recordHeader.pipelineHash;
+            pipeline.shaderCodeHash = recordHeader.shaderCodeHash;
+            pipeline.stageMask      = stageMask;
+
+            for( uint32 stageIndex = 0u; stageIndex < (uint32)VulkanPipelineStatisticsStage::Count; ++stageIndex )
+            {
+                if( stageMask & ( 1u << stageIndex ) )
+                {
+                    copyMemoryNonOverlapping( &pipeline.stages[ stageIndex ], pSource, sizeof( VulkanPipelineStageStatistics ) );
+                    pSource += sizeof( VulkanPipelineStageStatistics );
+                }
+            }
+
+            if( !updatePipelineStatistics( pSet, pipeline ) )
+            {
+                return ErrorId_OutOfMemory;
+            }
+        }
+
+        return ErrorId_Ok;
+    }
+
+    static bool isStageStatisticsRegression( const VulkanPipelineStageStatistics& baseline, const VulkanPipelineStageStatistics& current, const VulkanPipelineStatisticsThresholds& thresholds )
+    {
+        if( current.registerCount > baseline.registerCount + thresholds.registerCountIncrease ||
+            current.scalarRegisterCount > baseline.scalarRegisterCount + thresholds.registerCountIncrease )
+        {
+            return true;
+        }
+
+        // any new spill is reported:
+        if( current.spilledRegisterCount > baseline.spilledRegisterCount )
+        {
+            return true;
+        }
+
+        return current.scratchSizeInBytes > baseline.scratchSizeInBytes + thresholds.scratchSizeIncrease;
+    }
+
+    bool vulkan::comparePipelineStatistics( DynamicArray<VulkanPipelineStatisticsRegression>* pRegressions, VulkanPipelineStatisticsSet* pBaseline, ArrayView<const VulkanPipelineStatistics> current, const VulkanPipelineStatisticsThresholds& thresholds )
+    {
+        KEEN_PROFILE_CPU( Vk_comparePipelineStatistics );
+
+        for( size_t currentIndex = 0u; currentIndex < current.getSize(); ++currentIndex )
+        {
+            const VulkanPipelineStatistics* pCurrent = &current[ currentIndex ];
+            const VulkanPipelineStatistics* pBaselinePipeline = findPipelineStatistics( pBaseline, pCurrent->pipelineHash );
+
+            // :JK: unchanged shaders are compared as well - driver updates can regress them too
+            if( pBaselinePipeline == nullptr )
+            {
+                continue;
+            }
+
+            const uint32 stageMask = pBaselinePipeline->stageMask & pCurrent->stageMask;
+            for( uint32 stageIndex = 0u; stageIndex < (uint32)VulkanPipelineStatisticsStage::Count; ++stageIndex )
+            {
+                if( !( stageMask & ( 1u << stageIndex ) ) || !isStageStatisticsRegression( pBaselinePipeline->stages[ stageIndex ], pCurrent->stages[ stageIndex ], thresholds ) )
+                {
+                    continue;
+                }
+
+                VulkanPipelineStatisticsRegression* pRegression = pRegressions->pushBackZero();
+                if( pRegression == nullptr )
+                {
+                    return false;
+                }
+                pRegression->pBaseline  = pBaselinePipeline;
+                pRegression->pCurrent   = pCurrent;
+                pRegression->stage      = (VulkanPipelineStatisticsStage)stageIndex;
+            }
+        }
+
+        return true;
+    }
+
+    const char* vulkan::getPipelineStatisticsStageName( VulkanPipelineStatisticsStage stage )
+    {
+        switch( stage )
+        {
+        case VulkanPipelineStatisticsStage::Vertex:                 return "vertex";
+        case VulkanPipelineStatisticsStage::TessellationControl:    return "tessellation control";
+        case VulkanPipelineStatisticsStage::TessellationEvaluation: return "tessellation evaluation";
+        case VulkanPipelineStatisticsStage::Fragment:               return "fragment";
+        case VulkanPipelineStatisticsStage::Task:                   return "task";
+        case VulkanPipelineStatisticsStage::Mesh:                   return "mesh";
+        case VulkanPipelineStatisticsStage::Compute:                return "compute";
+        case VulkanPipelineStatisticsStage::Count:                  break;
+        }
+        return "unknown";
+    }
+
+}
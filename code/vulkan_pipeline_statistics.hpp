@@ -0,0 +1,88 @@
+#ifndef KEEN_VULKAN_PIPELINE_STATISTICS_HPP_INCLUDED
+#define KEEN_VULKAN_PIPELINE_STATISTICS_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+
+#include "keen/base/map.hpp"
+
+namespace keen
+{
+
+    enum class VulkanPipelineStatisticsStage : uint8
+    {
+        Vertex,
+        TessellationControl,
+        TessellationEvaluation,
+        Fragment,
+        Task,
+        Mesh,
+        Compute,
+
+        Count
+    };
+
+    // the subset of the driver statistics that is comparable between vendors - zero when the driver doesn't report a value:
+    struct VulkanPipelineStageStatistics
+    {
+        uint32                          registerCount;          // vector registers on amd
+        uint32                          scalarRegisterCount;
+        uint32                          spilledRegisterCount;
+        uint32                          scratchSizeInBytes;     // scratch / local memory (mostly caused by register spilling)
+        uint32                          instructionCount;       // code size in bytes when the driver doesn't report instructions
+    };
+
+    struct VulkanPipelineStatistics
+    {
+        uint64                          pipelineHash;           // hash of the pipeline name + permutation key (without the shader code) - stays the same between builds
+        uint64                          shaderCodeHash;
+        uint32                          stageMask;              // one bit per VulkanPipelineStatisticsStage
+        VulkanPipelineStageStatistics   stages[ (size_t)VulkanPipelineStatisticsStage::Count ];
+        DebugName                       debugName;              // not stored in the database
+    };
+
+    // the statistics of all pipelines - indexed by the pipeline hash:
+    struct VulkanPipelineStatisticsSet
+    {
+        DynamicArray<VulkanPipelineStatistics>  pipelines;
+        Map<HashKey64, uint32>                  pipelineIndices;
+    };
+
+    struct VulkanPipelineStatisticsThresholds
+    {
+        uint32                          registerCountIncrease = 0u;     // register count increases larger than this are reported
+        uint32                          scratchSizeIncrease = 0u;
+    };
+
+    struct VulkanPipelineStatisticsRegression
+    {
+        const VulkanPipelineStatistics* pBaseline;
+        const VulkanPipelineStatistics* pCurrent;
+        VulkanPipelineStatisticsStage   stage;
+    };
+
+    namespace vulkan
+    {
+
+        // pipeline has to be created with VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR to get the executable statistics:
+        void            collectPipelineStatistics( VulkanPipelineStatistics* pStatistics, VulkanApi* pVulkan, VkPipeline pipeline, VkShaderStageFlags shaderStages );
+
+        void            createPipelineStatisticsSet( VulkanPipelineStatisticsSet* pSet, MemoryAllocator* pAllocator );
+        void            destroyPipelineStatisticsSet( VulkanPipelineStatisticsSet* pSet );
+
+        // inserts or replaces the entry with the same pipeline hash:
+        bool            updatePipelineStatistics( VulkanPipelineStatisticsSet* pSet, const VulkanPipelineStatistics& statistics );
+        const VulkanPipelineStatistics* findPipelineStatistics( VulkanPipelineStatisticsSet* pSet, uint64 pipelineHash );
+
+        Result<void>    writePipelineStatisticsDatabase( Array<uint8>* pData, MemoryAllocator* pAllocator, ArrayView<const VulkanPipelineStatistics> pipelines, uint32 vendorId, uint32 deviceId );
+        Result<void>    readPipelineStatisticsDatabase( VulkanPipelineStatisticsSet* pSet, uint32* pVendorId, uint32* pDeviceId, ConstMemoryBlock data );
+
+        // reports every stage of a pipeline that exists in both sets and got more registers, spills or scratch memory:
+        bool            comparePipelineStatistics( DynamicArray<VulkanPipelineStatisticsRegression>* pRegressions, VulkanPipelineStatisticsSet* pBaseline, ArrayView<const VulkanPipelineStatistics> current, const VulkanPipelineStatisticsThresholds& thresholds );
+
+        const char*     getPipelineStatisticsStageName( VulkanPipelineStatisticsStage stage );
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,162 @@
+#include "vulkan_pipeline_statistics.hpp"
+
+#include "keen/base/tls_allocator_scope.hpp"
+#include "keen/base/unit_test.hpp"
+
+
+namespace keen
+{
+    class VulkanPipelineStatisticsTestFixture : public UnitTest
+    {
+    protected:
+        static VulkanPipelineStatistics createStatistics( uint64 pipelineHash, uint32 registerCount, uint32 scratchSizeInBytes )
+        {
+            VulkanPipelineStatistics statistics{};
+            statistics.pipelineHash     = pipelineHash;
+            statistics.shaderCodeHash   = pipelineHash * 3u;
+            statistics.stageMask        = ( 1u << (uint32)VulkanPipelineStatisticsStage::Vertex ) | ( 1u << (uint32)VulkanPipelineStatisticsStage::Fragment );
+
+            VulkanPipelineStageStatistics* pVertexStage = &statistics.stages[ (size_t)VulkanPipelineStatisticsStage::Vertex ];
+            pVertexStage->registerCount         = 24u;
+            pVertexStage->instructionCount      = 100u;
+
+            VulkanPipelineStageStatistics* pFragmentStage = &statistics.stages[ (size_t)VulkanPipelineStatisticsStage::Fragment ];
+            pFragmentStage->registerCount       = registerCount;
+            pFragmentStage->scratchSizeInBytes  = scratchSizeInBytes;
+            pFragmentStage->instructionCount    = 200u;
+            return statistics;
+        }
+    };
+
+    KEEN_UNIT_TEST_F( VulkanPipelineStatisticsTestFixture, testUpdate )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        VulkanPipelineStatisticsSet currentSet;
+        vulkan::createPipelineStatisticsSet( &currentSet, &stackAllocator );
+
+        KEEN_UT_CHECK( vulkan::updatePipelineStatistics( &currentSet, createStatistics( 1u, 32u, 0u ) ) );
+        KEEN_UT_CHECK( vulkan::updatePipelineStatistics( &currentSet, createStatistics( 2u, 32u, 0u ) ) );
+        KEEN_UT_CHECK( vulkan::findPipelineStatistics( &currentSet, 3u ) == nullptr );
+
+        // the same pipeline hash replaces the entry:
+        KEEN_UT_CHECK( vulkan::updatePipelineStatistics( &currentSet, createStatistics( 1u, 48u, 0u ) ) );
+        KEEN_UT_COMPARE_UINT32( (uint32)currentSet.pipelines.getCount(), 2u );
+
+        const VulkanPipelineStatistics* pStatistics = vulkan::findPipelineStatistics( &currentSet, 1u );
+        KEEN_UT_CHECK( pStatistics != nullptr && pStatistics->stages[ (size_t)VulkanPipelineStatisticsStage::Fragment ].registerCount == 48u );
+
+        // a pipeline that was looked up before is still added:
+        KEEN_UT_CHECK( vulkan::updatePipelineStatistics( &currentSet, createStatistics( 3u, 32u, 0u ) ) );
+        KEEN_UT_CHECK( vulkan::findPipelineStatistics( &currentSet, 3u ) != nullptr );
+        KEEN_UT_COMPARE_UINT32( (uint32)currentSet.pipelines.getCount(), 3u );
+
+        vulkan::destroyPipelineStatisticsSet( &currentSet );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanPipelineStatisticsTestFixture, testDatabaseRoundTrip )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        VulkanPipelineStatisticsSet currentSet;
+        vulkan::createPipelineStatisticsSet( &currentSet, &stackAllocator );
+
+        VulkanPipelineStatistics computeStatistics{};
+        computeStatistics.pipelineHash  = 3u;
+        computeStatistics.stageMask     = 1u << (uint32)VulkanPipelineStatisticsStage::Compute;
+        computeStatistics.stages[ (size_t)VulkanPipelineStatisticsStage::Compute ].spilledRegisterCount = 5u;
+
+        vulkan::updatePipelineStatistics( &currentSet, createStatistics( 1u, 32u, 64u ) );
+        vulkan::updatePipelineStatistics( &currentSet, createStatistics( 2u, 40u, 0u ) );
+        vulkan::updatePipelineStatistics( &currentSet, computeStatistics );
+
+        Array<uint8> data;
+        KEEN_UT_CHECK( vulkan::writePipelineStatisticsDatabase( &data, &stackAllocator, currentSet.pipelines, 0x1002u, 0x73bfu ).isOk() );
+
+        VulkanPipelineStatisticsSet baselineSet;
+        vulkan::createPipelineStatisticsSet( &baselineSet, &stackAllocator );
+
+        uint32 vendorId = 0u;
+        uint32 deviceId = 0u;
+        KEEN_UT_CHECK( vulkan::readPipelineStatisticsDatabase( &baselineSet, &vendorId, &deviceId, data.getMemory() ).isOk() );
+        KEEN_UT_COMPARE_UINT32( vendorId, 0x1002u );
+        KEEN_UT_COMPARE_UINT32( deviceId, 0x73bfu );
+        KEEN_UT_COMPARE_UINT32( (uint32)baselineSet.pipelines.getCount(), 3u );
+
+        for( size_t i = 0u; i < currentSet.pipelines.getCount(); ++i )
+        {
+            const VulkanPipelineStatistics& expected = currentSet.pipelines[ i ];
+            const VulkanPipelineStatistics* pRead = vulkan::findPipelineStatistics( &baselineSet, expected.pipelineHash );
+            KEEN_UT_CHECK( pRead != nullptr );
+            if( pRead == nullptr )
+            {
+                continue;
+            }
+            KEEN_UT_CHECK( pRead->shaderCodeHash == expected.shaderCodeHash );
+            KEEN_UT_COMPARE_UINT32( pRead->stageMask, expected.stageMask );
+            for( size_t stageIndex = 0u; stageIndex < (size_t)VulkanPipelineStatisticsStage::Count; ++stageIndex )
+            {
+                KEEN_UT_COMPARE_UINT32( pRead->stages[ stageIndex ].registerCount, expected.stages[ stageIndex ].registerCount );
+                KEEN_UT_COMPARE_UINT32( pRead->stages[ stageIndex ].spilledRegisterCount, expected.stages[ stageIndex ].spilledRegisterCount );
+                KEEN_UT_COMPARE_UINT32( pRead->stages[ stageIndex ].scratchSizeInBytes, expected.stages[ stageIndex ].scratchSizeInBytes );
+                KEEN_UT_COMPARE_UINT32( pRead->stages[ stageIndex ].instructionCount, expected.stages[ stageIndex ].instructionCount );
+            }
+        }
+
+        // truncated data is rejected:
+        VulkanPipelineStatisticsSet truncatedSet;
+        vulkan::createPipelineStatisticsSet( &truncatedSet, &stackAllocator );
+        ConstMemoryBlock truncatedData = data.getMemory();
+        truncatedData.size -= 4u;
+        KEEN_UT_CHECK( vulkan::readPipelineStatisticsDatabase( &truncatedSet, &vendorId, &deviceId, truncatedData ).hasError() );
+
+        vulkan::destroyPipelineStatisticsSet( &truncatedSet );
+        vulkan::destroyPipelineStatisticsSet( &baselineSet );
+        vulkan::destroyPipelineStatisticsSet( &currentSet );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanPipelineStatisticsTestFixture, testCompare )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        VulkanPipelineStatisticsSet baselineSet;
+        VulkanPipelineStatisticsSet currentSet;
+        vulkan::createPipelineStatisticsSet( &baselineSet, &stackAllocator );
+        vulkan::createPipelineStatisticsSet( &currentSet, &stackAllocator );
+
+        vulkan::updatePipelineStatistics( &baselineSet, createStatistics( 1u, 32u, 0u ) );
+        vulkan::updatePipelineStatistics( &baselineSet, createStatistics( 2u, 32u, 0u ) );
+        vulkan::updatePipelineStatistics( &baselineSet, createStatistics( 3u, 32u, 256u ) );
+
+        vulkan::updatePipelineStatistics( &currentSet, createStatistics( 1u, 32u, 0u ) );      // unchanged
+        vulkan::updatePipelineStatistics( &currentSet, createStatistics( 2u, 36u, 0u ) );      // more registers
+        vulkan::updatePipelineStatistics( &currentSet, createStatistics( 3u, 32u, 512u ) );    // more scratch memory
+        vulkan::updatePipelineStatistics( &currentSet, createStatistics( 4u, 128u, 0u ) );     // not in the baseline
+
+        DynamicArray<VulkanPipelineStatisticsRegression> regressions;
+        regressions.create( &stackAllocator );
+
+        VulkanPipelineStatisticsThresholds thresholds;
+        KEEN_UT_CHECK( vulkan::comparePipelineStatistics( &regressions, &baselineSet, currentSet.pipelines, thresholds ) );
+        KEEN_UT_COMPARE_UINT32( (uint32)regressions.getCount(), 2u );
+        if( regressions.getCount() == 2u )
+        {
+            KEEN_UT_CHECK( regressions[ 0u ].pCurrent->pipelineHash == 2u );
+            KEEN_UT_CHECK( regressions[ 0u ].pBaseline->pipelineHash == 2u );
+            KEEN_UT_CHECK( regressions[ 0u ].stage == VulkanPipelineStatisticsStage::Fragment );
+            KEEN_UT_CHECK( regressions[ 1u ].pCurrent->pipelineHash == 3u );
+        }
+
+        // increases below the thresholds are not reported:
+        regressions.clear();
+        thresholds.registerCountIncrease    = 4u;
+        thresholds.scratchSizeIncrease      = 256u;
+        KEEN_UT_CHECK( vulkan::comparePipelineStatistics( &regressions, &baselineSet, currentSet.pipelines, thresholds ) );
+        KEEN_UT_COMPARE_UINT32( (uint32)regressions.getCount(), 0u );
+
+        regressions.destroy();
+        vulkan::destroyPipelineStatisticsSet( &currentSet );
+        vulkan::destroyPipelineStatisticsSet( &baselineSet );
+    }
+
+}
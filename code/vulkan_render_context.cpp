@@ -17,6 +17,7 @@ namespace keen
         KEEN_DEFINE_BOOL_VARIABLE( s_waitForGpu,        "vulkan/WaitForGpu", false, "" );
         KEEN_DEFINE_BOOL_VARIABLE( s_enableBreadcrumbs, "vulkan/enableBreadcrumbs", false, "" );
         KEEN_DEFINE_BOOL_VARIABLE( s_verboseQueueSubmit,"vulkan/verboseQueueSubmit", false, "" );
+        KEEN_DEFINE_BOOL_VARIABLE( s_enableCommandBufferCache, "vulkan/enableCommandBufferCache", true, "Replay cacheable command buffers from recorded secondary command buffers" );
 
 #if !defined( KEEN_BUILD_MASTER )
         KEEN_DEFINE_BOOL_VARIABLE( s_splitSubmission,   "vulkan/splitSubmission", false, "" );
@@ -35,9 +36,13 @@ namespace keen
         m_pSharedData       = parameters.pSharedData;
 
         KEEN_PROFILE_COUNTER_REGISTER( m_vulkanDescriptorSetCount, 0u, "Vk_DescriptorSetCount", false );
+        KEEN_PROFILE_COUNTER_REGISTER( m_cachedCommandBufferHitCount, 0u, "Vk_CachedCommandBufferHitCount", false );
+        KEEN_PROFILE_COUNTER_REGISTER( m_cachedCommandBufferMissCount, 0u, "Vk_CachedCommandBufferMissCount", false );
+        KEEN_PROFILE_COUNTER_REGISTER( m_coalescedTransferCallCount, 0u, "Vk_CoalescedTransferCallCount", false );
 
         m_currentFrameId                = 0u;
         m_isNonInteractiveApplication   = parameters.isNonInteractiveApplication;
+        m_generatedCommandsPreprocessPeakSize = 0u;
 
         size_t workerCount = 1u;
 
@@ -68,10 +73,13 @@ namespace keen
             // descriptor pool:
             const uint32 sampledImageDescriptorCount = ( m_frames.getCount32() + 1u ) * parameters.bindlessTextureCount;
             const uint32 samplerDescriptorCount = ( m_frames.getCount32() + 1u ) * parameters.bindlessSamplerCount;
+            // + one buffer address table per frame:
+            const uint32 storageBufferDescriptorCount = ( m_frames.getCount32() + 1u ) * parameters.bindlessStorageBufferCount + m_frames.getCount32();
             const VkDescriptorPoolSize poolSizes[] =
             {
                 { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, sampledImageDescriptorCount },
-                { VK_DESCRIPTOR_TYPE_SAMPLER, samplerDescriptorCount }
+                { VK_DESCRIPTOR_TYPE_SAMPLER, samplerDescriptorCount },
+                { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, storageBufferDescriptorCount }
             };
 
             VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
@@ -140,7 +148,8 @@ namespace keen
             if( !pFrame->destroyObjects.tryCreate( parameters.pAllocator, 1024u ) ||
                 !pFrame->commandPools.tryCreate( m_pAllocator, workerCount ) ||
                 !pFrame->bindlessTexturesDirtyMask.tryCreateClear( m_pAllocator, parameters.bindlessTextureCount ) ||
-                !pFrame->bindlessSamplersDirtyMask.tryCreateClear( m_pAllocator, parameters.bindlessSamplerCount ) )
+                !pFrame->bindlessSamplersDirtyMask.tryCreateClear( m_pAllocator, parameters.bindlessSamplerCount ) ||
+                !pFrame->bindlessStorageBuffersDirtyMask.tryCreateClear( m_pAllocator, parameters.bindlessStorageBufferCount ) )
             {
                 destroy();
                 return false;
@@ -189,6 +198,21 @@ namespace keen
                 return false;
             }
 
+            // the pool for the cached secondary command buffers is never reset as a whole:
+            {
+                VkCommandPoolCreateInfo commandPoolCreateInfo{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+                commandPoolCreateInfo.queueFamilyIndex  = m_pSharedData->graphicsQueueFamilyIndex;
+                commandPoolCreateInfo.flags             = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+                result = m_pVulkan->vkCreateCommandPool( m_device, &commandPoolCreateInfo, m_pSharedData->pVulkanAllocationCallbacks, &pFrame->cachedCommandPool );
+                if( result.hasError() )
+                {
+                    KEEN_TRACE_ERROR( "[graphics] vkCreateCommandPool failed with error '%s'\n", result );
+                    destroy();
+                    return false;
+                }
+            }
+
 #if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
             if( enableBreadcrumbs )
             {
@@ -218,9 +242,43 @@ namespace keen
                     return false;
                 }
 
+                // the buffer address table is rewritten by the cpu at the start of the frame - so we need one per frame:
+                GraphicsBufferParameters addressTableParameters;
+                addressTableParameters.sizeInBytes  = max( 1u, parameters.bindlessStorageBufferCount ) * sizeof( uint64 );
+                addressTableParameters.usage        = GraphicsBufferUsageFlag::StorageBuffer;
+                addressTableParameters.cpuAccess    = GraphicsAccessMode_WriteOnly;
+                addressTableParameters.debugName    = "BindlessBufferAddressTable"_debug;
+
+                pFrame->pBindlessBufferAddressTable = m_pObjects->createBuffer( addressTableParameters );
+                if( pFrame->pBindlessBufferAddressTable == nullptr )
+                {
+                    KEEN_TRACE_ERROR( "[graphics] Could not create the bindless buffer address table\n" );
+                    destroy();
+                    return false;
+                }
+                vulkan::fillUploadMemoryWithZero( pFrame->pBindlessBufferAddressTable->uploadCopyKernel, pFrame->pBindlessBufferAddressTable->pMappedMemory, addressTableParameters.sizeInBytes );
+
+                VkDescriptorBufferInfo addressTableInfo;
+                addressTableInfo.buffer = pFrame->pBindlessBufferAddressTable->buffer;
+                addressTableInfo.offset = 0u;
+                addressTableInfo.range  = VK_WHOLE_SIZE;
+
+                VkWriteDescriptorSet addressTableWrite = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+                addressTableWrite.dstSet            = pFrame->bindlessDescriptorSet;
+                addressTableWrite.dstBinding        = 3u;
+                addressTableWrite.dstArrayElement   = 0u;
+                addressTableWrite.descriptorCount   = 1u;
+                addressTableWrite.descriptorType    = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                addressTableWrite.pBufferInfo       = &addressTableInfo;
+                m_pVulkan->vkUpdateDescriptorSets( m_device, 1u, &addressTableWrite, 0u, nullptr );
+
                 // set the first bit as dirty - to write the error descriptor in the first frame:
                 pFrame->bindlessTexturesDirtyMask.set( 0u );
                 pFrame->bindlessSamplersDirtyMask.set( 0u );
+                if( parameters.bindlessStorageBufferCount > 0u )
+                {
+                    pFrame->bindlessStorageBuffersDirtyMask.set( 0u );
+                }
             }
 
             pFrame->pDescriptorPool = nullptr;
@@ -237,6 +295,19 @@ namespace keen
 
             KEEN_ASSERT( pFrame->isRunning == false );
 
+            if( pFrame->pBindlessBufferAddressTable != nullptr )
+            {
+                m_pObjects->destroyDeviceObject( pFrame->pBindlessBufferAddressTable );
+                pFrame->pBindlessBufferAddressTable = nullptr;
+            }
+
+            if( pFrame->pGeneratedCommandsPreprocessBuffer != nullptr )
+            {
+                m_pObjects->destroyDeviceObject( pFrame->pGeneratedCommandsPreprocessBuffer );
+                pFrame->pGeneratedCommandsPreprocessBuffer      = nullptr;
+                pFrame->generatedCommandsPreprocessBufferSize   = 0u;
+            }
+
             if( pFrame->pDescriptorPool != nullptr )
             {
                 VulkanDescriptorPool* pDescriptorPool = pFrame->pDescriptorPool;
@@ -256,6 +327,14 @@ namespace keen
             }
 #endif
 
+            if( pFrame->cachedCommandPool != VK_NULL_HANDLE )
+            {
+                // :JK: this frees all cached command buffers as well
+                m_pVulkan->vkDestroyCommandPool( m_device, pFrame->cachedCommandPool, m_pSharedData->pVulkanAllocationCallbacks );
+                pFrame->cachedCommandPool = VK_NULL_HANDLE;
+            }
+            pFrame->cachedCommandBuffers.clear();
+
             if( pFrame->commandPools.hasElements() )
             {
                 if( pFrame->mainCommandBuffer != VK_NULL_HANDLE )
@@ -303,6 +382,9 @@ namespace keen
         }
 
         KEEN_PROFILE_COUNTER_UNREGISTER( m_vulkanDescriptorSetCount );
+        KEEN_PROFILE_COUNTER_UNREGISTER( m_cachedCommandBufferHitCount );
+        KEEN_PROFILE_COUNTER_UNREGISTER( m_cachedCommandBufferMissCount );
+        KEEN_PROFILE_COUNTER_UNREGISTER( m_coalescedTransferCallCount );
     }
 
     VulkanFrame* VulkanRenderContext::beginFrame( ArrayView<GraphicsSwapChain*> swapChains )
@@ -326,6 +408,7 @@ namespace keen
         pFrame->swapChainInfo.imageAvailableSemaphores.clear();
         pFrame->swapChainInfo.waitStageMasks.clear();
         pFrame->swapChainInfo.imageIndices.clear();
+        pFrame->swapChainInfo.presentRegions.clear();
         pFrame->hasBrokenSwapChains = false;
 
         for( size_t i = 0u; i < swapChains.getCount(); ++i )
@@ -446,10 +529,34 @@ namespace keen
             submitInfo.pWaitSemaphores      = pFrame->swapChainInfo.imageAvailableSemaphores.getStart();
             submitInfo.pWaitDstStageMask    = pFrame->swapChainInfo.waitStageMasks.getStart();
         }
-        if( flags.isSet( SubmitCommandBufferFlag::IsLastCommandBuffer ) && pFrame->swapChainInfo.swapChains.hasElements() )
+        // the binary present semaphore and the timeline semaphores are signaled in the same submit - the value of the binary one is ignored:
+        DynamicArray<VkSemaphore,VulkanMaxFrameTimelineSemaphoreSignalCount + 1u>  signalSemaphores;
+        DynamicArray<uint64,VulkanMaxFrameTimelineSemaphoreSignalCount + 1u>       signalValues;
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+        if( flags.isSet( SubmitCommandBufferFlag::IsLastCommandBuffer ) )
         {
-            submitInfo.signalSemaphoreCount = 1u;
-            submitInfo.pSignalSemaphores    = &pFrame->renderingFinishedSemaphore;
+            if( pFrame->swapChainInfo.swapChains.hasElements() )
+            {
+                signalSemaphores.pushBack( pFrame->renderingFinishedSemaphore );
+                signalValues.pushBack( 0u );
+            }
+            for( size_t i = 0u; i < pFrame->timelineSignalSemaphores.getCount(); ++i )
+            {
+                signalSemaphores.pushBack( pFrame->timelineSignalSemaphores[ i ] );
+                signalValues.pushBack( pFrame->timelineSignalValues[ i ] );
+            }
+
+            submitInfo.signalSemaphoreCount = rangecheck_cast<uint32>( signalSemaphores.getCount() );
+            submitInfo.pSignalSemaphores    = signalSemaphores.getStart();
+
+            if( pFrame->timelineSignalSemaphores.hasElements() )
+            {
+                timelineSubmitInfo.signalSemaphoreValueCount    = submitInfo.signalSemaphoreCount;
+                timelineSubmitInfo.pSignalSemaphoreValues       = signalValues.getStart();
+                submitInfo.pNext = &timelineSubmitInfo;
+            }
+            pFrame->timelineSignalSemaphores.clear();
+            pFrame->timelineSignalValues.clear();
         }
 
         submitInfo.commandBufferCount   = 1u;
@@ -571,6 +678,15 @@ namespace keen
 
         recordStartOfFrameCommands( pFrame, commandBuffer );
 
+        // :JK: the breadcrumbs are written while recording - so replaying old recordings would leave them in a wrong state
+        bool useCommandBufferCache = vulkan::s_enableCommandBufferCache && pFrame->cachedCommandPool != VK_NULL_HANDLE;
+#if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
+        useCommandBufferCache &= pFrame->pBreadcrumbBuffer == nullptr;
+#endif
+        pFrame->cachedCommandBufferUseIndex += 1u;
+
+        VulkanTransferCoalescingStatistics transferStatistics;
+
         // :JK: it would be trivial to do this in parallel (task system) again when this ever becomes a bottleneck
         const GraphicsCommandBuffer* pCommandBuffer = pFrame->pFirstCommandBuffer;
         while( pCommandBuffer != nullptr )
@@ -580,16 +696,37 @@ namespace keen
             recordParameters.queueInfos             = m_pSharedData->queueInfos;
             recordParameters.bindlessDescriptorSet  = pFrame->bindlessDescriptorSet;
             recordParameters.emptyDescriptorSet     = m_pSharedData->emptyDescriptorSet;
+            recordParameters.pTransferStatistics    = &transferStatistics;
+            if( pFrame->pGeneratedCommandsPreprocessBuffer != nullptr )
+            {
+                recordParameters.generatedCommandsPreprocessAddress = pFrame->pGeneratedCommandsPreprocessBuffer->deviceAddress;
+                recordParameters.generatedCommandsPreprocessSize    = pFrame->generatedCommandsPreprocessBufferSize;
+            }
+            recordParameters.pGeneratedCommandsPreprocessUsedSize   = &pFrame->generatedCommandsPreprocessUsedSize;
 #if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
             recordParameters.pBreadcrumbBuffer  = pFrame->pBreadcrumbBuffer;
 #endif
-            vulkan::recordCommandBuffer( m_pVulkan, commandBuffer, pCommandBuffer, recordParameters );
+
+            const VkCommandBuffer cachedCommandBuffer = ( useCommandBufferCache && pCommandBuffer->isCacheable ) ? getCachedCommandBuffer( pFrame, pCommandBuffer, recordParameters ) : VK_NULL_HANDLE;
+            if( cachedCommandBuffer != VK_NULL_HANDLE )
+            {
+                m_pVulkan->vkCmdExecuteCommands( commandBuffer, 1u, &cachedCommandBuffer );
+            }
+            else
+            {
+                vulkan::recordCommandBuffer( m_pVulkan, commandBuffer, pCommandBuffer, recordParameters );
+            }
 
             pCommandBuffer = pCommandBuffer->pNextCommandBuffer;
         }
 
         recordEndOfFrameCommands( pFrame, commandBuffer );
 
+#if KEEN_USING( KEEN_PROFILER )
+        // :JK: replayed cached command buffers only count when they are recorded
+        atomic::add_uint32_ordered( &m_coalescedTransferCallCount, transferStatistics.getSavedCallCount() );
+#endif
+
         result = m_pVulkan->vkEndCommandBuffer( commandBuffer );
         if( result.hasError() )
         {
@@ -600,6 +737,125 @@ namespace keen
         submitCommandBuffer( pFrame, commandBuffer, { SubmitCommandBufferFlag::IsFirstCommandBuffer, SubmitCommandBufferFlag::IsLastCommandBuffer }, "Frame"_debug );
     }
 
+    void VulkanRenderContext::invalidateCachedCommandBuffers( VulkanFrame* pFrame )
+    {
+        // the command buffers are kept for the next recordings - the entries are just never found again and are the first ones evicted:
+        for( size_t i = 0u; i < pFrame->cachedCommandBuffers.getCount(); ++i )
+        {
+            pFrame->cachedCommandBuffers[ i ].key           = 0u;
+            pFrame->cachedCommandBuffers[ i ].lastUseIndex  = 0u;
+        }
+    }
+
+    VkCommandBuffer VulkanRenderContext::getCachedCommandBuffer( VulkanFrame* pFrame, const GraphicsCommandBuffer* pCommandBuffer, const VulkanRecordCommandBufferParameters& recordParameters )
+    {
+        KEEN_PROFILE_CPU( Vk_GetCachedCommandBuffer );
+
+        const uint64 key        = vulkan::computeCommandBufferKey( pCommandBuffer );
+        const uint32 useIndex   = pFrame->cachedCommandBufferUseIndex;
+
+        VulkanCachedCommandBuffer* pEntry = nullptr;
+        for( size_t i = 0u; i < pFrame->cachedCommandBuffers.getCount(); ++i )
+        {
+            if( pFrame->cachedCommandBuffers[ i ].key == key )
+            {
+                pEntry = &pFrame->cachedCommandBuffers[ i ];
+                break;
+            }
+        }
+
+        if( pEntry != nullptr && pEntry->lastUseIndex == useIndex )
+        {
+            // :JK: the secondary command buffers are not recorded with SIMULTANEOUS_USE - so each one can only be executed once per frame
+            return VK_NULL_HANDLE;
+        }
+
+        if( pEntry != nullptr && !pEntry->usesPreprocessBuffer )
+        {
+            KEEN_PROFILE_COUNTER_INC( m_cachedCommandBufferHitCount );
+            pEntry->lastUseIndex = useIndex;
+            return pEntry->commandBuffer;
+        }
+
+        KEEN_PROFILE_COUNTER_INC( m_cachedCommandBufferMissCount );
+
+        if( pEntry == nullptr )
+        {
+            if( pFrame->cachedCommandBuffers.getCount() < VulkanMaxCachedCommandBufferCount )
+            {
+                VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+                commandBufferAllocateInfo.commandPool           = pFrame->cachedCommandPool;
+                commandBufferAllocateInfo.level                 = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+                commandBufferAllocateInfo.commandBufferCount    = 1u;
+
+                VkCommandBuffer newCommandBuffer;
+                const VulkanResult result = m_pVulkan->vkAllocateCommandBuffers( m_device, &commandBufferAllocateInfo, &newCommandBuffer );
+                if( result.hasError() )
+                {
+                    KEEN_TRACE_ERROR( "[graphics] vkAllocateCommandBuffers failed with error '%s'\n", result );
+                    return VK_NULL_HANDLE;
+                }
+
+                pEntry = pFrame->cachedCommandBuffers.pushBackZero();
+                pEntry->commandBuffer = newCommandBuffer;
+            }
+            else
+            {
+                // reuse the least recently used entry that was not executed in this frame yet:
+                for( size_t i = 0u; i < pFrame->cachedCommandBuffers.getCount(); ++i )
+                {
+                    VulkanCachedCommandBuffer* pCandidate = &pFrame->cachedCommandBuffers[ i ];
+                    if( pCandidate->lastUseIndex != useIndex && ( pEntry == nullptr || pCandidate->lastUseIndex < pEntry->lastUseIndex ) )
+                    {
+                        pEntry = pCandidate;
+                    }
+                }
+
+                if( pEntry == nullptr )
+                {
+                    return VK_NULL_HANDLE;
+                }
+            }
+        }
+
+        // record the secondary command buffer - the pool allows resetting single command buffers so vkBeginCommandBuffer resets the old recording:
+        // :JK: no ONE_TIME_SUBMIT because the recording is replayed until it gets invalidated. The command buffer contains complete
+        // rendering scopes so it doesn't inherit anything from the primary command buffer.
+        VkCommandBufferInheritanceInfo inheritanceInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+
+        VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+        commandBufferBeginInfo.flags            = 0u;
+        commandBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+        pEntry->key             = key;
+        pEntry->lastUseIndex    = useIndex;
+
+        const uint64 preprocessUsedSize = recordParameters.pGeneratedCommandsPreprocessUsedSize != nullptr ? *recordParameters.pGeneratedCommandsPreprocessUsedSize : 0u;
+
+        VulkanResult result = m_pVulkan->vkBeginCommandBuffer( pEntry->commandBuffer, &commandBufferBeginInfo );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkBeginCommandBuffer failed with error '%s'\n", result );
+            pEntry->key = 0u;
+            return VK_NULL_HANDLE;
+        }
+
+        vulkan::recordCommandBuffer( m_pVulkan, pEntry->commandBuffer, pCommandBuffer, recordParameters );
+
+        // :JK: executes allocate their preprocess range from the frame while recording - so a replay would share the range with other executes
+        pEntry->usesPreprocessBuffer = recordParameters.pGeneratedCommandsPreprocessUsedSize != nullptr && *recordParameters.pGeneratedCommandsPreprocessUsedSize != preprocessUsedSize;
+
+        result = m_pVulkan->vkEndCommandBuffer( pEntry->commandBuffer );
+        if( result.hasError() )
+        {
+            KEEN_TRACE_ERROR( "[graphics] vkEndCommandBuffer failed with error '%s'\n", result );
+            pEntry->key = 0u;
+            return VK_NULL_HANDLE;
+        }
+
+        return pEntry->commandBuffer;
+    }
+
 #if !defined( KEEN_BUILD_MASTER )
     void VulkanRenderContext::recordAndSubmitCommandsSplit( VulkanFrame* pFrame )
     {
@@ -632,6 +888,12 @@ namespace keen
             VulkanRecordCommandBufferParameters recordParameters {};
             recordParameters.frameId            = pFrame->id;
             recordParameters.queueInfos         = m_pSharedData->queueInfos;
+            if( pFrame->pGeneratedCommandsPreprocessBuffer != nullptr )
+            {
+                recordParameters.generatedCommandsPreprocessAddress = pFrame->pGeneratedCommandsPreprocessBuffer->deviceAddress;
+                recordParameters.generatedCommandsPreprocessSize    = pFrame->generatedCommandsPreprocessBufferSize;
+            }
+            recordParameters.pGeneratedCommandsPreprocessUsedSize   = &pFrame->generatedCommandsPreprocessUsedSize;
 #if KEEN_USING( KEEN_GPU_BREADCRUMB_SUPPORT )
             recordParameters.pBreadcrumbBuffer  = pFrame->pBreadcrumbBuffer;
 #endif
@@ -688,21 +950,60 @@ namespace keen
         }
 #endif
 
+        // grow the preprocess buffer for device generated commands when a larger indirect commands layout was created or a previous
+        // frame needed more space for all of its executes:
+        if( m_pVulkan->EXT_device_generated_commands )
+        {
+            pFrame->generatedCommandsPreprocessUsedSize = 0u;
+
+            const uint64 preprocessSize = max( m_pObjects->getMaxGeneratedCommandsPreprocessSize(), m_generatedCommandsPreprocessPeakSize );
+            if( preprocessSize > pFrame->generatedCommandsPreprocessBufferSize )
+            {
+                KEEN_PROFILE_CPU( Vk_GrowPreprocessBuffer );
+
+                // :JK: the frame is not running anymore - so the old buffer can be destroyed right away
+                if( pFrame->pGeneratedCommandsPreprocessBuffer != nullptr )
+                {
+                    m_pObjects->destroyDeviceObject( pFrame->pGeneratedCommandsPreprocessBuffer );
+                    pFrame->pGeneratedCommandsPreprocessBuffer      = nullptr;
+                    pFrame->generatedCommandsPreprocessBufferSize   = 0u;
+                }
+
+                pFrame->pGeneratedCommandsPreprocessBuffer = m_pObjects->createGeneratedCommandsPreprocessBuffer( preprocessSize, "Vk_GeneratedCommandsPreprocessBuffer"_debug );
+                if( pFrame->pGeneratedCommandsPreprocessBuffer != nullptr )
+                {
+                    pFrame->generatedCommandsPreprocessBufferSize = preprocessSize;
+                }
+                else
+                {
+                    KEEN_TRACE_ERROR( "[graphics] Could not create the generated commands preprocess buffer (%,d bytes)!\n", preprocessSize );
+                }
+            }
+        }
+
         // update bindless descriptor sets:
         if( bindlessDescriptorSet.textures.hasElements() )
         {
             KEEN_PROFILE_CPU( Vk_BindlessDescriptorSet );
 
-            if( bindlessDescriptorSet.textureDirtyMask.hasSetBits() || bindlessDescriptorSet.samplerDirtyMask.hasSetBits() )
+            if( bindlessDescriptorSet.textureDirtyMask.hasSetBits() || bindlessDescriptorSet.samplerDirtyMask.hasSetBits() || bindlessDescriptorSet.storageBufferDirtyMask.hasSetBits() )
             {
                 // merge dirty mask into all frame dirty masks:
                 for( size_t frameIndex = 0u; frameIndex < m_frames.getSize(); ++frameIndex )
                 {
                     transferSetBits( &m_frames[ frameIndex ].bindlessTexturesDirtyMask, bindlessDescriptorSet.textureDirtyMask );
                     transferSetBits( &m_frames[ frameIndex ].bindlessSamplersDirtyMask, bindlessDescriptorSet.samplerDirtyMask );
+                    transferSetBits( &m_frames[ frameIndex ].bindlessStorageBuffersDirtyMask, bindlessDescriptorSet.storageBufferDirtyMask );
                 }
             }
 
+            // :JK: the bindless set is not UPDATE_AFTER_BIND - writing it invalidates the cached secondary command buffers that bound it:
+            if( pFrame->bindlessTexturesDirtyMask.hasSetBits() || pFrame->bindlessSamplersDirtyMask.hasSetBits() ||
+                ( pFrame->bindlessStorageBuffersDirtyMask.hasSetBits() && bindlessDescriptorSet.storageBuffers.hasElements() ) )
+            {
+                invalidateCachedCommandBuffers( pFrame );
+            }
+
             // update all dirty descriptors for this frame:
             if( pFrame->bindlessTexturesDirtyMask.hasSetBits() )
             {
@@ -827,6 +1128,77 @@ namespace keen
                     m_pVulkan->vkUpdateDescriptorSets( m_device, writes.getCount32(), writes.getStart(), 0u, nullptr );
                 }               
             }
+
+            if( pFrame->bindlessStorageBuffersDirtyMask.hasSetBits() && bindlessDescriptorSet.storageBuffers.hasElements() )
+            {
+                // write changed descriptors..
+                constexpr uint32 BindlessDescriptorWriteBatchCount = 64u;
+                DynamicArray<VkWriteDescriptorSet, BindlessDescriptorWriteBatchCount>   writes;
+                DynamicArray<VkDescriptorBufferInfo, BindlessDescriptorWriteBatchCount> bufferInfos;
+
+                const VulkanBuffer* pErrorBuffer = (const VulkanBuffer*)bindlessDescriptorSet.storageBuffers[ 0 ];
+
+                // the address table is written in the same loop - track the written range so we only flush that:
+                uint64* pAddressTable = (uint64*)pFrame->pBindlessBufferAddressTable->pMappedMemory;
+                const uint32 firstDirtyIndex = pFrame->bindlessStorageBuffersDirtyMask.findFirstSet();
+                uint32 lastDirtyIndex = firstDirtyIndex;
+
+                for( uint32 dirtyIndex = firstDirtyIndex; dirtyIndex != pFrame->bindlessStorageBuffersDirtyMask.getCount(); dirtyIndex = pFrame->bindlessStorageBuffersDirtyMask.findNextSet( dirtyIndex ) )
+                {
+                    if( bufferInfos.getCount() == BindlessDescriptorWriteBatchCount )
+                    {
+                        m_pVulkan->vkUpdateDescriptorSets( m_device, writes.getCount32(), writes.getStart(), 0u, nullptr );
+                        writes.clear();
+                        bufferInfos.clear();
+                    }
+
+                    const VulkanBuffer* pBuffer = (const VulkanBuffer*)bindlessDescriptorSet.storageBuffers[ dirtyIndex ];
+                    if( pBuffer == nullptr )
+                    {
+                        // write error buffer descriptor
+                        pBuffer = pErrorBuffer;
+                    }
+
+                    VkDescriptorBufferInfo bufferDescriptorInfo;
+                    bufferDescriptorInfo.buffer = pBuffer->buffer;
+                    bufferDescriptorInfo.offset = 0u;
+                    bufferDescriptorInfo.range  = VK_WHOLE_SIZE;
+
+                    const VkDescriptorBufferInfo* pBufferInfo = bufferInfos.pushBack( bufferDescriptorInfo );
+                    KEEN_ASSERT( pBufferInfo != nullptr );
+
+                    VkWriteDescriptorSet write;
+                    write.sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                    write.pNext             = nullptr;
+                    write.dstSet            = pFrame->bindlessDescriptorSet;
+                    write.dstBinding        = 2u;
+                    write.dstArrayElement   = dirtyIndex;
+                    write.descriptorCount   = 1u;
+                    write.descriptorType    = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                    write.pImageInfo        = nullptr;
+                    write.pBufferInfo       = pBufferInfo;
+                    write.pTexelBufferView  = nullptr;
+                    writes.pushBack( write );
+
+                    // zero if the buffer has no device address (e.g. no GraphicsFeature::BufferDeviceAddress)
+                    pAddressTable[ dirtyIndex ] = pBuffer->deviceAddress;
+                    lastDirtyIndex = dirtyIndex;
+
+                    pFrame->bindlessStorageBuffersDirtyMask.clear( dirtyIndex );
+                }
+
+                KEEN_ASSERT( pFrame->bindlessStorageBuffersDirtyMask.getSetBitCount() == 0u );
+
+                if( writes.hasElements() )
+                {
+                    m_pVulkan->vkUpdateDescriptorSets( m_device, writes.getCount32(), writes.getStart(), 0u, nullptr );
+                }
+
+                VulkanGpuAllocation* pAllocation    = pFrame->pBindlessBufferAddressTable->allocation.pAllocation;
+                uint64 flushOffset                  = firstDirtyIndex * sizeof( uint64 );
+                uint64 flushSize                    = ( lastDirtyIndex - firstDirtyIndex + 1u ) * sizeof( uint64 );
+                m_pObjects->flushCpuMemoryCache( createArrayView( &pAllocation, 1u ), createArrayView( &flushOffset, 1u ), createArrayView( &flushSize, 1u ) );
+            }
         }
 
         {
@@ -855,6 +1227,9 @@ namespace keen
             recordAndSubmitCommands( pFrame );
         }
 
+        // :JK: the used size also counts the executes that were skipped because the buffer was too small - so the next frames fit them
+        m_generatedCommandsPreprocessPeakSize = max( m_generatedCommandsPreprocessPeakSize, pFrame->generatedCommandsPreprocessUsedSize );
+
         if( pFrame->swapChainInfo.swapChains.hasElements() )
         {
             KEEN_PROFILE_CPU( Vk_Present );
@@ -868,6 +1243,21 @@ namespace keen
             presentInfo.pSwapchains         = pFrame->swapChainInfo.swapChains.getStart();
             presentInfo.pImageIndices       = pFrame->swapChainInfo.imageIndices.getStart();
 
+            // only the damaged rectangles have to be composited (rectangleCount 0 means the full image):
+            DynamicArray<VkPresentRegionKHR,VulkanUsedSwapChainInfo::MaxSwapChainCount> presentRegions;
+            VkPresentRegionsKHR presentRegionsInfo = { VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR };
+            if( m_pVulkan->KHR_incremental_present )
+            {
+                KEEN_ASSERT( pFrame->swapChainInfo.presentRegions.getSize() == pFrame->swapChainInfo.swapChains.getSize() );
+                for( size_t i = 0u; i < pFrame->swapChainInfo.presentRegions.getSize(); ++i )
+                {
+                    presentRegions.pushBack( *pFrame->swapChainInfo.presentRegions[ i ] );
+                }
+                presentRegionsInfo.swapchainCount   = (uint32)presentRegions.getSize();
+                presentRegionsInfo.pRegions         = presentRegions.getStart();
+                presentInfo.pNext                   = &presentRegionsInfo;
+            }
+
             VulkanResult result = m_pVulkan->vkQueuePresentKHR( m_pSharedData->presentQueue, &presentInfo );
             if( result.hasError() )
             {
@@ -32,9 +32,11 @@ namespace keen
         bool                    enableBindlessDescriptors = false;
         uint32                  bindlessTextureCount = 0u;
         uint32                  bindlessSamplerCount = 0u;
+        uint32                  bindlessStorageBufferCount = 0u;
     };
 
     struct VulkanUsedSwapChainInfo;
+    struct VulkanRecordCommandBufferParameters;
 
     class VulkanRenderContext
     {
@@ -68,9 +70,13 @@ namespace keen
         Array<VulkanFrame>                      m_frames;
         uint32                                  m_currentFrameId;
         bool                                    m_isNonInteractiveApplication;
+        uint64                                  m_generatedCommandsPreprocessPeakSize;  // largest preprocess size all executes of a frame needed so far
 
 #if KEEN_USING( KEEN_PROFILER )
         uint32_atomic                           m_vulkanDescriptorSetCount;
+        uint32_atomic                           m_cachedCommandBufferHitCount;
+        uint32_atomic                           m_cachedCommandBufferMissCount;
+        uint32_atomic                           m_coalescedTransferCallCount;
 #endif
 
         void                                    executeFrame( VulkanFrame* pFrame, const GraphicsBindlessDescriptorSet& bindlessDescriptorSet );
@@ -80,6 +86,8 @@ namespace keen
         void                                    recordStartOfFrameCommands( VulkanFrame* pFrame, VkCommandBuffer commandBuffer );
         void                                    recordEndOfFrameCommands( VulkanFrame* pFrame, VkCommandBuffer commandBuffer );
         void                                    recordAndSubmitCommands( VulkanFrame* pFrame );
+        VkCommandBuffer                         getCachedCommandBuffer( VulkanFrame* pFrame, const GraphicsCommandBuffer* pCommandBuffer, const VulkanRecordCommandBufferParameters& recordParameters );
+        void                                    invalidateCachedCommandBuffers( VulkanFrame* pFrame );
 #if !defined( KEEN_BUILD_MASTER )
         void                                    recordAndSubmitCommandsSplit( VulkanFrame* pFrame );
 #endif
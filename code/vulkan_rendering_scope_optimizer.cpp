@@ -0,0 +1,384 @@
+#include "vulkan_rendering_scope_optimizer.hpp"
+#include "../global/graphics_command_buffer.hpp"
+#include "../global/graphics_system_private.hpp"
+
+namespace keen
+{
+
+    // commands that only change the state used by draws - they can be moved into a rendering scope
+    static bool isRenderingStateCommand( GraphicsCommandId id )
+    {
+        switch( id )
+        {
+        case GraphicsCommandId_SetViewport:
+        case GraphicsCommandId_SetScissorRectangle:
+        case GraphicsCommandId_SetShadingRate:
+        case GraphicsCommandId_SetStencilReference:
+        case GraphicsCommandId_SetStencilWriteMask:
+        case GraphicsCommandId_SetStencilCompareMask:
+        case GraphicsCommandId_SetCullMode:
+        case GraphicsCommandId_SetDepthState:
+        case GraphicsCommandId_SetStencilState:
+        case GraphicsCommandId_SetPrimitiveType:
+        case GraphicsCommandId_SetDepthBias:
+        case GraphicsCommandId_SetFillMode:
+        case GraphicsCommandId_SetBlendState:
+        case GraphicsCommandId_BindRenderPipeline:
+        case GraphicsCommandId_BindRenderDescriptorSets:
+        case GraphicsCommandId_BindRenderDescriptorSetsWithOffsets:
+        case GraphicsCommandId_PushConstants:
+        case GraphicsCommandId_BindVertexBuffer:
+        case GraphicsCommandId_BindVertexBuffers:
+        case GraphicsCommandId_BindIndexBuffer:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    // commands that can be between a clear and the rendering scope it is folded into (none of them reads or writes texture contents)
+    static bool isClearFoldingTransparentCommand( GraphicsCommandId id )
+    {
+        switch( id )
+        {
+        case GraphicsCommandId_PipelineBarrier:
+        case GraphicsCommandId_ClearColorTexture:
+        case GraphicsCommandId_ClearDepthTexture:
+            return true;
+
+        default:
+            return isRenderingStateCommand( id );
+        }
+    }
+
+    static bool isFullRenderArea( const GraphicsBeginRenderingCommand* pCommand )
+    {
+        const GraphicsRectangle& renderArea = pCommand->renderArea;
+        if( renderArea.width == 0u || renderArea.height == 0u )
+        {
+            return true;
+        }
+        return renderArea.x == 0 && renderArea.y == 0 && renderArea.width == pCommand->renderSize.x && renderArea.height == pCommand->renderSize.y;
+    }
+
+    static bool isClearRangeFoldable( const GraphicsTexture* pTexture, const GraphicsTextureSubresourceRange& range, const GraphicsBeginRenderingCommand* pCommand )
+    {
+        // LOAD_OP_CLEAR only clears the render area of the rendered layers:
+        if( !isFullRenderArea( pCommand ) || pCommand->viewMask != 0u )
+        {
+            return false;
+        }
+        const uint32 layerCount = max( pCommand->layerCount, 1u );
+        if( range.firstMipLevel != 0u || range.mipLevelCount != 1u || range.firstArrayLayer != 0u || range.arrayLayerCount != layerCount )
+        {
+            return false;
+        }
+
+        // ... and the render size can be smaller than the attachment (i.e. dynamic resolution or atlases):
+        GraphicsTextureSubresourceRange viewedRange = range;
+        graphics::resolveViewedTextureSubresourceRange( &pTexture, &viewedRange );
+        const uint32 levelWidth     = max( (uint32)pTexture->width >> viewedRange.firstMipLevel, 1u );
+        const uint32 levelHeight    = max( (uint32)pTexture->height >> viewedRange.firstMipLevel, 1u );
+        return levelWidth == pCommand->renderSize.x && levelHeight == pCommand->renderSize.y;
+    }
+
+    static bool isSameAttachment( const GraphicsRenderingAttachmentInfo& a, const GraphicsRenderingAttachmentInfo& b )
+    {
+        return a.pTexture == b.pTexture && a.pResolveTexture == b.pResolveTexture && a.textureLayout == b.textureLayout && a.resolveTextureLayout == b.resolveTextureLayout;
+    }
+
+    static bool areRenderingScopesMergeable( const GraphicsBeginRenderingCommand* pFirst, const GraphicsBeginRenderingCommand* pSecond )
+    {
+        if( pFirst->colorAttachmentCount != pSecond->colorAttachmentCount ||
+            pFirst->renderSize != pSecond->renderSize ||
+            pFirst->renderArea.x != pSecond->renderArea.x ||
+            pFirst->renderArea.y != pSecond->renderArea.y ||
+            pFirst->renderArea.width != pSecond->renderArea.width ||
+            pFirst->renderArea.height != pSecond->renderArea.height ||
+            pFirst->layerCount != pSecond->layerCount ||
+            pFirst->viewMask != pSecond->viewMask )
+        {
+            return false;
+        }
+
+        for( uint32 i = 0u; i < pFirst->colorAttachmentCount; ++i )
+        {
+            if( !isSameAttachment( pFirst->colorAttachments[ i ], pSecond->colorAttachments[ i ] ) )
+            {
+                return false;
+            }
+        }
+        if( !isSameAttachment( pFirst->depthAttachment, pSecond->depthAttachment ) ||
+            !isSameAttachment( pFirst->stencilAttachment, pSecond->stencilAttachment ) )
+        {
+            return false;
+        }
+
+        if( pFirst->shadingRateAttachment.pTexture != pSecond->shadingRateAttachment.pTexture ||
+            pFirst->shadingRateAttachment.textureLayout != pSecond->shadingRateAttachment.textureLayout ||
+            pFirst->shadingRateAttachment.texelSize != pSecond->shadingRateAttachment.texelSize )
+        {
+            return false;
+        }
+
+        const GraphicsRenderingInputAttachmentIndices& firstIndices     = pFirst->inputAttachmentIndices;
+        const GraphicsRenderingInputAttachmentIndices& secondIndices    = pSecond->inputAttachmentIndices;
+        if( firstIndices.isEnabled != secondIndices.isEnabled )
+        {
+            return false;
+        }
+        if( firstIndices.isEnabled )
+        {
+            if( firstIndices.depthInputIndex != secondIndices.depthInputIndex || firstIndices.stencilInputIndex != secondIndices.stencilInputIndex )
+            {
+                return false;
+            }
+            for( uint32 i = 0u; i < pFirst->colorAttachmentCount; ++i )
+            {
+                if( firstIndices.colorInputIndices[ i ] != secondIndices.colorInputIndices[ i ] )
+                {
+                    return false;
+                }
+            }
+        }
+
+        // the second scope has to continue with the content of the first one:
+        for( uint32 i = 0u; i < pSecond->colorAttachmentCount; ++i )
+        {
+            if( pSecond->colorAttachments[ i ].loadAction == GraphicsLoadAction::Clear )
+            {
+                return false;
+            }
+        }
+        if( ( pSecond->depthAttachment.pTexture != nullptr && pSecond->depthAttachment.loadAction == GraphicsLoadAction::Clear ) ||
+            ( pSecond->stencilAttachment.pTexture != nullptr && pSecond->stencilAttachment.loadAction == GraphicsLoadAction::Clear ) )
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    static VulkanRenderingScopePatch* getOrCreatePatch( VulkanRenderingScopeRewrite* pRewrite, const GraphicsBeginRenderingCommand* pCommand, size_t commandIndex )
+    {
+        VulkanCommandRewrite* pCommandRewrite = &pRewrite->commands[ commandIndex ];
+        if( pCommandRewrite->type == VulkanCommandRewriteType::PatchedBeginRendering )
+        {
+            return &pRewrite->patches[ pCommandRewrite->patchIndex ];
+        }
+        KEEN_ASSERT( pCommandRewrite->type == VulkanCommandRewriteType::Record );
+        KEEN_ASSERT( pRewrite->patchCount < pRewrite->patches.getCount() );
+
+        pCommandRewrite->type       = VulkanCommandRewriteType::PatchedBeginRendering;
+        pCommandRewrite->patchIndex = pRewrite->patchCount;
+        pRewrite->patchCount += 1u;
+
+        VulkanRenderingScopePatch* pPatch = &pRewrite->patches[ pCommandRewrite->patchIndex ];
+        for( uint32 i = 0u; i < pCommand->colorAttachmentCount; ++i )
+        {
+            pPatch->colorAttachments[ i ] = pCommand->colorAttachments[ i ];
+        }
+        pPatch->depthAttachment     = pCommand->depthAttachment;
+        pPatch->stencilAttachment   = pCommand->stencilAttachment;
+        return pPatch;
+    }
+
+    static bool tryFoldColorClear( VulkanRenderingScopeRewrite* pRewrite, const GraphicsClearColorTextureCommand* pClearCommand, const GraphicsBeginRenderingCommand* pBeginCommand, size_t beginCommandIndex )
+    {
+        if( !pClearCommand->range.aspectMask.isSet( GraphicsTextureAspectFlag::Color ) || !isClearRangeFoldable( pClearCommand->pTexture, pClearCommand->range, pBeginCommand ) )
+        {
+            return false;
+        }
+
+        for( uint32 i = 0u; i < pBeginCommand->colorAttachmentCount; ++i )
+        {
+            if( pBeginCommand->colorAttachments[ i ].pTexture != pClearCommand->pTexture )
+            {
+                continue;
+            }
+
+            // a scope that clears the attachment anyway makes the explicit clear redundant:
+            if( pBeginCommand->colorAttachments[ i ].loadAction != GraphicsLoadAction::Clear )
+            {
+                VulkanRenderingScopePatch* pPatch = getOrCreatePatch( pRewrite, pBeginCommand, beginCommandIndex );
+                pPatch->colorAttachments[ i ].loadAction        = GraphicsLoadAction::Clear;
+                pPatch->colorAttachments[ i ].clearValue.color  = pClearCommand->clearValue;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    static bool tryFoldDepthStencilClear( VulkanRenderingScopeRewrite* pRewrite, const GraphicsClearDepthTextureCommand* pClearCommand, const GraphicsBeginRenderingCommand* pBeginCommand, size_t beginCommandIndex )
+    {
+        const bool clearsDepth      = pClearCommand->range.aspectMask.isSet( GraphicsTextureAspectFlag::Depth );
+        const bool clearsStencil    = pClearCommand->range.aspectMask.isSet( GraphicsTextureAspectFlag::Stencil );
+        if( ( !clearsDepth && !clearsStencil ) || !isClearRangeFoldable( pClearCommand->pTexture, pClearCommand->range, pBeginCommand ) )
+        {
+            return false;
+        }
+
+        // every cleared aspect has to be an attachment of the scope:
+        if( ( clearsDepth && pBeginCommand->depthAttachment.pTexture != pClearCommand->pTexture ) ||
+            ( clearsStencil && pBeginCommand->stencilAttachment.pTexture != pClearCommand->pTexture ) )
+        {
+            return false;
+        }
+
+        if( clearsDepth && pBeginCommand->depthAttachment.loadAction != GraphicsLoadAction::Clear )
+        {
+            VulkanRenderingScopePatch* pPatch = getOrCreatePatch( pRewrite, pBeginCommand, beginCommandIndex );
+            pPatch->depthAttachment.loadAction          = GraphicsLoadAction::Clear;
+            pPatch->depthAttachment.clearValue.depth    = pClearCommand->clearValue;
+        }
+        if( clearsStencil && pBeginCommand->stencilAttachment.loadAction != GraphicsLoadAction::Clear )
+        {
+            // :JK: ClearDepthTexture always clears the stencil to zero
+            VulkanRenderingScopePatch* pPatch = getOrCreatePatch( pRewrite, pBeginCommand, beginCommandIndex );
+            pPatch->stencilAttachment.loadAction        = GraphicsLoadAction::Clear;
+            pPatch->stencilAttachment.clearValue.stencil = 0u;
+        }
+        return true;
+    }
+
+    static void foldClears( VulkanRenderingScopeRewrite* pRewrite, ArrayView<const GraphicsCommand* const> commands )
+    {
+        for( size_t clearIndex = 0u; clearIndex < commands.getCount(); ++clearIndex )
+        {
+            const GraphicsCommand* pClearCommand = commands[ clearIndex ];
+            if( pClearCommand->id != GraphicsCommandId_ClearColorTexture && pClearCommand->id != GraphicsCommandId_ClearDepthTexture )
+            {
+                continue;
+            }
+
+            // find the next rendering scope - the clear can only be folded if nothing in between touches texture contents:
+            size_t beginIndex = clearIndex + 1u;
+            while( beginIndex < commands.getCount() && commands[ beginIndex ]->id != GraphicsCommandId_BeginRendering && isClearFoldingTransparentCommand( commands[ beginIndex ]->id ) )
+            {
+                beginIndex += 1u;
+            }
+            if( beginIndex == commands.getCount() || commands[ beginIndex ]->id != GraphicsCommandId_BeginRendering )
+            {
+                continue;
+            }
+
+            const GraphicsBeginRenderingCommand* pBeginCommand = (const GraphicsBeginRenderingCommand*)commands[ beginIndex ];
+            if( pClearCommand->id == GraphicsCommandId_ClearColorTexture )
+            {
+                if( tryFoldColorClear( pRewrite, (const GraphicsClearColorTextureCommand*)pClearCommand, pBeginCommand, beginIndex ) )
+                {
+                    pRewrite->commands[ clearIndex ].type = VulkanCommandRewriteType::Skip;
+                    pRewrite->statistics.foldedColorClearCount += 1u;
+                }
+            }
+            else
+            {
+                if( tryFoldDepthStencilClear( pRewrite, (const GraphicsClearDepthTextureCommand*)pClearCommand, pBeginCommand, beginIndex ) )
+                {
+                    pRewrite->commands[ clearIndex ].type = VulkanCommandRewriteType::Skip;
+                    pRewrite->statistics.foldedDepthStencilClearCount += 1u;
+                }
+            }
+        }
+    }
+
+    static void mergeRenderingScopes( VulkanRenderingScopeRewrite* pRewrite, ArrayView<const GraphicsCommand* const> commands )
+    {
+        const size_t InvalidIndex = commands.getCount();
+
+        size_t firstBeginIndex  = InvalidIndex;    // BeginRendering of the merged scope
+        size_t lastBeginIndex   = InvalidIndex;    // BeginRendering of the last scope that was merged into it
+        size_t endIndex         = InvalidIndex;    // EndRendering of the last scope - invalid if something other than state commands followed
+
+        for( size_t commandIndex = 0u; commandIndex < commands.getCount(); ++commandIndex )
+        {
+            const GraphicsCommand* pCommand = commands[ commandIndex ];
+            switch( pCommand->id )
+            {
+            case GraphicsCommandId_BeginRendering:
+                {
+                    const GraphicsBeginRenderingCommand* pBeginCommand = (const GraphicsBeginRenderingCommand*)pCommand;
+                    if( endIndex != InvalidIndex &&
+                        pRewrite->commands[ commandIndex ].type == VulkanCommandRewriteType::Record &&
+                        areRenderingScopesMergeable( (const GraphicsBeginRenderingCommand*)commands[ lastBeginIndex ], pBeginCommand ) )
+                    {
+                        const GraphicsBeginRenderingCommand* pFirstBeginCommand = (const GraphicsBeginRenderingCommand*)commands[ firstBeginIndex ];
+
+                        // the merged scope stores like the last scope:
+                        VulkanRenderingScopePatch* pPatch = getOrCreatePatch( pRewrite, pFirstBeginCommand, firstBeginIndex );
+                        for( uint32 i = 0u; i < pBeginCommand->colorAttachmentCount; ++i )
+                        {
+                            pPatch->colorAttachments[ i ].storeAction = pBeginCommand->colorAttachments[ i ].storeAction;
+                        }
+                        pPatch->depthAttachment.storeAction     = pBeginCommand->depthAttachment.storeAction;
+                        pPatch->stencilAttachment.storeAction   = pBeginCommand->stencilAttachment.storeAction;
+
+                        pRewrite->commands[ endIndex ].type     = VulkanCommandRewriteType::Skip;
+                        pRewrite->commands[ commandIndex ].type = VulkanCommandRewriteType::Skip;
+                        pRewrite->statistics.mergedScopeCount += 1u;
+                    }
+                    else
+                    {
+                        firstBeginIndex = commandIndex;
+                    }
+                    lastBeginIndex  = commandIndex;
+                    endIndex        = InvalidIndex;
+                }
+                break;
+
+            case GraphicsCommandId_EndRendering:
+                endIndex = commandIndex;
+                break;
+
+            default:
+                if( !isRenderingStateCommand( pCommand->id ) )
+                {
+                    endIndex = InvalidIndex;
+                }
+                break;
+            }
+        }
+    }
+
+    bool vulkan::optimizeRenderingScopes( VulkanRenderingScopeRewrite* pRewrite, MemoryAllocator* pAllocator, ArrayView<const GraphicsCommand* const> commands )
+    {
+        KEEN_ASSERT( pRewrite != nullptr );
+
+        pRewrite->patchCount = 0u;
+        pRewrite->statistics = {};
+
+        uint32 beginRenderingCount = 0u;
+        for( size_t i = 0u; i < commands.getCount(); ++i )
+        {
+            if( commands[ i ]->id == GraphicsCommandId_BeginRendering )
+            {
+                beginRenderingCount += 1u;
+            }
+        }
+
+        if( !pRewrite->commands.tryCreateWithValue( pAllocator, commands.getCount(), VulkanCommandRewrite{} ) ||
+            !pRewrite->patches.tryCreate( pAllocator, beginRenderingCount ) )
+        {
+            destroyRenderingScopeRewrite( pRewrite );
+            return false;
+        }
+
+        if( beginRenderingCount > 0u )
+        {
+            // :JK: clears first - a scope that got a folded clear is never merged with the previous one (the clear is between them)
+            foldClears( pRewrite, commands );
+            mergeRenderingScopes( pRewrite, commands );
+        }
+
+        return true;
+    }
+
+    void vulkan::destroyRenderingScopeRewrite( VulkanRenderingScopeRewrite* pRewrite )
+    {
+        pRewrite->commands.destroy();
+        pRewrite->patches.destroy();
+        pRewrite->patchCount = 0u;
+    }
+
+}
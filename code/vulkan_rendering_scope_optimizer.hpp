@@ -0,0 +1,63 @@
+#ifndef KEEN_VULKAN_RENDERING_SCOPE_OPTIMIZER_HPP_INCLUDED
+#define KEEN_VULKAN_RENDERING_SCOPE_OPTIMIZER_HPP_INCLUDED
+
+#include "keen/base/array.hpp"
+#include "vulkan_api.hpp"
+
+namespace keen
+{
+    struct GraphicsCommand;
+
+    enum class VulkanCommandRewriteType : uint8
+    {
+        Record,                 // record the command as it is
+        Skip,                   // folded into the load action of a rendering scope or merged with the neighbouring scope
+        PatchedBeginRendering,  // BeginRendering with the attachment infos of the scope patch
+    };
+
+    struct VulkanCommandRewrite
+    {
+        VulkanCommandRewriteType            type = VulkanCommandRewriteType::Record;
+        uint32                              patchIndex = 0u;
+    };
+
+    // the attachment infos of a BeginRendering command with folded clears (load actions) and merged scopes (store actions of the last merged scope)
+    struct VulkanRenderingScopePatch
+    {
+        GraphicsRenderingAttachmentInfo     colorAttachments[ GraphicsLimits_MaxColorTargetCount ];
+        GraphicsRenderingAttachmentInfo     depthAttachment;
+        GraphicsRenderingAttachmentInfo     stencilAttachment;
+    };
+
+    struct VulkanRenderingScopeOptimizerStatistics
+    {
+        uint32                              foldedColorClearCount = 0u;
+        uint32                              foldedDepthStencilClearCount = 0u;
+        uint32                              mergedScopeCount = 0u;
+    };
+
+    struct VulkanRenderingScopeRewrite
+    {
+        Array<VulkanCommandRewrite>                 commands;       // one entry per command of the stream
+        Array<VulkanRenderingScopePatch>            patches;
+        uint32                                      patchCount = 0u;
+        VulkanRenderingScopeOptimizerStatistics     statistics;
+
+        bool                                        hasRewrites() const { return statistics.foldedColorClearCount + statistics.foldedDepthStencilClearCount + statistics.mergedScopeCount > 0u; }
+    };
+
+    namespace vulkan
+    {
+
+        // :JK: folds ClearColorTexture/ClearDepthTexture commands into the load action of the next rendering scope and merges adjacent
+        // rendering scopes on the same attachments that only have state commands in between. the command stream is not modified - the
+        // rewrite is applied while recording. clears are only folded into scopes that cover the whole cleared subresource: no render area,
+        // a render size that matches the extent of the cleared mip level and exactly the layers of the scope
+        bool        optimizeRenderingScopes( VulkanRenderingScopeRewrite* pRewrite, MemoryAllocator* pAllocator, ArrayView<const GraphicsCommand* const> commands );
+        void        destroyRenderingScopeRewrite( VulkanRenderingScopeRewrite* pRewrite );
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,306 @@
+#include "vulkan_rendering_scope_optimizer.hpp"
+#include "../global/graphics_command_buffer.hpp"
+#include "../global/graphics_system_private.hpp"
+
+#include "keen/base/tls_allocator_scope.hpp"
+#include "keen/base/unit_test.hpp"
+
+
+namespace keen
+{
+    class VulkanRenderingScopeOptimizerTestFixture : public UnitTest
+    {
+    public:
+        VulkanRenderingScopeOptimizerTestFixture()
+        {
+            // :JK: only the size is read - the textures don't need any vulkan handles
+            for( size_t i = 0u; i < 3u; ++i )
+            {
+                m_textures[ i ].width       = 1280u;
+                m_textures[ i ].height      = 720u;
+                m_textures[ i ].depth       = 1u;
+                m_textures[ i ].levelCount  = 1u;
+                m_textures[ i ].layerCount  = 1u;
+            }
+            m_pColorTexture     = &m_textures[ 0u ];
+            m_pOtherTexture     = &m_textures[ 1u ];
+            m_pDepthTexture     = &m_textures[ 2u ];
+
+            m_barrierCommand.id     = GraphicsCommandId_PipelineBarrier;
+            m_drawCommand.id        = GraphicsCommandId_Draw;
+            m_setViewportCommand.id = GraphicsCommandId_SetViewport;
+            m_endCommand.id         = GraphicsCommandId_EndRendering;
+        }
+
+    protected:
+        GraphicsTexture                 m_textures[ 3u ]{};
+        const GraphicsTexture*          m_pColorTexture;
+        const GraphicsTexture*          m_pOtherTexture;
+        const GraphicsTexture*          m_pDepthTexture;
+
+        GraphicsCommand                 m_barrierCommand{};
+        GraphicsCommand                 m_drawCommand{};
+        GraphicsCommand                 m_setViewportCommand{};
+        GraphicsCommand                 m_endCommand{};
+
+        void fillBeginRenderingCommand( GraphicsBeginRenderingCommand* pCommand, GraphicsLoadAction colorLoadAction, GraphicsLoadAction depthLoadAction )
+        {
+            *pCommand = {};
+            pCommand->id                                = GraphicsCommandId_BeginRendering;
+            pCommand->renderSize                        = { 1280u, 720u };
+            pCommand->layerCount                        = 1u;
+            pCommand->colorAttachmentCount              = 1u;
+            pCommand->colorAttachments[ 0u ].pTexture   = m_pColorTexture;
+            pCommand->colorAttachments[ 0u ].loadAction = colorLoadAction;
+            pCommand->colorAttachments[ 0u ].storeAction = GraphicsStoreAction::Store;
+            pCommand->depthAttachment.pTexture          = m_pDepthTexture;
+            pCommand->depthAttachment.loadAction        = depthLoadAction;
+            pCommand->depthAttachment.storeAction       = GraphicsStoreAction::Store;
+        }
+
+        void fillClearColorCommand( GraphicsClearColorTextureCommand* pCommand, const GraphicsTexture* pTexture, GraphicsColorClearValue clearValue )
+        {
+            *pCommand = {};
+            pCommand->id            = GraphicsCommandId_ClearColorTexture;
+            pCommand->pTexture      = pTexture;
+            pCommand->clearValue    = clearValue;
+            pCommand->range         = GraphicsTextureSubresourceRange{};
+        }
+
+        void fillClearDepthCommand( GraphicsClearDepthTextureCommand* pCommand, const GraphicsTexture* pTexture, GraphicsTextureAspectFlagMask aspectMask )
+        {
+            *pCommand = {};
+            pCommand->id                = GraphicsCommandId_ClearDepthTexture;
+            pCommand->pTexture          = pTexture;
+            pCommand->clearValue        = GraphicsDepthClearValue::One;
+            pCommand->range             = GraphicsTextureSubresourceRange{};
+            pCommand->range.aspectMask  = aspectMask;
+        }
+    };
+
+    KEEN_UNIT_TEST_F( VulkanRenderingScopeOptimizerTestFixture, testFoldColorClear )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        GraphicsClearColorTextureCommand clearCommand;
+        fillClearColorCommand( &clearCommand, m_pColorTexture, GraphicsColorClearValue::RGBA_One );
+        GraphicsBeginRenderingCommand beginCommand;
+        fillBeginRenderingCommand( &beginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+
+        const GraphicsCommand* commands[] = { &clearCommand, &m_barrierCommand, &beginCommand, &m_drawCommand, &m_endCommand };
+
+        VulkanRenderingScopeRewrite rewrite;
+        KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+        KEEN_UT_CHECK( rewrite.hasRewrites() );
+        KEEN_UT_COMPARE_UINT32( rewrite.statistics.foldedColorClearCount, 1u );
+        KEEN_UT_COMPARE_UINT32( rewrite.statistics.mergedScopeCount, 0u );
+
+        KEEN_UT_CHECK( rewrite.commands[ 0u ].type == VulkanCommandRewriteType::Skip );
+        KEEN_UT_CHECK( rewrite.commands[ 1u ].type == VulkanCommandRewriteType::Record );
+        KEEN_UT_CHECK( rewrite.commands[ 2u ].type == VulkanCommandRewriteType::PatchedBeginRendering );
+
+        const VulkanRenderingScopePatch& patch = rewrite.patches[ rewrite.commands[ 2u ].patchIndex ];
+        KEEN_UT_CHECK( patch.colorAttachments[ 0u ].loadAction == GraphicsLoadAction::Clear );
+        KEEN_UT_CHECK( patch.colorAttachments[ 0u ].clearValue.color == GraphicsColorClearValue::RGBA_One );
+        KEEN_UT_CHECK( patch.depthAttachment.loadAction == GraphicsLoadAction::Load );
+
+        vulkan::destroyRenderingScopeRewrite( &rewrite );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanRenderingScopeOptimizerTestFixture, testKeepUnfoldableClears )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        GraphicsClearColorTextureCommand clearCommand;
+        GraphicsBeginRenderingCommand beginCommand;
+        VulkanRenderingScopeRewrite rewrite;
+
+        // a draw between the clear and the scope might read the texture:
+        {
+            fillClearColorCommand( &clearCommand, m_pColorTexture, GraphicsColorClearValue::RGBA_Zero );
+            fillBeginRenderingCommand( &beginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+
+            const GraphicsCommand* commands[] = { &clearCommand, &m_drawCommand, &beginCommand, &m_endCommand };
+            KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+            KEEN_UT_CHECK( !rewrite.hasRewrites() );
+            vulkan::destroyRenderingScopeRewrite( &rewrite );
+        }
+
+        // the scope does not render to the cleared texture:
+        {
+            fillClearColorCommand( &clearCommand, m_pOtherTexture, GraphicsColorClearValue::RGBA_Zero );
+            fillBeginRenderingCommand( &beginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+
+            const GraphicsCommand* commands[] = { &clearCommand, &beginCommand, &m_endCommand };
+            KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+            KEEN_UT_CHECK( !rewrite.hasRewrites() );
+            vulkan::destroyRenderingScopeRewrite( &rewrite );
+        }
+
+        // LOAD_OP_CLEAR would only clear the render area:
+        {
+            fillClearColorCommand( &clearCommand, m_pColorTexture, GraphicsColorClearValue::RGBA_Zero );
+            fillBeginRenderingCommand( &beginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+            beginCommand.renderArea = { 0, 0, 640u, 720u };
+
+            const GraphicsCommand* commands[] = { &clearCommand, &beginCommand, &m_endCommand };
+            KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+            KEEN_UT_CHECK( !rewrite.hasRewrites() );
+            vulkan::destroyRenderingScopeRewrite( &rewrite );
+        }
+
+        // ... and only the render size of a larger texture (i.e. dynamic resolution):
+        {
+            fillClearColorCommand( &clearCommand, m_pColorTexture, GraphicsColorClearValue::RGBA_Zero );
+            fillBeginRenderingCommand( &beginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+            m_textures[ 0u ].width  = 1920u;
+            m_textures[ 0u ].height = 1080u;
+
+            const GraphicsCommand* commands[] = { &clearCommand, &beginCommand, &m_endCommand };
+            KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+            KEEN_UT_CHECK( !rewrite.hasRewrites() );
+            vulkan::destroyRenderingScopeRewrite( &rewrite );
+
+            m_textures[ 0u ].width  = 1280u;
+            m_textures[ 0u ].height = 720u;
+        }
+
+        // ... and only the rendered layers:
+        {
+            fillClearColorCommand( &clearCommand, m_pColorTexture, GraphicsColorClearValue::RGBA_Zero );
+            clearCommand.range.arrayLayerCount = 6u;
+            fillBeginRenderingCommand( &beginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+
+            const GraphicsCommand* commands[] = { &clearCommand, &beginCommand, &m_endCommand };
+            KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+            KEEN_UT_CHECK( !rewrite.hasRewrites() );
+            vulkan::destroyRenderingScopeRewrite( &rewrite );
+        }
+    }
+
+    KEEN_UNIT_TEST_F( VulkanRenderingScopeOptimizerTestFixture, testFoldDepthStencilClear )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        GraphicsClearDepthTextureCommand clearCommand;
+        GraphicsBeginRenderingCommand beginCommand;
+        VulkanRenderingScopeRewrite rewrite;
+
+        // the stencil aspect can't be folded into a scope without a stencil attachment:
+        {
+            fillClearDepthCommand( &clearCommand, m_pDepthTexture, { GraphicsTextureAspectFlag::Depth, GraphicsTextureAspectFlag::Stencil } );
+            fillBeginRenderingCommand( &beginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+
+            const GraphicsCommand* commands[] = { &clearCommand, &beginCommand, &m_endCommand };
+            KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+            KEEN_UT_CHECK( !rewrite.hasRewrites() );
+            vulkan::destroyRenderingScopeRewrite( &rewrite );
+        }
+
+        {
+            fillClearDepthCommand( &clearCommand, m_pDepthTexture, { GraphicsTextureAspectFlag::Depth, GraphicsTextureAspectFlag::Stencil } );
+            fillBeginRenderingCommand( &beginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::DontCare );
+            beginCommand.stencilAttachment              = beginCommand.depthAttachment;
+            beginCommand.stencilAttachment.loadAction   = GraphicsLoadAction::Load;
+
+            const GraphicsCommand* commands[] = { &clearCommand, &m_setViewportCommand, &beginCommand, &m_endCommand };
+            KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+            KEEN_UT_COMPARE_UINT32( rewrite.statistics.foldedDepthStencilClearCount, 1u );
+            KEEN_UT_CHECK( rewrite.commands[ 0u ].type == VulkanCommandRewriteType::Skip );
+            KEEN_UT_CHECK( rewrite.commands[ 2u ].type == VulkanCommandRewriteType::PatchedBeginRendering );
+
+            const VulkanRenderingScopePatch& patch = rewrite.patches[ rewrite.commands[ 2u ].patchIndex ];
+            KEEN_UT_CHECK( patch.depthAttachment.loadAction == GraphicsLoadAction::Clear );
+            KEEN_UT_CHECK( patch.depthAttachment.clearValue.depth == GraphicsDepthClearValue::One );
+            KEEN_UT_CHECK( patch.stencilAttachment.loadAction == GraphicsLoadAction::Clear );
+            KEEN_UT_COMPARE_UINT32( patch.stencilAttachment.clearValue.stencil, 0u );
+            vulkan::destroyRenderingScopeRewrite( &rewrite );
+        }
+    }
+
+    KEEN_UNIT_TEST_F( VulkanRenderingScopeOptimizerTestFixture, testMergeRenderingScopes )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        GraphicsBeginRenderingCommand firstBeginCommand;
+        fillBeginRenderingCommand( &firstBeginCommand, GraphicsLoadAction::Clear, GraphicsLoadAction::Clear );
+        GraphicsBeginRenderingCommand secondBeginCommand;
+        fillBeginRenderingCommand( &secondBeginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+        GraphicsBeginRenderingCommand thirdBeginCommand;
+        fillBeginRenderingCommand( &thirdBeginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+        thirdBeginCommand.depthAttachment.storeAction = GraphicsStoreAction::DontCare;
+
+        const GraphicsCommand* commands[] =
+        {
+            &firstBeginCommand, &m_drawCommand, &m_endCommand,
+            &m_setViewportCommand,
+            &secondBeginCommand, &m_drawCommand, &m_endCommand,
+            &thirdBeginCommand, &m_drawCommand, &m_endCommand,
+        };
+
+        VulkanRenderingScopeRewrite rewrite;
+        KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+        KEEN_UT_COMPARE_UINT32( rewrite.statistics.mergedScopeCount, 2u );
+
+        KEEN_UT_CHECK( rewrite.commands[ 0u ].type == VulkanCommandRewriteType::PatchedBeginRendering );
+        KEEN_UT_CHECK( rewrite.commands[ 2u ].type == VulkanCommandRewriteType::Skip );
+        KEEN_UT_CHECK( rewrite.commands[ 3u ].type == VulkanCommandRewriteType::Record );
+        KEEN_UT_CHECK( rewrite.commands[ 4u ].type == VulkanCommandRewriteType::Skip );
+        KEEN_UT_CHECK( rewrite.commands[ 6u ].type == VulkanCommandRewriteType::Skip );
+        KEEN_UT_CHECK( rewrite.commands[ 7u ].type == VulkanCommandRewriteType::Skip );
+        KEEN_UT_CHECK( rewrite.commands[ 9u ].type == VulkanCommandRewriteType::Record );
+
+        // the merged scope loads like the first and stores like the last scope:
+        const VulkanRenderingScopePatch& patch = rewrite.patches[ rewrite.commands[ 0u ].patchIndex ];
+        KEEN_UT_CHECK( patch.colorAttachments[ 0u ].loadAction == GraphicsLoadAction::Clear );
+        KEEN_UT_CHECK( patch.depthAttachment.loadAction == GraphicsLoadAction::Clear );
+        KEEN_UT_CHECK( patch.colorAttachments[ 0u ].storeAction == GraphicsStoreAction::Store );
+        KEEN_UT_CHECK( patch.depthAttachment.storeAction == GraphicsStoreAction::DontCare );
+
+        vulkan::destroyRenderingScopeRewrite( &rewrite );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanRenderingScopeOptimizerTestFixture, testKeepSeparateRenderingScopes )
+    {
+        TlsStackAllocatorScope stackAllocator;
+
+        GraphicsBeginRenderingCommand firstBeginCommand;
+        GraphicsBeginRenderingCommand secondBeginCommand;
+        VulkanRenderingScopeRewrite rewrite;
+
+        // a barrier between the scopes:
+        {
+            fillBeginRenderingCommand( &firstBeginCommand, GraphicsLoadAction::Clear, GraphicsLoadAction::Clear );
+            fillBeginRenderingCommand( &secondBeginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+
+            const GraphicsCommand* commands[] = { &firstBeginCommand, &m_endCommand, &m_barrierCommand, &secondBeginCommand, &m_endCommand };
+            KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+            KEEN_UT_CHECK( !rewrite.hasRewrites() );
+            vulkan::destroyRenderingScopeRewrite( &rewrite );
+        }
+
+        // different attachments:
+        {
+            fillBeginRenderingCommand( &firstBeginCommand, GraphicsLoadAction::Clear, GraphicsLoadAction::Clear );
+            fillBeginRenderingCommand( &secondBeginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+            secondBeginCommand.colorAttachments[ 0u ].pTexture = m_pOtherTexture;
+
+            const GraphicsCommand* commands[] = { &firstBeginCommand, &m_endCommand, &secondBeginCommand, &m_endCommand };
+            KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+            KEEN_UT_CHECK( !rewrite.hasRewrites() );
+            vulkan::destroyRenderingScopeRewrite( &rewrite );
+        }
+
+        // the second scope clears again:
+        {
+            fillBeginRenderingCommand( &firstBeginCommand, GraphicsLoadAction::Load, GraphicsLoadAction::Load );
+            fillBeginRenderingCommand( &secondBeginCommand, GraphicsLoadAction::Clear, GraphicsLoadAction::Load );
+
+            const GraphicsCommand* commands[] = { &firstBeginCommand, &m_endCommand, &secondBeginCommand, &m_endCommand };
+            KEEN_UT_CHECK( vulkan::optimizeRenderingScopes( &rewrite, &stackAllocator, commands ) );
+            KEEN_UT_CHECK( !rewrite.hasRewrites() );
+            vulkan::destroyRenderingScopeRewrite( &rewrite );
+        }
+    }
+
+}
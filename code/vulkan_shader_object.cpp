@@ -0,0 +1,125 @@
+#include "vulkan_shader_object.hpp"
+
+namespace keen
+{
+
+    VkShaderStageFlagBits vulkan::getShaderObjectStageFlagBits( VulkanShaderObjectStage stage )
+    {
+        switch( stage )
+        {
+        case VulkanShaderObjectStage_Vertex:                    return VK_SHADER_STAGE_VERTEX_BIT;
+        case VulkanShaderObjectStage_TessellationControl:       return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+        case VulkanShaderObjectStage_TessellationEvaluation:    return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+        case VulkanShaderObjectStage_Geometry:                  return VK_SHADER_STAGE_GEOMETRY_BIT;
+        case VulkanShaderObjectStage_Fragment:                  return VK_SHADER_STAGE_FRAGMENT_BIT;
+        case VulkanShaderObjectStage_Task:                      return VK_SHADER_STAGE_TASK_BIT_EXT;
+        case VulkanShaderObjectStage_Mesh:                      return VK_SHADER_STAGE_MESH_BIT_EXT;
+        case VulkanShaderObjectStage_Count:                     break;
+        }
+        KEEN_BREAK( "invalid VulkanShaderObjectStage" );
+        return VK_SHADER_STAGE_VERTEX_BIT;
+    }
+
+    VkShaderStageFlags vulkan::getShaderObjectBindStageMask( const VkPhysicalDeviceFeatures& enabledFeatures, bool isMeshShaderEnabled )
+    {
+        VkShaderStageFlags stageMask = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        if( enabledFeatures.tessellationShader )
+        {
+            stageMask |= VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+        }
+        if( enabledFeatures.geometryShader )
+        {
+            stageMask |= VK_SHADER_STAGE_GEOMETRY_BIT;
+        }
+        if( isMeshShaderEnabled )
+        {
+            stageMask |= VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT;
+        }
+        return stageMask;
+    }
+
+    void vulkan::fillShaderObjectPipeline( VulkanShaderObjectPipeline* pPipeline, const GraphicsRenderPipelineParameters& parameters, VkShaderStageFlags bindStageMask, bool isShadingRateEnabled )
+    {
+        zeroValue( pPipeline );
+
+        pPipeline->bindStageMask            = bindStageMask;
+        pPipeline->rasterizationSamples     = vulkan::getSampleCountFlagBits( parameters.sampleCount );
+        pPipeline->patchControlPoints       = parameters.patchSize;
+
+        // same as the pipeline state: both faces use the front masks
+        pPipeline->setStencilReference      = !parameters.dynamicState.isSet( GraphicsDynamicStateFlag::StencilReference );
+        pPipeline->setStencilCompareMask    = !parameters.dynamicState.isSet( GraphicsDynamicStateFlag::StencilCompareMask );
+        pPipeline->setStencilWriteMask      = !parameters.dynamicState.isSet( GraphicsDynamicStateFlag::StencilWriteMask );
+        pPipeline->stencilCompareMask       = parameters.frontStencil.testMask;
+        pPipeline->stencilWriteMask         = parameters.frontStencil.writeMask;
+
+        if( isShadingRateEnabled && !parameters.dynamicState.isSet( GraphicsDynamicStateFlag::ShadingRate ) )
+        {
+            pPipeline->setShadingRate               = true;
+            pPipeline->shadingRateSize              = vulkan::getFragmentShadingRateSize( parameters.shadingRate );
+            pPipeline->shadingRateCombinerOps[ 0u ] = vulkan::getFragmentShadingRateCombinerOp( parameters.shadingRateCombiners[ 0u ] );
+            pPipeline->shadingRateCombinerOps[ 1u ] = vulkan::getFragmentShadingRateCombinerOp( parameters.shadingRateCombiners[ 1u ] );
+        }
+    }
+
+    void vulkan::writeShaderObjectPipelineBind( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, const VulkanShaderObjectPipeline& pipeline, const VulkanRenderPipelineDynamicState& dynamicState )
+    {
+        VkShaderStageFlagBits   stages[ VulkanShaderObjectStage_Count ];
+        VkShaderEXT             shaders[ VulkanShaderObjectStage_Count ];
+        uint32                  stageCount = 0u;
+        for( uint32 stageIndex = 0u; stageIndex < VulkanShaderObjectStage_Count; ++stageIndex )
+        {
+            const VkShaderStageFlagBits stageBit = getShaderObjectStageFlagBits( (VulkanShaderObjectStage)stageIndex );
+            if( ( pipeline.bindStageMask & stageBit ) == 0u )
+            {
+                KEEN_ASSERT( pipeline.shaders[ stageIndex ] == VK_NULL_HANDLE );
+                continue;
+            }
+
+            stages[ stageCount ]    = stageBit;
+            shaders[ stageCount ]   = pipeline.shaders[ stageIndex ];
+            stageCount++;
+        }
+        pVulkan->vkCmdBindShadersEXT( commandBuffer, stageCount, stages, shaders );
+
+        // everything that the pipeline parameters describe:
+        const VulkanDynamicStateFeatureMask allFeatures = { VulkanDynamicStateFeature::ExtendedDynamicState, VulkanDynamicStateFeature::ExtendedDynamicState2, VulkanDynamicStateFeature::ExtendedDynamicState3, VulkanDynamicStateFeature::VertexInputDynamicState };
+        writeRenderPipelineDynamicState( pVulkan, commandBuffer, allFeatures, dynamicState );
+
+        // the state that compileRenderPipeline always bakes with the same value:
+        pVulkan->vkCmdSetRasterizerDiscardEnableEXT( commandBuffer, VK_FALSE );
+        pVulkan->vkCmdSetPrimitiveRestartEnableEXT( commandBuffer, VK_FALSE );
+        pVulkan->vkCmdSetDepthBoundsTestEnableEXT( commandBuffer, VK_FALSE );
+        pVulkan->vkCmdSetDepthClampEnableEXT( commandBuffer, VK_FALSE );
+        pVulkan->vkCmdSetLineWidth( commandBuffer, 1.0f );
+
+        // :JK: the sample mask array has one entry per 32 samples
+        const VkSampleMask sampleMask[ 2u ] = { ~0u, ~0u };
+        pVulkan->vkCmdSetRasterizationSamplesEXT( commandBuffer, pipeline.rasterizationSamples );
+        pVulkan->vkCmdSetSampleMaskEXT( commandBuffer, pipeline.rasterizationSamples, sampleMask );
+
+        if( pipeline.shaders[ VulkanShaderObjectStage_TessellationControl ] != VK_NULL_HANDLE )
+        {
+            pVulkan->vkCmdSetPatchControlPointsEXT( commandBuffer, pipeline.patchControlPoints );
+        }
+
+        if( pipeline.setStencilReference )
+        {
+            pVulkan->vkCmdSetStencilReference( commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, 0u );
+        }
+        if( pipeline.setStencilCompareMask )
+        {
+            pVulkan->vkCmdSetStencilCompareMask( commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, pipeline.stencilCompareMask );
+        }
+        if( pipeline.setStencilWriteMask )
+        {
+            pVulkan->vkCmdSetStencilWriteMask( commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, pipeline.stencilWriteMask );
+        }
+
+        if( pipeline.setShadingRate )
+        {
+            pVulkan->vkCmdSetFragmentShadingRateKHR( commandBuffer, &pipeline.shadingRateSize, pipeline.shadingRateCombinerOps );
+        }
+    }
+
+}
@@ -0,0 +1,61 @@
+#ifndef KEEN_VULKAN_SHADER_OBJECT_HPP_INCLUDED
+#define KEEN_VULKAN_SHADER_OBJECT_HPP_INCLUDED
+
+#include "vulkan_pipeline_key.hpp"
+
+namespace keen
+{
+
+    enum VulkanShaderObjectStage : uint8
+    {
+        VulkanShaderObjectStage_Vertex,
+        VulkanShaderObjectStage_TessellationControl,
+        VulkanShaderObjectStage_TessellationEvaluation,
+        VulkanShaderObjectStage_Geometry,               // never used - but has to be unbound if the device supports it
+        VulkanShaderObjectStage_Fragment,
+        VulkanShaderObjectStage_Task,
+        VulkanShaderObjectStage_Mesh,
+
+        VulkanShaderObjectStage_Count
+    };
+
+    // the part of a shader object render pipeline that is not covered by VulkanRenderPipelineDynamicState:
+    struct VulkanShaderObjectPipeline
+    {
+        VkShaderEXT                         shaders[ VulkanShaderObjectStage_Count ];   // VK_NULL_HANDLE for unused stages
+        VkShaderStageFlags                  bindStageMask;                              // all stages the device has enabled - unused ones are bound to VK_NULL_HANDLE
+
+        VkSampleCountFlagBits               rasterizationSamples;
+        uint32                              patchControlPoints;                         // only with tessellation shaders
+
+        // the stencil reference and masks are only set on bind if they are not dynamic:
+        bool8                               setStencilReference;        // always 0 - same as the pipeline state
+        bool8                               setStencilCompareMask;
+        bool8                               setStencilWriteMask;
+        uint32                              stencilCompareMask;
+        uint32                              stencilWriteMask;
+
+        bool8                               setShadingRate;
+        VkExtent2D                          shadingRateSize;
+        VkFragmentShadingRateCombinerOpKHR  shadingRateCombinerOps[ 2u ];
+    };
+
+    namespace vulkan
+    {
+
+        VkShaderStageFlagBits   getShaderObjectStageFlagBits( VulkanShaderObjectStage stage );
+
+        // the stages that every vkCmdBindShadersEXT has to cover with the given (enabled) device features:
+        VkShaderStageFlags      getShaderObjectBindStageMask( const VkPhysicalDeviceFeatures& enabledFeatures, bool isMeshShaderEnabled );
+
+        // fills everything but the shaders:
+        void                    fillShaderObjectPipeline( VulkanShaderObjectPipeline* pPipeline, const GraphicsRenderPipelineParameters& parameters, VkShaderStageFlags bindStageMask, bool isShadingRateEnabled );
+
+        // binds the shaders and sets all state that a draw with shader objects depends on. :JK: there is no pipeline to inherit anything from - so this has to be complete
+        void                    writeShaderObjectPipelineBind( VulkanApi* pVulkan, VkCommandBuffer commandBuffer, const VulkanShaderObjectPipeline& pipeline, const VulkanRenderPipelineDynamicState& dynamicState );
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,373 @@
+#include "vulkan_shader_object.hpp"
+#include "vulkan_stub_api_ut.hpp"
+
+
+namespace keen
+{
+    struct VulkanRecordedShaderObjectCommands
+    {
+        uint32                  commandCount;
+
+        uint32                  bindShadersCount;
+        uint32                  boundStageCount;
+        VkShaderStageFlagBits   boundStages[ VulkanShaderObjectStage_Count ];
+        VkShaderEXT             boundShaders[ VulkanShaderObjectStage_Count ];
+
+        VkCullModeFlags         cullMode;
+        uint32                  primitiveTopologyCount;
+        VkPrimitiveTopology     primitiveTopology;
+        VkPolygonMode           polygonMode;
+        uint32                  vertexInputCount;
+        uint32                  vertexAttributeCount;
+        uint32                  colorBlendEnableCount;
+
+        uint32                  rasterizerDiscardCount;
+        VkBool32                rasterizerDiscardEnable;
+        VkSampleCountFlagBits   rasterizationSamples;
+        uint32                  sampleMaskCount;
+        uint32                  patchControlPointsCount;
+        uint32                  patchControlPoints;
+        uint32                  stencilReferenceCount;
+        uint32                  stencilReference;
+        uint32                  stencilCompareMaskCount;
+        uint32                  stencilCompareMask;
+        uint32                  stencilWriteMaskCount;
+        uint32                  shadingRateCount;
+    };
+
+    static VulkanRecordedShaderObjectCommands s_recordedCommands;
+
+    static VKAPI_ATTR void VKAPI_CALL recordBindShaders( VkCommandBuffer, uint32_t stageCount, const VkShaderStageFlagBits* pStages, const VkShaderEXT* pShaders )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.bindShadersCount++;
+        s_recordedCommands.boundStageCount = stageCount;
+        for( uint32 i = 0u; i < stageCount && i < VulkanShaderObjectStage_Count; ++i )
+        {
+            s_recordedCommands.boundStages[ i ]     = pStages[ i ];
+            s_recordedCommands.boundShaders[ i ]    = pShaders[ i ];
+        }
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetCullMode( VkCommandBuffer, VkCullModeFlags cullMode )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.cullMode = cullMode;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetFrontFace( VkCommandBuffer, VkFrontFace )
+    {
+        s_recordedCommands.commandCount++;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetPrimitiveTopology( VkCommandBuffer, VkPrimitiveTopology primitiveTopology )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.primitiveTopologyCount++;
+        s_recordedCommands.primitiveTopology = primitiveTopology;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetBool( VkCommandBuffer, VkBool32 )
+    {
+        s_recordedCommands.commandCount++;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetRasterizerDiscardEnable( VkCommandBuffer, VkBool32 enable )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.rasterizerDiscardCount++;
+        s_recordedCommands.rasterizerDiscardEnable = enable;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetCompareOp( VkCommandBuffer, VkCompareOp )
+    {
+        s_recordedCommands.commandCount++;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetStencilOp( VkCommandBuffer, VkStencilFaceFlags, VkStencilOp, VkStencilOp, VkStencilOp, VkCompareOp )
+    {
+        s_recordedCommands.commandCount++;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetDepthBias( VkCommandBuffer, float, float, float )
+    {
+        s_recordedCommands.commandCount++;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetPolygonMode( VkCommandBuffer, VkPolygonMode polygonMode )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.polygonMode = polygonMode;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetColorBlendEnable( VkCommandBuffer, uint32_t, uint32_t, const VkBool32* )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.colorBlendEnableCount++;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetColorBlendEquation( VkCommandBuffer, uint32_t, uint32_t, const VkColorBlendEquationEXT* )
+    {
+        s_recordedCommands.commandCount++;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetColorWriteMask( VkCommandBuffer, uint32_t, uint32_t, const VkColorComponentFlags* )
+    {
+        s_recordedCommands.commandCount++;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetVertexInput( VkCommandBuffer, uint32_t, const VkVertexInputBindingDescription2EXT*, uint32_t attributeCount, const VkVertexInputAttributeDescription2EXT* )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.vertexInputCount++;
+        s_recordedCommands.vertexAttributeCount = attributeCount;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetLineWidth( VkCommandBuffer, float )
+    {
+        s_recordedCommands.commandCount++;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetRasterizationSamples( VkCommandBuffer, VkSampleCountFlagBits samples )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.rasterizationSamples = samples;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetSampleMask( VkCommandBuffer, VkSampleCountFlagBits, const VkSampleMask* )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.sampleMaskCount++;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetPatchControlPoints( VkCommandBuffer, uint32_t patchControlPoints )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.patchControlPointsCount++;
+        s_recordedCommands.patchControlPoints = patchControlPoints;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetStencilReference( VkCommandBuffer, VkStencilFaceFlags, uint32_t reference )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.stencilReferenceCount++;
+        s_recordedCommands.stencilReference = reference;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetStencilCompareMask( VkCommandBuffer, VkStencilFaceFlags, uint32_t compareMask )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.stencilCompareMaskCount++;
+        s_recordedCommands.stencilCompareMask = compareMask;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetStencilWriteMask( VkCommandBuffer, VkStencilFaceFlags, uint32_t )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.stencilWriteMaskCount++;
+    }
+
+    static VKAPI_ATTR void VKAPI_CALL recordSetFragmentShadingRate( VkCommandBuffer, const VkExtent2D*, const VkFragmentShadingRateCombinerOpKHR[ 2u ] )
+    {
+        s_recordedCommands.commandCount++;
+        s_recordedCommands.shadingRateCount++;
+    }
+
+    class VulkanShaderObjectTestFixture : public VulkanStubApiTestFixture
+    {
+    public:
+        VulkanShaderObjectTestFixture()
+        {
+            m_vulkan.vkCmdBindShadersEXT                = recordBindShaders;
+            m_vulkan.vkCmdSetCullModeEXT                = recordSetCullMode;
+            m_vulkan.vkCmdSetFrontFaceEXT               = recordSetFrontFace;
+            m_vulkan.vkCmdSetPrimitiveTopologyEXT       = recordSetPrimitiveTopology;
+            m_vulkan.vkCmdSetDepthTestEnableEXT         = recordSetBool;
+            m_vulkan.vkCmdSetDepthWriteEnableEXT        = recordSetBool;
+            m_vulkan.vkCmdSetDepthCompareOpEXT          = recordSetCompareOp;
+            m_vulkan.vkCmdSetStencilTestEnableEXT       = recordSetBool;
+            m_vulkan.vkCmdSetStencilOpEXT               = recordSetStencilOp;
+            m_vulkan.vkCmdSetDepthBiasEnableEXT         = recordSetBool;
+            m_vulkan.vkCmdSetDepthBias                  = recordSetDepthBias;
+            m_vulkan.vkCmdSetPolygonModeEXT             = recordSetPolygonMode;
+            m_vulkan.vkCmdSetColorBlendEnableEXT        = recordSetColorBlendEnable;
+            m_vulkan.vkCmdSetColorBlendEquationEXT      = recordSetColorBlendEquation;
+            m_vulkan.vkCmdSetColorWriteMaskEXT          = recordSetColorWriteMask;
+            m_vulkan.vkCmdSetAlphaToCoverageEnableEXT   = recordSetBool;
+            m_vulkan.vkCmdSetVertexInputEXT             = recordSetVertexInput;
+            m_vulkan.vkCmdSetRasterizerDiscardEnableEXT = recordSetRasterizerDiscardEnable;
+            m_vulkan.vkCmdSetPrimitiveRestartEnableEXT  = recordSetBool;
+            m_vulkan.vkCmdSetDepthBoundsTestEnableEXT   = recordSetBool;
+            m_vulkan.vkCmdSetDepthClampEnableEXT        = recordSetBool;
+            m_vulkan.vkCmdSetLineWidth                  = recordSetLineWidth;
+            m_vulkan.vkCmdSetRasterizationSamplesEXT    = recordSetRasterizationSamples;
+            m_vulkan.vkCmdSetSampleMaskEXT              = recordSetSampleMask;
+            m_vulkan.vkCmdSetPatchControlPointsEXT      = recordSetPatchControlPoints;
+            m_vulkan.vkCmdSetStencilReference           = recordSetStencilReference;
+            m_vulkan.vkCmdSetStencilCompareMask         = recordSetStencilCompareMask;
+            m_vulkan.vkCmdSetStencilWriteMask           = recordSetStencilWriteMask;
+            m_vulkan.vkCmdSetFragmentShadingRateKHR     = recordSetFragmentShadingRate;
+
+            // :JK: the shader code is never looked at
+            for( size_t i = 0u; i < KEEN_COUNTOF( m_shaderCode ); ++i )
+            {
+                m_shaderCode[ i ] = (uint8)i;
+            }
+
+            m_parameters.vertexShaderCode   = createConstMemoryBlockFromArray( m_shaderCode );
+            m_parameters.fragmentShaderCode = createConstMemoryBlockFromArray( m_shaderCode );
+            m_parameters.pPipelineLayout    = (const GraphicsPipelineLayout*)this;
+            m_parameters.setRenderTargetFormat( PixelFormat::R8G8B8A8_unorm, PixelFormat::D32_sfloat );
+            m_parameters.setRasterizerState( GraphicsCullMode::Back, GraphicsFillMode::Solid, GraphicsWindingOrder::Ccw );
+
+            m_vertexShader      = createStubHandle<VkShaderEXT>( 0x1000u );
+            m_fragmentShader    = createStubHandle<VkShaderEXT>( 0x2000u );
+        }
+
+    protected:
+        uint8                               m_shaderCode[ 64u ];
+        GraphicsRenderPipelineParameters    m_parameters;
+        VkShaderEXT                         m_vertexShader;
+        VkShaderEXT                         m_fragmentShader;
+
+        void bindPipeline( const GraphicsRenderPipelineParameters& parameters, const VkPhysicalDeviceFeatures& enabledFeatures, bool isMeshShaderEnabled, bool isShadingRateEnabled )
+        {
+            VulkanShaderObjectPipeline pipeline;
+            vulkan::fillShaderObjectPipeline( &pipeline, parameters, vulkan::getShaderObjectBindStageMask( enabledFeatures, isMeshShaderEnabled ), isShadingRateEnabled );
+            if( isConstMemoryBlockValid( parameters.meshShaderCode ) )
+            {
+                pipeline.shaders[ VulkanShaderObjectStage_Mesh ]    = m_vertexShader;
+            }
+            else
+            {
+                pipeline.shaders[ VulkanShaderObjectStage_Vertex ]  = m_vertexShader;
+            }
+            if( isConstMemoryBlockValid( parameters.tcShaderCode ) )
+            {
+                pipeline.shaders[ VulkanShaderObjectStage_TessellationControl ]     = m_vertexShader;
+                pipeline.shaders[ VulkanShaderObjectStage_TessellationEvaluation ]  = m_vertexShader;
+            }
+            pipeline.shaders[ VulkanShaderObjectStage_Fragment ] = m_fragmentShader;
+
+            VulkanRenderPipelineDynamicState dynamicState;
+            vulkan::fillRenderPipelineDynamicState( &dynamicState, parameters );
+
+            zeroValue( &s_recordedCommands );
+            vulkan::writeShaderObjectPipelineBind( &m_vulkan, VK_NULL_HANDLE, pipeline, dynamicState );
+        }
+    };
+
+    KEEN_UNIT_TEST_F( VulkanShaderObjectTestFixture, testBoundStages )
+    {
+        VkPhysicalDeviceFeatures enabledFeatures;
+        zeroValue( &enabledFeatures );
+        enabledFeatures.tessellationShader = VK_TRUE;
+
+        // every stage the device supports has to be bound - the unused ones with VK_NULL_HANDLE:
+        bindPipeline( m_parameters, enabledFeatures, true, false );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.bindShadersCount, 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.boundStageCount, 6u );
+
+        uint32 nonNullStageCount = 0u;
+        for( uint32 i = 0u; i < s_recordedCommands.boundStageCount; ++i )
+        {
+            KEEN_UT_CHECK( s_recordedCommands.boundStages[ i ] != VK_SHADER_STAGE_GEOMETRY_BIT );
+            if( s_recordedCommands.boundShaders[ i ] == VK_NULL_HANDLE )
+            {
+                continue;
+            }
+            nonNullStageCount++;
+
+            if( s_recordedCommands.boundStages[ i ] == VK_SHADER_STAGE_VERTEX_BIT )
+            {
+                KEEN_UT_CHECK( s_recordedCommands.boundShaders[ i ] == m_vertexShader );
+            }
+            else
+            {
+                KEEN_UT_COMPARE_UINT32( s_recordedCommands.boundStages[ i ], VK_SHADER_STAGE_FRAGMENT_BIT );
+                KEEN_UT_CHECK( s_recordedCommands.boundShaders[ i ] == m_fragmentShader );
+            }
+        }
+        KEEN_UT_COMPARE_UINT32( nonNullStageCount, 2u );
+
+        // without optional stages only vertex + fragment are bound:
+        zeroValue( &enabledFeatures );
+        bindPipeline( m_parameters, enabledFeatures, false, false );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.boundStageCount, 2u );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanShaderObjectTestFixture, testCompleteState )
+    {
+        VkPhysicalDeviceFeatures enabledFeatures;
+        zeroValue( &enabledFeatures );
+
+        GraphicsRenderPipelineParameters parameters = m_parameters;
+        parameters.sampleCount = 4u;
+        parameters.setPrimitiveType( GraphicsPrimitiveType::LineList );
+
+        bindPipeline( parameters, enabledFeatures, false, false );
+
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.cullMode, VK_CULL_MODE_BACK_BIT );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.polygonMode, VK_POLYGON_MODE_FILL );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.primitiveTopologyCount, 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.primitiveTopology, VK_PRIMITIVE_TOPOLOGY_LINE_LIST );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.vertexInputCount, 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.colorBlendEnableCount, 1u );
+
+        // the state that has no equivalent in the pipeline parameters:
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.rasterizerDiscardCount, 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.rasterizerDiscardEnable, VK_FALSE );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.rasterizationSamples, VK_SAMPLE_COUNT_4_BIT );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.sampleMaskCount, 1u );
+
+        // no tessellation shader - no patch control points:
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.patchControlPointsCount, 0u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.shadingRateCount, 0u );
+
+        // the stencil reference is not dynamic - so it has the pipeline value:
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.stencilReferenceCount, 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.stencilReference, 0u );
+
+        // bind + 9 (eds1 with the stencil ops of both faces) + 2 (eds2) + 5 (eds3) + vertex input + 7 fixed + stencil reference + 2 stencil masks:
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.commandCount, 28u );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanShaderObjectTestFixture, testOptionalState )
+    {
+        VkPhysicalDeviceFeatures enabledFeatures;
+        zeroValue( &enabledFeatures );
+        enabledFeatures.tessellationShader = VK_TRUE;
+
+        GraphicsRenderPipelineParameters parameters = m_parameters;
+        parameters.tcShaderCode = createConstMemoryBlockFromArray( m_shaderCode );
+        parameters.teShaderCode = createConstMemoryBlockFromArray( m_shaderCode );
+        parameters.setPrimitiveType( GraphicsPrimitiveType::PatchList );
+        parameters.patchSize    = 3u;
+        parameters.frontStencil.testMask = 0x0fu;
+        parameters.dynamicState.set( GraphicsDynamicStateFlag::StencilWriteMask );
+        parameters.dynamicState.set( GraphicsDynamicStateFlag::StencilReference );
+
+        bindPipeline( parameters, enabledFeatures, false, true );
+
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.patchControlPointsCount, 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.patchControlPoints, 3u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.stencilCompareMaskCount, 1u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.stencilCompareMask, 0x0fu );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.stencilWriteMaskCount, 0u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.stencilReferenceCount, 0u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.shadingRateCount, 1u );
+
+        // mesh pipelines have neither a topology nor a vertex input state:
+        GraphicsRenderPipelineParameters meshParameters = m_parameters;
+        meshParameters.vertexShaderCode = {};
+        meshParameters.meshShaderCode   = createConstMemoryBlockFromArray( m_shaderCode );
+
+        zeroValue( &enabledFeatures );
+        bindPipeline( meshParameters, enabledFeatures, true, false );
+
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.boundStageCount, 4u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.primitiveTopologyCount, 0u );
+        KEEN_UT_COMPARE_UINT32( s_recordedCommands.vertexInputCount, 0u );
+    }
+
+}
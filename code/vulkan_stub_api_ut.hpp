@@ -0,0 +1,34 @@
+#ifndef KEEN_VULKAN_STUB_API_UT_HPP_INCLUDED
+#define KEEN_VULKAN_STUB_API_UT_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+
+#include "keen/base/unit_test.hpp"
+
+namespace keen
+{
+    // :JK: base of the tests that run vulkan code without a device: the test installs stubs into m_vulkan instead of the driver functions
+    // and the stubs record the calls into a static struct of the test (the vulkan functions have no user data pointer)
+    class VulkanStubApiTestFixture : public UnitTest
+    {
+    public:
+        VulkanStubApiTestFixture()
+        {
+            // every function that is not stubbed stays null - so a call that the test doesn't expect crashes instead of doing nothing
+            zeroValue( &m_vulkan );
+        }
+
+    protected:
+        VulkanApi                   m_vulkan;
+
+        // a handle that is never dereferenced - only passed through and compared:
+        template<typename THandle>
+        static THandle createStubHandle( uintptr_t value )
+        {
+            return (THandle)value;
+        }
+    };
+
+}
+
+#endif
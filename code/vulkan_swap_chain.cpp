@@ -3,6 +3,28 @@
 namespace keen
 {
 
+    static bool isRectangleEmpty( const GraphicsRectangle& rectangle )
+    {
+        return rectangle.width == 0u || rectangle.height == 0u;
+    }
+
+    static GraphicsRectangle mergeRectangles( const GraphicsRectangle& a, const GraphicsRectangle& b )
+    {
+        if( isRectangleEmpty( a ) )
+        {
+            return b;
+        }
+        if( isRectangleEmpty( b ) )
+        {
+            return a;
+        }
+        const sint32 x0 = min( a.x, b.x );
+        const sint32 y0 = min( a.y, b.y );
+        const sint32 x1 = max( a.x + (sint32)a.width, b.x + (sint32)b.width );
+        const sint32 y1 = max( a.y + (sint32)a.height, b.y + (sint32)b.height );
+        return GraphicsRectangle{ x0, y0, (uint32)( x1 - x0 ), (uint32)( y1 - y0 ) };
+    }
+
     bool VulkanSwapChain::tryCreate( const VulkanSwapChainParameters& parameters )
     {
         m_pAllocator            = parameters.pAllocator;
@@ -22,6 +44,10 @@ namespace keen
         m_allowTearing          = false;
         m_wasTimedOut           = false;
 
+        m_presentRegion         = { 0u, nullptr };
+        m_hasDamageRegion       = false;
+        m_isImageDamagePending  = false;
+
         m_lastImageTime         = time::getCurrentTime();
 
         if( !initializeBackBuffer( &m_backBuffers[ 0u ], parameters.backBufferColorFormat ) )
@@ -125,6 +151,65 @@ namespace keen
         }
     }
 
+    void VulkanSwapChain::setDamageRegion( ArrayView<const GraphicsRectangle> damageRectangles )
+    {
+        const GraphicsRectangle fullRectangle = getFullImageRectangle();
+
+        m_damageRectangles.clear();
+        m_hasDamageRegion = true;
+
+        GraphicsRectangle bounds = {};
+        bool isOverflowing = false;
+        for( size_t i = 0u; i < damageRectangles.getSize(); ++i )
+        {
+            const GraphicsRectangle& rectangle = damageRectangles[ i ];
+
+            // clip against the image:
+            const sint32 x0 = max( rectangle.x, 0 );
+            const sint32 y0 = max( rectangle.y, 0 );
+            const sint32 x1 = min( rectangle.x + (sint32)rectangle.width, (sint32)fullRectangle.width );
+            const sint32 y1 = min( rectangle.y + (sint32)rectangle.height, (sint32)fullRectangle.height );
+            if( x1 <= x0 || y1 <= y0 )
+            {
+                continue;
+            }
+
+            const GraphicsRectangle clippedRectangle = { x0, y0, (uint32)( x1 - x0 ), (uint32)( y1 - y0 ) };
+            bounds = mergeRectangles( bounds, clippedRectangle );
+
+            VkRectLayerKHR damageRectangle;
+            damageRectangle.offset  = { clippedRectangle.x, clippedRectangle.y };
+            damageRectangle.extent  = { clippedRectangle.width, clippedRectangle.height };
+            damageRectangle.layer   = 0u;
+            if( !m_damageRectangles.tryPushBack( damageRectangle ) )
+            {
+                isOverflowing = true;
+            }
+        }
+
+        if( isOverflowing )
+        {
+            // :JK: too many rectangles - the compositor gets the bounding rectangle instead
+            m_damageRectangles.clear();
+
+            VkRectLayerKHR damageRectangle;
+            damageRectangle.offset  = { bounds.x, bounds.y };
+            damageRectangle.extent  = { bounds.width, bounds.height };
+            damageRectangle.layer   = 0u;
+            m_damageRectangles.pushBack( damageRectangle );
+        }
+
+        // rectangleCount 0 would mean the full image - so an empty damage region presents a single empty rectangle instead
+        if( !m_damageRectangles.hasElements() )
+        {
+            VkRectLayerKHR damageRectangle = {};
+            m_damageRectangles.pushBack( damageRectangle );
+        }
+
+        m_presentRegion.rectangleCount  = (uint32)m_damageRectangles.getSize();
+        m_presentRegion.pRectangles     = m_damageRectangles.getStart();
+    }
+
     bool VulkanSwapChain::beginNextImage( VulkanUsedSwapChainInfo* pSwapChainInfo, GraphicsFrameId frameId )
     {
         KEEN_PROFILE_CPU( Vk_acquireNextImage );
@@ -143,6 +228,9 @@ namespace keen
             return false;
         }
 
+        // the previous image was presented - so its damage is now missing in all other images:
+        accumulateImageDamage();
+
         VkSemaphore imageAvailableSemaphore = m_imageAvailableSemaphores[ m_currentImageAvailableSemaphoreIndex ];
         m_currentImageAvailableSemaphoreIndex = ( m_currentImageAvailableSemaphoreIndex + 1 ) % m_imageAvailableSemaphores.getCount32();
         // :JK: the idea is to use a high timeout normally (because especially with amd we saw spikes here of multiple seconds when switching between windowed and full-screen mode)
@@ -198,14 +286,18 @@ namespace keen
         if( !pSwapChainInfo->swapChains.tryPushBack( m_swapChain ) ||
             !pSwapChainInfo->imageAvailableSemaphores.tryPushBack( imageAvailableSemaphore ) ||
             !pSwapChainInfo->waitStageMasks.tryPushBack( VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT ) ||
-            !pSwapChainInfo->imageIndices.tryPushBack( imageIndex ) )
+            !pSwapChainInfo->imageIndices.tryPushBack( imageIndex ) ||
+            !pSwapChainInfo->presentRegions.tryPushBack( &m_presentRegion ) )
         {
             return false;
         }
 
-        m_currentFrameId    = frameId;
-        m_currentImageIndex = imageIndex;
-        m_lastImageTime     = time::getCurrentTime();
+        m_currentFrameId        = frameId;
+        m_currentImageIndex     = imageIndex;
+        m_lastImageTime         = time::getCurrentTime();
+        m_isImageDamagePending  = true;
+
+        m_pSwapChainWrapper->info.redrawArea = m_imageRedrawAreas[ imageIndex ];
 
         return true;
     }
@@ -262,6 +354,50 @@ namespace keen
         m_pVulkan->vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrierFromDrawToPresent );
     }
 
+    GraphicsRectangle VulkanSwapChain::getFullImageRectangle() const
+    {
+        return GraphicsRectangle{ 0, 0, m_swapChainSize.x, m_swapChainSize.y };
+    }
+
+    void VulkanSwapChain::accumulateImageDamage()
+    {
+        if( m_isImageDamagePending )
+        {
+            // without a damage region the whole image was rendered:
+            GraphicsRectangle damageBounds = {};
+            if( m_hasDamageRegion )
+            {
+                for( size_t i = 0u; i < m_damageRectangles.getSize(); ++i )
+                {
+                    const VkRectLayerKHR& damageRectangle = m_damageRectangles[ i ];
+                    damageBounds = mergeRectangles( damageBounds, GraphicsRectangle{ damageRectangle.offset.x, damageRectangle.offset.y, damageRectangle.extent.width, damageRectangle.extent.height } );
+                }
+            }
+            else
+            {
+                damageBounds = getFullImageRectangle();
+            }
+
+            for( size_t i = 0u; i < m_imageRedrawAreas.getCount(); ++i )
+            {
+                if( i == m_currentImageIndex )
+                {
+                    // the presented image is up to date now
+                    m_imageRedrawAreas[ i ] = {};
+                }
+                else
+                {
+                    m_imageRedrawAreas[ i ] = mergeRectangles( m_imageRedrawAreas[ i ], damageBounds );
+                }
+            }
+            m_isImageDamagePending = false;
+        }
+
+        m_damageRectangles.clear();
+        m_hasDamageRegion   = false;
+        m_presentRegion     = { 0u, nullptr };
+    }
+
     const VulkanTexture* VulkanSwapChain::getBackBufferTexture( size_t colorFormatIndex )
     {
         if( m_backBuffers[ colorFormatIndex ].format == PixelFormat::None )
@@ -616,6 +752,17 @@ namespace keen
             return result.getErrorId();
         }
 
+        // the content of new images is undefined - so they have to be fully redrawn:
+        if( !m_imageRedrawAreas.tryCreate( m_pAllocator, imageCount ) )
+        {
+            return ErrorId_OutOfMemory;
+        }
+        for( size_t i = 0u; i < m_imageRedrawAreas.getCount(); ++i )
+        {
+            m_imageRedrawAreas[ i ] = getFullImageRectangle();
+        }
+        m_isImageDamagePending = false;
+
 #if KEEN_USING( KEEN_VULKAN_OBJECT_NAMES )
         for( uint32 i = 0u; i < m_swapChainImages.getCount32(); ++i )
         {
@@ -812,6 +959,8 @@ namespace keen
         }
 
         m_swapChainImages.destroy();
+        m_imageRedrawAreas.destroy();
+        m_isImageDamagePending = false;
 
         m_swapChainSize = { 0u, 0u };
 
@@ -44,6 +44,8 @@ namespace keen
         bool                        isValid() const { return m_swapChain != VK_NULL_HANDLE; }
 
         void                        setPresentationInterval( uint32 interval );
+        // damaged rectangles of the current image - without a damage region the full image counts as damaged
+        void                        setDamageRegion( ArrayView<const GraphicsRectangle> damageRectangles );
 
         GraphicsFrameId             getFrameId() const { return m_currentFrameId; }
         bool                        beginNextImage( VulkanUsedSwapChainInfo* pSwapChainInfo, GraphicsFrameId frameId );
@@ -57,6 +59,9 @@ namespace keen
         const VulkanTexture*        getBackBufferTexture( size_t colorFormatIndex );
 
     private:
+        // more rectangles are merged into their bounding rectangle
+        static constexpr size_t     MaxDamageRectangleCount = 16u;
+
         struct BackBuffer
         {
             Array<VkImageView>      swapChainImageViews;
@@ -77,6 +82,9 @@ namespace keen
         void                        destroyBackBuffer( BackBuffer* pBackBuffer );
         void                        updateBackBufferImage( BackBuffer* pBackBuffer, uint32 imageIndex );
 
+        GraphicsRectangle           getFullImageRectangle() const;
+        void                        accumulateImageDamage();
+
         MemoryAllocator*            m_pAllocator;
 
         VulkanApi*                  m_pVulkan;
@@ -96,6 +104,13 @@ namespace keen
         GraphicsFrameId             m_currentFrameId;
         uint32                      m_currentImageIndex;
 
+        // per swap chain image: the bounding rectangle of the damage since the image was presented the last time
+        Array<GraphicsRectangle>    m_imageRedrawAreas;
+        DynamicArray<VkRectLayerKHR,MaxDamageRectangleCount> m_damageRectangles;
+        VkPresentRegionKHR          m_presentRegion;
+        bool                        m_hasDamageRegion;
+        bool                        m_isImageDamagePending;
+
         BackBuffer                  m_backBuffers[ GraphicsLimits_MaxRenderTargetPixelFormatCount ];
 
         Array<VkSemaphore>          m_imageAvailableSemaphores;
@@ -23,10 +23,15 @@ namespace keen
         {
             anyShaderFlags |= VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT | VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT;
         }
+        if( optionalShaderStages.isSet( GraphicsOptionalShaderStageFlag::MeshShaders ) )
+        {
+            anyShaderFlags |= VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_MESH_SHADER_BIT_EXT;
+        }
 
         switch( accessType )
         {
         case GraphicsAccessFlag::IndirectBuffer:                        return { VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT };
+        case GraphicsAccessFlag::ConditionalRenderingPredicate:         return { VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT, VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT };
         case GraphicsAccessFlag::IndexBuffer:                           return { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT };
         case GraphicsAccessFlag::VertexBuffer:                          return { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT };
         case GraphicsAccessFlag::VS_Read_UniformBuffer:                 return { VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_UNIFORM_READ_BIT };
@@ -39,6 +44,7 @@ namespace keen
         case GraphicsAccessFlag::FS_Read_Other:                         return { VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT };
         case GraphicsAccessFlag::ColorAttachment_Read:                  return { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT };
         case GraphicsAccessFlag::DepthStencilAttachment_Read:           return { VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT };
+        case GraphicsAccessFlag::ShadingRateAttachment_Read:            return { VK_PIPELINE_STAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR, VK_ACCESS_FRAGMENT_SHADING_RATE_ATTACHMENT_READ_BIT_KHR };
         case GraphicsAccessFlag::CS_Read_UniformBuffer:                 return { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_UNIFORM_READ_BIT };
         case GraphicsAccessFlag::CS_Read_SampledImage:                  return { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT };
         case GraphicsAccessFlag::CS_Read_Other:                         return { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT };
@@ -119,6 +119,9 @@ namespace keen
         testImageBarrier( GraphicsAccessFlag::FS_Read_SampledImage, GraphicsAccessFlag::ColorAttachment_Write,
             { VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 0 } );
 
+        testImageBarrier( GraphicsAccessFlag::CS_Write, GraphicsAccessFlag::ShadingRateAttachment_Read,
+            { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_FRAGMENT_SHADING_RATE_ATTACHMENT_READ_BIT_KHR } );
+
         testGlobalBarrier( {}, GraphicsAccessFlag::Transfer_Read, { VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0 } );
 
         testGlobalBarrier( GraphicsAccessFlag::Transfer_Write, GraphicsAccessFlag::VertexBuffer,
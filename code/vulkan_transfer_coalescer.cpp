@@ -0,0 +1,108 @@
+#include "vulkan_transfer_coalescer.hpp"
+
+namespace keen
+{
+
+    static bool isRangeOverlapping( uint64 offsetA, uint64 sizeA, uint64 offsetB, uint64 sizeB )
+    {
+        return offsetA < offsetB + sizeB && offsetB < offsetA + sizeA;
+    }
+
+    static bool isImageRegionOverlapping( const VkBufferImageCopy& regionA, const VkBufferImageCopy& regionB )
+    {
+        const VkImageSubresourceLayers& subresourceA = regionA.imageSubresource;
+        const VkImageSubresourceLayers& subresourceB = regionB.imageSubresource;
+        if( subresourceA.mipLevel != subresourceB.mipLevel || ( subresourceA.aspectMask & subresourceB.aspectMask ) == 0u )
+        {
+            return false;
+        }
+        if( !isRangeOverlapping( subresourceA.baseArrayLayer, subresourceA.layerCount, subresourceB.baseArrayLayer, subresourceB.layerCount ) )
+        {
+            return false;
+        }
+
+        // offsets are never negative for buffer to image copies:
+        return isRangeOverlapping( (uint32)regionA.imageOffset.x, regionA.imageExtent.width, (uint32)regionB.imageOffset.x, regionB.imageExtent.width ) &&
+            isRangeOverlapping( (uint32)regionA.imageOffset.y, regionA.imageExtent.height, (uint32)regionB.imageOffset.y, regionB.imageExtent.height ) &&
+            isRangeOverlapping( (uint32)regionA.imageOffset.z, regionA.imageExtent.depth, (uint32)regionB.imageOffset.z, regionB.imageExtent.depth );
+    }
+
+    bool vulkan::appendBufferCopyRegion( DynamicArray<VkBufferCopy, VulkanMaxCoalescedCopyRegionCount>* pRegions, const VkBufferCopy& region, bool isSameBuffer )
+    {
+        for( size_t i = 0u; i < pRegions->getCount(); ++i )
+        {
+            const VkBufferCopy& otherRegion = ( *pRegions )[ i ];
+            if( isRangeOverlapping( region.dstOffset, region.size, otherRegion.dstOffset, otherRegion.size ) )
+            {
+                return false;
+            }
+            if( isSameBuffer &&
+                ( isRangeOverlapping( region.dstOffset, region.size, otherRegion.srcOffset, otherRegion.size ) ||
+                  isRangeOverlapping( region.srcOffset, region.size, otherRegion.dstOffset, otherRegion.size ) ) )
+            {
+                return false;
+            }
+        }
+
+        if( pRegions->hasElements() )
+        {
+            // a copy that continues the previous one in both buffers (i.e. a large upload split into chunks) just extends that region:
+            VkBufferCopy* pLastRegion = &pRegions->getLast();
+            if( pLastRegion->srcOffset + pLastRegion->size == region.srcOffset && pLastRegion->dstOffset + pLastRegion->size == region.dstOffset )
+            {
+                pLastRegion->size += region.size;
+                return true;
+            }
+        }
+
+        if( pRegions->getRemainingCapacity() == 0u )
+        {
+            return false;
+        }
+        pRegions->pushBack( region );
+        return true;
+    }
+
+    bool vulkan::appendBufferImageCopyRegion( DynamicArray<VkBufferImageCopy, VulkanMaxCoalescedCopyRegionCount>* pRegions, const VkBufferImageCopy& region )
+    {
+        if( pRegions->getRemainingCapacity() == 0u )
+        {
+            return false;
+        }
+        for( size_t i = 0u; i < pRegions->getCount(); ++i )
+        {
+            if( isImageRegionOverlapping( region, ( *pRegions )[ i ] ) )
+            {
+                return false;
+            }
+        }
+        pRegions->pushBack( region );
+        return true;
+    }
+
+    bool vulkan::tryMergeFillBufferRange( VulkanFillBufferRange* pRange, const VulkanFillBufferRange& nextRange )
+    {
+        // :JK: whole size fills depend on the buffer size - they are rare enough to not bother
+        if( pRange->size == VK_WHOLE_SIZE || nextRange.size == VK_WHOLE_SIZE )
+        {
+            return false;
+        }
+        if( pRange->value != nextRange.value )
+        {
+            return false;
+        }
+
+        const uint64 rangeEnd       = pRange->offset + pRange->size;
+        const uint64 nextRangeEnd   = nextRange.offset + nextRange.size;
+        if( nextRange.offset > rangeEnd || pRange->offset > nextRangeEnd )
+        {
+            return false;
+        }
+
+        // offsets and sizes are multiples of 4 - so the union is a valid fill range as well:
+        pRange->offset  = min( pRange->offset, nextRange.offset );
+        pRange->size    = max( rangeEnd, nextRangeEnd ) - pRange->offset;
+        return true;
+    }
+
+}
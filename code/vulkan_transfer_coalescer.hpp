@@ -0,0 +1,45 @@
+#ifndef KEEN_VULKAN_TRANSFER_COALESCER_HPP_INCLUDED
+#define KEEN_VULKAN_TRANSFER_COALESCER_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+
+namespace keen
+{
+    constexpr size_t VulkanMaxCoalescedCopyRegionCount = 32u;
+
+    struct VulkanTransferCoalescingStatistics
+    {
+        uint32                      savedCopyBufferCount = 0u;          // vkCmdCopyBuffer calls merged into the call of a previous command
+        uint32                      savedCopyBufferToTextureCount = 0u; // vkCmdCopyBufferToImage calls merged into the call of a previous command
+        uint32                      savedFillBufferCount = 0u;          // vkCmdFillBuffer calls merged into the range of a previous command
+
+        uint32                      getSavedCallCount() const { return savedCopyBufferCount + savedCopyBufferToTextureCount + savedFillBufferCount; }
+    };
+
+    struct VulkanFillBufferRange
+    {
+        uint64                      offset = 0u;
+        uint64                      size = 0u;
+        uint32                      value = 0u;
+    };
+
+    namespace vulkan
+    {
+
+        // :JK: all regions of one vkCmdCopyBuffer call execute without any ordering between them - so the new region must not write memory
+        // another region reads or writes (consecutive copy commands without a barrier in between have no ordering guarantee either, but
+        // a merged call with overlapping regions is invalid usage). returns false when the region can't be added to the call
+        bool        appendBufferCopyRegion( DynamicArray<VkBufferCopy, VulkanMaxCoalescedCopyRegionCount>* pRegions, const VkBufferCopy& region, bool isSameBuffer );
+
+        // the same for vkCmdCopyBufferToImage (VUID-vkCmdCopyBufferToImage-pRegions-00173): the new region must not write texels of the same
+        // mip level, layer and aspect that another region of the call writes
+        bool        appendBufferImageCopyRegion( DynamicArray<VkBufferImageCopy, VulkanMaxCoalescedCopyRegionCount>* pRegions, const VkBufferImageCopy& region );
+
+        // merges the next fill of the same buffer into the range when both write the same value and the ranges touch or overlap:
+        bool        tryMergeFillBufferRange( VulkanFillBufferRange* pRange, const VulkanFillBufferRange& nextRange );
+
+    }
+
+}
+
+#endif
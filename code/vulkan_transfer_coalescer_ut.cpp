@@ -0,0 +1,166 @@
+#include "vulkan_transfer_coalescer.hpp"
+
+#include "keen/base/unit_test.hpp"
+
+
+namespace keen
+{
+    class VulkanTransferCoalescerTestFixture : public UnitTest
+    {
+    protected:
+        DynamicArray<VkBufferCopy, VulkanMaxCoalescedCopyRegionCount>   m_regions;
+
+        static VkBufferCopy createRegion( uint64 sourceOffset, uint64 targetOffset, uint64 size )
+        {
+            VkBufferCopy region;
+            region.srcOffset    = sourceOffset;
+            region.dstOffset    = targetOffset;
+            region.size         = size;
+            return region;
+        }
+
+        static VkBufferImageCopy createImageRegion( uint32 level, uint32 baseLayer, uint32 layerCount, sint32 x, sint32 y, uint32 size )
+        {
+            VkBufferImageCopy region{};
+            region.imageSubresource.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel        = level;
+            region.imageSubresource.baseArrayLayer  = baseLayer;
+            region.imageSubresource.layerCount      = layerCount;
+            region.imageOffset                      = { x, y, 0 };
+            region.imageExtent                      = { size, size, 1u };
+            return region;
+        }
+
+        static VulkanFillBufferRange createFillRange( uint64 offset, uint64 size, uint32 value )
+        {
+            VulkanFillBufferRange range;
+            range.offset    = offset;
+            range.size      = size;
+            range.value     = value;
+            return range;
+        }
+    };
+
+    KEEN_UNIT_TEST_F( VulkanTransferCoalescerTestFixture, testAppendBufferCopyRegions )
+    {
+        // scattered particle updates between two buffers:
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 0u, 1024u, 64u ), false ) );
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 256u, 0u, 64u ), false ) );
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 512u, 4096u, 128u ), false ) );
+        KEEN_UT_COMPARE_UINT32( m_regions.getCount32(), 3u );
+
+        // the source may be read by several regions:
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 0u, 8192u, 64u ), false ) );
+        KEEN_UT_COMPARE_UINT32( m_regions.getCount32(), 4u );
+
+        // but a target must only be written once:
+        KEEN_UT_CHECK( !vulkan::appendBufferCopyRegion( &m_regions, createRegion( 1024u, 1056u, 64u ), false ) );
+        KEEN_UT_CHECK( !vulkan::appendBufferCopyRegion( &m_regions, createRegion( 1024u, 0u, 4u ), false ) );
+        KEEN_UT_COMPARE_UINT32( m_regions.getCount32(), 4u );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanTransferCoalescerTestFixture, testExtendBufferCopyRegion )
+    {
+        // a large upload split into chunks is copied with a single region:
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 0u, 4096u, 256u ), false ) );
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 256u, 4352u, 256u ), false ) );
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 512u, 4608u, 512u ), false ) );
+        KEEN_UT_COMPARE_UINT32( m_regions.getCount32(), 1u );
+        KEEN_UT_CHECK( m_regions[ 0u ].srcOffset == 0u );
+        KEEN_UT_CHECK( m_regions[ 0u ].dstOffset == 4096u );
+        KEEN_UT_CHECK( m_regions[ 0u ].size == 1024u );
+
+        // only contiguous in the source - that is a new region:
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 1024u, 0u, 256u ), false ) );
+        KEEN_UT_COMPARE_UINT32( m_regions.getCount32(), 2u );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanTransferCoalescerTestFixture, testBufferCopyRegionLimits )
+    {
+        for( uint64 i = 0u; i < VulkanMaxCoalescedCopyRegionCount; ++i )
+        {
+            KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 0u, i * 128u, 64u ), false ) );
+        }
+        KEEN_UT_CHECK( !vulkan::appendBufferCopyRegion( &m_regions, createRegion( 0u, 1u << 20u, 64u ), false ) );
+
+        // a full call can still be extended:
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 64u, ( VulkanMaxCoalescedCopyRegionCount - 1u ) * 128u + 64u, 64u ), false ) );
+        KEEN_UT_COMPARE_UINT32( m_regions.getCount32(), (uint32)VulkanMaxCoalescedCopyRegionCount );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanTransferCoalescerTestFixture, testSameBufferCopyRegions )
+    {
+        // compaction inside of one buffer:
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 1024u, 0u, 64u ), true ) );
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 2048u, 128u, 64u ), true ) );
+
+        // reads what a previous region writes:
+        KEEN_UT_CHECK( !vulkan::appendBufferCopyRegion( &m_regions, createRegion( 0u, 4096u, 64u ), true ) );
+        // writes what a previous region reads:
+        KEEN_UT_CHECK( !vulkan::appendBufferCopyRegion( &m_regions, createRegion( 4096u, 2048u, 64u ), true ) );
+        KEEN_UT_COMPARE_UINT32( m_regions.getCount32(), 2u );
+
+        // the same regions are fine between different buffers:
+        KEEN_UT_CHECK( vulkan::appendBufferCopyRegion( &m_regions, createRegion( 0u, 4096u, 64u ), false ) );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanTransferCoalescerTestFixture, testAppendBufferImageCopyRegions )
+    {
+        DynamicArray<VkBufferImageCopy, VulkanMaxCoalescedCopyRegionCount> regions;
+
+        // streamed tiles of one level:
+        KEEN_UT_CHECK( vulkan::appendBufferImageCopyRegion( &regions, createImageRegion( 0u, 0u, 1u, 0, 0, 64u ) ) );
+        KEEN_UT_CHECK( vulkan::appendBufferImageCopyRegion( &regions, createImageRegion( 0u, 0u, 1u, 64, 0, 64u ) ) );
+        KEEN_UT_CHECK( vulkan::appendBufferImageCopyRegion( &regions, createImageRegion( 0u, 0u, 1u, 0, 64, 64u ) ) );
+
+        // the same box in another level or layer:
+        KEEN_UT_CHECK( vulkan::appendBufferImageCopyRegion( &regions, createImageRegion( 1u, 0u, 1u, 0, 0, 64u ) ) );
+        KEEN_UT_CHECK( vulkan::appendBufferImageCopyRegion( &regions, createImageRegion( 0u, 1u, 2u, 0, 0, 64u ) ) );
+        KEEN_UT_COMPARE_UINT32( regions.getCount32(), 5u );
+
+        // overlapping box in the same level and layer:
+        KEEN_UT_CHECK( !vulkan::appendBufferImageCopyRegion( &regions, createImageRegion( 0u, 0u, 1u, 32, 32, 64u ) ) );
+        KEEN_UT_CHECK( !vulkan::appendBufferImageCopyRegion( &regions, createImageRegion( 0u, 2u, 1u, 63, 63, 1u ) ) );
+        KEEN_UT_COMPARE_UINT32( regions.getCount32(), 5u );
+
+        // full:
+        while( regions.getRemainingCapacity() > 0u )
+        {
+            KEEN_UT_CHECK( vulkan::appendBufferImageCopyRegion( &regions, createImageRegion( 2u + regions.getCount32(), 0u, 1u, 0, 0, 64u ) ) );
+        }
+        KEEN_UT_CHECK( !vulkan::appendBufferImageCopyRegion( &regions, createImageRegion( 0u, 0u, 1u, 128, 128, 64u ) ) );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanTransferCoalescerTestFixture, testMergeFillBufferRanges )
+    {
+        VulkanFillBufferRange range = createFillRange( 256u, 256u, 0u );
+
+        // adjacent:
+        KEEN_UT_CHECK( vulkan::tryMergeFillBufferRange( &range, createFillRange( 512u, 128u, 0u ) ) );
+        KEEN_UT_CHECK( range.offset == 256u && range.size == 384u );
+        KEEN_UT_CHECK( vulkan::tryMergeFillBufferRange( &range, createFillRange( 0u, 256u, 0u ) ) );
+        KEEN_UT_CHECK( range.offset == 0u && range.size == 640u );
+
+        // overlapping and contained:
+        KEEN_UT_CHECK( vulkan::tryMergeFillBufferRange( &range, createFillRange( 600u, 100u, 0u ) ) );
+        KEEN_UT_CHECK( range.offset == 0u && range.size == 700u );
+        KEEN_UT_CHECK( vulkan::tryMergeFillBufferRange( &range, createFillRange( 64u, 64u, 0u ) ) );
+        KEEN_UT_CHECK( range.offset == 0u && range.size == 700u );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanTransferCoalescerTestFixture, testKeepFillBufferRanges )
+    {
+        VulkanFillBufferRange range = createFillRange( 256u, 256u, 0u );
+
+        // gap in between:
+        KEEN_UT_CHECK( !vulkan::tryMergeFillBufferRange( &range, createFillRange( 516u, 128u, 0u ) ) );
+        KEEN_UT_CHECK( !vulkan::tryMergeFillBufferRange( &range, createFillRange( 0u, 252u, 0u ) ) );
+
+        // a different value overwrites a part of the range - so the order matters:
+        KEEN_UT_CHECK( !vulkan::tryMergeFillBufferRange( &range, createFillRange( 256u, 64u, 0xffffffffu ) ) );
+
+        KEEN_UT_CHECK( !vulkan::tryMergeFillBufferRange( &range, createFillRange( 0u, VK_WHOLE_SIZE, 0u ) ) );
+        KEEN_UT_CHECK( range.offset == 256u && range.size == 256u );
+    }
+
+}
@@ -7,6 +7,12 @@
 #include "vulkan_api.hpp"
 #include "vulkan_gpu_allocator.hpp"
 #include "vulkan_breadcrumbs.hpp"
+#include "vulkan_pipeline_key.hpp"
+#include "vulkan_shader_object.hpp"
+#include "vulkan_host_image_copy.hpp"
+#include "vulkan_host_memory_import.hpp"
+#include "vulkan_external_memory.hpp"
+#include "vulkan_upload_copy.hpp"
 #include "global/graphics_system_private.hpp"
 
 namespace keen
@@ -19,12 +25,33 @@ namespace keen
     {
         VkPipelineLayout        pipelineLayout;
         bool                    useBindlessDescriptors;
+        uint32                  layoutId;               // unique - identifies the layout in the shared render pipeline keys
+        uint64                  layoutHash;             // same between runs - identifies the layout in the pipeline binary archive
+        uint32                  objectGeneration;       // unique per created object (see vulkan::combineCommandBufferKey)
+        uint32                  dynamicOffsetCounts[ GraphicsLimits_MaxDescriptorSetSlotCount ];   // dynamic buffer descriptors per set
+
+        // shader objects are created without a VkPipelineLayout - so they need the pieces:
+        VkDescriptorSetLayout   setLayouts[ GraphicsLimits_MaxDescriptorSetSlotCount + 1u ];
+        uint32                  setLayoutCount;
+        VkPushConstantRange     pushConstantRanges[ GraphicsLimits_MaxPushConstantRangeCount + 1u ];
+        uint32                  pushConstantRangeCount;
     };
 
     struct VulkanRenderPipeline : public GraphicsRenderPipeline
     {
-        VkPipeline              pipeline;
-        bool8                   scissorTestEnabled;
+        VkPipeline                          pipeline;
+        bool8                               scissorTestEnabled;
+        uint32                              objectGeneration;       // unique per created object (see vulkan::combineCommandBufferKey)
+
+        // pipelines that only differ in dynamic state share the VkPipeline:
+        HashKey64                           sharedPipelineKey;
+        bool8                               isSharedPipeline;
+        VulkanDynamicStateFeatureMask       dynamicStateFeatures;
+        VulkanRenderPipelineDynamicState    dynamicState;
+
+        // pipeline is VK_NULL_HANDLE for shader object pipelines:
+        bool8                               isShaderObjectPipeline;
+        VulkanShaderObjectPipeline          shaderObjects;
     };
 
     struct VulkanSwapChainWrapper : public GraphicsSwapChain
@@ -35,12 +62,14 @@ namespace keen
     struct VulkanComputePipeline : public GraphicsComputePipeline
     {
         VkPipeline              pipeline;
+        uint32                  objectGeneration;       // unique per created object (see vulkan::combineCommandBufferKey)
     };
 
     struct VulkanDeviceMemory : public GraphicsDeviceMemory
     {
         VulkanGpuDeviceMemoryAllocation allocation;
         bool                            isCoherent;
+        VulkanUploadCopyKernel          uploadCopyKernel;   // for writes into the mapped memory
     };
 
     struct VulkanTexture : public GraphicsTexture
@@ -48,6 +77,16 @@ namespace keen
         VkImage                 image;
         VkImageView             imageView;
         VulkanGpuAllocationInfo allocation;
+        bool8                   isLocalReadAttachment = false;  // the image has the input attachment usage
+        VkFormatFeatureFlags    formatFeatures = 0u;            // optimal tiling features of the image format (decides how mips are generated)
+        bool8                   isHostTransferEnabled = false;  // the image has the host transfer usage (see GraphicsTextureFlag::HostTransfer)
+        VulkanExportableMemory  exportableMemory;               // only set for textures with GraphicsTextureFlag::Exportable
+        uint32                  objectGeneration;               // unique per created object (see vulkan::combineCommandBufferKey)
+    };
+
+    struct VulkanTimelineSemaphore : public GraphicsTimelineSemaphore
+    {
+        VkSemaphore             semaphore;
     };
 
     struct VulkanBuffer : public GraphicsBuffer
@@ -57,6 +96,9 @@ namespace keen
         uint64                      boundMemoryOffset;
         const VulkanDeviceMemory*   pBoundDeviceMemory;
         VkDeviceAddress             deviceAddress;  // only valid with the correct usage flags
+        VkDeviceMemory              importedMemory; // only set for buffers on top of imported host memory (owned by the buffer)
+        VulkanUploadCopyKernel      uploadCopyKernel;   // for writes into the mapped memory (depends on the memory type)
+        uint32                      objectGeneration;   // unique per created object (see vulkan::combineCommandBufferKey)
     };
 
     struct VulkanSampler : public GraphicsSampler
@@ -68,6 +110,9 @@ namespace keen
     {
         VkDescriptorSetLayout       layout;
         Array<VulkanSampler*>       staticSamplers;
+        uint64                      layoutHash;         // bindings + static sampler parameters
+        uint32                      dynamicUniformBufferCount;
+        uint32                      dynamicStorageBufferCount;
     };
 
     struct VulkanGpuProfileEvent
@@ -79,6 +124,7 @@ namespace keen
     struct VulkanDescriptorSet : public GraphicsDescriptorSet
     {
         VkDescriptorSet             set;
+        uint32                      objectGeneration;   // unique per created object (see vulkan::combineCommandBufferKey)
     };
 
     struct StaticVulkanDescriptorSet : public VulkanDescriptorSet
@@ -89,6 +135,21 @@ namespace keen
     struct VulkanQueryPool : public GraphicsQueryPool
     {
         VkQueryPool                 queryPool;
+        VkQueryType                 queryType;
+        uint32                      objectGeneration;   // unique per created object (see vulkan::combineCommandBufferKey)
+    };
+
+    struct VulkanIndirectCommandsLayout : public GraphicsIndirectCommandsLayout
+    {
+        VkIndirectCommandsLayoutEXT layout;
+        VkIndirectExecutionSetEXT   executionSet;       // VK_NULL_HANDLE if the layout has no pipeline token
+        VkPipeline                  pipeline;           // the fixed pipeline if the layout has no pipeline token
+        VkShaderStageFlags          shaderStages;
+        uint32                      indirectStride;
+        uint32                      maxSequenceCount;
+        uint64                      preprocessSize;     // for maxSequenceCount sequences
+        uint64                      preprocessAlignment;
+        uint32                      objectGeneration;   // unique per created object (see vulkan::combineCommandBufferKey)
     };
 
     enum class VulkanDescriptorPoolType
@@ -118,6 +179,21 @@ namespace keen
         size_t                              allocatedCommandBufferCount;
     };
 
+    // secondary command buffer recorded from a cacheable GraphicsCommandBuffer. Cacheable command buffers must only reference persistent objects:
+    // dynamic descriptor sets and swap chain textures change their vulkan handles without an object being destroyed. Entries that referenced a
+    // destroyed object are never found again (the key contains the object generations) and get reused by the least recently used eviction.
+    // The recordings bind the bindless descriptor set of their frame, which is not UPDATE_AFTER_BIND - so all entries of a frame are
+    // invalidated when its bindless descriptors are written (see VulkanRenderContext::invalidateCachedCommandBuffers).
+    struct VulkanCachedCommandBuffer
+    {
+        uint64                              key;                // see vulkan::computeCommandBufferKey
+        uint32                              lastUseIndex;
+        bool                                usesPreprocessBuffer;   // contains generated commands - the preprocess range is only valid for the recording frame
+        VkCommandBuffer                     commandBuffer;
+    };
+
+    constexpr size_t VulkanMaxCachedCommandBufferCount = 32u;
+
     struct VulkanUsedSwapChainInfo
     {
         static constexpr size_t MaxSwapChainCount = 64u;
@@ -125,6 +201,7 @@ namespace keen
         DynamicArray<VkSemaphore,MaxSwapChainCount>             imageAvailableSemaphores;
         DynamicArray<VkPipelineStageFlags,MaxSwapChainCount>    waitStageMasks;
         DynamicArray<uint32,MaxSwapChainCount>                  imageIndices;
+        DynamicArray<const VkPresentRegionKHR*,MaxSwapChainCount>   presentRegions;     // owned by the swap chains - filled until the present
     };
 
     struct VulkanFrame : public GraphicsFrame
@@ -138,9 +215,22 @@ namespace keen
         VkDescriptorSet                     bindlessDescriptorSet;
         BitArrayCount                       bindlessTexturesDirtyMask;
         BitArrayCount                       bindlessSamplersDirtyMask;
+        BitArrayCount                       bindlessStorageBuffersDirtyMask;
+        VulkanBuffer*                       pBindlessBufferAddressTable;    // uint64 device address per bindless storage buffer (bindless binding 3)
+        VulkanBuffer*                       pGeneratedCommandsPreprocessBuffer;
+        uint64                              generatedCommandsPreprocessBufferSize;
+        uint64                              generatedCommandsPreprocessUsedSize;    // each execute of the frame gets its own range of the buffer
 
         VkSemaphore                         renderingFinishedSemaphore;
 
+        // signaled with the last command buffer of the frame (see GraphicsDevice::signalTimelineSemaphore):
+        DynamicArray<VkSemaphore,VulkanMaxFrameTimelineSemaphoreSignalCount>    timelineSignalSemaphores;
+        DynamicArray<uint64,VulkanMaxFrameTimelineSemaphoreSignalCount>         timelineSignalValues;
+
+        VkCommandPool                       cachedCommandPool;      // not reset per frame - owns the cached secondary command buffers
+        DynamicArray<VulkanCachedCommandBuffer,VulkanMaxCachedCommandBufferCount>   cachedCommandBuffers;
+        uint32                              cachedCommandBufferUseIndex;
+
         DynamicArray<VulkanSwapChain*,64u>  targetSwapChains;
         VulkanUsedSwapChainInfo             swapChainInfo;
 
@@ -156,6 +246,9 @@ namespace keen
         VkCommandPool                       commandPool;
         VkCommandBuffer                     commandBuffer;
         VkFence                             fence;
+
+        // host memory imports used as copy source by this batch - destroyed when the batch has finished:
+        DynamicArray<VulkanBuffer*, VulkanMaxTransferBatchHostMemoryImportCount>  hostMemoryBuffers;
     };
 
     struct VulkanTransferQueue
@@ -181,6 +274,13 @@ namespace keen
         VkPhysicalDeviceFeatures                            deviceFeatures;
         VkPhysicalDeviceVulkan11Features                    deviceFeatures_1_1;
         VkPhysicalDeviceVulkan12Features                    deviceFeatures_1_2;
+        VkPhysicalDeviceDeviceGeneratedCommandsPropertiesEXT    deviceGeneratedCommandsProperties;
+        VulkanDynamicStateFeatureMask                       dynamicStateFeatures;
+        bool                                                useShaderObjects;
+        VkShaderStageFlags                                  shaderObjectStageMask;      // stages that every vkCmdBindShadersEXT has to cover
+        VulkanHostImageCopyInfo                             hostImageCopyInfo;
+        VulkanHostMemoryImportInfo                          hostMemoryImportInfo;
+        VulkanExternalMemoryInfo                            externalMemoryInfo;
 
         Array<VkQueueFamilyProperties>                      queueFamilyProperties;
         uint32                                              graphicsQueueFamilyIndex;
@@ -0,0 +1,159 @@
+#include "vulkan_upload_copy.hpp"
+
+#if defined( __AVX__ )
+#   include <immintrin.h>
+#   define KEEN_VULKAN_AVX_STREAMING_STORES     KEEN_ON
+#   define KEEN_VULKAN_SSE2_STREAMING_STORES    KEEN_OFF
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#   include <emmintrin.h>
+#   define KEEN_VULKAN_AVX_STREAMING_STORES     KEEN_OFF
+#   define KEEN_VULKAN_SSE2_STREAMING_STORES    KEEN_ON
+#else
+#   define KEEN_VULKAN_AVX_STREAMING_STORES     KEEN_OFF
+#   define KEEN_VULKAN_SSE2_STREAMING_STORES    KEEN_OFF
+#endif
+
+namespace keen
+{
+
+#if KEEN_USING( KEEN_VULKAN_AVX_STREAMING_STORES ) || KEEN_USING( KEEN_VULKAN_SSE2_STREAMING_STORES )
+    // the write combining buffers are written to memory as whole cache lines - so the streaming loops write one line per iteration:
+    static constexpr size_t StreamingLineSize = 64u;
+
+    // returns the size of the unaligned head that has to be written with regular stores:
+    static size_t getStreamingHeadSize( const void* pTarget, size_t size )
+    {
+        const uintptr_t targetAddress = (uintptr_t)pTarget;
+        return min( size, (size_t)( alignUp( targetAddress, (uintptr_t)StreamingLineSize ) - targetAddress ) );
+    }
+#endif
+
+    VulkanUploadCopyKernel vulkan::selectUploadCopyKernel( VkMemoryPropertyFlags memoryFlags )
+    {
+        KEEN_ASSERT( isBitmaskSet( memoryFlags, (VkMemoryPropertyFlags)VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) );
+
+        // :JK: host visible memory without the cached flag is write combined on all desktop drivers (that is always coherent as well).
+        // cached memory is written with regular stores - it is either read back by the cpu or non coherent (and flushed line by line)
+        if( isBitmaskSet( memoryFlags, (VkMemoryPropertyFlags)VK_MEMORY_PROPERTY_HOST_CACHED_BIT ) || !isBitmaskSet( memoryFlags, (VkMemoryPropertyFlags)VK_MEMORY_PROPERTY_HOST_COHERENT_BIT ) )
+        {
+            return VulkanUploadCopyKernel::Memcpy;
+        }
+        return hasStreamingStores() ? VulkanUploadCopyKernel::Streaming : VulkanUploadCopyKernel::Memcpy;
+    }
+
+    void vulkan::copyToUploadMemory( VulkanUploadCopyKernel kernel, void* pTarget, const void* pSource, size_t size )
+    {
+        if( kernel == VulkanUploadCopyKernel::Streaming && size >= VulkanMinStreamingCopySize )
+        {
+            copyMemoryStreaming( pTarget, pSource, size );
+        }
+        else
+        {
+            copyMemoryNonOverlapping( pTarget, pSource, size );
+        }
+    }
+
+    void vulkan::fillUploadMemoryWithZero( VulkanUploadCopyKernel kernel, void* pTarget, size_t size )
+    {
+        if( kernel == VulkanUploadCopyKernel::Streaming && size >= VulkanMinStreamingCopySize )
+        {
+            fillMemoryWithZeroStreaming( pTarget, size );
+        }
+        else
+        {
+            fillMemoryWithZero( pTarget, size );
+        }
+    }
+
+    bool vulkan::hasStreamingStores()
+    {
+#if KEEN_USING( KEEN_VULKAN_AVX_STREAMING_STORES ) || KEEN_USING( KEEN_VULKAN_SSE2_STREAMING_STORES )
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void vulkan::copyMemoryStreaming( void* pTarget, const void* pSource, size_t size )
+    {
+#if KEEN_USING( KEEN_VULKAN_AVX_STREAMING_STORES ) || KEEN_USING( KEEN_VULKAN_SSE2_STREAMING_STORES )
+        uint8* pTargetBytes         = (uint8*)pTarget;
+        const uint8* pSourceBytes   = (const uint8*)pSource;
+
+        const size_t headSize = getStreamingHeadSize( pTargetBytes, size );
+        copyMemoryNonOverlapping( pTargetBytes, pSourceBytes, headSize );
+        pTargetBytes    += headSize;
+        pSourceBytes    += headSize;
+        size            -= headSize;
+
+        // the source alignment is unknown - loads are unaligned:
+        while( size >= StreamingLineSize )
+        {
+#   if KEEN_USING( KEEN_VULKAN_AVX_STREAMING_STORES )
+            const __m256i data0 = _mm256_loadu_si256( (const __m256i*)( pSourceBytes + 0u ) );
+            const __m256i data1 = _mm256_loadu_si256( (const __m256i*)( pSourceBytes + 32u ) );
+            _mm256_stream_si256( (__m256i*)( pTargetBytes + 0u ), data0 );
+            _mm256_stream_si256( (__m256i*)( pTargetBytes + 32u ), data1 );
+#   else
+            const __m128i data0 = _mm_loadu_si128( (const __m128i*)( pSourceBytes + 0u ) );
+            const __m128i data1 = _mm_loadu_si128( (const __m128i*)( pSourceBytes + 16u ) );
+            const __m128i data2 = _mm_loadu_si128( (const __m128i*)( pSourceBytes + 32u ) );
+            const __m128i data3 = _mm_loadu_si128( (const __m128i*)( pSourceBytes + 48u ) );
+            _mm_stream_si128( (__m128i*)( pTargetBytes + 0u ), data0 );
+            _mm_stream_si128( (__m128i*)( pTargetBytes + 16u ), data1 );
+            _mm_stream_si128( (__m128i*)( pTargetBytes + 32u ), data2 );
+            _mm_stream_si128( (__m128i*)( pTargetBytes + 48u ), data3 );
+#   endif
+            pTargetBytes    += StreamingLineSize;
+            pSourceBytes    += StreamingLineSize;
+            size            -= StreamingLineSize;
+        }
+
+        // :JK: the streaming stores are weakly ordered - the fence makes them visible before anything that is written after the copy (i.e. the submit)
+        _mm_sfence();
+
+        copyMemoryNonOverlapping( pTargetBytes, pSourceBytes, size );
+#else
+        copyMemoryNonOverlapping( pTarget, pSource, size );
+#endif
+    }
+
+    void vulkan::fillMemoryWithZeroStreaming( void* pTarget, size_t size )
+    {
+#if KEEN_USING( KEEN_VULKAN_AVX_STREAMING_STORES ) || KEEN_USING( KEEN_VULKAN_SSE2_STREAMING_STORES )
+        uint8* pTargetBytes = (uint8*)pTarget;
+
+        const size_t headSize = getStreamingHeadSize( pTargetBytes, size );
+        fillMemoryWithZero( pTargetBytes, headSize );
+        pTargetBytes    += headSize;
+        size            -= headSize;
+
+#   if KEEN_USING( KEEN_VULKAN_AVX_STREAMING_STORES )
+        const __m256i zero = _mm256_setzero_si256();
+#   else
+        const __m128i zero = _mm_setzero_si128();
+#   endif
+        while( size >= StreamingLineSize )
+        {
+#   if KEEN_USING( KEEN_VULKAN_AVX_STREAMING_STORES )
+            _mm256_stream_si256( (__m256i*)( pTargetBytes + 0u ), zero );
+            _mm256_stream_si256( (__m256i*)( pTargetBytes + 32u ), zero );
+#   else
+            _mm_stream_si128( (__m128i*)( pTargetBytes + 0u ), zero );
+            _mm_stream_si128( (__m128i*)( pTargetBytes + 16u ), zero );
+            _mm_stream_si128( (__m128i*)( pTargetBytes + 32u ), zero );
+            _mm_stream_si128( (__m128i*)( pTargetBytes + 48u ), zero );
+#   endif
+            pTargetBytes    += StreamingLineSize;
+            size            -= StreamingLineSize;
+        }
+
+        _mm_sfence();
+
+        fillMemoryWithZero( pTargetBytes, size );
+#else
+        fillMemoryWithZero( pTarget, size );
+#endif
+    }
+
+}
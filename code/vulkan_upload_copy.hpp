@@ -0,0 +1,35 @@
+#ifndef KEEN_VULKAN_UPLOAD_COPY_HPP_INCLUDED
+#define KEEN_VULKAN_UPLOAD_COPY_HPP_INCLUDED
+
+#include "vulkan_api.hpp"
+
+namespace keen
+{
+    // smaller copies are done with regular stores - the fence after the streaming stores costs more than the cache pollution
+    constexpr size_t VulkanMinStreamingCopySize = 256u;
+
+    enum class VulkanUploadCopyKernel : uint8
+    {
+        Memcpy,         // cached host memory - the cpu caches combine the writes (and the cpu might read the data again)
+        Streaming,      // uncached (write combined) host memory - non temporal stores write full cache lines and bypass the cpu caches
+    };
+
+    namespace vulkan
+    {
+
+        VulkanUploadCopyKernel  selectUploadCopyKernel( VkMemoryPropertyFlags memoryFlags );
+
+        // :JK: use these for all writes into mapped gpu memory that the cpu does not read again:
+        void                    copyToUploadMemory( VulkanUploadCopyKernel kernel, void* pTarget, const void* pSource, size_t size );
+        void                    fillUploadMemoryWithZero( VulkanUploadCopyKernel kernel, void* pTarget, size_t size );
+
+        // non temporal stores (SSE2/AVX) followed by a store fence - regular stores on platforms without them:
+        bool                    hasStreamingStores();
+        void                    copyMemoryStreaming( void* pTarget, const void* pSource, size_t size );
+        void                    fillMemoryWithZeroStreaming( void* pTarget, size_t size );
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+#include "vulkan_upload_copy.hpp"
+
+#include "keen/base/inivariables.hpp"
+#include "keen/base/profiler.hpp"
+#include "keen/base/unit_test.hpp"
+
+
+namespace keen
+{
+    static constexpr size_t UploadCopyTestBufferSize = 4096u;
+    static constexpr size_t UploadCopyBenchmarkMaxSize = 4u * 1024u * 1024u;
+
+    KEEN_DEFINE_BOOL_VARIABLE( s_runUploadCopyBenchmark, "vulkan/runUploadCopyBenchmark", false, "Trace the timings of the upload copy kernels when the unit tests run" );
+
+    class VulkanUploadCopyTestFixture : public UnitTest
+    {
+    public:
+        VulkanUploadCopyTestFixture()
+        {
+            for( size_t i = 0u; i < UploadCopyTestBufferSize; ++i )
+            {
+                m_source[ i ] = (uint8)( i * 7u + 3u );
+            }
+        }
+
+    protected:
+        uint8           m_source[ UploadCopyTestBufferSize ];
+        uint8           m_target[ UploadCopyTestBufferSize + 2u * 64u ];
+
+        void resetTarget()
+        {
+            for( size_t i = 0u; i < KEEN_COUNTOF( m_target ); ++i )
+            {
+                m_target[ i ] = 0xcdu;
+            }
+        }
+
+        // checks the copied range and that the bytes around it were not touched:
+        bool isCopied( size_t targetOffset, size_t sourceOffset, size_t size ) const
+        {
+            for( size_t i = 0u; i < KEEN_COUNTOF( m_target ); ++i )
+            {
+                const bool isInRange = i >= targetOffset && i < targetOffset + size;
+                const uint8 expectedValue = isInRange ? m_source[ sourceOffset + i - targetOffset ] : 0xcdu;
+                if( m_target[ i ] != expectedValue )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool isZeroFilled( size_t targetOffset, size_t size ) const
+        {
+            for( size_t i = 0u; i < KEEN_COUNTOF( m_target ); ++i )
+            {
+                const bool isInRange = i >= targetOffset && i < targetOffset + size;
+                if( m_target[ i ] != ( isInRange ? 0u : 0xcdu ) )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    KEEN_UNIT_TEST_F( VulkanUploadCopyTestFixture, testSelectUploadCopyKernel )
+    {
+        const VkMemoryPropertyFlags writeCombined = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        const VulkanUploadCopyKernel expectedKernel = vulkan::hasStreamingStores() ? VulkanUploadCopyKernel::Streaming : VulkanUploadCopyKernel::Memcpy;
+        KEEN_UT_CHECK( vulkan::selectUploadCopyKernel( writeCombined ) == expectedKernel );
+
+        // resizable bar memory is write combined as well:
+        KEEN_UT_CHECK( vulkan::selectUploadCopyKernel( writeCombined | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT ) == expectedKernel );
+
+        // cached memory is read back by the cpu or written with regular stores anyway:
+        KEEN_UT_CHECK( vulkan::selectUploadCopyKernel( writeCombined | VK_MEMORY_PROPERTY_HOST_CACHED_BIT ) == VulkanUploadCopyKernel::Memcpy );
+        KEEN_UT_CHECK( vulkan::selectUploadCopyKernel( VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT ) == VulkanUploadCopyKernel::Memcpy );
+        KEEN_UT_CHECK( vulkan::selectUploadCopyKernel( VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT ) == VulkanUploadCopyKernel::Memcpy );
+    }
+
+    KEEN_UNIT_TEST_F( VulkanUploadCopyTestFixture, testStreamingCopy )
+    {
+        // unaligned heads, whole cache lines and tails of all kinds:
+        const size_t sizes[] = { 0u, 1u, 15u, 63u, 64u, 65u, 255u, 256u, 1000u, 4000u };
+        const size_t offsets[] = { 0u, 1u, 13u, 32u, 63u };
+        for( size_t sizeIndex = 0u; sizeIndex < KEEN_COUNTOF( sizes ); ++sizeIndex )
+        {
+            for( size_t offsetIndex = 0u; offsetIndex < KEEN_COUNTOF( offsets ); ++offsetIndex )
+            {
+                const size_t targetOffset = offsets[ offsetIndex ];
+                const size_t sourceOffset = offsets[ ( offsetIndex + 1u ) % KEEN_COUNTOF( offsets ) ];
+
+                resetTarget();
+                vulkan::copyMemoryStreaming( m_target + targetOffset, m_source + sourceOffset, sizes[ sizeIndex ] );
+                KEEN_UT_CHECK( isCopied( targetOffset, sourceOffset, sizes[ sizeIndex ] ) );
+
+                resetTarget();
+                vulkan::copyToUploadMemory( VulkanUploadCopyKernel::Streaming, m_target + targetOffset, m_source + sourceOffset, sizes[ sizeIndex ] );
+                KEEN_UT_CHECK( isCopied( targetOffset, sourceOffset, sizes[ sizeIndex ] ) );
+
+                resetTarget();
+                vulkan::fillMemoryWithZeroStreaming( m_target + targetOffset, sizes[ sizeIndex ] );
+                KEEN_UT_CHECK( isZeroFilled( targetOffset, sizes[ sizeIndex ] ) );
+            }
+        }
+    }
+
+    // :JK: not a real test - the timings go to the log to compare the kernels on a new cpu (enable vulkan/runUploadCopyBenchmark). the target
+    // is regular (cached) memory here, on write combined memory the difference is larger because partial line writes are slower there
+    KEEN_UNIT_TEST_F( VulkanUploadCopyTestFixture, benchmarkUploadCopyKernels )
+    {
+        if( !s_runUploadCopyBenchmark )
+        {
+            return;
+        }
+
+        // larger than the last level cache of most desktop cpus - that is where the streaming stores pay off:
+        static uint8 s_benchmarkSource[ UploadCopyBenchmarkMaxSize ];
+        static uint8 s_benchmarkTarget[ UploadCopyBenchmarkMaxSize ];
+
+        for( size_t i = 0u; i < UploadCopyBenchmarkMaxSize; ++i )
+        {
+            s_benchmarkSource[ i ] = 0x5au;
+        }
+
+        constexpr size_t BenchmarkBytesPerSize = 64u * 1024u * 1024u;
+        for( size_t size = VulkanMinStreamingCopySize; size <= UploadCopyBenchmarkMaxSize; size *= 4u )
+        {
+            const size_t iterationCount = BenchmarkBytesPerSize / size;
+
+            const SystemTimer memcpyTimer;
+            for( size_t i = 0u; i < iterationCount; ++i )
+            {
+                copyMemoryNonOverlapping( s_benchmarkTarget, s_benchmarkSource, size );
+            }
+            const Time memcpyTime = memcpyTimer.getElapsedTime();
+
+            const SystemTimer streamingTimer;
+            for( size_t i = 0u; i < iterationCount; ++i )
+            {
+                vulkan::copyMemoryStreaming( s_benchmarkTarget, s_benchmarkSource, size );
+            }
+            const Time streamingTime = streamingTimer.getElapsedTime();
+
+            KEEN_TRACE_INFO( "[graphics] upload copy %zu bytes x %zu: memcpy %k streaming %k\n", size, iterationCount, memcpyTime, streamingTime );
+        }
+
+        KEEN_UT_CHECK( s_benchmarkTarget[ UploadCopyBenchmarkMaxSize - 1u ] == 0x5au );
+    }
+
+}